@@ -19,6 +19,23 @@ Macro (add_acceptance_test casename)
 
 EndMacro (add_acceptance_test)
 
+# Input:
+#   - casename: with or without extension
+#
+# Same reference data and tolerances as add_acceptance_test(), but
+# time-of-flight is computed by the level-scheduled ECLParallelTOF solver.
+Macro (add_parallel_tof_acceptance_test casename)
+
+  String (REGEX REPLACE "\\.[^.]*$" "" basename "${casename}")
+
+  Add_Test (NAME    ParallelToF_accept_${casename}_all_steps
+            COMMAND runAcceptanceTest
+            "case=${OPM_DATA_ROOT}/flow_diagnostic_test/eclipse-simulation/${basename}"
+            "ref-dir=${OPM_DATA_ROOT}/flow_diagnostic_test/fd-ref-data/${basename}"
+            "solver=parallel" "atol=5e-6" "rtol=1e-13")
+
+EndMacro (add_parallel_tof_acceptance_test)
+
 # Input
 #  - casename: with or without extension
 #
@@ -49,6 +66,36 @@ Macro (add_celldata_acceptance_test casename)
 
 EndMacro (add_celldata_acceptance_test)
 
+# Input
+#   - casename: with or without extension
+#
+# Compares optimised kernels (parallel loops, interval hints, fused kr/Pc
+# evaluation, restart array cache) to their reference code paths.
+Macro (add_equivalence_test casename)
+
+  String (REGEX REPLACE "\\.[^.]*$" "" basename "${casename}")
+
+  Add_Test (NAME    Equivalence_${casename}
+            COMMAND runEquivalenceTest
+            "case=${OPM_DATA_ROOT}/flow_diagnostic_test/eclipse-simulation/${basename}"
+            "max-ulps=4")
+
+EndMacro (add_equivalence_test)
+
+# Input
+#   - casename: with or without extension
+#
+# Structural consistency of well topology and grid mappings.
+Macro (add_topology_test casename)
+
+  String (REGEX REPLACE "\\.[^.]*$" "" basename "${casename}")
+
+  Add_Test (NAME    Topology_${casename}
+            COMMAND runTopologyTest
+            "case=${OPM_DATA_ROOT}/flow_diagnostic_test/eclipse-simulation/${basename}")
+
+EndMacro (add_topology_test)
+
 If (NOT TARGET test-suite)
   Add_Custom_Target (test-suite)
 EndIf ()
@@ -56,5 +103,8 @@ EndIf ()
 # Acceptance tests
 
 Add_Acceptance_Test (SIMPLE_2PH_W_FAULT_LGR)
+Add_Parallel_ToF_Acceptance_Test (SIMPLE_2PH_W_FAULT_LGR)
 Add_Trans_Acceptance_Test (SIMPLE_2PH_W_FAULT_LGR)
 Add_CellData_Acceptance_Test (SIMPLE_2PH_W_FAULT_LGR "pressure")
+Add_Equivalence_Test (SIMPLE_2PH_W_FAULT_LGR)
+Add_Topology_Test (SIMPLE_2PH_W_FAULT_LGR)
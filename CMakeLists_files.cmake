@@ -21,10 +21,17 @@
 #                             the library needs it.
 
 list (APPEND MAIN_SOURCE_FILES
+        opm/utility/ECLByteCodec.cpp
+        opm/utility/ECLCancellation.cpp
         opm/utility/ECLCaseUtilities.cpp
         opm/utility/ECLEndPointScaling.cpp
+        opm/utility/ECLExecutor.cpp
+        opm/utility/ECLFieldPyramid.cpp
         opm/utility/ECLFluxCalc.cpp
         opm/utility/ECLGraph.cpp
+        opm/utility/ECLMemoryBudget.cpp
+        opm/utility/ECLMemoryPolicy.cpp
+        opm/utility/ECLParallelTOF.cpp
         opm/utility/ECLPropertyUnitConversion.cpp
         opm/utility/ECLPropTable.cpp
         opm/utility/ECLPvtCommon.cpp
@@ -32,43 +39,74 @@ list (APPEND MAIN_SOURCE_FILES
         opm/utility/ECLPvtGas.cpp
         opm/utility/ECLPvtOil.cpp
         opm/utility/ECLPvtWater.cpp
+        opm/utility/ECLRankSelectBitVector.cpp
         opm/utility/ECLRegionMapping.cpp
         opm/utility/ECLResultData.cpp
         opm/utility/ECLSaturationFunc.cpp
+        opm/utility/ECLSharedFields.cpp
+        opm/utility/ECLSpatialIndex.cpp
+        opm/utility/ECLStepSeries.cpp
+        opm/utility/ECLSummaryData.cpp
         opm/utility/ECLTableInterpolation1D.cpp
         opm/utility/ECLUnitHandling.cpp
         opm/utility/ECLWellSolution.cpp
+        opm/utility/ECLWorkerPool.cpp
         )
 
 list (APPEND TEST_SOURCE_FILES
         tests/test_eclendpointscaling.cpp
+        tests/test_eclexecutor.cpp
+        tests/test_eclfieldpyramid.cpp
+        tests/test_eclkernelequivalence.cpp
+        tests/test_eclmemorybudget.cpp
+        tests/test_eclmemorypolicy.cpp
+        tests/test_eclparalleltof.cpp
         tests/test_eclpropertyunitconversion.cpp
         tests/test_eclproptable.cpp
         tests/test_eclpvtcommon.cpp
+        tests/test_eclrankselectbitvector.cpp
         tests/test_eclregionmapping.cpp
+        tests/test_eclsharedfields.cpp
         tests/test_eclsimple1dinterpolant.cpp
+        tests/test_eclspatialindex.cpp
+        tests/test_eclstaticarraycache.cpp
+        tests/test_eclstepseries.cpp
+        tests/test_eclsummarydata.cpp
         tests/test_eclunithandling.cpp
+        tests/test_eclworkerpool.cpp
         )
 
 list (APPEND EXAMPLE_SOURCE_FILES
+        examples/benchmarkKernels.cpp
         examples/computeFlowStorageCurve.cpp
         examples/computeLocalSolutions.cpp
         examples/computePhaseFluxes.cpp
+        examples/computeStepDiagnostics.cpp
         examples/computeToFandTracers.cpp
         examples/computeTracers.cpp
         examples/dynamicCellProperty.cpp
+        examples/exportFieldPyramids.cpp
         examples/extractFromRestart.cpp
         examples/extractPropCurves.cpp
         tests/runAcceptanceTest.cpp
+        tests/runEquivalenceTest.cpp
         tests/runLinearisedCellDataTest.cpp
+        tests/runTopologyTest.cpp
         tests/runTransTest.cpp
         )
 
 list (APPEND PUBLIC_HEADER_FILES
+        opm/utility/ECLByteCodec.hpp
+        opm/utility/ECLCancellation.hpp
         opm/utility/ECLCaseUtilities.hpp
         opm/utility/ECLEndPointScaling.hpp
+        opm/utility/ECLExecutor.hpp
+        opm/utility/ECLFieldPyramid.hpp
         opm/utility/ECLFluxCalc.hpp
         opm/utility/ECLGraph.hpp
+        opm/utility/ECLMemoryBudget.hpp
+        opm/utility/ECLMemoryPolicy.hpp
+        opm/utility/ECLParallelTOF.hpp
         opm/utility/ECLPhaseIndex.hpp
         opm/utility/ECLPiecewiseLinearInterpolant.hpp
         opm/utility/ECLPropertyUnitConversion.hpp
@@ -78,10 +116,17 @@ list (APPEND PUBLIC_HEADER_FILES
         opm/utility/ECLPvtGas.hpp
         opm/utility/ECLPvtOil.hpp
         opm/utility/ECLPvtWater.hpp
+        opm/utility/ECLRankSelectBitVector.hpp
         opm/utility/ECLRegionMapping.hpp
         opm/utility/ECLResultData.hpp
         opm/utility/ECLSaturationFunc.hpp
+        opm/utility/ECLSharedFields.hpp
+        opm/utility/ECLSpatialIndex.hpp
+        opm/utility/ECLStaticArrayCache.hpp
+        opm/utility/ECLStepSeries.hpp
+        opm/utility/ECLSummaryData.hpp
         opm/utility/ECLTableInterpolation1D.hpp
         opm/utility/ECLUnitHandling.hpp
         opm/utility/ECLWellSolution.hpp
+        opm/utility/ECLWorkerPool.hpp
         )
@@ -0,0 +1,210 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <examples/exampleSetup.hpp>
+#include <examples/perfCounters.hpp>
+
+#include <opm/utility/ECLCaseUtilities.hpp>
+#include <opm/utility/ECLExecutor.hpp>
+#include <opm/utility/ECLFluxCalc.hpp>
+#include <opm/utility/ECLGraph.hpp>
+#include <opm/utility/ECLPhaseIndex.hpp>
+#include <opm/utility/ECLPvtOil.hpp>
+#include <opm/utility/ECLResultData.hpp>
+#include <opm/utility/ECLSaturationFunc.hpp>
+#include <opm/utility/ECLUnitHandling.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Syntax (typical):
+//   benchmarkKernels case=<ecl_case_prefix> [step=<report_step>]
+//                    [repeat=10] [perf=true] [serial=true]
+//
+// Measures the throughput of the library's core kernels on a single
+// report step of a result set:
+//
+//   - Phase fluxes (ECLFluxCalc::flux()), per connection.
+//   - Relative permeabilities (ECLSaturationFunc::relperm()), per cell.
+//   - Oil formation volume factor (ECLPVT::Oil), per cell.
+//
+// With 'perf=true' (default), hardware counters are collected through
+// Linux perf_event_open() and the report includes instructions per cycle,
+// last-level cache misses and branch misses per item as well as an
+// estimate of memory traffic per item.  Counters that are unavailable are
+// reported as "n/a".
+//
+// Counters measure the calling thread only.  Option 'serial=true'
+// (default) therefore runs all library loops in the calling thread.  Use
+// 'serial=false' to measure wall-clock throughput of the thread pool.
+
+namespace {
+    /// Run all library loops in the calling thread while in scope.
+    class SerialExecution
+    {
+    public:
+        explicit SerialExecution(const bool enable)
+            : enable_(enable)
+        {
+            if (this->enable_) {
+                Opm::ECLExecution::setDefaultExecutor
+                    (std::make_shared<Opm::ECLSerialExecutor>());
+            }
+        }
+
+        ~SerialExecution()
+        {
+            if (this->enable_) {
+                Opm::ECLExecution::setDefaultExecutor(nullptr);
+            }
+        }
+
+    private:
+        bool enable_;
+    };
+
+    std::string phaseName(const Opm::ECLPhaseIndex p)
+    {
+        switch (p) {
+        case Opm::ECLPhaseIndex::Aqua:   return "water";
+        case Opm::ECLPhaseIndex::Liquid: return "oil";
+        case Opm::ECLPhaseIndex::Vapour: return "gas";
+        }
+
+        return "unknown";
+    }
+
+    std::vector<double>
+    cellData(const Opm::ECLGraph&                  graph,
+             const Opm::ECLRestartData&            rstrt,
+             const std::string&                    vector,
+             const Opm::ECLGraph::UnitConvention   unit)
+    {
+        auto x = std::vector<double>{};
+
+        if (rstrt.haveKeywordData(vector)) {
+            x = graph.linearisedCellData(rstrt, vector, unit);
+        }
+
+        if (x.empty()) {
+            x.assign(graph.numCells(), 0.0);
+        }
+
+        return x;
+    }
+
+    int selectStep(const Opm::ParameterGroup&               prm,
+                   const Opm::ECLCaseUtilities::ResultSet&  rset)
+    {
+        const auto steps = rset.reportStepIDs();
+
+        if (steps.empty()) {
+            throw std::invalid_argument("Result Set Has No Report Steps");
+        }
+
+        return prm.getDefault("step", steps.back());
+    }
+} // namespace Anonymous
+
+int main(int argc, char* argv[])
+try {
+    const auto prm  = example::initParam(argc, argv);
+    const auto rset = example::identifyResultSet(prm);
+
+    const auto init  = Opm::ECLInitFileData(rset.initFile());
+    const auto graph = Opm::ECLGraph::load(rset.gridFile(), init);
+
+    const auto step  = selectStep(prm, rset);
+    const auto rstrt = Opm::ECLRestartData(rset.restartFile(step));
+
+    if (! rstrt.selectReportStep(step)) {
+        std::cerr << "Report Step " << step << " Not Available\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto grav   = prm.getDefault("grav", 9.80665);
+    const auto useEPS = prm.getDefault("use_ep_scaling", true);
+
+    const auto calc  = Opm::ECLFluxCalc(graph, init, grav, useEPS);
+    const auto sfunc = Opm::ECLSaturationFunc(graph, init, useEPS);
+
+    const SerialExecution serial{ prm.getDefault("serial", true) };
+
+    example::Benchmark bench {
+        prm.getDefault("perf", true), prm.getDefault("repeat", 10)
+    };
+
+    const auto nconn  = graph.neighbours().size() / 2;
+    const auto ncells = graph.numCells();
+
+    for (const auto& p : graph.activePhases()) {
+        const auto name = phaseName(p);
+
+        bench.run("flux/" + name, nconn, "conn", [&calc, &rstrt, p]()
+        {
+            calc.flux(rstrt, p);
+        });
+
+        bench.run("relperm/" + name, ncells, "cell",
+                  [&sfunc, &graph, &rstrt, p]()
+        {
+            sfunc.relperm(graph, rstrt, p);
+        });
+    }
+
+    if (const auto oil = Opm::ECLPVT::CreateOilPVTInterpolant
+        ::fromECLOutput(init))
+    {
+        using Oil = Opm::ECLPVT::Oil;
+
+        const auto rs = Oil::DissolvedGas {
+            cellData(graph, rstrt, "RS",
+                     &Opm::ECLUnits::UnitSystem::dissolvedGasOilRat)
+        };
+
+        const auto po = Oil::OilPressure {
+            cellData(graph, rstrt, "PRESSURE",
+                     &Opm::ECLUnits::UnitSystem::pressure)
+        };
+
+        // All cells in PVT region zero.  Measures table lookup, not
+        // region partitioning.
+        bench.run("pvt/oil-fvf", ncells, "cell", [&oil, &rs, &po]()
+        {
+            oil->formationVolumeFactor(0, rs, po);
+        });
+    }
+
+    bench.print(std::cout);
+}
+catch (const std::exception& e) {
+    std::cerr << "Caught Exception: " << e.what() << '\n';
+
+    return EXIT_FAILURE;
+}
@@ -25,6 +25,8 @@
 #include "exampleSetup.hpp"
 #include <opm/flowdiagnostics/CellSet.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <ios>
 #include <type_traits>
@@ -156,20 +158,77 @@ namespace {
             }
         }
     }
+
+    /// Compare Toolbox concentrations to those of the batched tracer
+    /// solver, which propagates all start sets together.
+    void compareBatchedTracers(const example::Setup&                   setup,
+                               const StartSets&                        start,
+                               const ::Opm::FlowDiagnostics::Solution& sol,
+                               const Opm::ECLParallelTOF::Direction    dir)
+    {
+        auto cells = std::vector<std::vector<int>>{};
+        cells.reserve(start.size());
+
+        for (const auto& pt : start) {
+            cells.emplace_back(pt.begin(), pt.end());
+        }
+
+        const auto tracers =
+            example::initParallelTOF(setup).solveTracers(dir, cells);
+
+        for (auto n = start.size(), k = 0*n; k < n; ++k) {
+            const auto& id = start[k].id();
+            const auto& t  = tracers[k];
+
+            auto conc = sol.concentration(id);
+            auto diff = 0.0;
+
+            for (auto m = t.cells.size(), i = 0*m; i < m; ++i) {
+                const auto c = conc.find(t.cells[i]);
+                const auto v = (c == conc.end()) ? 0.0 : c->second;
+
+                diff = std::max(diff, std::abs(v - t.concentration[i]));
+
+                if (c != conc.end()) { conc.erase(c); }
+            }
+
+            // Cells reached by Toolbox only.
+            for (const auto& item : conc) {
+                diff = std::max(diff, std::abs(item.second));
+            }
+
+            if (diff > 1.0e-8) {
+                std::cout << id.to_string()
+                          << ": FAIL (batched tracer difference "
+                          << diff << ")\n";
+            }
+        }
+    }
 }
 
 // Syntax (typical):
 //   computeLocalSolutions case=<ecl_case_prefix> step=<report_number>
+//
+// Optional parameter batched_tracers=true additionally solves all well
+// tracers in a single batched pass (Opm::ECLParallelTOF) and compares
+// the concentrations to those of the Toolbox.
 int main(int argc, char* argv[])
 try {
     example::Setup setup(argc, argv);
     auto& fdTool = setup.toolbox;
 
+    const auto batched = setup.param.getDefault("batched_tracers", false);
+
     {
         const auto inj = injectors(setup);
         const auto fwd = fdTool.computeInjectionDiagnostics(inj);
 
         runAnalysis(inj, fwd.fd, true);
+
+        if (batched) {
+            compareBatchedTracers(setup, inj, fwd.fd,
+                                  Opm::ECLParallelTOF::Direction::Forward);
+        }
     }
 
     {
@@ -177,6 +236,11 @@ try {
         const auto rev  = fdTool.computeProductionDiagnostics(prod);
 
         runAnalysis(prod, rev.fd, false);
+
+        if (batched) {
+            compareBatchedTracers(setup, prod, rev.fd,
+                                  Opm::ECLParallelTOF::Direction::Reverse);
+        }
     }
 }
 catch (const std::exception& e) {
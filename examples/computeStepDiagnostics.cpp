@@ -0,0 +1,174 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "exampleSetup.hpp"
+#include "pipeline.hpp"
+
+#include <opm/flowdiagnostics/DerivedQuantities.hpp>
+
+#include <iostream>
+#include <memory>
+
+namespace {
+    /// State of single report step as it passes through the pipeline.
+    struct StepState
+    {
+        int    step{-1};
+        double time{-1.0};
+
+        std::shared_ptr<Opm::ECLRestartData> restart;
+
+        std::shared_ptr<Opm::FlowDiagnostics::ConnectionValues> flux;
+        std::vector<Opm::ECLWellSolution::WellData>             wells;
+
+        Opm::FlowDiagnostics::Graph fphi;
+        double lorenz{0.0};
+    };
+} // Anonymous
+
+// Syntax (typical):
+//   computeStepDiagnostics case=<ecl_case_prefix>
+//
+// Computes the Lorenz coefficient of every report step.  Report steps are
+// processed concurrently by a pipeline of stages with configurable
+// parallelism (parameters 'read_threads', 'flux_threads' and
+// 'solve_threads').  A per-stage timing report is written to standard
+// error.  Parameter 'deadline' (seconds) abandons the run, including
+// loading the grid, once that much wall-clock time has elapsed.
+int main(int argc, char* argv[])
+try {
+    auto param = example::initParam(argc, argv);
+
+    const auto token = example::cancellationToken(param);
+
+    const auto rset = example::identifyResultSet(param);
+    const Opm::ECLInitFileData init(rset.initFile());
+    const auto graph = Opm::ECLGraph::load(rset.gridFile(), init, token);
+
+    const bool compute_fluxes = param.getDefault("compute_fluxes", false);
+    const bool useEPS = param.getDefault("use_ep_scaling", false);
+
+    const auto readThreads  = param.getDefault("read_threads", 2);
+    const auto fluxThreads  = param.getDefault("flux_threads", 2);
+    const auto solveThreads = param.getDefault("solve_threads", 4);
+
+    // Shared, read-only model state.
+    const auto calc = compute_fluxes
+        ? std::make_shared<Opm::ECLFluxCalc>(graph, init, 0.0, useEPS)
+        : std::shared_ptr<Opm::ECLFluxCalc>{};
+
+    const auto pv = graph.poreVolume();
+
+    example::Pipeline<StepState> pipeline;
+
+    pipeline.addStage("read", [&rset, &token](StepState& s)
+    {
+        token.throwIfCancelled();
+
+        s.restart = std::make_shared<Opm::ECLRestartData>
+            (rset.restartFile(s.step));
+
+        if (! s.restart->selectReportStep(s.step)) {
+            throw std::domain_error("Report Step Not Available");
+        }
+
+        s.time = example::simulationTime(*s.restart);
+    }, readThreads);
+
+    pipeline.addStage("flux", [&graph, &calc, &token](StepState& s)
+    {
+        token.throwIfCancelled();
+
+        const auto& rstrt = *s.restart;
+
+        auto flux = calc
+            ? example::extractFluxField(graph, [&calc, &rstrt, &token]
+                  (const Opm::ECLPhaseIndex p)
+              {
+                  return calc->flux(rstrt, p, token);
+              })
+            : example::extractFluxField(graph, [&graph, &rstrt]
+                  (const Opm::ECLPhaseIndex p)
+              {
+                  return graph.flux(rstrt, p);
+              });
+
+        s.flux = std::make_shared<Opm::FlowDiagnostics::ConnectionValues>
+            (std::move(flux));
+    }, fluxThreads);
+
+    pipeline.addStage("wells", [&graph](StepState& s)
+    {
+        auto wsol = Opm::ECLWellSolution{-1.0, false};
+
+        s.wells = wsol.solution(*s.restart, graph.activeGrids());
+
+        // Restart data no longer needed.  Release early.
+        s.restart.reset();
+    });
+
+    pipeline.addStage("solve", [&graph, &pv, &token](StepState& s)
+    {
+        token.throwIfCancelled();
+
+        auto tool = example::initToolbox(graph);
+
+        tool.assignConnectionFlux(*s.flux);
+        tool.assignInflowFlux(example::extractWellFlows(graph, s.wells));
+
+        s.flux.reset();
+
+        const auto start = std::vector<Opm::FlowDiagnostics::CellSet>{};
+
+        const auto fwd = tool.computeInjectionDiagnostics(start);
+        const auto rev = tool.computeProductionDiagnostics(start);
+
+        s.fphi = Opm::FlowDiagnostics::
+            flowCapacityStorageCapacityCurve(fwd, rev, pv, 1.0);
+    }, solveThreads);
+
+    pipeline.addStage("post", [](StepState& s)
+    {
+        s.lorenz = Opm::FlowDiagnostics::lorenzCoefficient(s.fphi);
+    });
+
+    pipeline.addStage("write", [](StepState& s)
+    {
+        std::cout << s.step << "    " << s.time
+                  << "    " << s.lorenz << '\n';
+    });
+
+    auto input = std::vector<StepState>{};
+    for (const auto& step : rset.reportStepIDs()) {
+        input.emplace_back();
+        input.back().step = step;
+    }
+
+    std::cout.precision(16);
+
+    pipeline.run(std::move(input));
+    pipeline.printReport(std::cerr);
+}
+catch (const std::exception& e) {
+    std::cerr << "Caught exception: " << e.what() << '\n';
+}
@@ -24,18 +24,75 @@
 
 #include "exampleSetup.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace {
+    double maxRelativeDifference(const std::vector<double>& x,
+                                 const std::vector<double>& y)
+    {
+        auto diff = 0.0;
+
+        for (auto n = x.size(), i = 0*n; i < n; ++i) {
+            const auto scale = std::max(std::abs(x[i]), std::abs(y[i]));
+
+            if (scale > 0.0) {
+                diff = std::max(diff, std::abs(x[i] - y[i]) / scale);
+            }
+        }
+
+        return diff;
+    }
+} // Anonymous
 
 // Syntax (typical):
 //   computeToFandTracers case=<ecl_case_prefix> step=<report_number>
+//
+// Optional parameter tof_engine selects the time-of-flight solver:
+//   toolbox  (default) Serial solver of FlowDiagnostics::Toolbox
+//   parallel           Level-scheduled solver, Opm::ECLParallelTOF
+//   compare            Both.  Outputs Toolbox result and reports the
+//                      maximum relative difference on standard error.
 int main(int argc, char* argv[])
 try {
     example::Setup setup(argc, argv);
     auto& fdTool = setup.toolbox;
 
+    const auto engine =
+        setup.param.getDefault<std::string>("tof_engine", "toolbox");
+
     // Solve for time of flight.
-    std::vector<Opm::FlowDiagnostics::CellSet> start;
-    auto sol = fdTool.computeInjectionDiagnostics(start);
-    const auto& tof = sol.fd.timeOfFlight();
+    auto tof = std::vector<double>{};
+
+    if (engine != "parallel") {
+        std::vector<Opm::FlowDiagnostics::CellSet> start;
+        auto sol = fdTool.computeInjectionDiagnostics(start);
+        tof = sol.fd.timeOfFlight();
+    }
+
+    if (engine != "toolbox") {
+        const auto sol = example::initParallelTOF(setup)
+            .solve(Opm::ECLParallelTOF::Direction::Forward);
+
+        const auto& stats = sol.statistics;
+        std::cerr << "Parallel TOF: " << stats.numLevels << " levels, "
+                  << stats.numComponents << " components (widest level "
+                  << stats.widestLevel << ", largest component "
+                  << stats.largestComponent << " cells)\n";
+
+        if (tof.empty()) {
+            tof = sol.timeOfFlight;
+        }
+        else {
+            std::cerr << "Maximum relative difference to Toolbox: "
+                      << maxRelativeDifference(tof, sol.timeOfFlight)
+                      << '\n';
+        }
+    }
 
     // Write it to standard out.
     std::cout.precision(16);
@@ -29,13 +29,16 @@
 #include <opm/flowdiagnostics/ConnectionValues.hpp>
 #include <opm/flowdiagnostics/Toolbox.hpp>
 
+#include <opm/utility/ECLCancellation.hpp>
 #include <opm/utility/ECLCaseUtilities.hpp>
 #include <opm/utility/ECLFluxCalc.hpp>
 #include <opm/utility/ECLGraph.hpp>
+#include <opm/utility/ECLParallelTOF.hpp>
 #include <opm/utility/ECLPhaseIndex.hpp>
 #include <opm/utility/ECLResultData.hpp>
 #include <opm/utility/ECLWellSolution.hpp>
 
+#include <chrono>
 #include <exception>
 #include <initializer_list>
 #include <sstream>
@@ -132,6 +135,47 @@ namespace example {
         return well_flows;
     }
 
+    template <class WellFluxes>
+    std::vector<double>
+    extractTotalInflow(const Opm::ECLGraph& G,
+                       const WellFluxes&    well_fluxes)
+    {
+        auto inflow = std::vector<double>(G.numCells(), 0.0);
+
+        for (const auto& well : well_fluxes) {
+            for (const auto& completion : well.completions) {
+                const int cell_index =
+                    G.activeCell(completion.ijk, completion.gridName);
+
+                if (cell_index >= 0) {
+                    inflow[cell_index] += completion.reservoir_inflow_rate;
+                }
+            }
+        }
+
+        return inflow;
+    }
+
+    inline std::vector<double>
+    totalFlux(const Opm::FlowDiagnostics::ConnectionValues& flux)
+    {
+        using ConnVals = Opm::FlowDiagnostics::ConnectionValues;
+
+        auto tot = std::vector<double>(flux.numConnections(), 0.0);
+
+        for (auto p = ConnVals::PhaseID{0};
+             p.id < flux.numPhases(); ++p.id)
+        {
+            for (auto c = ConnVals::ConnID{0};
+                 c.id < flux.numConnections(); ++c.id)
+            {
+                tot[c.id] += flux(c, p);
+            }
+        }
+
+        return tot;
+    }
+
 
 
 
@@ -193,6 +237,25 @@ namespace example {
 
 
 
+    /// Cancellation token of parameter 'deadline', the wall-clock time
+    /// (seconds) after which a run is abandoned.  Never cancelled if the
+    /// parameter is absent or not positive.
+    inline Opm::ECLCancellationToken
+    cancellationToken(const Opm::ParameterGroup& param)
+    {
+        const auto deadline = param.getDefault("deadline", 0.0);
+
+        if (! (deadline > 0.0)) {
+            return Opm::ECLCancellationToken{};
+        }
+
+        return Opm::ECLCancellationToken::withTimeout(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(deadline)));
+    }
+
+
+
     inline Opm::FlowDiagnostics::Toolbox
     initToolbox(const Opm::ECLGraph& G)
     {
@@ -292,6 +355,26 @@ namespace example {
     };
 
 
+    /// Alternative to the Toolbox' time-of-flight solver.  Fluxes of
+    /// the currently selected report step.
+    inline Opm::ECLParallelTOF
+    initParallelTOF(const Setup& setup)
+    {
+        const auto& G = setup.graph;
+
+        auto tof = Opm::ECLParallelTOF{ G.numCells(), G.neighbours() };
+
+        tof.assignPoreVolume(G.poreVolume());
+
+        tof.assignConnectionFlux(totalFlux(
+            extractFluxField(G, setup.init, *setup.restart,
+                             setup.compute_fluxes_, setup.useEPS_)));
+
+        tof.assignInflowFlux(extractTotalInflow(G, setup.well_fluxes));
+
+        return tof;
+    }
+
 } // namespace example
 
 
@@ -0,0 +1,209 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "exampleSetup.hpp"
+#include "pipeline.hpp"
+
+#include <opm/utility/ECLFieldPyramid.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// Named cell field of single report step.
+    struct Field
+    {
+        std::string         name;
+        std::vector<double> values;
+    };
+
+    /// State of single report step as it passes through the pipeline.
+    struct StepState
+    {
+        int step{-1};
+
+        std::shared_ptr<Opm::ECLRestartData> restart;
+
+        std::vector<Field> fields;
+
+        std::vector<std::pair<std::string, Opm::ECLFieldPyramid>> pyramids;
+    };
+
+    std::string pyramidFile(const std::string& prefix,
+                            const std::string& field,
+                            const int          step)
+    {
+        std::ostringstream os;
+
+        os << prefix << '_' << field << '_'
+           << std::setw(4) << std::setfill('0') << step << ".fpyr";
+
+        return os.str();
+    }
+} // Anonymous
+
+// Syntax (typical):
+//   exportFieldPyramids case=<ecl_case_prefix> [output=<prefix>] [tof=true]
+//
+// Exports level-of-detail pyramids of pressure, saturations and, unless
+// 'tof=false', forward and backward time-of-flight for every report step.
+// One file per field and report step, named
+//
+//     <prefix>_<FIELD>_<step>.fpyr
+//
+// with <prefix> defaulting to the case name.  Tile size is controlled by
+// parameters 'tile_i', 'tile_j' and 'tile_k'.  Report steps are processed
+// concurrently (parameters 'read_threads', 'solve_threads' and
+// 'build_threads').  A per-stage timing report is written to standard
+// error.  Parameter 'deadline' (seconds) abandons the run, including
+// loading the grid, once that much wall-clock time has elapsed.
+int main(int argc, char* argv[])
+try {
+    auto param = example::initParam(argc, argv);
+
+    const auto token = example::cancellationToken(param);
+
+    const auto rset = example::identifyResultSet(param);
+    const Opm::ECLInitFileData init(rset.initFile());
+    const auto graph = Opm::ECLGraph::load(rset.gridFile(), init, token);
+
+    const auto prefix = param.getDefault<std::string>("output",
+        (rset.gridFile().parent_path() / rset.gridFile().stem()).string());
+
+    const bool tof = param.getDefault("tof", true);
+
+    auto opt = Opm::ECLFieldPyramid::Options{};
+    opt.tileSize[0] = param.getDefault("tile_i", opt.tileSize[0]);
+    opt.tileSize[1] = param.getDefault("tile_j", opt.tileSize[1]);
+    opt.tileSize[2] = param.getDefault("tile_k", opt.tileSize[2]);
+
+    const auto readThreads  = param.getDefault("read_threads", 2);
+    const auto solveThreads = param.getDefault("solve_threads", 2);
+    const auto buildThreads = param.getDefault("build_threads", 4);
+
+    example::Pipeline<StepState> pipeline;
+
+    pipeline.addStage("read", [&rset, &graph, &token](StepState& s)
+    {
+        token.throwIfCancelled();
+
+        s.restart = std::make_shared<Opm::ECLRestartData>
+            (rset.restartFile(s.step));
+
+        if (! s.restart->selectReportStep(s.step)) {
+            throw std::domain_error("Report Step Not Available");
+        }
+
+        const auto& rstrt = *s.restart;
+
+        if (rstrt.haveKeywordData("PRESSURE")) {
+            s.fields.push_back(Field {
+                "PRESSURE", graph.linearisedCellData
+                (rstrt, "PRESSURE", &Opm::ECLUnits::UnitSystem::pressure)
+            });
+        }
+
+        for (const auto* sat : { "SWAT", "SGAS" }) {
+            if (rstrt.haveKeywordData(sat)) {
+                s.fields.push_back(Field {
+                    sat, graph.rawLinearisedCellData<double>(rstrt, sat)
+                });
+            }
+        }
+    }, readThreads);
+
+    pipeline.addStage("tof", [&graph, &token, tof](StepState& s)
+    {
+        token.throwIfCancelled();
+
+        if (tof) {
+            auto tool = example::initToolbox(graph);
+
+            tool.assignConnectionFlux(example::extractFluxField(graph,
+                [&graph, &s](const Opm::ECLPhaseIndex p)
+            {
+                return graph.flux(*s.restart, p);
+            }));
+
+            auto wsol = Opm::ECLWellSolution{-1.0, false};
+
+            tool.assignInflowFlux(example::extractWellFlows(graph,
+                wsol.solution(*s.restart, graph.activeGrids())));
+
+            const auto start = std::vector<Opm::FlowDiagnostics::CellSet>{};
+
+            const auto fwd = tool.computeInjectionDiagnostics(start);
+            const auto rev = tool.computeProductionDiagnostics(start);
+
+            s.fields.push_back(Field{ "TOF_FWD", fwd.fd.timeOfFlight() });
+            s.fields.push_back(Field{ "TOF_BWD", rev.fd.timeOfFlight() });
+        }
+
+        // Restart data no longer needed.  Release early.
+        s.restart.reset();
+    }, solveThreads);
+
+    pipeline.addStage("build", [&graph, &opt, &token](StepState& s)
+    {
+        for (const auto& f : s.fields) {
+            token.throwIfCancelled();
+
+            s.pyramids.emplace_back(f.name, Opm::ECLFieldPyramid::
+                                    fromECLGraph(graph, f.values, opt));
+        }
+
+        s.fields.clear();
+    }, buildThreads);
+
+    pipeline.addStage("write", [&prefix](StepState& s)
+    {
+        for (const auto& p : s.pyramids) {
+            const auto file = pyramidFile(prefix, p.first, s.step);
+
+            p.second.save(file);
+
+            std::cout << file << ": " << p.second.numLevels()
+                      << " levels, " << p.second.compressedSize()
+                      << " bytes\n";
+        }
+
+        s.pyramids.clear();
+    });
+
+    auto input = std::vector<StepState>{};
+    for (const auto& step : rset.reportStepIDs()) {
+        input.emplace_back();
+        input.back().step = step;
+    }
+
+    pipeline.run(std::move(input));
+    pipeline.printReport(std::cerr);
+}
+catch (const std::exception& e) {
+    std::cerr << "Caught exception: " << e.what() << '\n';
+}
@@ -282,11 +282,15 @@ try {
     const auto useEPS = prm.getDefault("useEPS", false);
     const auto cellID = prm.getDefault("cell", 0);
 
+    // Non-negative tolerance removes redundant table nodes.  Default:
+    // Report all nodes of the input tables.
+    const auto tol = prm.getDefault("simplifyTol", -1.0);
+
     const auto rset  = example::identifyResultSet(prm);
     const auto init  = Opm::ECLInitFileData(rset.initFile());
     const auto graph = Opm::ECLGraph::load(rset.gridFile(), init);
-    const auto sfunc = Opm::ECLSaturationFunc(graph, init, useEPS);
-    const auto pvtCC = Opm::ECLPVT::ECLPvtCurveCollection(graph, init);
+    const auto sfunc = Opm::ECLSaturationFunc(graph, init, useEPS, tol);
+    const auto pvtCC = Opm::ECLPVT::ECLPvtCurveCollection(graph, init, tol);
 
     // -----------------------------------------------------------------
     // Relative permeability
@@ -0,0 +1,365 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_EXAMPLEPERFCOUNTERS_HEADER_INCLUDED
+#define OPM_EXAMPLEPERFCOUNTERS_HEADER_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define OPM_EXAMPLE_HAVE_PERF_EVENTS 1
+#else
+#define OPM_EXAMPLE_HAVE_PERF_EVENTS 0
+#endif
+
+/// \file
+///
+/// Hardware performance counters and a small benchmark harness.
+///
+/// Counters are collected through the Linux perf_event_open() interface
+/// for the calling thread.  Counters that cannot be opened--e.g., on other
+/// platforms, in containers, or when restricted by the
+/// kernel.perf_event_paranoid setting--are reported as unavailable while
+/// wall-clock timing continues to work.
+
+namespace example {
+
+    /// Group of hardware counters for the calling thread.
+    class PerfCounters
+    {
+    public:
+        /// Counted events.
+        enum Event : std::size_t {
+            Cycles, Instructions, LLCMisses, BranchMisses, NumEvents
+        };
+
+        /// Counter values of a single measurement.
+        struct Reading
+        {
+            /// Elapsed wall-clock time (seconds).
+            double seconds{0.0};
+
+            /// Event counts, scaled for multiplexing.
+            std::array<double, NumEvents> count{};
+
+            /// Whether or not the corresponding event was counted.
+            std::array<bool, NumEvents> available{};
+
+            Reading& operator+=(const Reading& rhs)
+            {
+                this->seconds += rhs.seconds;
+
+                for (auto e = 0*NumEvents; e < NumEvents; ++e) {
+                    this->count[e]     += rhs.count[e];
+                    this->available[e]  = rhs.available[e];
+                }
+
+                return *this;
+            }
+        };
+
+        /// Constructor.
+        ///
+        /// \param[in] enable Whether or not to open hardware counters.
+        ///    Timing only if \c false.
+        explicit PerfCounters(const bool enable = true)
+        {
+            this->fd_.fill(-1);
+
+            if (enable) {
+                this->open();
+            }
+        }
+
+        /// Destructor.  Closes counters.
+        ~PerfCounters()
+        {
+#if OPM_EXAMPLE_HAVE_PERF_EVENTS
+            for (const auto fd : this->fd_) {
+                if (fd >= 0) { ::close(fd); }
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        /// Whether or not any hardware counter is available.
+        bool anyAvailable() const
+        {
+            for (const auto fd : this->fd_) {
+                if (fd >= 0) { return true; }
+            }
+
+            return false;
+        }
+
+        /// Measure single invocation of function.
+        template <class Function>
+        Reading measure(Function&& f)
+        {
+            this->control(/* PERF_EVENT_IOC_RESET */ 0);
+            this->control(/* PERF_EVENT_IOC_ENABLE */ 1);
+
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const auto stop = std::chrono::steady_clock::now();
+
+            this->control(/* PERF_EVENT_IOC_DISABLE */ 2);
+
+            auto r = this->read();
+            r.seconds = std::chrono::duration<double>(stop - start).count();
+
+            return r;
+        }
+
+    private:
+        std::array<int, NumEvents> fd_;
+
+        void open()
+        {
+#if OPM_EXAMPLE_HAVE_PERF_EVENTS
+            const auto events = std::array<std::pair<std::uint32_t,
+                                                     std::uint64_t>,
+                                           NumEvents> {{
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+                { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+            }};
+
+            for (auto e = 0*NumEvents; e < NumEvents; ++e) {
+                auto attr = perf_event_attr{};
+                std::memset(&attr, 0, sizeof attr);
+
+                attr.size           = sizeof attr;
+                attr.type           = events[e].first;
+                attr.config         = events[e].second;
+                attr.disabled       = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv     = 1;
+                attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED
+                                    | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                // Calling thread, any CPU, no group.
+                this->fd_[e] = static_cast<int>
+                    (::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+#endif
+        }
+
+        void control(const int request)
+        {
+#if OPM_EXAMPLE_HAVE_PERF_EVENTS
+            const unsigned long op[] = {
+                PERF_EVENT_IOC_RESET,
+                PERF_EVENT_IOC_ENABLE,
+                PERF_EVENT_IOC_DISABLE,
+            };
+
+            for (const auto fd : this->fd_) {
+                if (fd >= 0) { ::ioctl(fd, op[request], 0); }
+            }
+#else
+            static_cast<void>(request);
+#endif
+        }
+
+        Reading read() const
+        {
+            auto r = Reading{};
+
+#if OPM_EXAMPLE_HAVE_PERF_EVENTS
+            for (auto e = 0*NumEvents; e < NumEvents; ++e) {
+                if (this->fd_[e] < 0) { continue; }
+
+                // { value, time_enabled, time_running }
+                std::uint64_t buf[3] = { 0, 0, 0 };
+
+                if (::read(this->fd_[e], buf, sizeof buf) != sizeof buf) {
+                    continue;
+                }
+
+                r.available[e] = true;
+                r.count[e]     = (buf[2] > 0)
+                    ? static_cast<double>(buf[0]) * buf[1] / buf[2]
+                    : 0.0;
+            }
+#endif
+
+            return r;
+        }
+    };
+
+    /// Repeated measurement of named kernels with derived metrics.
+    class Benchmark
+    {
+    public:
+        /// Constructor.
+        ///
+        /// \param[in] counters Whether or not to collect hardware
+        ///    counters.
+        ///
+        /// \param[in] repeat Number of timed repetitions per kernel.  One
+        ///    additional, untimed warm-up run precedes the measurement.
+        Benchmark(const bool counters, const int repeat)
+            : perf_    (counters)
+            , counters_(counters)
+            , repeat_  (std::max(repeat, 1))
+        {}
+
+        /// Measure kernel.
+        ///
+        /// \param[in] name Kernel name.
+        ///
+        /// \param[in] items Number of items (cells, connections) processed
+        ///    per invocation.
+        ///
+        /// \param[in] unit Name of item unit (e.g., "conn").
+        ///
+        /// \param[in] kernel Kernel.
+        void run(const std::string&           name,
+                 const std::size_t            items,
+                 const std::string&           unit,
+                 const std::function<void()>& kernel)
+        {
+            kernel();
+
+            auto total = PerfCounters::Reading{};
+            for (auto i = 0; i < this->repeat_; ++i) {
+                total += this->perf_.measure(kernel);
+            }
+
+            this->results_.push_back(Result {
+                name, static_cast<double>(items) * this->repeat_,
+                unit, total
+            });
+        }
+
+        /// Write table of throughput and derived counter metrics.
+        ///
+        /// IPC is instructions per cycle.  Bytes per item estimates
+        /// memory traffic from last-level cache misses at 64 bytes per
+        /// cache line.
+        void print(std::ostream& os) const
+        {
+            using PC = PerfCounters;
+
+            const auto flags = os.flags();
+            const auto prec  = os.precision();
+
+            os << std::left  << std::setw(20) << "Kernel"
+               << std::setw(6)  << "Item"
+               << std::right << std::setw(12) << "MItems/s"
+               << std::setw(10) << "ns/item"
+               << std::setw(8)  << "IPC"
+               << std::setw(14) << "LLC miss/item"
+               << std::setw(12) << "Bytes/item"
+               << std::setw(14) << "Br.miss/item" << '\n';
+
+            os << std::fixed;
+
+            for (const auto& r : this->results_) {
+                const auto& c = r.reading;
+                const auto  n = r.items;
+
+                os << std::left  << std::setw(20) << r.name
+                   << std::setw(6)  << r.unit
+                   << std::right << std::setprecision(3)
+                   << std::setw(12) << n / c.seconds / 1.0e6
+                   << std::setprecision(2)
+                   << std::setw(10) << 1.0e9 * c.seconds / n;
+
+                os << std::setw(8);
+                if (c.available[PC::Cycles] && c.available[PC::Instructions]
+                    && (c.count[PC::Cycles] > 0.0))
+                {
+                    os << c.count[PC::Instructions] / c.count[PC::Cycles];
+                }
+                else {
+                    os << "n/a";
+                }
+
+                os << std::setprecision(3);
+                perItem(os, 14, c, PC::LLCMisses, n, 1.0);
+                perItem(os, 12, c, PC::LLCMisses, n, 64.0);
+                perItem(os, 14, c, PC::BranchMisses, n, 1.0);
+
+                os << '\n';
+            }
+
+            if (this->counters_ && ! this->perf_.anyAvailable()) {
+                os << "Hardware counters unavailable "
+                   << "(check kernel.perf_event_paranoid)\n";
+            }
+
+            os.flags(flags);
+            os.precision(prec);
+        }
+
+    private:
+        struct Result
+        {
+            std::string           name;
+            double                items;
+            std::string           unit;
+            PerfCounters::Reading reading;
+        };
+
+        PerfCounters        perf_;
+        bool                counters_;
+        int                 repeat_;
+        std::vector<Result> results_;
+
+        static void perItem(std::ostream&                os,
+                            const int                    width,
+                            const PerfCounters::Reading& c,
+                            const PerfCounters::Event    e,
+                            const double                 items,
+                            const double                 scale)
+        {
+            os << std::setw(width);
+
+            if (c.available[e]) {
+                os << scale * c.count[e] / items;
+            }
+            else {
+                os << "n/a";
+            }
+        }
+    };
+
+} // namespace example
+
+#endif // OPM_EXAMPLEPERFCOUNTERS_HEADER_INCLUDED
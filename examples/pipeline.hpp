@@ -0,0 +1,419 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_EXAMPLEPIPELINE_HEADER_INCLUDED
+#define OPM_EXAMPLEPIPELINE_HEADER_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// \file
+///
+/// Stage-based pipeline for multi-step diagnostics workflows.
+///
+/// Each work item--typically the state of a single report step--passes
+/// through a linear sequence of named stages (read restart, compute
+/// fluxes, solve, write &c).  Consecutive stages are connected by bounded
+/// queues and every stage runs a configurable number of worker threads,
+/// so independent report steps flow through the pipeline concurrently
+/// while memory use stays bounded.  Per-stage timing statistics identify
+/// the bottleneck stage.
+
+namespace example {
+
+    /// Bounded, closable FIFO queue connecting two pipeline stages.
+    template <typename T>
+    class BoundedQueue
+    {
+    public:
+        explicit BoundedQueue(const std::size_t capacity)
+            : capacity_(std::max(capacity, std::size_t{1}))
+        {}
+
+        /// Append item.  Blocks while queue is full.
+        ///
+        /// \return Whether or not item was accepted.  False if the queue
+        ///    has been closed.
+        bool push(T item)
+        {
+            std::unique_lock<std::mutex> guard(this->lock_);
+
+            this->notFull_.wait(guard, [this]()
+            {
+                return this->closed_
+                    || (this->items_.size() < this->capacity_);
+            });
+
+            if (this->closed_) { return false; }
+
+            this->items_.push_back(std::move(item));
+            this->notEmpty_.notify_one();
+
+            return true;
+        }
+
+        /// Remove oldest item.  Blocks while queue is empty and open.
+        ///
+        /// \return Whether or not an item was retrieved.  False once the
+        ///    queue is closed and drained.
+        bool pop(T& item)
+        {
+            std::unique_lock<std::mutex> guard(this->lock_);
+
+            this->notEmpty_.wait(guard, [this]()
+            {
+                return this->closed_ || ! this->items_.empty();
+            });
+
+            if (this->items_.empty()) { return false; }
+
+            item = std::move(this->items_.front());
+            this->items_.pop_front();
+            this->notFull_.notify_one();
+
+            return true;
+        }
+
+        /// Signal end of input.  Pending items may still be retrieved.
+        void close()
+        {
+            std::lock_guard<std::mutex> guard(this->lock_);
+
+            this->closed_ = true;
+
+            this->notEmpty_.notify_all();
+            this->notFull_.notify_all();
+        }
+
+    private:
+        std::size_t capacity_;
+        bool        closed_{false};
+        std::deque<T> items_;
+
+        std::mutex              lock_;
+        std::condition_variable notEmpty_;
+        std::condition_variable notFull_;
+    };
+
+    /// Linear pipeline of stages operating on items of type \c Item.
+    ///
+    /// Item must be default constructible and movable.
+    template <typename Item>
+    class Pipeline
+    {
+    public:
+        /// Stage operation.  Modifies item in place.
+        using Work = std::function<void(Item&)>;
+
+        /// Timing statistics of single stage.
+        struct StageReport
+        {
+            std::string name;
+            std::size_t parallelism;
+
+            /// Number of items processed.
+            std::size_t items;
+
+            /// Total time spent in stage operation (seconds, summed over
+            /// all worker threads).
+            double busy;
+
+            /// Total time spent waiting for input or for space in the
+            /// output queue (seconds, summed over all worker threads).
+            double blocked;
+
+            /// Mean and maximum time to process a single item (seconds).
+            double meanLatency;
+            double maxLatency;
+
+            /// Fraction of stage's available thread time spent working.
+            double utilisation;
+        };
+
+        /// Append stage.
+        ///
+        /// \param[in] name Stage name used in reports.
+        ///
+        /// \param[in] work Stage operation.
+        ///
+        /// \param[in] parallelism Number of worker threads.
+        ///
+        /// \param[in] capacity Capacity of the stage's input queue.
+        ///
+        /// \return \code *this \endcode.
+        Pipeline& addStage(std::string       name,
+                           Work              work,
+                           const std::size_t parallelism = 1,
+                           const std::size_t capacity    = 2)
+        {
+            this->stages_.push_back(Stage {
+                std::move(name), std::move(work),
+                std::max(parallelism, std::size_t{1}), capacity
+            });
+
+            return *this;
+        }
+
+        /// Pass all items through the pipeline.
+        ///
+        /// Rethrows the first exception raised by any stage after all
+        /// worker threads have terminated.
+        ///
+        /// \param[in] input Items in order of submission.
+        ///
+        /// \return Processed items, in order of completion.
+        std::vector<Item> run(std::vector<Item> input)
+        {
+            using Clock = std::chrono::steady_clock;
+
+            const auto nstage = this->stages_.size();
+
+            auto queues = std::vector<std::unique_ptr<BoundedQueue<Item>>>{};
+            for (auto s = 0*nstage; s < nstage; ++s) {
+                queues.emplace_back
+                    (new BoundedQueue<Item>(this->stages_[s].capacity));
+            }
+
+            // Output queue.  Drained concurrently by this thread.
+            queues.emplace_back(new BoundedQueue<Item>(input.size() + 1));
+
+            this->report_.assign(nstage, StageReport{});
+            for (auto s = 0*nstage; s < nstage; ++s) {
+                this->report_[s].name        = this->stages_[s].name;
+                this->report_[s].parallelism = this->stages_[s].parallelism;
+            }
+
+            std::mutex         statLock;
+            std::exception_ptr error;
+            std::atomic<bool>  failed{false};
+
+            auto fail = [&](std::exception_ptr e)
+            {
+                {
+                    std::lock_guard<std::mutex> guard(statLock);
+                    if (! error) { error = e; }
+                }
+
+                failed = true;
+
+                for (auto& q : queues) { q->close(); }
+            };
+
+            const auto start = Clock::now();
+            auto threads = std::vector<std::thread>{};
+
+            // Feeder.
+            threads.emplace_back([&queues, &input]()
+            {
+                for (auto& item : input) {
+                    if (! queues.front()->push(std::move(item))) { break; }
+                }
+
+                queues.front()->close();
+            });
+
+            // Stage workers.  Last worker of a stage to finish closes
+            // the stage's output queue.
+            auto active = std::vector<std::atomic<std::size_t>>(nstage);
+
+            for (auto s = 0*nstage; s < nstage; ++s) {
+                active[s] = this->stages_[s].parallelism;
+
+                for (auto w = 0*nstage; w < this->stages_[s].parallelism; ++w)
+                {
+                    threads.emplace_back([&, s]()
+                    {
+                        auto& in  = *queues[s + 0];
+                        auto& out = *queues[s + 1];
+                        auto& rpt = this->report_[s];
+
+                        auto item    = Item{};
+                        auto blocked = Clock::duration::zero();
+
+                        while (true) {
+                            auto t0 = Clock::now();
+                            if (! in.pop(item)) { break; }
+                            blocked += Clock::now() - t0;
+
+                            if (failed) { continue; }
+
+                            t0 = Clock::now();
+                            try {
+                                this->stages_[s].work(item);
+                            }
+                            catch (...) {
+                                fail(std::current_exception());
+                                continue;
+                            }
+                            const auto dt = Clock::now() - t0;
+
+                            {
+                                std::lock_guard<std::mutex> guard(statLock);
+
+                                const auto sec = seconds(dt);
+
+                                rpt.items += 1;
+                                rpt.busy  += sec;
+                                rpt.maxLatency = std::max(rpt.maxLatency, sec);
+                            }
+
+                            t0 = Clock::now();
+                            if (! out.push(std::move(item))) { break; }
+                            blocked += Clock::now() - t0;
+                        }
+
+                        {
+                            std::lock_guard<std::mutex> guard(statLock);
+                            rpt.blocked += seconds(blocked);
+                        }
+
+                        if (--active[s] == 0) { out.close(); }
+                    });
+                }
+            }
+
+            auto result = std::vector<Item>{};
+            {
+                auto item = Item{};
+                while (queues.back()->pop(item)) {
+                    result.push_back(std::move(item));
+                }
+            }
+
+            for (auto& t : threads) { t.join(); }
+
+            const auto wall = seconds(Clock::now() - start);
+
+            for (auto& rpt : this->report_) {
+                if (rpt.items > 0) {
+                    rpt.meanLatency = rpt.busy / rpt.items;
+                }
+
+                if (wall > 0.0) {
+                    rpt.utilisation = rpt.busy / (wall * rpt.parallelism);
+                }
+            }
+
+            this->wallTime_ = wall;
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+
+            return result;
+        }
+
+        /// Per-stage statistics of most recent run().
+        const std::vector<StageReport>& report() const
+        {
+            return this->report_;
+        }
+
+        /// Write per-stage statistics of most recent run() as a table.
+        /// The stage with the highest utilisation is marked as the
+        /// bottleneck.
+        void printReport(std::ostream& os) const
+        {
+            auto bottleneck = this->report_.size();
+            auto maxUtil    = -1.0;
+
+            for (auto n = this->report_.size(), s = 0*n; s < n; ++s) {
+                if (this->report_[s].utilisation > maxUtil) {
+                    maxUtil    = this->report_[s].utilisation;
+                    bottleneck = s;
+                }
+            }
+
+            const auto flags = os.flags();
+            const auto prec  = os.precision();
+
+            os << std::left  << std::setw(16) << "Stage"
+               << std::right << std::setw(8)  << "Threads"
+               << std::setw(8)  << "Items"
+               << std::setw(12) << "Items/s"
+               << std::setw(12) << "Mean [ms]"
+               << std::setw(12) << "Max [ms]"
+               << std::setw(12) << "Blocked [s]"
+               << std::setw(8)  << "Util" << '\n';
+
+            os << std::fixed;
+
+            for (auto n = this->report_.size(), s = 0*n; s < n; ++s) {
+                const auto& r = this->report_[s];
+
+                const auto rate = (this->wallTime_ > 0.0)
+                    ? r.items / this->wallTime_ : 0.0;
+
+                os << std::left  << std::setw(16) << r.name
+                   << std::right << std::setw(8)  << r.parallelism
+                   << std::setw(8)  << r.items
+                   << std::setprecision(2)
+                   << std::setw(12) << rate
+                   << std::setw(12) << 1000.0*r.meanLatency
+                   << std::setw(12) << 1000.0*r.maxLatency
+                   << std::setw(12) << r.blocked
+                   << std::setw(7)  << 100.0*r.utilisation << '%'
+                   << ((s == bottleneck) ? "  <-- bottleneck" : "")
+                   << '\n';
+            }
+
+            os << "Wall time: " << std::setprecision(3)
+               << this->wallTime_ << " s\n";
+
+            os.flags(flags);
+            os.precision(prec);
+        }
+
+    private:
+        struct Stage
+        {
+            std::string name;
+            Work        work;
+            std::size_t parallelism;
+            std::size_t capacity;
+        };
+
+        std::vector<Stage>       stages_;
+        std::vector<StageReport> report_;
+        double                   wallTime_{0.0};
+
+        template <class Duration>
+        static double seconds(const Duration& d)
+        {
+            return std::chrono::duration<double>(d).count();
+        }
+    };
+
+} // namespace example
+
+#endif // OPM_EXAMPLEPIPELINE_HEADER_INCLUDED
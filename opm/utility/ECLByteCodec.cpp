@@ -0,0 +1,201 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLByteCodec.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/// \file
+///
+/// Implementation of byte plane run-length codec.
+
+namespace {
+    /// Shortest run of identical bytes encoded as a run.
+    const std::size_t minRun = 3;
+
+    /// Longest run of identical bytes in a single code.
+    const std::size_t maxRun = 127 + minRun;
+
+    /// Longest sequence of literal bytes in a single code.
+    const std::size_t maxLiteral = 128;
+
+    void runLengthEncode(const std::vector<unsigned char>& b,
+                         std::vector<unsigned char>&       out)
+    {
+        const auto n = b.size();
+
+        auto runAt = [&b, n](const std::size_t i)
+        {
+            return (i + minRun <= n)
+                && (b[i] == b[i + 1]) && (b[i] == b[i + 2]);
+        };
+
+        auto i = 0*n;
+        while (i < n) {
+            if (runAt(i)) {
+                auto run = minRun;
+                while ((i + run < n) && (run < maxRun) &&
+                       (b[i + run] == b[i]))
+                {
+                    ++run;
+                }
+
+                // Codes 128..255: Run of (code - 128 + minRun) bytes.
+                out.push_back(static_cast<unsigned char>
+                              (128 + run - minRun));
+                out.push_back(b[i]);
+
+                i += run;
+                continue;
+            }
+
+            auto j = i + 1;
+            while ((j < n) && (j - i < maxLiteral) && ! runAt(j)) {
+                ++j;
+            }
+
+            // Codes 0..127: Literal sequence of (code + 1) bytes.
+            out.push_back(static_cast<unsigned char>(j - i - 1));
+            out.insert(out.end(), b.begin() + i, b.begin() + j);
+
+            i = j;
+        }
+    }
+
+    std::vector<unsigned char>
+    runLengthDecode(const std::vector<unsigned char>& code,
+                    const std::size_t                 size)
+    {
+        auto b = std::vector<unsigned char>{};
+        b.reserve(size);
+
+        auto corrupt = []()
+        {
+            return std::runtime_error("Corrupt Byte Plane Encoding");
+        };
+
+        for (auto n = code.size(), i = 0*n; i < n; ) {
+            const auto c = static_cast<std::size_t>(code[i++]);
+
+            if (c < 128) {
+                const auto len = c + 1;
+
+                if ((i + len > n) || (b.size() + len > size)) {
+                    throw corrupt();
+                }
+
+                b.insert(b.end(), code.begin() + i,
+                         code.begin() + i + len);
+                i += len;
+            }
+            else {
+                const auto len = c - 128 + minRun;
+
+                if ((i >= n) || (b.size() + len > size)) {
+                    throw corrupt();
+                }
+
+                b.insert(b.end(), len, code[i++]);
+            }
+        }
+
+        if (b.size() != size) {
+            throw corrupt();
+        }
+
+        return b;
+    }
+} // Anonymous namespace
+
+template <typename Word>
+std::vector<unsigned char>
+Opm::ECLByteCodec::encode(const std::vector<Word>& words)
+{
+    const auto n = words.size();
+    const auto m = sizeof(Word);
+
+    auto planes = std::vector<unsigned char>(m * n);
+
+    for (auto i = 0*n; i < n; ++i) {
+        for (auto p = 0*m; p < m; ++p) {
+            planes[p*n + i] =
+                static_cast<unsigned char>(words[i] >> (8 * (m - 1 - p)));
+        }
+    }
+
+    auto code = std::vector<unsigned char>{};
+    runLengthEncode(planes, code);
+
+    code.shrink_to_fit();
+
+    return code;
+}
+
+template <typename Word>
+std::vector<Word>
+Opm::ECLByteCodec::decode(const std::vector<unsigned char>& code,
+                          const std::size_t                 n)
+{
+    const auto m = sizeof(Word);
+
+    const auto planes = runLengthDecode(code, m * n);
+
+    auto words = std::vector<Word>(n, Word{0});
+
+    for (auto i = 0*n; i < n; ++i) {
+        auto w = Word{0};
+
+        for (auto p = 0*m; p < m; ++p) {
+            w = (w << 8) | planes[p*n + i];
+        }
+
+        words[i] = w;
+    }
+
+    return words;
+}
+
+// =====================================================================
+// Explicit instantiations.
+// ---------------------------------------------------------------------
+
+namespace Opm { namespace ECLByteCodec {
+
+    template std::vector<unsigned char>
+    encode<std::uint32_t>(const std::vector<std::uint32_t>& words);
+
+    template std::vector<unsigned char>
+    encode<std::uint64_t>(const std::vector<std::uint64_t>& words);
+
+    template std::vector<std::uint32_t>
+    decode<std::uint32_t>(const std::vector<unsigned char>& code,
+                          const std::size_t                 n);
+
+    template std::vector<std::uint64_t>
+    decode<std::uint64_t>(const std::vector<unsigned char>& code,
+                          const std::size_t                 n);
+
+}} // namespace Opm::ECLByteCodec
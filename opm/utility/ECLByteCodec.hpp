@@ -0,0 +1,67 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLBYTECODEC_HEADER_INCLUDED
+#define OPM_ECLBYTECODEC_HEADER_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+/// \file
+///
+/// Lossless compression of sequences of machine words.
+///
+/// Words are split into byte planes--all most significant bytes first,
+/// then all second most significant bytes &c--and the planes are run-length
+/// encoded.  Effective when most words have zero high-order bytes, e.g.,
+/// for differences (XOR or arithmetic) between similar values.  Callers are
+/// responsible for forming such differences.
+
+namespace Opm { namespace ECLByteCodec {
+
+    /// Compress sequence of words.
+    ///
+    /// \tparam Word Unsigned integer type.  Supported types are \code
+    ///    std::uint32_t \endcode and \code std::uint64_t \endcode.
+    ///
+    /// \param[in] words Sequence of words.
+    ///
+    /// \return Compressed byte sequence.
+    template <typename Word>
+    std::vector<unsigned char>
+    encode(const std::vector<Word>& words);
+
+    /// Decompress sequence of words.
+    ///
+    /// \tparam Word Unsigned integer type used in encode().
+    ///
+    /// \param[in] code Compressed byte sequence created by encode().
+    ///
+    /// \param[in] n Number of words in original sequence.
+    ///
+    /// \return Original sequence of words.  Throws \code
+    ///    std::runtime_error \endcode if \p code is not a valid encoding of
+    ///    \p n words.
+    template <typename Word>
+    std::vector<Word>
+    decode(const std::vector<unsigned char>& code, const std::size_t n);
+
+}} // namespace Opm::ECLByteCodec
+
+#endif // OPM_ECLBYTECODEC_HEADER_INCLUDED
@@ -0,0 +1,86 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLCancellation.hpp>
+
+#include <atomic>
+#include <memory>
+
+struct Opm::ECLCancellationToken::State
+{
+    explicit State(const Clock::time_point dl)
+        : deadline(dl)
+    {}
+
+    std::atomic<bool> flag{false};
+    Clock::time_point deadline;
+};
+
+Opm::ECLOperationCancelled::ECLOperationCancelled()
+    : std::runtime_error("Operation Cancelled")
+{}
+
+Opm::ECLCancellationToken
+Opm::ECLCancellationToken::cancellable(const Clock::time_point deadline)
+{
+    auto token = ECLCancellationToken{};
+
+    token.state_ = std::make_shared<State>(deadline);
+
+    return token;
+}
+
+Opm::ECLCancellationToken
+Opm::ECLCancellationToken::withTimeout(const Clock::duration timeout)
+{
+    return cancellable(Clock::now() + timeout);
+}
+
+void Opm::ECLCancellationToken::cancel() const
+{
+    if (this->state_) {
+        this->state_->flag.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool Opm::ECLCancellationToken::cancelled() const
+{
+    if (! this->state_) {
+        return false;
+    }
+
+    if (this->state_->flag.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    if ((this->state_->deadline != Clock::time_point::max()) &&
+        (Clock::now() >= this->state_->deadline))
+    {
+        // Latch so later checks need not consult the clock.
+        this->state_->flag.store(true, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,98 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLCANCELLATION_HEADER_INCLUDED
+#define OPM_ECLCANCELLATION_HEADER_INCLUDED
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+/// \file
+///
+/// Cooperative cancellation of long-running evaluations.
+///
+/// Long-running functions accept an ECLCancellationToken and check it at
+/// chunk boundaries--e.g., between grids, report steps or subranges of a
+/// parallel loop.  Once the token is cancelled, or its deadline has
+/// passed, the function abandons its work by throwing an exception of type
+/// ECLOperationCancelled.
+
+namespace Opm {
+
+    /// Exception thrown when an evaluation is abandoned.
+    class ECLOperationCancelled : public std::runtime_error
+    {
+    public:
+        ECLOperationCancelled();
+    };
+
+    /// Shared cancellation flag and optional deadline.
+    ///
+    /// Copies refer to the same flag, so the requesting thread keeps one
+    /// copy and passes another to the evaluation.
+    class ECLCancellationToken
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /// Token that is never cancelled.  Checking it is free.
+        ECLCancellationToken() = default;
+
+        /// Create cancellable token.
+        ///
+        /// \param[in] deadline Point in time after which the token is
+        ///    considered cancelled even if cancel() has not been called.
+        ///    Default: No deadline.
+        static ECLCancellationToken
+        cancellable(const Clock::time_point deadline =
+                    Clock::time_point::max());
+
+        /// Create cancellable token with deadline relative to the current
+        /// time.
+        ///
+        /// \param[in] timeout Time from now until the deadline.
+        static ECLCancellationToken
+        withTimeout(const Clock::duration timeout);
+
+        /// Request cancellation.  No effect on a token that was not
+        /// created cancellable.
+        void cancel() const;
+
+        /// Whether or not cancellation has been requested or the deadline
+        /// has passed.
+        bool cancelled() const;
+
+        /// Throw ECLOperationCancelled if cancelled() is true.
+        void throwIfCancelled() const
+        {
+            if (this->state_ && this->cancelled()) {
+                throw ECLOperationCancelled{};
+            }
+        }
+
+    private:
+        struct State;
+
+        std::shared_ptr<State> state_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLCANCELLATION_HEADER_INCLUDED
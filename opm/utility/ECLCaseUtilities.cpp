@@ -292,6 +292,20 @@ Opm::ECLCaseUtilities::ResultSet::initFile() const
                           { ".INIT", ".FINIT" });
 }
 
+Opm::ECLCaseUtilities::ResultSet::Path
+Opm::ECLCaseUtilities::ResultSet::summarySpecFile() const
+{
+    return deriveFileName(this->prefix_,
+                          { ".SMSPEC", ".FSMSPEC" });
+}
+
+Opm::ECLCaseUtilities::ResultSet::Path
+Opm::ECLCaseUtilities::ResultSet::unifiedSummaryFile() const
+{
+    return deriveFileName(this->prefix_,
+                          { ".UNSMRY", ".FUNSMRY" });
+}
+
 Opm::ECLCaseUtilities::ResultSet::Path
 Opm::ECLCaseUtilities::ResultSet::restartFile(const int reportStepID) const
 {
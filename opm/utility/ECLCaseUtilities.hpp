@@ -45,6 +45,18 @@ namespace Opm { namespace ECLCaseUtilities {
         /// Retrieve name of result set's init file.
         Path initFile() const;
 
+        /// Retrieve name of result set's summary specification file.
+        ///
+        /// \return Name of .SMSPEC (or .FSMSPEC) file.  Empty if the result
+        ///    set has no summary specification.
+        Path summarySpecFile() const;
+
+        /// Retrieve name of result set's unified summary file.
+        ///
+        /// \return Name of .UNSMRY (or .FUNSMRY) file.  Empty if the result
+        ///    set has no unified summary file.
+        Path unifiedSummaryFile() const;
+
         /// Retrieve name of result set's restart file corresponding to a
         /// particular report/restart step ID.
         ///
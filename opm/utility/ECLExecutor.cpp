@@ -0,0 +1,449 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLExecutor.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pthread.h>
+
+/// \file
+///
+/// Implementation of serial and work-stealing executors.
+
+namespace {
+    /// Number of subranges, of at least 'grain' iterations each, into
+    /// which to partition a loop of 'n' iterations.  Over-decompose
+    /// somewhat to give idle threads something to steal.
+    std::size_t numChunks(const std::size_t n,
+                          const std::size_t grain,
+                          const std::size_t concurrency)
+    {
+        const auto g = std::max(grain, std::size_t{1});
+
+        return std::min((n + g - 1) / g, 4 * concurrency);
+    }
+
+    std::mutex& defaultExecutorLock();
+
+    std::shared_ptr<Opm::ECLExecutor>& defaultExecutorSlot()
+    {
+        static std::shared_ptr<Opm::ECLExecutor> executor;
+
+        return executor;
+    }
+
+    /// Fork handlers.  Keep the default executor slot consistent across
+    /// fork() and give the child process, which inherits none of the
+    /// parent's worker threads, an executor that does not depend on them.
+    namespace Fork {
+        void prepare()
+        {
+            defaultExecutorLock().lock();
+        }
+
+        void parent()
+        {
+            defaultExecutorLock().unlock();
+        }
+
+        void child()
+        {
+            auto& executor = defaultExecutorSlot();
+
+            if (executor) {
+                // Inherited executor's threads do not exist in the child
+                // and its internal locks may be held.  Never run or
+                // destroy it.
+                new std::shared_ptr<Opm::ECLExecutor>(std::move(executor));
+
+                executor = std::make_shared<Opm::ECLSerialExecutor>();
+            }
+
+            defaultExecutorLock().unlock();
+        }
+    } // namespace Fork
+
+    std::mutex& defaultExecutorLock()
+    {
+        static std::mutex lock;
+
+        static const auto forkHandlers =
+            ::pthread_atfork(&Fork::prepare, &Fork::parent, &Fork::child);
+
+        static_cast<void>(forkHandlers);
+
+        return lock;
+    }
+} // Anonymous namespace
+
+// =====================================================================
+// Class ECLExecutor
+// ---------------------------------------------------------------------
+
+Opm::ECLExecutor::~ECLExecutor()
+{}
+
+// =====================================================================
+// Class ECLSerialExecutor
+// ---------------------------------------------------------------------
+
+void
+Opm::ECLSerialExecutor::parallelFor(const std::size_t n,
+                                    const std::size_t /* grain */,
+                                    const RangeTask&  task)
+{
+    if (n > 0) {
+        task(0, n);
+    }
+}
+
+std::size_t Opm::ECLSerialExecutor::concurrency() const
+{
+    return 1;
+}
+
+// =====================================================================
+// Class ECLWorkStealingExecutor::Impl
+// ---------------------------------------------------------------------
+
+class Opm::ECLWorkStealingExecutor::Impl
+{
+public:
+    explicit Impl(const std::size_t concurrency);
+
+    ~Impl();
+
+    void parallelFor(const std::size_t n,
+                     const std::size_t grain,
+                     const RangeTask&  task);
+
+    std::size_t concurrency() const
+    {
+        return this->threads_.size() + 1;
+    }
+
+private:
+    /// Single parallelFor() invocation.
+    struct Job {
+        /// Loop body.
+        const RangeTask* task;
+
+        /// Number of subranges not yet completed.  Protected by 'lock'.
+        std::size_t remaining;
+
+        /// First exception thrown by loop body.  Protected by 'lock'.
+        std::exception_ptr error;
+
+        std::mutex              lock;
+        std::condition_variable done;
+    };
+
+    /// Subrange of single job.
+    struct Chunk {
+        Job*        job;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /// Per-thread queue of subranges.
+    struct Queue {
+        std::mutex        lock;
+        std::deque<Chunk> chunks;
+    };
+
+    /// One queue per worker thread, and one shared by all threads that
+    /// are external to the pool.
+    std::vector<std::unique_ptr<Queue>> queues_;
+
+    std::vector<std::thread> threads_;
+
+    /// Number of queued subranges and shutdown flag.  Protected by
+    /// 'sleepLock_'.
+    std::size_t pending_{0};
+    bool        stop_{false};
+
+    std::mutex              sleepLock_;
+    std::condition_variable wake_;
+
+    /// Queue owned by calling thread.
+    std::size_t homeQueue() const;
+
+    /// Pop subrange from own queue or steal one from another queue.
+    bool pop(const std::size_t home, Chunk& chunk);
+
+    /// Run single subrange, if any is available.
+    bool runOne(const std::size_t home);
+
+    void workerLoop(const std::size_t self);
+};
+
+namespace {
+    /// Pool and queue index of current worker thread, if any.
+    thread_local const void* currentPool  = nullptr;
+    thread_local std::size_t currentQueue = 0;
+} // Anonymous namespace
+
+Opm::ECLWorkStealingExecutor::Impl::Impl(const std::size_t concurrency)
+{
+    auto n = concurrency;
+    if (n == 0) {
+        n = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    for (auto i = 0*n; i < n; ++i) {
+        this->queues_.emplace_back(new Queue);
+    }
+
+    for (auto i = 0*n; i + 1 < n; ++i) {
+        this->threads_.emplace_back([this, i]() { this->workerLoop(i); });
+    }
+}
+
+Opm::ECLWorkStealingExecutor::Impl::~Impl()
+{
+    {
+        std::lock_guard<std::mutex> guard(this->sleepLock_);
+        this->stop_ = true;
+    }
+
+    this->wake_.notify_all();
+
+    for (auto& t : this->threads_) {
+        t.join();
+    }
+}
+
+void
+Opm::ECLWorkStealingExecutor::Impl::parallelFor(const std::size_t n,
+                                                const std::size_t grain,
+                                                const RangeTask&  task)
+{
+    const auto nchunk = numChunks(n, grain, this->concurrency());
+
+    if (nchunk <= 1) {
+        if (n > 0) { task(0, n); }
+
+        return;
+    }
+
+    Job job;
+    job.task      = &task;
+    job.remaining = nchunk;
+
+    // Distribute subranges round-robin, starting with the caller's own
+    // queue, so that every thread finds work locally.
+    const auto home  = this->homeQueue();
+    const auto nq    = this->queues_.size();
+    const auto size  = (n + nchunk - 1) / nchunk;
+
+    for (auto c = 0*nchunk; c < nchunk; ++c) {
+        auto& q = *this->queues_[(home + c) % nq];
+
+        const auto begin = c * size;
+        const auto end   = std::min(begin + size, n);
+
+        std::lock_guard<std::mutex> guard(q.lock);
+        q.chunks.push_back(Chunk{ &job, begin, end });
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(this->sleepLock_);
+        this->pending_ += nchunk;
+    }
+
+    this->wake_.notify_all();
+
+    // Help out until all of this job's subranges are complete.
+    while (true) {
+        {
+            std::lock_guard<std::mutex> guard(job.lock);
+            if (job.remaining == 0) { break; }
+        }
+
+        if (! this->runOne(home)) {
+            // Remaining subranges are in progress elsewhere.
+            std::unique_lock<std::mutex> guard(job.lock);
+            job.done.wait(guard, [&job]() { return job.remaining == 0; });
+        }
+    }
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+std::size_t Opm::ECLWorkStealingExecutor::Impl::homeQueue() const
+{
+    return (currentPool == this)
+        ? currentQueue
+        : this->queues_.size() - 1;
+}
+
+bool
+Opm::ECLWorkStealingExecutor::Impl::pop(const std::size_t home,
+                                        Chunk&            chunk)
+{
+    const auto nq = this->queues_.size();
+
+    for (auto k = 0*nq; k < nq; ++k) {
+        auto& q = *this->queues_[(home + k) % nq];
+
+        std::lock_guard<std::mutex> guard(q.lock);
+
+        if (q.chunks.empty()) { continue; }
+
+        if (k == 0) {
+            // Own queue.  Take oldest.
+            chunk = q.chunks.front();
+            q.chunks.pop_front();
+        }
+        else {
+            // Steal from other end.
+            chunk = q.chunks.back();
+            q.chunks.pop_back();
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+bool Opm::ECLWorkStealingExecutor::Impl::runOne(const std::size_t home)
+{
+    auto chunk = Chunk{ nullptr, 0, 0 };
+
+    if (! this->pop(home, chunk)) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(this->sleepLock_);
+        this->pending_ -= 1;
+    }
+
+    auto error = std::exception_ptr{};
+
+    try {
+        (*chunk.job->task)(chunk.begin, chunk.end);
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    auto& job = *chunk.job;
+
+    // Signal completion while holding the lock.  The job object lives on
+    // the stack of the thread that waits for it.
+    std::lock_guard<std::mutex> guard(job.lock);
+
+    if (error && ! job.error) {
+        job.error = error;
+    }
+
+    if (--job.remaining == 0) {
+        job.done.notify_all();
+    }
+
+    return true;
+}
+
+void Opm::ECLWorkStealingExecutor::Impl::workerLoop(const std::size_t self)
+{
+    currentPool  = this;
+    currentQueue = self;
+
+    while (true) {
+        if (this->runOne(self)) { continue; }
+
+        std::unique_lock<std::mutex> guard(this->sleepLock_);
+
+        this->wake_.wait(guard, [this]()
+        {
+            return this->stop_ || (this->pending_ > 0);
+        });
+
+        if (this->stop_) { return; }
+    }
+}
+
+// =====================================================================
+// Class ECLWorkStealingExecutor
+// ---------------------------------------------------------------------
+
+Opm::ECLWorkStealingExecutor::
+ECLWorkStealingExecutor(const std::size_t concurrency)
+    : pImpl_(new Impl(concurrency))
+{}
+
+Opm::ECLWorkStealingExecutor::~ECLWorkStealingExecutor()
+{}
+
+void
+Opm::ECLWorkStealingExecutor::parallelFor(const std::size_t n,
+                                          const std::size_t grain,
+                                          const RangeTask&  task)
+{
+    this->pImpl_->parallelFor(n, grain, task);
+}
+
+std::size_t Opm::ECLWorkStealingExecutor::concurrency() const
+{
+    return this->pImpl_->concurrency();
+}
+
+// =====================================================================
+// Namespace ECLExecution
+// ---------------------------------------------------------------------
+
+std::shared_ptr<Opm::ECLExecutor>
+Opm::ECLExecution::defaultExecutor()
+{
+    std::lock_guard<std::mutex> guard(defaultExecutorLock());
+
+    auto& executor = defaultExecutorSlot();
+
+    if (! executor) {
+        executor = std::make_shared<ECLWorkStealingExecutor>();
+    }
+
+    return executor;
+}
+
+void
+Opm::ECLExecution::setDefaultExecutor(std::shared_ptr<ECLExecutor> executor)
+{
+    std::lock_guard<std::mutex> guard(defaultExecutorLock());
+
+    defaultExecutorSlot() = std::move(executor);
+}
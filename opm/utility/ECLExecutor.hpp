@@ -0,0 +1,197 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLEXECUTOR_HEADER_INCLUDED
+#define OPM_ECLEXECUTOR_HEADER_INCLUDED
+
+#include <opm/utility/ECLCancellation.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+/// \file
+///
+/// Executor abstraction through which all data-parallel loops of the
+/// library are dispatched.
+///
+/// Host applications that already own a thread pool implement
+/// ECLExecutor in terms of that pool and install it by calling
+/// ECLExecution::setDefaultExecutor().  Otherwise the library uses a
+/// built-in work-stealing pool.  Deterministic, single-threaded runs
+/// (e.g., for debugging) are achieved by installing an ECLSerialExecutor.
+///
+/// A child process created by fork() does not inherit the parent's worker
+/// threads.  If the parent has used or installed a default executor, the
+/// child's default executor is therefore replaced by an ECLSerialExecutor.
+
+namespace Opm {
+
+    /// Interface of parallel loop executors.
+    class ECLExecutor
+    {
+    public:
+        /// Loop body.  Processes the half-open index range [begin, end).
+        using RangeTask =
+            std::function<void(std::size_t begin, std::size_t end)>;
+
+        /// Destructor.
+        virtual ~ECLExecutor();
+
+        /// Run loop body over index range [0, n).
+        ///
+        /// The range is partitioned into disjoint subranges of at least
+        /// \p grain indices (except possibly the last) and the body is
+        /// invoked once for each subrange, potentially concurrently.
+        /// Returns once all subranges have been processed.  The first
+        /// exception thrown by the body, if any, is propagated to the
+        /// caller.
+        ///
+        /// \param[in] n Number of loop iterations.
+        ///
+        /// \param[in] grain Minimum number of iterations per subrange.
+        ///
+        /// \param[in] task Loop body.
+        virtual void parallelFor(const std::size_t n,
+                                 const std::size_t grain,
+                                 const RangeTask&  task) = 0;
+
+        /// Maximum number of loop bodies that may run concurrently.
+        virtual std::size_t concurrency() const = 0;
+    };
+
+    /// Executor that runs the entire loop in the calling thread.
+    class ECLSerialExecutor : public ECLExecutor
+    {
+    public:
+        void parallelFor(const std::size_t n,
+                         const std::size_t grain,
+                         const RangeTask&  task) override;
+
+        std::size_t concurrency() const override;
+    };
+
+    /// Built-in thread pool.
+    ///
+    /// Each worker thread has its own queue of subranges.  Idle threads
+    /// steal subranges from the back of other threads' queues.  The
+    /// calling thread participates in processing its own loop, so nested
+    /// parallelFor() calls do not deadlock.
+    class ECLWorkStealingExecutor : public ECLExecutor
+    {
+    public:
+        /// Constructor.
+        ///
+        /// \param[in] concurrency Total number of threads, including the
+        ///    calling thread, that process loop bodies.  Zero (default)
+        ///    selects the number of hardware threads.
+        explicit ECLWorkStealingExecutor(const std::size_t concurrency = 0);
+
+        /// Destructor.  Terminates worker threads.
+        ~ECLWorkStealingExecutor();
+
+        /// Disabled copy constructor.
+        ECLWorkStealingExecutor(const ECLWorkStealingExecutor&) = delete;
+
+        /// Disabled assignment operator.
+        ECLWorkStealingExecutor&
+        operator=(const ECLWorkStealingExecutor&) = delete;
+
+        void parallelFor(const std::size_t n,
+                         const std::size_t grain,
+                         const RangeTask&  task) override;
+
+        std::size_t concurrency() const override;
+
+    private:
+        class Impl;
+
+        std::unique_ptr<Impl> pImpl_;
+    };
+
+    namespace ECLExecution {
+
+        /// Retrieve executor used by library's parallel loops.  Creates
+        /// the built-in work-stealing pool on first use unless a different
+        /// executor has been installed.
+        std::shared_ptr<ECLExecutor> defaultExecutor();
+
+        /// Install executor used by library's parallel loops.
+        ///
+        /// \param[in] executor Executor.  Null restores the built-in
+        ///    work-stealing pool.
+        void setDefaultExecutor(std::shared_ptr<ECLExecutor> executor);
+
+        /// Convenience function to run a loop through the default
+        /// executor.
+        ///
+        /// \param[in] n Number of loop iterations.
+        ///
+        /// \param[in] grain Minimum number of iterations per subrange.
+        ///
+        /// \param[in] body Loop body.  Invoked as \code body(begin, end)
+        ///    \endcode.
+        template <class Body>
+        void parallelFor(const std::size_t n,
+                         const std::size_t grain,
+                         Body&&            body)
+        {
+            defaultExecutor()
+                ->parallelFor(n, grain, std::forward<Body>(body));
+        }
+
+        /// Convenience function to run a cancellable loop through the
+        /// default executor.
+        ///
+        /// The token is checked before the loop starts and at the start
+        /// of every subrange.  Once cancelled, subranges not yet started
+        /// are skipped and the loop throws ECLOperationCancelled.
+        ///
+        /// \param[in] n Number of loop iterations.
+        ///
+        /// \param[in] grain Minimum number of iterations per subrange.
+        ///
+        /// \param[in] token Cancellation token.
+        ///
+        /// \param[in] body Loop body.  Invoked as \code body(begin, end)
+        ///    \endcode.
+        template <class Body>
+        void parallelFor(const std::size_t           n,
+                         const std::size_t           grain,
+                         const ECLCancellationToken& token,
+                         Body&&                      body)
+        {
+            token.throwIfCancelled();
+
+            defaultExecutor()->parallelFor(n, grain,
+                [&token, &body](const std::size_t begin,
+                                const std::size_t end)
+            {
+                token.throwIfCancelled();
+
+                body(begin, end);
+            });
+        }
+
+    } // namespace ECLExecution
+
+} // namespace Opm
+
+#endif // OPM_ECLEXECUTOR_HEADER_INCLUDED
@@ -0,0 +1,634 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLFieldPyramid.hpp>
+
+#include <opm/utility/ECLByteCodec.hpp>
+#include <opm/utility/ECLGraph.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+/// \file
+///
+/// Implementation of \c ECLFieldPyramid interface.
+
+namespace {
+    using Index3 = ::Opm::ECLFieldPyramid::Index3;
+
+    std::size_t product(const Index3& n)
+    {
+        return static_cast<std::size_t>(n[0])
+            *  static_cast<std::size_t>(n[1])
+            *  static_cast<std::size_t>(n[2]);
+    }
+
+    /// Tile compression.
+    ///
+    /// Values are converted to their IEEE 754 bit patterns and each value
+    /// is XOR-ed with its predecessor.  Neighbouring values of smooth
+    /// fields share sign, exponent and leading mantissa bits, so the high
+    /// order bytes of the differences are mostly zero and compress well
+    /// in ECLByteCodec.  Lossless with respect to the single precision
+    /// values.
+    namespace Codec {
+        std::vector<unsigned char> encode(const std::vector<float>& x)
+        {
+            auto words = std::vector<std::uint32_t>(x.size());
+            auto prev  = std::uint32_t{0};
+
+            for (auto n = x.size(), i = 0*n; i < n; ++i) {
+                auto bits = std::uint32_t{0};
+                std::memcpy(&bits, &x[i], sizeof bits);
+
+                words[i] = bits ^ prev;
+                prev     = bits;
+            }
+
+            return ::Opm::ECLByteCodec::encode(words);
+        }
+
+        std::vector<float>
+        decode(const std::vector<unsigned char>& code,
+               const std::size_t                 n)
+        {
+            const auto words =
+                ::Opm::ECLByteCodec::decode<std::uint32_t>(code, n);
+
+            auto x    = std::vector<float>(n);
+            auto prev = std::uint32_t{0};
+
+            for (auto i = 0*n; i < n; ++i) {
+                prev ^= words[i];
+                std::memcpy(&x[i], &prev, sizeof prev);
+            }
+
+            return x;
+        }
+    } // namespace Codec
+
+    /// Weighted sums of cell values on single pyramid level.
+    struct WeightedSums
+    {
+        std::vector<double> value;
+        std::vector<double> weight;
+
+        std::vector<float> average() const
+        {
+            const auto nan = std::numeric_limits<float>::quiet_NaN();
+
+            auto x = std::vector<float>(this->value.size(), nan);
+
+            for (auto n = x.size(), i = 0*n; i < n; ++i) {
+                const auto w = this->weight[i];
+
+                if (w > 0.0) {
+                    x[i] = static_cast<float>(this->value[i] / w);
+                }
+            }
+
+            return x;
+        }
+    };
+
+    /// Merge blocks of 2x2x2 cells.
+    WeightedSums coarsen(const WeightedSums& fine,
+                         const Index3&       fdim,
+                         const Index3&       cdim)
+    {
+        auto coarse = WeightedSums{
+            std::vector<double>(product(cdim), 0.0),
+            std::vector<double>(product(cdim), 0.0)
+        };
+
+        auto f = std::size_t{0};
+        for (auto k = 0; k < fdim[2]; ++k) {
+            for (auto j = 0; j < fdim[1]; ++j) {
+                const auto row = static_cast<std::size_t>(j / 2)
+                    + static_cast<std::size_t>(cdim[1]) * (k / 2);
+
+                for (auto i = 0; i < fdim[0]; ++i, ++f) {
+                    const auto c = static_cast<std::size_t>(i / 2)
+                        + static_cast<std::size_t>(cdim[0]) * row;
+
+                    coarse.value [c] += fine.value [f];
+                    coarse.weight[c] += fine.weight[f];
+                }
+            }
+        }
+
+        return coarse;
+    }
+
+    namespace File {
+        /// Identifies field pyramid files.
+        const char magic[8] = { 'O', 'P', 'M', 'F', 'P', 'Y', 'R', '1' };
+
+        /// Position of single compressed tile relative to the start of
+        /// the tile section.
+        struct DirectoryEntry
+        {
+            std::uint64_t offset;
+            std::uint64_t size;
+        };
+
+        template <typename T>
+        void write(std::ostream& os, const T& x)
+        {
+            os.write(reinterpret_cast<const char*>(&x), sizeof x);
+        }
+
+        template <typename T>
+        T read(std::istream& is)
+        {
+            auto x = T{};
+            is.read(reinterpret_cast<char*>(&x), sizeof x);
+
+            if (! is) {
+                throw std::runtime_error("Field Pyramid File Truncated");
+            }
+
+            return x;
+        }
+
+        void writeIndex3(std::ostream& os, const Index3& n)
+        {
+            for (const auto& ni : n) {
+                write(os, static_cast<std::int32_t>(ni));
+            }
+        }
+
+        Index3 readIndex3(std::istream& is)
+        {
+            auto n = Index3{};
+
+            for (auto& ni : n) {
+                ni = static_cast<int>(read<std::int32_t>(is));
+            }
+
+            return n;
+        }
+    } // namespace File
+} // Anonymous namespace
+
+// ---------------------------------------------------------------------
+// Class Opm::ECLFieldPyramid
+// ---------------------------------------------------------------------
+
+Opm::ECLFieldPyramid::
+ECLFieldPyramid(const Index3&              cartDims,
+                const std::vector<int>&    mainGridCell,
+                const std::vector<double>& field,
+                const std::vector<double>& weight,
+                const Options&             opt)
+    : cartDims_(cartDims)
+    , tileSize_(opt.tileSize)
+{
+    if ((field.size() != mainGridCell.size()) ||
+        (weight.size() != mainGridCell.size()))
+    {
+        throw std::invalid_argument {
+            "Field, Weight, and Cell Mapping Sizes Differ"
+        };
+    }
+
+    this->defineLevels();
+
+    const auto nglob = product(this->cartDims_);
+
+    auto sums = WeightedSums {
+        std::vector<double>(nglob, 0.0),
+        std::vector<double>(nglob, 0.0)
+    };
+
+    for (auto n = field.size(), c = 0*n; c < n; ++c) {
+        const auto w = weight[c];
+        const auto v = field[c];
+
+        if ((mainGridCell[c] < 0) || ! (w > 0.0) || ! std::isfinite(v)) {
+            continue;
+        }
+
+        const auto g = static_cast<std::size_t>(mainGridCell[c]);
+
+        if (g >= nglob) {
+            throw std::invalid_argument {
+                "Main Grid Cell " + std::to_string(g) + " Out of Bounds"
+            };
+        }
+
+        sums.value [g] += w * v;
+        sums.weight[g] += w;
+    }
+
+    const auto nlvl = this->numLevels();
+
+    for (auto lvl = 0; lvl < nlvl; ++lvl) {
+        this->storeLevel(lvl, sums.average());
+
+        if (lvl + 1 < nlvl) {
+            sums = coarsen(sums, this->levels_[lvl + 0].dimensions,
+                                 this->levels_[lvl + 1].dimensions);
+        }
+    }
+}
+
+Opm::ECLFieldPyramid
+Opm::ECLFieldPyramid::fromECLGraph(const ECLGraph&            G,
+                                   const std::vector<double>& field,
+                                   const Options&             opt)
+{
+    const auto nc = G.numCells();
+
+    if (field.size() != nc) {
+        throw std::invalid_argument {
+            "Field Size Does Not Match Number of Active Cells"
+        };
+    }
+
+    const auto dims = G.cartesianDimensions();
+
+    auto cell = std::vector<int>(nc, -1);
+
+    for (auto c = 0*nc; c < nc; ++c) {
+        const auto loc = G.mainGridLocation(static_cast<int>(c));
+
+        if (loc.gridID == 0) {
+            cell[c] = loc.ijk[0] + dims[0]*(loc.ijk[1] + dims[1]*loc.ijk[2]);
+        }
+    }
+
+    return ECLFieldPyramid(dims, cell, field, G.poreVolume(), opt);
+}
+
+Opm::ECLFieldPyramid
+Opm::ECLFieldPyramid::load(const boost::filesystem::path& file,
+                           const int                      finestLevel)
+{
+    boost::filesystem::ifstream is(file, std::ios::in | std::ios::binary);
+
+    if (! is) {
+        std::ostringstream os;
+
+        os << "Failed to open Field Pyramid File "
+           << file.generic_string();
+
+        throw std::invalid_argument(os.str());
+    }
+
+    char magic[sizeof File::magic];
+    is.read(magic, sizeof magic);
+
+    if (! is || ! std::equal(std::begin(magic), std::end(magic),
+                             std::begin(File::magic)))
+    {
+        throw std::runtime_error {
+            "File " + file.generic_string() +
+            " is Not a Field Pyramid File"
+        };
+    }
+
+    auto pyr = ECLFieldPyramid{};
+
+    pyr.cartDims_ = File::readIndex3(is);
+    pyr.tileSize_ = File::readIndex3(is);
+
+    pyr.defineLevels();
+
+    const auto nlvl = pyr.numLevels();
+
+    if (File::read<std::int32_t>(is) != nlvl) {
+        throw std::runtime_error {
+            "Inconsistent Level Count in Field Pyramid File"
+        };
+    }
+
+    pyr.finestLevel_ = std::max(0, std::min(finestLevel, nlvl - 1));
+
+    // Directory.  Coarsest level first.
+    auto dir = std::vector<std::vector<File::DirectoryEntry>>(nlvl);
+    for (auto lvl = nlvl - 1; lvl >= 0; --lvl) {
+        dir[lvl].resize(product(pyr.levels_[lvl].numTiles));
+
+        for (auto& e : dir[lvl]) {
+            e = File::read<File::DirectoryEntry>(is);
+        }
+    }
+
+    // Tiles of requested levels form a prefix of the tile section.
+    const auto start = is.tellg();
+    for (auto lvl = nlvl - 1; lvl >= pyr.finestLevel_; --lvl) {
+        auto& tiles = pyr.tiles_[lvl];
+        tiles.resize(dir[lvl].size());
+
+        for (auto n = tiles.size(), t = 0*n; t < n; ++t) {
+            const auto& e = dir[lvl][t];
+
+            is.seekg(start + static_cast<std::streamoff>(e.offset));
+
+            tiles[t].resize(static_cast<std::size_t>(e.size));
+            is.read(reinterpret_cast<char*>(tiles[t].data()),
+                    tiles[t].size());
+
+            if (! is) {
+                throw std::runtime_error("Field Pyramid File Truncated");
+            }
+        }
+    }
+
+    return pyr;
+}
+
+void
+Opm::ECLFieldPyramid::save(const boost::filesystem::path& file) const
+{
+    if (this->finestLevel_ > 0) {
+        throw std::logic_error {
+            "Cannot Save Partially Loaded Field Pyramid"
+        };
+    }
+
+    boost::filesystem::ofstream os(file, std::ios::out   |
+                                         std::ios::trunc |
+                                         std::ios::binary);
+
+    os.write(File::magic, sizeof File::magic);
+
+    File::writeIndex3(os, this->cartDims_);
+    File::writeIndex3(os, this->tileSize_);
+    File::write(os, static_cast<std::int32_t>(this->numLevels()));
+
+    auto offset = std::uint64_t{0};
+    for (auto lvl = this->numLevels() - 1; lvl >= 0; --lvl) {
+        for (const auto& tile : this->tiles_[lvl]) {
+            const auto size = static_cast<std::uint64_t>(tile.size());
+
+            File::write(os, File::DirectoryEntry{ offset, size });
+
+            offset += size;
+        }
+    }
+
+    for (auto lvl = this->numLevels() - 1; lvl >= 0; --lvl) {
+        for (const auto& tile : this->tiles_[lvl]) {
+            os.write(reinterpret_cast<const char*>(tile.data()),
+                     tile.size());
+        }
+    }
+
+    if (! os) {
+        std::ostringstream msg;
+
+        msg << "Failed to write Field Pyramid File "
+            << file.generic_string();
+
+        throw std::runtime_error(msg.str());
+    }
+}
+
+int Opm::ECLFieldPyramid::numLevels() const
+{
+    return static_cast<int>(this->levels_.size());
+}
+
+int Opm::ECLFieldPyramid::finestLevel() const
+{
+    return this->finestLevel_;
+}
+
+const Opm::ECLFieldPyramid::Level&
+Opm::ECLFieldPyramid::level(const int level) const
+{
+    if ((level < 0) || (level >= this->numLevels())) {
+        throw std::invalid_argument {
+            "Pyramid Level " + std::to_string(level) + " Out of Bounds"
+        };
+    }
+
+    return this->levels_[level];
+}
+
+std::vector<Opm::ECLFieldPyramid::Index3>
+Opm::ECLFieldPyramid::tilesInRegion(const int     level,
+                                    const Index3& lo,
+                                    const Index3& hi) const
+{
+    const auto& L = this->level(level);
+
+    auto first = Index3{};
+    auto last  = Index3{};
+
+    for (auto d = 0; d < 3; ++d) {
+        const auto l = std::max(lo[d], 0);
+        const auto h = std::min(hi[d], this->cartDims_[d]);
+
+        if (l >= h) {
+            return {};
+        }
+
+        // Inclusive range of tiles covering level cells containing main
+        // grid cells [l, h).
+        first[d] = (l       / L.blockSize) / this->tileSize_[d];
+        last [d] = ((h - 1) / L.blockSize) / this->tileSize_[d];
+    }
+
+    auto tiles = std::vector<Index3>{};
+
+    for (auto k = first[2]; k <= last[2]; ++k) {
+        for (auto j = first[1]; j <= last[1]; ++j) {
+            for (auto i = first[0]; i <= last[0]; ++i) {
+                tiles.push_back(Index3{ { i, j, k } });
+            }
+        }
+    }
+
+    return tiles;
+}
+
+Opm::ECLFieldPyramid::Tile
+Opm::ECLFieldPyramid::tile(const int level, const Index3& tile) const
+{
+    const auto& L    = this->level(level);
+    const auto& code = this->compressedTile(level, tile);
+
+    auto t = Tile{};
+
+    for (auto d = 0; d < 3; ++d) {
+        t.origin[d] = tile[d] * this->tileSize_[d];
+        t.size  [d] = std::min(this->tileSize_[d],
+                               L.dimensions[d] - t.origin[d]);
+    }
+
+    t.values = Codec::decode(code, product(t.size));
+
+    return t;
+}
+
+const std::vector<unsigned char>&
+Opm::ECLFieldPyramid::compressedTile(const int     level,
+                                     const Index3& tile) const
+{
+    const auto t = this->tileIndex(level, tile);
+
+    if (level < this->finestLevel_) {
+        throw std::invalid_argument {
+            "Pyramid Level " + std::to_string(level) + " Not Loaded"
+        };
+    }
+
+    return this->tiles_[level][t];
+}
+
+std::size_t Opm::ECLFieldPyramid::compressedSize() const
+{
+    auto size = std::size_t{0};
+
+    for (const auto& lvl : this->tiles_) {
+        for (const auto& tile : lvl) {
+            size += tile.size();
+        }
+    }
+
+    return size;
+}
+
+void Opm::ECLFieldPyramid::defineLevels()
+{
+    for (auto d = 0; d < 3; ++d) {
+        if ((this->cartDims_[d] <= 0) || (this->tileSize_[d] <= 0)) {
+            throw std::invalid_argument {
+                "Grid Dimensions and Tile Sizes Must be Positive"
+            };
+        }
+    }
+
+    this->levels_.clear();
+
+    auto dim       = this->cartDims_;
+    auto blockSize = 1;
+
+    while (true) {
+        auto L = Level{};
+
+        L.dimensions = dim;
+        L.blockSize  = blockSize;
+
+        for (auto d = 0; d < 3; ++d) {
+            L.numTiles[d] =
+                (dim[d] + this->tileSize_[d] - 1) / this->tileSize_[d];
+        }
+
+        this->levels_.push_back(L);
+
+        if (product(dim) == 1) {
+            break;
+        }
+
+        for (auto& n : dim) {
+            n = (n + 1) / 2;
+        }
+
+        blockSize *= 2;
+    }
+
+    this->tiles_.assign(this->levels_.size(), {});
+}
+
+void Opm::ECLFieldPyramid::storeLevel(const int                 lvl,
+                                      const std::vector<float>& values)
+{
+    const auto& L = this->levels_[lvl];
+
+    auto& tiles = this->tiles_[lvl];
+    tiles.resize(product(L.numTiles));
+
+    const auto nx = static_cast<std::size_t>(L.dimensions[0]);
+    const auto ny = static_cast<std::size_t>(L.dimensions[1]);
+
+    auto t = std::size_t{0};
+    for (auto tk = 0; tk < L.numTiles[2]; ++tk) {
+        for (auto tj = 0; tj < L.numTiles[1]; ++tj) {
+            for (auto ti = 0; ti < L.numTiles[0]; ++ti, ++t) {
+                const auto origin = Index3{ {
+                    ti * this->tileSize_[0],
+                    tj * this->tileSize_[1],
+                    tk * this->tileSize_[2]
+                } };
+
+                auto size = Index3{};
+                for (auto d = 0; d < 3; ++d) {
+                    size[d] = std::min(this->tileSize_[d],
+                                       L.dimensions[d] - origin[d]);
+                }
+
+                auto x = std::vector<float>{};
+                x.reserve(product(size));
+
+                for (auto k = origin[2]; k < origin[2] + size[2]; ++k) {
+                    for (auto j = origin[1]; j < origin[1] + size[1]; ++j) {
+                        const auto start = values.begin() + origin[0]
+                            + nx*(j + ny*static_cast<std::size_t>(k));
+
+                        x.insert(x.end(), start, start + size[0]);
+                    }
+                }
+
+                tiles[t] = Codec::encode(x);
+            }
+        }
+    }
+}
+
+std::size_t
+Opm::ECLFieldPyramid::tileIndex(const int lvl, const Index3& tile) const
+{
+    const auto& L = this->level(lvl);
+
+    for (auto d = 0; d < 3; ++d) {
+        if ((tile[d] < 0) || (tile[d] >= L.numTiles[d])) {
+            throw std::invalid_argument {
+                "Tile Index Out of Bounds in Pyramid Level "
+                + std::to_string(lvl)
+            };
+        }
+    }
+
+    return static_cast<std::size_t>(tile[0])
+        + static_cast<std::size_t>(L.numTiles[0])
+        * (tile[1] + static_cast<std::size_t>(L.numTiles[1]) * tile[2]);
+}
@@ -0,0 +1,252 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLFIELDPYRAMID_HEADER_INCLUDED
+#define OPM_ECLFIELDPYRAMID_HEADER_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+/// \file
+///
+/// Multi-resolution representation of cell fields for visualisation.
+
+namespace Opm {
+
+    class ECLGraph;
+
+    /// Level-of-detail pyramid of a single cell field over the model's
+    /// main grid.
+    ///
+    /// Level zero has one value per main grid cell.  Each subsequent level
+    /// merges blocks of 2x2x2 cells of the previous level, until a single
+    /// cell remains.  Values are weighted averages--typically pore-volume
+    /// weighted--of the active cells within each block.  Cells of local
+    /// grid refinements contribute to the main grid cell that hosts the
+    /// refinement.  Blocks without active cells have the value NaN.
+    ///
+    /// Each level is partitioned into tiles of a fixed number of cells and
+    /// every tile is compressed separately, so that clients may fetch a
+    /// coarse overview first and then refine individual regions.  Values
+    /// are stored in single precision.
+    class ECLFieldPyramid
+    {
+    public:
+        /// Cartesian (I,J,K) index tuple or extent.
+        using Index3 = std::array<int, 3>;
+
+        /// Construction parameters.
+        struct Options
+        {
+            /// Default parameters.
+            Options()
+                : tileSize{ { 32, 32, 8 } }
+            {}
+
+            /// Number of cells in each direction of a tile.
+            Index3 tileSize;
+        };
+
+        /// Geometry of single pyramid level.
+        struct Level
+        {
+            /// Number of cells in each direction.
+            Index3 dimensions;
+
+            /// Number of tiles in each direction.
+            Index3 numTiles;
+
+            /// Number of main grid cells, in each direction, merged into
+            /// one cell of this level.  Equal to \code 1 << level
+            /// \endcode.
+            int blockSize;
+        };
+
+        /// Decompressed tile.
+        struct Tile
+        {
+            /// Level (I,J,K) of first cell in tile.
+            Index3 origin;
+
+            /// Number of cells in each direction.  Less than the tile size
+            /// at the upper boundaries of a level.
+            Index3 size;
+
+            /// Cell values.  I cycling most rapidly, then J, then K.
+            std::vector<float> values;
+        };
+
+        /// Constructor.
+        ///
+        /// \param[in] cartDims Cartesian dimensions of main grid.
+        ///
+        /// \param[in] mainGridCell Main grid global cell index (linear
+        ///    index of (I,J,K) with I cycling most rapidly) of each active
+        ///    cell.  Negative entries exclude the active cell.
+        ///
+        /// \param[in] field Cell values.  One value for each active cell.
+        ///    Non-finite values are excluded.
+        ///
+        /// \param[in] weight Non-negative averaging weight of each active
+        ///    cell.  Typically pore-volume.
+        ///
+        /// \param[in] opt Construction parameters.
+        ECLFieldPyramid(const Index3&              cartDims,
+                        const std::vector<int>&    mainGridCell,
+                        const std::vector<double>& field,
+                        const std::vector<double>& weight,
+                        const Options&             opt = Options{});
+
+        /// Named constructor.  Pore-volume weighted pyramid of cell field
+        /// defined on the active cells of a connection graph.
+        ///
+        /// \param[in] G Connection graph.  Defines active cells, their
+        ///    main grid locations, and pore-volumes.
+        ///
+        /// \param[in] field Cell values.  One value for each active cell
+        ///    of \p G.
+        ///
+        /// \param[in] opt Construction parameters.
+        ///
+        /// \return Pyramid of \p field.
+        static ECLFieldPyramid
+        fromECLGraph(const ECLGraph&            G,
+                     const std::vector<double>& field,
+                     const Options&             opt = Options{});
+
+        /// Named constructor.  Restore pyramid from file previously
+        /// created by member function save().
+        ///
+        /// Tiles are stored in order of decreasing level, so that loading
+        /// only the coarse levels reads only a prefix of the file.
+        ///
+        /// \param[in] file Name of pyramid file.
+        ///
+        /// \param[in] finestLevel Finest level to load.  Zero (default)
+        ///    loads all levels.  Tiles of finer levels are not available
+        ///    in the result.
+        ///
+        /// \return Pyramid.
+        static ECLFieldPyramid
+        load(const boost::filesystem::path& file,
+             const int                      finestLevel = 0);
+
+        /// Write pyramid to file.
+        ///
+        /// The file contains a header with the level geometry, a directory
+        /// of the byte offset and size of each tile, and the compressed
+        /// tiles, coarsest level first.  Clients may fetch individual
+        /// tiles by byte range.  Native-endian binary format.
+        ///
+        /// \param[in] file Name of pyramid file.  Overwritten if it exists.
+        void save(const boost::filesystem::path& file) const;
+
+        /// Retrieve number of levels.
+        int numLevels() const;
+
+        /// Retrieve finest level for which tiles are available.  Zero
+        /// unless restricted by load().
+        int finestLevel() const;
+
+        /// Retrieve geometry of single level.
+        ///
+        /// \param[in] level Level index.  Zero for the finest level.
+        const Level& level(const int level) const;
+
+        /// Identify tiles of single level that cover a box of main grid
+        /// cells.
+        ///
+        /// \param[in] level Level index.
+        ///
+        /// \param[in] lo Main grid (I,J,K) of lower corner of box.
+        ///    Inclusive.
+        ///
+        /// \param[in] hi Main grid (I,J,K) of upper corner of box.
+        ///    Exclusive.
+        ///
+        /// \return Tile indices, I cycling most rapidly.  Empty if the box
+        ///    is empty or outside the grid.
+        std::vector<Index3>
+        tilesInRegion(const int     level,
+                      const Index3& lo,
+                      const Index3& hi) const;
+
+        /// Retrieve decompressed tile.
+        ///
+        /// \param[in] level Level index.
+        ///
+        /// \param[in] tile Tile index within level.
+        ///
+        /// \return Tile values.
+        Tile tile(const int level, const Index3& tile) const;
+
+        /// Retrieve compressed representation of tile.
+        ///
+        /// \param[in] level Level index.
+        ///
+        /// \param[in] tile Tile index within level.
+        ///
+        /// \return Compressed tile.  Same bytes as stored by save().
+        const std::vector<unsigned char>&
+        compressedTile(const int level, const Index3& tile) const;
+
+        /// Retrieve total size, in bytes, of all available compressed
+        /// tiles.
+        std::size_t compressedSize() const;
+
+    private:
+        /// Cartesian dimensions of main grid.
+        Index3 cartDims_;
+
+        /// Number of cells in each direction of a tile.
+        Index3 tileSize_;
+
+        /// Finest level for which tiles are available.
+        int finestLevel_{0};
+
+        /// Geometry of each level.  Finest level first.
+        std::vector<Level> levels_;
+
+        /// Compressed tiles of each level.  Linear tile index, I cycling
+        /// most rapidly.  Empty for levels finer than finestLevel_.
+        std::vector<std::vector<std::vector<unsigned char>>> tiles_;
+
+        /// Default constructor for load().
+        ECLFieldPyramid() = default;
+
+        /// Define level geometry from main grid dimensions and tile size.
+        void defineLevels();
+
+        /// Compress and store single level.
+        ///
+        /// \param[in] lvl Level index.
+        ///
+        /// \param[in] values Cell values of level, I cycling most rapidly.
+        void storeLevel(const int lvl, const std::vector<float>& values);
+
+        /// Linear index of tile in level.  Throws if out of bounds.
+        std::size_t tileIndex(const int lvl, const Index3& tile) const;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLFIELDPYRAMID_HEADER_INCLUDED
@@ -34,14 +34,14 @@
 
 namespace {
 
-    std::vector<double>
-    computeGravDZ(const std::vector<int>&    neigh,
-                  const double               grav,
-                  const std::vector<double>& depth)
+    ::Opm::ECLLargeArray<double>
+    computeGravDZ(const ::Opm::ECLLargeArray<int>& neigh,
+                  const double                     grav,
+                  const std::vector<double>&       depth)
     {
         const auto nf = neigh.size() / 2;
 
-        auto gdz = std::vector<double>{};
+        auto gdz = ::Opm::ECLLargeArray<double>{};
         gdz.reserve(nf);
 
         for (auto f = 0*nf; f < nf; ++f) {
@@ -187,8 +187,8 @@ namespace Opm
         : graph_(graph)
         , satfunc_(graph, init, useEPS)
         , rmap_(pvtnumVector(graph, init))
-        , neighbours_(graph.neighbours())
-        , transmissibility_(graph.transmissibility())
+        , neighbours_(graph.neighbourArray())
+        , transmissibility_(graph.transmissibilityArray())
         , gravDz_(computeGravDZ(neighbours_, grav, depthVector(graph, init)))
         , pvtGas_(ECLPVT::CreateGasPVTInterpolant::fromECLOutput(init))
         , pvtOil_(ECLPVT::CreateOilPVTInterpolant::fromECLOutput(init))
@@ -205,18 +205,24 @@ namespace Opm
 
 
     std::vector<double>
-    ECLFluxCalc::flux(const ECLRestartData& rstrt,
-                      const ECLPhaseIndex   phase) const
+    ECLFluxCalc::flux(const ECLRestartData&       rstrt,
+                      const ECLPhaseIndex         phase,
+                      const ECLCancellationToken& token) const
     {
         // Obtain dynamic data.
-        const auto dyn_data = this->phaseProperties(rstrt, phase);
+        const auto dyn_data = this->phaseProperties(rstrt, phase, token);
 
         // Compute fluxes per connection.
         const int num_conn = transmissibility_.size();
         std::vector<double> fluxvec(num_conn);
-        for (int conn = 0; conn < num_conn; ++conn) {
-            fluxvec[conn] = singleFlux(conn, dyn_data);
-        }
+        ECLExecution::parallelFor(num_conn, 4096, token,
+            [this, &dyn_data, &fluxvec]
+            (const std::size_t begin, const std::size_t end)
+        {
+            for (auto conn = begin; conn < end; ++conn) {
+                fluxvec[conn] = singleFlux(conn, dyn_data);
+            }
+        });
         return fluxvec;
     }
 
@@ -256,8 +262,9 @@ namespace Opm
 
 
     ECLFluxCalc::DynamicData
-    ECLFluxCalc::phaseProperties(const ECLRestartData& rstrt,
-                                 const ECLPhaseIndex   phase) const
+    ECLFluxCalc::phaseProperties(const ECLRestartData&       rstrt,
+                                 const ECLPhaseIndex         phase,
+                                 const ECLCancellationToken& token) const
     {
         auto dyn_data = DynamicData{};
 
@@ -270,7 +277,7 @@ namespace Opm
         // Step 1 of Mobility Calculation.
         // Store phase's relative permeability values.
         dyn_data.mobility =
-            this->satfunc_.relperm(this->graph_, rstrt, phase);
+            this->satfunc_.relperm(this->graph_, rstrt, phase, token);
 
         // Step 1 of Mass Density (Reservoir Conditions) Calculation.
         // Allocate space for storing the cell values.
@@ -278,13 +285,13 @@ namespace Opm
 
         switch (phase) {
         case ECLPhaseIndex::Aqua:
-            return this->watPVT(std::move(dyn_data));
+            return this->watPVT(token, std::move(dyn_data));
 
         case ECLPhaseIndex::Liquid:
-            return this->oilPVT(rstrt, std::move(dyn_data));
+            return this->oilPVT(rstrt, token, std::move(dyn_data));
 
         case ECLPhaseIndex::Vapour:
-            return this->gasPVT(rstrt, std::move(dyn_data));
+            return this->gasPVT(rstrt, token, std::move(dyn_data));
         }
 
         throw std::invalid_argument {
@@ -297,14 +304,15 @@ namespace Opm
 
 
     ECLFluxCalc::DynamicData
-    ECLFluxCalc::gasPVT(const ECLRestartData& rstrt,
-                        DynamicData&&         dyn_data) const
+    ECLFluxCalc::gasPVT(const ECLRestartData&       rstrt,
+                        const ECLCancellationToken& token,
+                        DynamicData&&               dyn_data) const
     {
         verify_active_phase(this->pvtGas_, "Gas");
 
         const auto rv = vapoilVector(this->graph_, this->vapoil_, rstrt);
 
-        this->regionLoop([this, &rv, &dyn_data]
+        this->regionLoop(token, [this, &rv, &dyn_data]
             (const int regID)
         {
             // Note: This function assumes that 'regID' is a traditional
@@ -367,14 +375,15 @@ namespace Opm
 
 
     ECLFluxCalc::DynamicData
-    ECLFluxCalc::oilPVT(const ECLRestartData& rstrt,
-                        DynamicData&&         dyn_data) const
+    ECLFluxCalc::oilPVT(const ECLRestartData&       rstrt,
+                        const ECLCancellationToken& token,
+                        DynamicData&&               dyn_data) const
     {
         verify_active_phase(this->pvtOil_, "Oil");
 
         const auto rs = disgasVector(this->graph_, this->disgas_, rstrt);
 
-        this->regionLoop([this, &rs, &dyn_data]
+        this->regionLoop(token, [this, &rs, &dyn_data]
             (const int regID)
         {
             // Note: This section assumes that 'regID' is a traditional
@@ -437,11 +446,12 @@ namespace Opm
 
 
     ECLFluxCalc::DynamicData
-    ECLFluxCalc::watPVT(DynamicData&& dyn_data) const
+    ECLFluxCalc::watPVT(const ECLCancellationToken& token,
+                        DynamicData&&               dyn_data) const
     {
         verify_active_phase(this->pvtWat_, "Water");
 
-        this->regionLoop([this, &dyn_data]
+        this->regionLoop(token, [this, &dyn_data]
             (const int regID)
         {
             // Note: This section assumes that 'regID' is a traditional
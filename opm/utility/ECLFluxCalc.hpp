@@ -20,7 +20,10 @@
 #ifndef OPM_ECLFLUXCALC_HEADER_INCLUDED
 #define OPM_ECLFLUXCALC_HEADER_INCLUDED
 
+#include <opm/utility/ECLCancellation.hpp>
+#include <opm/utility/ECLExecutor.hpp>
 #include <opm/utility/ECLGraph.hpp>
+#include <opm/utility/ECLMemoryPolicy.hpp>
 #include <opm/utility/ECLPhaseIndex.hpp>
 #include <opm/utility/ECLPvtGas.hpp>
 #include <opm/utility/ECLPvtOil.hpp>
@@ -28,6 +31,7 @@
 #include <opm/utility/ECLRegionMapping.hpp>
 #include <opm/utility/ECLSaturationFunc.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -66,12 +70,19 @@ namespace Opm
         ///
         /// \param[in] phase Canonical phase for which to retrive flux.
         ///
+        /// \param[in] token Cancellation token.  Checked between phases of
+        ///            the calculation and per region or block of
+        ///            connections.  Throws ECLOperationCancelled once
+        ///            cancelled.
+        ///
         /// \return Flux values corresponding to selected phase.
         ///         Empty if required data is missing.
         ///         Numerical values in SI units (rm^3/s).
         std::vector<double>
-        flux(const ECLRestartData& rstrt,
-             const ECLPhaseIndex   phase) const;
+        flux(const ECLRestartData&       rstrt,
+             const ECLPhaseIndex         phase,
+             const ECLCancellationToken& token =
+                 ECLCancellationToken{}) const;
 
     private:
         struct DynamicData
@@ -84,16 +95,20 @@ namespace Opm
         double singleFlux(const int connection,
                           const DynamicData& dyn_data) const;
 
-        DynamicData phaseProperties(const ECLRestartData& rstrt,
-                                    const ECLPhaseIndex   phase) const;
+        DynamicData phaseProperties(const ECLRestartData&       rstrt,
+                                    const ECLPhaseIndex         phase,
+                                    const ECLCancellationToken& token) const;
 
-        DynamicData gasPVT(const ECLRestartData& rstrt,
-                           DynamicData&&         dyn_data) const;
+        DynamicData gasPVT(const ECLRestartData&       rstrt,
+                           const ECLCancellationToken& token,
+                           DynamicData&&               dyn_data) const;
 
-        DynamicData oilPVT(const ECLRestartData& rstrt,
-                           DynamicData&&         dyn_data) const;
+        DynamicData oilPVT(const ECLRestartData&       rstrt,
+                           const ECLCancellationToken& token,
+                           DynamicData&&               dyn_data) const;
 
-        DynamicData watPVT(DynamicData&& dyn_data) const;
+        DynamicData watPVT(const ECLCancellationToken& token,
+                           DynamicData&&               dyn_data) const;
 
         void computePhaseMobility(const int                  regID,
                                   const std::vector<double>& mu,
@@ -130,19 +145,32 @@ namespace Opm
         }
 
         template <class RegOp>
-        void regionLoop(RegOp&& regOp) const
+        void regionLoop(const ECLCancellationToken& token,
+                        RegOp&&                     regOp) const
         {
-            for (const auto& regID : this->rmap_.activeRegions()) {
-                regOp(regID);
-            }
+            // Regions use distinct PVT tables and write to disjoint cell
+            // subsets, so they may be processed concurrently.
+            const auto regions = this->rmap_.activeRegions();
+
+            ECLExecution::parallelFor(regions.size(), 1, token,
+                [&regions, &regOp]
+                (const std::size_t begin, const std::size_t end)
+            {
+                for (auto i = begin; i < end; ++i) {
+                    regOp(regions[i]);
+                }
+            });
         }
 
         const ECLGraph& graph_;
         ECLSaturationFunc satfunc_;
         ECLRegionMapping rmap_;
-        std::vector<int> neighbours_;
-        std::vector<double> transmissibility_;
-        std::vector<double> gravDz_;
+        // Streamed by flux kernel.  Allocated subject to ECLMemory
+        // placement policy.  Connection topology and transmissibility
+        // refer to the graph's own storage.
+        const ECLLargeArray<int>& neighbours_;
+        const ECLLargeArray<double>& transmissibility_;
+        ECLLargeArray<double> gravDz_;
 
         bool disgas_{false};
         bool vapoil_{false};
@@ -22,18 +22,23 @@
 #endif
 
 #include <opm/utility/ECLGraph.hpp>
+#include <opm/utility/ECLRankSelectBitVector.hpp>
 #include <opm/utility/ECLResultData.hpp>
+#include <opm/utility/ECLStaticArrayCache.hpp>
 #include <opm/utility/ECLUnitHandling.hpp>
 
 #include <opm/parser/eclipse/Units/Units.hpp>
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -108,6 +113,30 @@ namespace {
         std::array<std::size_t,3>
         cartesianDimensions(const ecl_grid_type* G);
 
+        /// Identify main grid cell hosting a cell of a local grid.
+        ///
+        /// Follows chains of nested local grid refinements up to the main
+        /// grid.
+        ///
+        /// \param[in] G Main grid obtained from loadCase().
+        ///
+        /// \param[in] lgr Local grid of \p G.  Typically obtained from
+        ///    function getGrid().
+        ///
+        /// \param[in] globalCell Global index of cell relative to \p lgr.
+        ///
+        /// \return Global index, relative to \p G, of host cell.  Negative
+        ///    one (-1) if the host cell cannot be identified.
+        int mainGridHostCell(const ecl_grid_type* G,
+                             const ecl_grid_type* lgr,
+                             int                  globalCell);
+
+        /// Allocate identity of graph's active cell layout in static
+        /// array caches.
+        ///
+        /// \return Process-wide unique, positive identity.
+        std::size_t nextGraphCacheID();
+
         /// Access unit conventions pertaining to single grid in result set.
         ///
         /// \tparam ResultSet Type representing a result set.  Must
@@ -157,6 +186,13 @@ namespace {
         loadNNC(const ecl_grid_type* G,
                 const ecl_file_type* init);
 
+        /// Minimum number of global cells for which a grid maps global
+        /// cells to active cells through a rank/select bit vector (1.25
+        /// bits per cell) rather than an explicit array of active cell
+        /// IDs (32 bits per cell).  The explicit array is somewhat faster
+        /// to query, and cheap in small grids.
+        const std::size_t succinctMapThreshold = std::size_t{1} << 22;
+
         /// Cartesian connections in a model grid.
         class CartesianGridData
         {
@@ -171,9 +207,13 @@ namespace {
             ///
             /// \param[in] gridID Numeric identifier of this grid.  Zero for
             ///    main grid, positive for LGRs.
-            CartesianGridData(const ecl_grid_type*          G,
-                              const ::Opm::ECLInitFileData& init,
-                              const int                     gridID);
+            ///
+            /// \param[in] token Cancellation token.  Checked before each
+            ///    of the I, J and K connection passes.
+            CartesianGridData(const ecl_grid_type*               G,
+                              const ::Opm::ECLInitFileData&      init,
+                              const int                          gridID,
+                              const ::Opm::ECLCancellationToken& token);
 
             /// Retrieve non-negative numeric ID of grid instance.
             ///
@@ -211,9 +251,21 @@ namespace {
             /// 1] \endcode.
             const std::vector<double>& transmissibility() const;
 
+            /// Release neighbourship relations and transmissibility
+            /// values once they have been merged into the graph's
+            /// connection arrays.  Preserves numConnections().
+            void releaseConnections();
+
             /// Retrieve ID of active cell from global ID.
             int activeCell(const std::size_t globalCell) const;
 
+            /// Retrieve global cell indices of all active cells in grid.
+            std::vector<std::size_t> activeGlobal() const;
+
+            /// Retrieve size of grid's bounding box (i.e., the number of
+            /// cells in each cardinal direction).
+            const std::array<std::size_t,3>& cartesianSize() const;
+
             /// Retrieve ID of active cell from (I,J,K) index tuple.
             int activeCell(const int i, const int j, const int k) const;
 
@@ -287,6 +339,9 @@ namespace {
                 /// Retrive global cell indices of all active cells in grid.
                 std::vector<std::size_t> activeGlobal() const;
 
+                /// Retrieve size of grid's bounding box.
+                const std::array<std::size_t,3>& cartesianSize() const;
+
                 /// Retrieve pore-volume values for all active cells in grid.
                 ///
                 /// SI unit conventions (rm^3).
@@ -398,15 +453,31 @@ namespace {
                 /// Static pore-volumes of all active cells.
                 std::vector<double> activePVol_;
 
-                /// Active index of model's global cells.
+                /// Active index of model's global cells.  Empty if the
+                /// grid uses the succinct mapping activeBits_.
                 std::vector<int> active_ID_;
 
+                /// Succinct active index of model's global cells.  Used
+                /// instead of active_ID_ in large grids.
+                ::Opm::ECLRankSelectBitVector activeBits_;
+
                 /// Whether or not a particular active cell is subdivided.
                 std::vector<bool> is_divided_;
 
                 /// Retrieve number of active cells in grid.
                 std::size_t numActiveCells() const;
 
+                /// Retrieve active cell ID of particular global cell from
+                /// whichever mapping is in use.
+                ///
+                /// \param[in] globalCell Index of particular global cell.
+                ///    Must be in the range \code [0 .. numGlobalCells())
+                ///    \endcode.
+                ///
+                /// \return Active cell ID of \p globalCell.  Negative one
+                /// (\code -1 \endcode) if the global cell is inactive.
+                int activeID(const std::size_t globalCell) const;
+
                 /// Compute linear index of global cell from explicit
                 /// (I,J,K) tuple.
                 ///
@@ -455,15 +526,18 @@ namespace {
             DirectionSuffix suffix_;
 
             /// Flattened neighbourship relation (array of size \code
-            /// 2*numConnections() \endcode).
+            /// 2*numConnections() \endcode).  Empty once released.
             std::vector<int> neigh_;
 
+            /// Number of Cartesian connections in grid.
+            std::size_t nconn_{0};
+
             /// Source cells for each Cartesian connection.
             OutCell outCell_;
 
             /// Transmissibility field for purpose of on-demand flux
             /// calculation if fluxes are not already available in dynamic
-            /// result set.
+            /// result set.  Empty once released.
             std::vector<double> trans_;
 
             /// Predicate for whether or not a particular result vector is
@@ -574,6 +648,33 @@ ECL::getGridName(const ecl_grid_type* G, const int gridID)
     return ecl_grid_get_name(G);
 }
 
+int
+ECL::mainGridHostCell(const ecl_grid_type* G,
+                      const ecl_grid_type* lgr,
+                      int                  globalCell)
+{
+    // Nesting depth is bounded by the number of grids.
+    for (auto depth = 0, n = numGrids(G);
+         (lgr != G) && (globalCell >= 0) && (depth < n); ++depth)
+    {
+        globalCell = ecl_grid_get_parent_cell1(lgr, globalCell);
+
+        const auto* parent = ecl_grid_get_parent_name(lgr);
+
+        lgr = ((parent == nullptr) || ! ecl_grid_has_lgr(G, parent))
+            ? G : ecl_grid_get_lgr(G, parent);
+    }
+
+    return (lgr == G) ? globalCell : -1;
+}
+
+std::size_t ECL::nextGraphCacheID()
+{
+    static std::atomic<std::size_t> id{0};
+
+    return ++id;
+}
+
 std::vector<double>
 ECL::getPVolVector(const ecl_grid_type*          G,
                    const ::Opm::ECLInitFileData& init,
@@ -732,7 +833,29 @@ CartesianCells::CartesianCells(const ecl_grid_type*       G,
     }
 
     {
-        std::vector<int>(pvol.size(), -1).swap(this->active_ID_);
+        const auto succinct = pvol.size() >= succinctMapThreshold;
+
+        if (succinct) {
+            // Active cells follow the global cell ordering, so the active
+            // ID of a cell is its rank among the active global cells.
+            assert (std::is_sorted(this->rsMap_.subset.begin(),
+                                   this->rsMap_.subset.end(),
+                [](const ID& c1, const ID& c2)
+            {
+                return c1.glob < c2.glob;
+            }));
+
+            auto is_active = std::vector<bool>(pvol.size(), false);
+            for (const auto& cell : this->rsMap_.subset) {
+                is_active[cell.glob] = true;
+            }
+
+            this->active_ID_.clear();
+            this->activeBits_ = ::Opm::ECLRankSelectBitVector(is_active);
+        }
+        else {
+            std::vector<int>(pvol.size(), -1).swap(this->active_ID_);
+        }
 
         this->activePVol_.clear();
         this->activePVol_.reserve(this->rsMap_.subset.size());
@@ -743,7 +866,10 @@ CartesianCells::CartesianCells(const ecl_grid_type*       G,
         auto active = 0;
 
         for (const auto& cell : this->rsMap_.subset) {
-            this->active_ID_[cell.glob] = active++;
+            if (! succinct) {
+                this->active_ID_[cell.glob] = active++;
+            }
+
             this->activePVol_.push_back(pvol[cell.glob]);
 
             const auto ert_active = static_cast<int>(cell.act);
@@ -768,6 +894,12 @@ ECL::CartesianGridData::CartesianCells::activeGlobal() const
     return active;
 }
 
+const std::array<std::size_t,3>&
+ECL::CartesianGridData::CartesianCells::cartesianSize() const
+{
+    return this->cartesianSize_;
+}
+
 const std::vector<double>&
 ECL::CartesianGridData::CartesianCells::activePoreVolume() const
 {
@@ -847,7 +979,9 @@ namespace { namespace ECL {
 std::size_t
 ECL::CartesianGridData::CartesianCells::numGlobalCells() const
 {
-    return this->active_ID_.size();
+    const auto& dim = this->cartesianSize_;
+
+    return dim[0] * dim[1] * dim[2];
 }
 
 int
@@ -856,7 +990,7 @@ CartesianCells::getActiveCell(const std::size_t globalCell) const
 {
     if (globalCell >= numGlobalCells()) { return -1; }
 
-    return this->active_ID_[globalCell];
+    return this->activeID(globalCell);
 }
 
 std::size_t
@@ -892,7 +1026,7 @@ CartesianCells::getNeighbour(const std::size_t globalCell,
 
     if (globNeigh >= numGlobalCells()) { return -1; }
 
-    return this->active_ID_[globNeigh];
+    return this->activeID(globNeigh);
 }
 
 bool
@@ -912,6 +1046,17 @@ ECL::CartesianGridData::CartesianCells::numActiveCells() const
     return this->rsMap_.subset.size();
 }
 
+int
+ECL::CartesianGridData::
+CartesianCells::activeID(const std::size_t globalCell) const
+{
+    if (! this->active_ID_.empty()) {
+        return this->active_ID_[globalCell];
+    }
+
+    return this->activeBits_.position(globalCell);
+}
+
 std::size_t
 ECL::CartesianGridData::
 CartesianCells::globIdx(const IndexTuple& ijk) const
@@ -948,9 +1093,10 @@ CartesianCells::ind2sub(const std::size_t globalCell) const
 // ======================================================================
 
 ECL::CartesianGridData::
-CartesianGridData(const ecl_grid_type*          G,
-                  const ::Opm::ECLInitFileData& init,
-                  const int                     gridID)
+CartesianGridData(const ecl_grid_type*               G,
+                  const ::Opm::ECLInitFileData&      init,
+                  const int                          gridID,
+                  const ::Opm::ECLCancellationToken& token)
     : gridID_  (gridID)
     , gridName_(::ECL::getGridName(G, gridID))
     , cells_   (G, ::ECL::getPVolVector(G, init, gridName_))
@@ -973,8 +1119,12 @@ CartesianGridData(const ecl_grid_type*          G,
                           CartesianCells::Direction::J ,
                           CartesianCells::Direction::K })
     {
+        token.throwIfCancelled();
+
         this->deriveNeighbours(gcells, init, d);
     }
+
+    this->nconn_ = this->neigh_.size() / 2;
 }
 
 int ECL::CartesianGridData::gridID() const
@@ -997,7 +1147,7 @@ ECL::CartesianGridData::numCells() const
 std::size_t
 ECL::CartesianGridData::numConnections() const
 {
-    return this->neigh_.size() / 2;
+    return this->nconn_;
 }
 
 const std::vector<int>&
@@ -1018,12 +1168,31 @@ ECL::CartesianGridData::transmissibility() const
     return this->trans_;
 }
 
+void
+ECL::CartesianGridData::releaseConnections()
+{
+    std::vector<int>   {}.swap(this->neigh_);
+    std::vector<double>{}.swap(this->trans_);
+}
+
 int
 ECL::CartesianGridData::activeCell(const std::size_t globalCell) const
 {
     return this->cells_.getActiveCell(globalCell);
 }
 
+std::vector<std::size_t>
+ECL::CartesianGridData::activeGlobal() const
+{
+    return this->cells_.activeGlobal();
+}
+
+const std::array<std::size_t,3>&
+ECL::CartesianGridData::cartesianSize() const
+{
+    return this->cells_.cartesianSize();
+}
+
 int
 ECL::CartesianGridData::activeCell(const int i,
                                    const int j,
@@ -1244,8 +1413,14 @@ public:
     ///                 If available in the INIT file, the constructor will
     ///                 also leverage the transmissibility data when
     ///                 constructing the active cell neighbourship table.
+    ///
+    /// \param[in] token Cancellation token.  Checked between grids,
+    ///                  between the Cartesian connection passes of each
+    ///                  grid and before processing non-neighbouring
+    ///                  connections and LGR host cells.
     Impl(const boost::filesystem::path& grid,
-         const ECLInitFileData&         init);
+         const ECLInitFileData&         init,
+         const ECLCancellationToken&    token);
 
     /// Retrieve number of grids.
     ///
@@ -1268,6 +1443,31 @@ public:
     int activeCell(const std::string&       gridID,
                    const std::array<int,3>& ijk) const;
 
+    /// Retrieve grid and (I,J,K) tuple of active cell.
+    ///
+    /// \param[in] activeCell Active ID (relative to linear, global
+    ///     numbering) of particular cell.
+    ///
+    /// \return Location of \p activeCell.  Negative one (-1) in all
+    ///     fields if \p activeCell is outside the valid range.
+    CellLocation cellLocation(const int activeCell) const;
+
+    /// Retrieve main grid (I,J,K) tuple of active cell.  Cells of local
+    /// grids map to their main grid host cell.
+    ///
+    /// \param[in] activeCell Active ID (relative to linear, global
+    ///     numbering) of particular cell.
+    ///
+    /// \return Main grid location of \p activeCell.  Negative one (-1)
+    ///     in all fields if \p activeCell is outside the valid range or
+    ///     if its host cell is unknown.
+    CellLocation mainGridLocation(const int activeCell) const;
+
+    /// Retrieve Cartesian dimensions of particular grid.
+    ///
+    /// \param[in] gridID Numeric grid ID.  Zero for main grid.
+    std::array<int,3> cartesianDimensions(const int gridID) const;
+
     /// Retrieve number of active cells in graph.
     std::size_t numCells() const;
 
@@ -1290,7 +1490,7 @@ public:
     /// The \c i-th connection is between active cells \code
     /// neighbours()[2*i + 0] \endcode and \code neighbours()[2*i + 1]
     /// \endcode.
-    std::vector<int> neighbours() const;
+    const ECLLargeArray<int>& neighbours() const;
 
     /// Retrieve static pore-volume values on active cells only.
     ///
@@ -1306,7 +1506,7 @@ public:
     /// transmissibility of the connection between cells \code
     /// neighbours()[2*i + 0] \endcode and \code neighbours()[2*i + 1]
     /// \endcode.
-    std::vector<double> transmissibility() const;
+    const ECLLargeArray<double>& transmissibility() const;
 
     /// Retrieve phase flux on all connections defined by \code neighbours()
     /// \endcode.
@@ -1345,6 +1545,24 @@ public:
     rawLinearisedCellData(const ResultSet&   rset,
                           const std::string& vector) const;
 
+    /// Retrieve static result set vector linearised on active cells.
+    ///
+    /// Specialisation for INIT result sets.  The vector is decoded and
+    /// linearised once per graph and result set, and subsequent requests
+    /// are served from the result set's static array cache.
+    ///
+    /// \tparam T Element type of result set vector.
+    ///
+    /// \param[in] init ECL INIT result set.
+    ///
+    /// \param[in] vector Name of result set vector.
+    ///
+    /// \return Result set vector linearised on active cells.
+    template <typename T>
+    std::vector<T>
+    rawLinearisedCellData(const ECLInitFileData& init,
+                          const std::string&     vector) const;
+
     /// Retrieve floating-point result set vector from current view
     /// (e.g., particular report step) linearised on active cells and
     /// converted to strict SI unit conventions.
@@ -1606,6 +1824,25 @@ private:
     /// range \code [0 .. numCells()) \endcode).
     std::vector<std::size_t> activeOffset_;
 
+    /// Grid-local global cell index of each active cell.  Combined with
+    /// activeOffset_ to form the inverse of activeCell().  Stored in 32
+    /// bits, since a single grid's Cartesian index is limited to 32 bits.
+    std::vector<std::uint32_t> activeGlobal_;
+
+    /// Main grid global cell index of host cell of each active cell in
+    /// local grids, in order of active ID starting at \code
+    /// activeOffset_[1] \endcode.  Negative one (-1) if unknown.
+    std::vector<int> hostGlobal_;
+
+    /// Neighbourship relations of all connections: Cartesian connections
+    /// of each grid, in grid order, followed by all non-neighbouring
+    /// connections.  Streamed by flux kernels.
+    ECLLargeArray<int> neighbours_;
+
+    /// Static transmissibility of all connections in neighbours_.  Empty
+    /// if unavailable in one or more grids.
+    ECLLargeArray<double> trans_;
+
     /// Set of active phases in result set.  Derived from .INIT on the
     /// assumption that the set of active phases does not change throughout
     /// the simulation run.
@@ -1616,6 +1853,10 @@ private:
 
     std::unordered_map<std::string, int> gridID_;
 
+    /// Identity of this graph's active cell layout in static array caches
+    /// of INIT result sets.  Unique within the process.
+    std::size_t cacheID_;
+
     /// Extract explicit non-neighbouring connections from ECL output.
     ///
     /// Writes to \c neigh_ and \c nncID_.
@@ -1626,6 +1867,19 @@ private:
     void defineNNCs(const ecl_grid_type*   G,
                     const ECLInitFileData& init);
 
+    /// Merge connections of all grids and non-neighbouring connections
+    /// into single arrays and release each grid's own copy.
+    ///
+    /// Writes to \c neighbours_ and \c trans_.
+    void defineConnections();
+
+    /// Identify main grid host cells of all active cells in local grids.
+    ///
+    /// Writes to \c hostGlobal_.
+    ///
+    /// \param[in] G ERT Grid representation.
+    void defineHostCells(const ecl_grid_type* G);
+
     /// Extract scenario's set of active phases.
     ///
     /// Writes to activePhases_.
@@ -1860,8 +2114,12 @@ isViable(const std::vector<ECL::CartesianGridData>& grids,
 // ======================================================================
 
 Opm::ECLGraph::Impl::Impl(const boost::filesystem::path& grid,
-                          const ECLInitFileData&         init)
+                          const ECLInitFileData&         init,
+                          const ECLCancellationToken&    token)
+    : cacheID_(ECL::nextGraphCacheID())
 {
+    token.throwIfCancelled();
+
     const auto G = ECL::loadCase(grid);
 
     const auto numGrids = ECL::numGrids(G.get());
@@ -1872,18 +2130,44 @@ Opm::ECLGraph::Impl::Impl(const boost::filesystem::path& grid,
 
     for (auto gridID = 0*numGrids; gridID < numGrids; ++gridID)
     {
+        token.throwIfCancelled();
+
         this->grid_.emplace_back(ECL::getGrid(G.get(), gridID),
-                                 init, gridID);
+                                 init, gridID, token);
 
         this->activeOffset_.push_back(this->activeOffset_.back() +
                                       this->grid_.back().numCells());
 
+        {
+            const auto& dim  = this->grid_.back().cartesianSize();
+            const auto  nglb = dim[0] * dim[1] * dim[2];
+
+            if (nglb > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::invalid_argument {
+                    "Grid '" + this->grid_.back().gridName() +
+                    "' Too Large for 32-Bit Cell Indices"
+                };
+            }
+
+            const auto glob = this->grid_.back().activeGlobal();
+
+            this->activeGlobal_.insert(this->activeGlobal_.end(),
+                                       glob.begin(), glob.end());
+        }
+
         this->activeGrids_.push_back(this->grid_.back().gridName());
 
         this->gridID_[this->activeGrids_.back()] = gridID;
     }
 
+    token.throwIfCancelled();
+
     this->defineNNCs(G.get(), init);
+    this->defineConnections();
+
+    token.throwIfCancelled();
+
+    this->defineHostCells(G.get());
     this->defineActivePhases(init);
 }
 
@@ -1922,6 +2206,85 @@ activeCell(const std::string&       gridID,
     return off + active;
 }
 
+Opm::ECLGraph::CellLocation
+Opm::ECLGraph::Impl::cellLocation(const int activeCell) const
+{
+    auto loc = CellLocation{ -1, { { -1, -1, -1 } } };
+
+    if ((activeCell < 0) ||
+        (static_cast<std::size_t>(activeCell) >= this->numCells()))
+    {
+        return loc;
+    }
+
+    const auto cell = static_cast<std::size_t>(activeCell);
+
+    // First offset strictly greater than 'cell' ends the cell's grid.
+    // Skips any grids without active cells.
+    const auto start = std::begin(this->activeOffset_) + 1;
+    const auto gIdx  = static_cast<std::size_t>(std::distance(start,
+        std::upper_bound(start, std::end(this->activeOffset_), cell)));
+
+    assert ((gIdx < this->grid_.size()) &&
+            "Logic Error in ECLGraph::Impl::cellLocation()");
+
+    const auto& dim  = this->grid_[gIdx].cartesianSize();
+    const auto  glob = this->activeGlobal_[cell];
+
+    loc.gridID = static_cast<int>(gIdx);
+    loc.ijk[0] = static_cast<int>(glob % dim[0]);
+    loc.ijk[1] = static_cast<int>((glob / dim[0]) % dim[1]);
+    loc.ijk[2] = static_cast<int>( glob / (dim[0] * dim[1]));
+
+    return loc;
+}
+
+Opm::ECLGraph::CellLocation
+Opm::ECLGraph::Impl::mainGridLocation(const int activeCell) const
+{
+    auto loc = this->cellLocation(activeCell);
+
+    if (loc.gridID <= 0) {
+        // Main grid cell or invalid input.
+        return loc;
+    }
+
+    const auto lgrCell = static_cast<std::size_t>(activeCell)
+        - this->activeOffset_[1];
+
+    const auto host = this->hostGlobal_[lgrCell];
+
+    if (host < 0) {
+        return CellLocation{ -1, { { -1, -1, -1 } } };
+    }
+
+    const auto& dim  = this->grid_[0].cartesianSize();
+    const auto  glob = static_cast<std::size_t>(host);
+
+    loc.gridID = 0;
+    loc.ijk[0] = static_cast<int>(glob % dim[0]);
+    loc.ijk[1] = static_cast<int>((glob / dim[0]) % dim[1]);
+    loc.ijk[2] = static_cast<int>( glob / (dim[0] * dim[1]));
+
+    return loc;
+}
+
+std::array<int,3>
+Opm::ECLGraph::Impl::cartesianDimensions(const int gridID) const
+{
+    if ((gridID < 0) || (gridID >= this->numGrids())) {
+        throw std::invalid_argument {
+            "Grid ID " + std::to_string(gridID) + " Out of Bounds"
+        };
+    }
+
+    const auto& dim = this->grid_[gridID].cartesianSize();
+
+    return { { static_cast<int>(dim[0]),
+               static_cast<int>(dim[1]),
+               static_cast<int>(dim[2]) } };
+}
+
 std::size_t
 Opm::ECLGraph::Impl::numCells() const
 {
@@ -1952,35 +2315,10 @@ Opm::ECLGraph::Impl::activeGrids() const
     return this->activeGrids_;
 }
 
-std::vector<int>
+const Opm::ECLLargeArray<int>&
 Opm::ECLGraph::Impl::neighbours() const
 {
-    auto N = std::vector<int>{};
-
-    // this->numConnections() includes NNCs.
-    N.reserve(2 * this->numConnections());
-
-    {
-        auto off = this->activeOffset_.begin();
-
-        for (const auto& G : this->grid_) {
-            const auto add = static_cast<int>(*off);
-
-            for (const auto& cell : G.neighbours()) {
-                N.push_back(cell + add);
-            }
-
-            ++off;
-        }
-    }
-
-    {
-        const auto& nnc = this->nnc_.getNeighbours();
-
-        N.insert(N.end(), nnc.begin(), nnc.end());
-    }
-
-    return N;
+    return this->neighbours_;
 }
 
 std::vector<double>
@@ -1998,32 +2336,10 @@ Opm::ECLGraph::Impl::activePoreVolume() const
     return pvol;
 }
 
-std::vector<double>
+const Opm::ECLLargeArray<double>&
 Opm::ECLGraph::Impl::transmissibility() const
 {
-    auto trans = std::vector<double>{};
-
-    // Recall: this->numConnections() includes NNCs.
-    const auto totconn = this->numConnections();
-    trans.reserve(totconn);
-
-    for (const auto& G : this->grid_) {
-        const auto& Ti = G.transmissibility();
-
-        trans.insert(trans.end(), Ti.begin(), Ti.end());
-    }
-
-    if (this->nnc_.numConnections() > 0) {
-        const auto& tranNNC = this->nnc_.transmissibility();
-
-        trans.insert(trans.end(), tranNNC.begin(), tranNNC.end());
-    }
-
-    if (trans.size() < totconn) {
-        return {};
-    }
-
-    return trans;
+    return this->trans_;
 }
 
 std::vector<double>
@@ -2094,6 +2410,23 @@ namespace Opm {
 
         return x;
     }
+
+    template <typename T>
+    std::vector<T>
+    ECLGraph::Impl::rawLinearisedCellData(const ECLInitFileData& init,
+                                          const std::string&     vector) const
+    {
+        const auto key = ECLStaticArrayCache::Key{ this->cacheID_, vector };
+
+        const auto x = init.staticArrayCache().template get<T>(key,
+            [this, &init, &vector]()
+        {
+            return this->rawLinearisedCellData<T, ECLInitFileData>
+                (init, vector);
+        });
+
+        return *x;
+    }
 } // namespace Opm
 
 std::vector<double>
@@ -2148,6 +2481,75 @@ Opm::ECLGraph::Impl::defineNNCs(const ecl_grid_type*   G,
     }
 }
 
+void
+Opm::ECLGraph::Impl::defineConnections()
+{
+    // Recall: this->numConnections() includes NNCs.
+    const auto totconn = this->numConnections();
+
+    this->neighbours_.reserve(2 * totconn);
+    this->trans_     .reserve(1 * totconn);
+
+    {
+        auto off = this->activeOffset_.begin();
+
+        for (auto& G : this->grid_) {
+            const auto add = static_cast<int>(*off);
+
+            for (const auto& cell : G.neighbours()) {
+                this->neighbours_.push_back(cell + add);
+            }
+
+            const auto& Ti = G.transmissibility();
+
+            this->trans_.insert(this->trans_.end(), Ti.begin(), Ti.end());
+
+            G.releaseConnections();
+
+            ++off;
+        }
+    }
+
+    {
+        const auto& nnc = this->nnc_.getNeighbours();
+
+        this->neighbours_.insert(this->neighbours_.end(),
+                                 nnc.begin(), nnc.end());
+    }
+
+    if (this->nnc_.numConnections() > 0) {
+        const auto& tranNNC = this->nnc_.transmissibility();
+
+        this->trans_.insert(this->trans_.end(),
+                            tranNNC.begin(), tranNNC.end());
+    }
+
+    if (this->trans_.size() < totconn) {
+        ECLLargeArray<double>{}.swap(this->trans_);
+    }
+}
+
+void
+Opm::ECLGraph::Impl::defineHostCells(const ecl_grid_type* G)
+{
+    const auto lgrBegin = this->activeOffset_[1];
+
+    this->hostGlobal_.clear();
+    this->hostGlobal_.reserve(this->activeOffset_.back() - lgrBegin);
+
+    for (auto n = this->grid_.size(), gIdx = 0*n + 1; gIdx < n; ++gIdx) {
+        const auto* lgr = ECL::getGrid(G, static_cast<int>(gIdx));
+
+        for (auto cell = this->activeOffset_[gIdx + 0];
+                  cell < this->activeOffset_[gIdx + 1]; ++cell)
+        {
+            const auto glob = static_cast<int>(this->activeGlobal_[cell]);
+
+            this->hostGlobal_.push_back(ECL::mainGridHostCell(G, lgr, glob));
+        }
+    }
+}
+
 template <class GetFluxUnit>
 void
 Opm::ECLGraph::Impl::fluxNNC(const ECLRestartData& rstrt,
@@ -2293,9 +2695,10 @@ Opm::ECLGraph::operator=(ECLGraph&& rhs)
 
 Opm::ECLGraph
 Opm::ECLGraph::load(const boost::filesystem::path& grid,
-                    const ECLInitFileData&         init)
+                    const ECLInitFileData&         init,
+                    const ECLCancellationToken&    token)
 {
-    auto pImpl = ImplPtr{new Impl(grid, init)};
+    auto pImpl = ImplPtr{new Impl(grid, init, token)};
 
     return { std::move(pImpl) };
 }
@@ -2312,6 +2715,37 @@ Opm::ECLGraph::activeCell(const std::array<int,3>& ijk,
     return this->pImpl_->activeCell(gridID, ijk);
 }
 
+Opm::ECLGraph::CellLocation
+Opm::ECLGraph::cellLocation(const int activeCell) const
+{
+    return this->pImpl_->cellLocation(activeCell);
+}
+
+std::vector<Opm::ECLGraph::CellLocation>
+Opm::ECLGraph::cellLocation(const std::vector<int>& activeCells) const
+{
+    auto loc = std::vector<CellLocation>{};
+    loc.reserve(activeCells.size());
+
+    for (const auto& cell : activeCells) {
+        loc.push_back(this->pImpl_->cellLocation(cell));
+    }
+
+    return loc;
+}
+
+Opm::ECLGraph::CellLocation
+Opm::ECLGraph::mainGridLocation(const int activeCell) const
+{
+    return this->pImpl_->mainGridLocation(activeCell);
+}
+
+std::array<int,3>
+Opm::ECLGraph::cartesianDimensions(const int gridID) const
+{
+    return this->pImpl_->cartesianDimensions(gridID);
+}
+
 std::size_t Opm::ECLGraph::numCells() const
 {
     return this->pImpl_->numCells();
@@ -2336,7 +2770,9 @@ Opm::ECLGraph::activeGrids() const
 
 std::vector<int> Opm::ECLGraph::neighbours() const
 {
-    return this->pImpl_->neighbours();
+    const auto& N = this->pImpl_->neighbours();
+
+    return { N.begin(), N.end() };
 }
 
 std::vector<double> Opm::ECLGraph::poreVolume() const
@@ -2345,6 +2781,19 @@ std::vector<double> Opm::ECLGraph::poreVolume() const
 }
 
 std::vector<double> Opm::ECLGraph::transmissibility() const
+{
+    const auto& T = this->pImpl_->transmissibility();
+
+    return { T.begin(), T.end() };
+}
+
+const Opm::ECLLargeArray<int>& Opm::ECLGraph::neighbourArray() const
+{
+    return this->pImpl_->neighbours();
+}
+
+const Opm::ECLLargeArray<double>&
+Opm::ECLGraph::transmissibilityArray() const
 {
     return this->pImpl_->transmissibility();
 }
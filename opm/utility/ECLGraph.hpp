@@ -20,6 +20,8 @@
 #ifndef OPM_ECLGRAPH_HEADER_INCLUDED
 #define OPM_ECLGRAPH_HEADER_INCLUDED
 
+#include <opm/utility/ECLCancellation.hpp>
+#include <opm/utility/ECLMemoryPolicy.hpp>
 #include <opm/utility/ECLPhaseIndex.hpp>
 #include <opm/utility/ECLResultData.hpp>
 #include <opm/utility/ECLUnitHandling.hpp>
@@ -86,11 +88,18 @@ namespace Opm {
         ///                 when constructing the active cell neighbourship
         ///                 table.
         ///
+        /// \param[in] token Cancellation token.  Checked between grids
+        ///                  and between the I, J and K connection passes
+        ///                  of each grid.  Throws ECLOperationCancelled
+        ///                  once cancelled.
+        ///
         /// \return Fully formed ECLIPSE connection graph with property
         /// associations.
         static ECLGraph
         load(const boost::filesystem::path& gridFile,
-             const ECLInitFileData&         init);
+             const ECLInitFileData&         init,
+             const ECLCancellationToken&    token =
+                 ECLCancellationToken{});
 
         /// Retrieve number of grids in model.
         ///
@@ -113,6 +122,59 @@ namespace Opm {
         int activeCell(const std::array<int,3>& ijk,
                        const std::string&       gridID = 0) const;
 
+        /// Location of an active cell within the model's grids.
+        struct CellLocation {
+            /// Numeric grid ID.  Zero for main grid, positive for LGRs.
+            /// Index into activeGrids().
+            int gridID;
+
+            /// Cartesian (I,J,K) index tuple relative to grid \c gridID.
+            std::array<int,3> ijk;
+        };
+
+        /// Retrieve grid and (I,J,K) tuple of active cell.  Inverse of
+        /// activeCell().
+        ///
+        /// \param[in] activeCell Active ID (relative to linear, global
+        ///     numbering) of particular cell.
+        ///
+        /// \return Location of \p activeCell.  Negative one (-1) in all
+        ///     fields if \p activeCell is not in the range \code [0 ..
+        ///     numCells()) \endcode.
+        CellLocation cellLocation(const int activeCell) const;
+
+        /// Retrieve grids and (I,J,K) tuples of sequence of active cells.
+        ///
+        /// \param[in] activeCells Active IDs (relative to linear, global
+        ///     numbering) of sequence of cells.
+        ///
+        /// \return Location of each element of \p activeCells.
+        std::vector<CellLocation>
+        cellLocation(const std::vector<int>& activeCells) const;
+
+        /// Retrieve main grid (I,J,K) tuple of active cell.
+        ///
+        /// Identical to cellLocation() for cells of the main grid.  Cells
+        /// of local grid refinements, including nested refinements, map to
+        /// the main grid cell that hosts the refinement.
+        ///
+        /// \param[in] activeCell Active ID (relative to linear, global
+        ///     numbering) of particular cell.
+        ///
+        /// \return Main grid location of \p activeCell.  Grid ID zero
+        ///     unless \p activeCell is outside the valid range or its host
+        ///     cell is unknown, in which case all fields are negative one.
+        CellLocation mainGridLocation(const int activeCell) const;
+
+        /// Retrieve Cartesian dimensions of particular grid.
+        ///
+        /// \param[in] gridID Numeric grid ID.  Zero (default) for the main
+        ///     grid and positive for LGRs.  Index into activeGrids().
+        ///
+        /// \return Number of cells in each cardinal direction of grid \p
+        ///     gridID.
+        std::array<int,3> cartesianDimensions(const int gridID = 0) const;
+
         /// Retrieve number of active cells in graph.
         std::size_t numCells() const;
 
@@ -153,6 +215,21 @@ namespace Opm {
         /// \endcode.
         std::vector<double> transmissibility() const;
 
+        /// Access the graph's own storage of neighbourship relations.
+        ///
+        /// Same contents as neighbours(), but without copying.  Allocated
+        /// subject to the ECLMemory placement policy for use by parallel
+        /// kernels.  Valid for the lifetime of the graph.
+        const ECLLargeArray<int>& neighbourArray() const;
+
+        /// Access the graph's own storage of static transmissibility
+        /// values.
+        ///
+        /// Same contents as transmissibility(), but without copying.
+        /// Allocated subject to the ECLMemory placement policy for use by
+        /// parallel kernels.  Valid for the lifetime of the graph.
+        const ECLLargeArray<double>& transmissibilityArray() const;
+
         /// Retrieve phase flux on all connections defined by \code
         /// neighbours() \endcode.
         ///
@@ -170,6 +247,11 @@ namespace Opm {
         /// Retrieve result set vector from current view (e.g., particular
         /// report step) linearised on active cells.
         ///
+        /// Vectors of an \c ECLInitFileData result set are decoded and
+        /// linearised only once per graph.  Repeated requests, e.g., from
+        /// several end-point scaling or PVT factories, are served from the
+        /// result set's static array cache.
+        ///
         /// \tparam T Element type of result set vector.
         ///
         /// \param[in] vector Name of result set vector.
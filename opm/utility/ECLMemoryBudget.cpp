@@ -0,0 +1,432 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLMemoryBudget.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// \file
+///
+/// Implementation of coordinated least-recently-used memory budget.
+
+// ---------------------------------------------------------------------
+// Class Opm::ECLMemoryBudget::Impl
+// ---------------------------------------------------------------------
+
+class Opm::ECLMemoryBudget::Impl
+{
+public:
+    /// Pending eviction.  Executed after the budget lock is released.
+    struct Victim
+    {
+        Evictor evict;
+        EntryID entry;
+    };
+
+    using VictimList = std::vector<Victim>;
+
+    /// Execute pending evictions.  Caller must not hold lock.
+    static void evict(const VictimList& victims);
+
+    explicit Impl(const std::size_t limit);
+
+    VictimList setLimit(const std::size_t bytes);
+
+    std::size_t limit() const;
+
+    std::size_t usage() const;
+
+    std::vector<Usage> report() const;
+
+    ClientID registerClient(std::string name, Evictor evict);
+
+    void unregisterClient(const ClientID client);
+
+    bool charge(const ClientID    client,
+                const EntryID     entry,
+                const std::size_t bytes,
+                VictimList&       victims);
+
+    void touch(const ClientID client, const EntryID entry);
+
+    void release(const ClientID client, const EntryID entry);
+
+private:
+    struct Client
+    {
+        Evictor evict;
+        Usage   usage;
+    };
+
+    struct Entry
+    {
+        ClientID    client;
+        EntryID     entry;
+        std::size_t bytes;
+    };
+
+    /// Entries in order of use.  Most recently used first.
+    using LRUList = std::list<Entry>;
+
+    using EntryKey = std::pair<ClientID, EntryID>;
+
+    mutable std::mutex lock_;
+
+    std::size_t limit_;
+    std::size_t used_{0};
+
+    ClientID                     nextClient_{0};
+    std::map<ClientID, Client>   clients_;
+
+    LRUList                                 lru_;
+    std::map<EntryKey, LRUList::iterator>   index_;
+
+    /// Size of each entry of non-evictable clients.  Not in lru_.
+    std::map<EntryKey, std::size_t>         pinned_;
+
+    /// Total size of all entries in pinned_.  Included in used_.
+    std::size_t                             pinnedUsed_{0};
+
+    /// Forget entry.  Caller holds lock.
+    void erase(LRUList::iterator e);
+
+    /// Forget entry of non-evictable client.  Caller holds lock.
+    void erasePinned(std::map<EntryKey, std::size_t>::iterator e);
+
+    /// Evict least recently used entries until total usage fits within
+    /// limit.  Caller holds lock.
+    VictimList shrink();
+};
+
+void Opm::ECLMemoryBudget::Impl::evict(const VictimList& victims)
+{
+    for (const auto& victim : victims) {
+        victim.evict(victim.entry);
+    }
+}
+
+Opm::ECLMemoryBudget::Impl::Impl(const std::size_t limit)
+    : limit_(limit)
+{}
+
+Opm::ECLMemoryBudget::Impl::VictimList
+Opm::ECLMemoryBudget::Impl::setLimit(const std::size_t bytes)
+{
+    std::lock_guard<std::mutex> guard(this->lock_);
+
+    this->limit_ = bytes;
+
+    return this->shrink();
+}
+
+std::size_t Opm::ECLMemoryBudget::Impl::limit() const
+{
+    std::lock_guard<std::mutex> guard(this->lock_);
+
+    return this->limit_;
+}
+
+std::size_t Opm::ECLMemoryBudget::Impl::usage() const
+{
+    std::lock_guard<std::mutex> guard(this->lock_);
+
+    return this->used_;
+}
+
+std::vector<Opm::ECLMemoryBudget::Usage>
+Opm::ECLMemoryBudget::Impl::report() const
+{
+    std::lock_guard<std::mutex> guard(this->lock_);
+
+    auto rpt = std::vector<Usage>{};
+    rpt.reserve(this->clients_.size());
+
+    for (const auto& client : this->clients_) {
+        rpt.push_back(client.second.usage);
+    }
+
+    return rpt;
+}
+
+Opm::ECLMemoryBudget::ClientID
+Opm::ECLMemoryBudget::Impl::registerClient(std::string name, Evictor evict)
+{
+    std::lock_guard<std::mutex> guard(this->lock_);
+
+    const auto id = this->nextClient_++;
+
+    auto& client = this->clients_[id];
+
+    client.evict           = std::move(evict);
+    client.usage.name      = std::move(name);
+    client.usage.evictable = static_cast<bool>(client.evict);
+
+    return id;
+}
+
+void Opm::ECLMemoryBudget::Impl::unregisterClient(const ClientID client)
+{
+    std::lock_guard<std::mutex> guard(this->lock_);
+
+    auto e = this->index_.lower_bound(EntryKey{ client, 0 });
+
+    while ((e != this->index_.end()) && (e->first.first == client)) {
+        auto lruPos = e->second;
+        ++e;
+
+        this->erase(lruPos);
+    }
+
+    auto p = this->pinned_.lower_bound(EntryKey{ client, 0 });
+
+    while ((p != this->pinned_.end()) && (p->first.first == client)) {
+        this->erasePinned(p++);
+    }
+
+    this->clients_.erase(client);
+}
+
+bool Opm::ECLMemoryBudget::Impl::charge(const ClientID    client,
+                                        const EntryID     entry,
+                                        const std::size_t bytes,
+                                        VictimList&       victims)
+{
+    std::lock_guard<std::mutex> guard(this->lock_);
+
+    auto c = this->clients_.find(client);
+
+    if (c == this->clients_.end()) {
+        return false;
+    }
+
+    if (! c->second.usage.evictable) {
+        {
+            auto p = this->pinned_.find(EntryKey{ client, entry });
+            if (p != this->pinned_.end()) {
+                this->erasePinned(p);
+            }
+        }
+
+        this->pinned_[EntryKey{ client, entry }] = bytes;
+
+        this->used_       += bytes;
+        this->pinnedUsed_ += bytes;
+
+        c->second.usage.entries += 1;
+        c->second.usage.bytes   += bytes;
+
+        // Pinned entry leaves less room for evictable ones.
+        victims = this->shrink();
+
+        return true;
+    }
+
+    if ((this->pinnedUsed_ > this->limit_) ||
+        (bytes > this->limit_ - this->pinnedUsed_))
+    {
+        // No room next to non-evictable entries.
+        return false;
+    }
+
+    {
+        auto e = this->index_.find(EntryKey{ client, entry });
+        if (e != this->index_.end()) {
+            this->erase(e->second);
+        }
+    }
+
+    this->lru_.push_front(Entry{ client, entry, bytes });
+    this->index_[EntryKey{ client, entry }] = this->lru_.begin();
+
+    this->used_ += bytes;
+
+    c->second.usage.entries += 1;
+    c->second.usage.bytes   += bytes;
+
+    // New entry is at the front of the list and fits within the limit
+    // along with all non-evictable entries.  It is never among the
+    // victims.
+    victims = this->shrink();
+
+    return true;
+}
+
+void Opm::ECLMemoryBudget::Impl::touch(const ClientID client,
+                                       const EntryID  entry)
+{
+    std::lock_guard<std::mutex> guard(this->lock_);
+
+    auto e = this->index_.find(EntryKey{ client, entry });
+    if (e != this->index_.end()) {
+        this->lru_.splice(this->lru_.begin(), this->lru_, e->second);
+    }
+}
+
+void Opm::ECLMemoryBudget::Impl::release(const ClientID client,
+                                         const EntryID  entry)
+{
+    std::lock_guard<std::mutex> guard(this->lock_);
+
+    auto e = this->index_.find(EntryKey{ client, entry });
+    if (e != this->index_.end()) {
+        this->erase(e->second);
+    }
+
+    auto p = this->pinned_.find(EntryKey{ client, entry });
+    if (p != this->pinned_.end()) {
+        this->erasePinned(p);
+    }
+}
+
+void Opm::ECLMemoryBudget::Impl::erase(LRUList::iterator e)
+{
+    auto c = this->clients_.find(e->client);
+    if (c != this->clients_.end()) {
+        c->second.usage.entries -= 1;
+        c->second.usage.bytes   -= e->bytes;
+    }
+
+    this->used_ -= e->bytes;
+
+    this->index_.erase(EntryKey{ e->client, e->entry });
+    this->lru_.erase(e);
+}
+
+void
+Opm::ECLMemoryBudget::Impl::
+erasePinned(std::map<EntryKey, std::size_t>::iterator e)
+{
+    auto c = this->clients_.find(e->first.first);
+    if (c != this->clients_.end()) {
+        c->second.usage.entries -= 1;
+        c->second.usage.bytes   -= e->second;
+    }
+
+    this->used_       -= e->second;
+    this->pinnedUsed_ -= e->second;
+
+    this->pinned_.erase(e);
+}
+
+Opm::ECLMemoryBudget::Impl::VictimList
+Opm::ECLMemoryBudget::Impl::shrink()
+{
+    auto victims = VictimList{};
+
+    while ((this->used_ > this->limit_) && ! this->lru_.empty()) {
+        auto e = std::prev(this->lru_.end());
+
+        auto c = this->clients_.find(e->client);
+        if (c != this->clients_.end()) {
+            c->second.usage.evictions += 1;
+
+            victims.push_back(Victim{ c->second.evict, e->entry });
+        }
+
+        this->erase(e);
+    }
+
+    return victims;
+}
+
+// ---------------------------------------------------------------------
+// Class Opm::ECLMemoryBudget
+// ---------------------------------------------------------------------
+
+Opm::ECLMemoryBudget::ECLMemoryBudget(const std::size_t limit)
+    : pImpl_(new Impl(limit))
+{}
+
+Opm::ECLMemoryBudget::~ECLMemoryBudget()
+{}
+
+Opm::ECLMemoryBudget& Opm::ECLMemoryBudget::instance()
+{
+    static ECLMemoryBudget budget;
+
+    return budget;
+}
+
+void Opm::ECLMemoryBudget::setLimit(const std::size_t bytes)
+{
+    Impl::evict(this->pImpl_->setLimit(bytes));
+}
+
+std::size_t Opm::ECLMemoryBudget::limit() const
+{
+    return this->pImpl_->limit();
+}
+
+std::size_t Opm::ECLMemoryBudget::usage() const
+{
+    return this->pImpl_->usage();
+}
+
+std::vector<Opm::ECLMemoryBudget::Usage>
+Opm::ECLMemoryBudget::report() const
+{
+    return this->pImpl_->report();
+}
+
+Opm::ECLMemoryBudget::ClientID
+Opm::ECLMemoryBudget::registerClient(std::string name, Evictor evict)
+{
+    return this->pImpl_->registerClient(std::move(name), std::move(evict));
+}
+
+void Opm::ECLMemoryBudget::unregisterClient(const ClientID client)
+{
+    this->pImpl_->unregisterClient(client);
+}
+
+bool Opm::ECLMemoryBudget::charge(const ClientID    client,
+                                  const EntryID     entry,
+                                  const std::size_t bytes)
+{
+    auto victims = Impl::VictimList{};
+
+    const auto retain = this->pImpl_->charge(client, entry, bytes, victims);
+
+    Impl::evict(victims);
+
+    return retain;
+}
+
+void Opm::ECLMemoryBudget::touch(const ClientID client,
+                                 const EntryID  entry)
+{
+    this->pImpl_->touch(client, entry);
+}
+
+void Opm::ECLMemoryBudget::release(const ClientID client,
+                                   const EntryID  entry)
+{
+    this->pImpl_->release(client, entry);
+}
@@ -0,0 +1,386 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLMEMORYBUDGET_HEADER_INCLUDED
+#define OPM_ECLMEMORYBUDGET_HEADER_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// \file
+///
+/// Process-wide memory budget shared by all library caches.
+///
+/// Every cache registers with the budget and charges the size of each
+/// retained entry.  Whenever the total charge exceeds the budget's limit,
+/// the least recently used entries--irrespective of which cache holds
+/// them--are evicted until the total fits.  Evicted entries are recomputed
+/// on next use.  Entries larger than the limit are never retained.
+///
+/// Caches whose entries must not be evicted, such as static model arrays,
+/// register without an eviction callback.  Their entries are counted in
+/// the total and in the per-cache report, and so leave less room for
+/// evictable entries, but they are always retained.
+///
+/// The default limit is zero, meaning that caching is disabled.  Host
+/// applications enable caching by calling ECLMemoryBudget::setLimit().
+
+namespace Opm {
+
+    /// Coordinated, least-recently-used memory budget.
+    class ECLMemoryBudget
+    {
+    public:
+        /// Identity of registered cache.
+        using ClientID = std::size_t;
+
+        /// Identity of single cache entry.  Unique within a client.
+        using EntryID = std::size_t;
+
+        /// Eviction callback.  Invoked without any budget locks held.
+        /// Must release the entry and must tolerate being called for
+        /// entries that have already been released.  Empty for caches
+        /// whose entries are never evicted.
+        using Evictor = std::function<void(EntryID)>;
+
+        /// Memory usage of single registered cache.
+        struct Usage
+        {
+            /// Cache name passed to registerClient().
+            std::string name;
+
+            /// Number of retained entries.
+            std::size_t entries{0};
+
+            /// Total size, in bytes, of retained entries.
+            std::size_t bytes{0};
+
+            /// Number of entries evicted by the budget.
+            std::size_t evictions{0};
+
+            /// Whether or not the budget may evict the cache's entries.
+            bool evictable{true};
+        };
+
+        /// Constructor.
+        ///
+        /// \param[in] limit Maximum total size, in bytes, of all retained
+        ///    cache entries.
+        explicit ECLMemoryBudget(const std::size_t limit = 0);
+
+        /// Destructor.
+        ~ECLMemoryBudget();
+
+        /// Disabled copy constructor.
+        ECLMemoryBudget(const ECLMemoryBudget&) = delete;
+
+        /// Disabled assignment operator.
+        ECLMemoryBudget& operator=(const ECLMemoryBudget&) = delete;
+
+        /// Retrieve process-wide budget used by all library caches.
+        static ECLMemoryBudget& instance();
+
+        /// Change limit.  Evicts entries if the current total exceeds the
+        /// new limit.
+        ///
+        /// \param[in] bytes Maximum total size of retained cache entries.
+        ///    Zero disables caching.
+        void setLimit(const std::size_t bytes);
+
+        /// Retrieve current limit.
+        std::size_t limit() const;
+
+        /// Retrieve total size, in bytes, of all retained entries.
+        std::size_t usage() const;
+
+        /// Retrieve memory usage of all registered caches, in order of
+        /// registration.
+        std::vector<Usage> report() const;
+
+        /// Register cache.
+        ///
+        /// \param[in] name Cache name used in reports.
+        ///
+        /// \param[in] evict Eviction callback.  Empty to register a
+        ///    cache whose entries are never evicted.
+        ///
+        /// \return Client identity.  Pass to unregisterClient() before
+        ///    the cache is destroyed.
+        ClientID registerClient(std::string name, Evictor evict);
+
+        /// Unregister cache and forget all its entries.  Eviction callback
+        /// is not invoked by this function.
+        ///
+        /// \param[in] client Client identity.
+        void unregisterClient(const ClientID client);
+
+        /// Charge memory of new cache entry.
+        ///
+        /// Evicts least recently used entries of any cache to make room.
+        /// Entries of non-evictable caches are always retained and are
+        /// never evicted, even if larger than the limit.
+        ///
+        /// \param[in] client Client identity.
+        ///
+        /// \param[in] entry Entry identity.
+        ///
+        /// \param[in] bytes Size of entry.
+        ///
+        /// \return Whether or not the entry may be retained.  False if the
+        ///    entry does not fit within the limit next to all entries of
+        ///    non-evictable caches, in which case the caller must release
+        ///    it.
+        bool charge(const ClientID    client,
+                    const EntryID     entry,
+                    const std::size_t bytes);
+
+        /// Mark entry as most recently used.
+        ///
+        /// \param[in] client Client identity.
+        ///
+        /// \param[in] entry Entry identity.
+        void touch(const ClientID client, const EntryID entry);
+
+        /// Release memory charged for entry that was dropped by the cache
+        /// itself.
+        ///
+        /// \param[in] client Client identity.
+        ///
+        /// \param[in] entry Entry identity.
+        void release(const ClientID client, const EntryID entry);
+
+    private:
+        class Impl;
+
+        std::unique_ptr<Impl> pImpl_;
+    };
+
+    /// Map from keys to lazily computed values that are retained subject
+    /// to an ECLMemoryBudget.
+    ///
+    /// Values are shared, immutable objects.  Eviction removes the cache's
+    /// reference only, so values remain valid for as long as a caller
+    /// holds on to them.  All member functions are thread-safe.
+    ///
+    /// \tparam Key Key type.  Must be less-than comparable.
+    ///
+    /// \tparam Value Cached value type.
+    template <class Key, class Value>
+    class ECLBudgetedCache
+    {
+    public:
+        /// Function that reports the memory size of a value in bytes.
+        using SizeFunction = std::function<std::size_t(const Value&)>;
+
+        /// Constructor.
+        ///
+        /// \param[in] name Cache name used in budget reports.
+        ///
+        /// \param[in] size Memory size of values.
+        ///
+        /// \param[in] budget Memory budget.  Must outlive the cache.
+        ECLBudgetedCache(std::string      name,
+                         SizeFunction     size,
+                         ECLMemoryBudget& budget =
+                             ECLMemoryBudget::instance())
+            : size_  (std::move(size))
+            , budget_(budget)
+            , state_ (std::make_shared<State>())
+        {
+            auto state = std::weak_ptr<State>(this->state_);
+
+            this->client_ = this->budget_.registerClient(std::move(name),
+                [state](const ECLMemoryBudget::EntryID entry)
+            {
+                if (auto s = state.lock()) {
+                    s->erase(entry);
+                }
+            });
+        }
+
+        /// Destructor.  Releases all entries.
+        ~ECLBudgetedCache()
+        {
+            this->budget_.unregisterClient(this->client_);
+        }
+
+        /// Disabled copy constructor.
+        ECLBudgetedCache(const ECLBudgetedCache&) = delete;
+
+        /// Disabled assignment operator.
+        ECLBudgetedCache& operator=(const ECLBudgetedCache&) = delete;
+
+        /// Whether or not the budget currently permits caching.  Callers
+        /// may bypass the cache entirely if not.
+        bool enabled() const
+        {
+            return this->budget_.limit() > 0;
+        }
+
+        /// Retrieve value, computing it if not currently cached.
+        ///
+        /// \param[in] key Key.
+        ///
+        /// \param[in] compute Function that computes the value.  Invoked
+        ///    as \code compute() \endcode without any locks held.
+        ///
+        /// \return Value associated to \p key.
+        template <class Compute>
+        std::shared_ptr<const Value>
+        get(const Key& key, Compute&& compute)
+        {
+            auto value = std::shared_ptr<const Value>{};
+            auto entry = ECLMemoryBudget::EntryID{0};
+
+            {
+                std::lock_guard<std::mutex> guard(this->state_->lock);
+
+                auto i = this->state_->items.find(key);
+                if (i != this->state_->items.end()) {
+                    value = i->second.value;
+                    entry = i->second.entry;
+
+                    this->state_->hits += 1;
+                }
+                else {
+                    this->state_->misses += 1;
+                }
+            }
+
+            if (value != nullptr) {
+                // Outside cache lock.  Budget may call evictor.
+                this->budget_.touch(this->client_, entry);
+
+                return value;
+            }
+
+            value = std::make_shared<const Value>(compute());
+            const auto bytes = this->size_(*value);
+
+            {
+                std::lock_guard<std::mutex> guard(this->state_->lock);
+
+                auto& item = this->state_->items[key];
+
+                if (item.value != nullptr) {
+                    // Computed concurrently by another thread.
+                    return item.value;
+                }
+
+                entry = ++this->state_->nextEntry;
+
+                item.value = value;
+                item.entry = entry;
+
+                this->state_->keys[entry] = key;
+            }
+
+            if (! this->budget_.charge(this->client_, entry, bytes)) {
+                this->state_->erase(entry);
+            }
+
+            return value;
+        }
+
+        /// Drop all entries.
+        void clear()
+        {
+            auto entries = std::vector<ECLMemoryBudget::EntryID>{};
+            {
+                std::lock_guard<std::mutex> guard(this->state_->lock);
+
+                for (const auto& k : this->state_->keys) {
+                    entries.push_back(k.first);
+                }
+
+                this->state_->items.clear();
+                this->state_->keys.clear();
+            }
+
+            for (const auto& entry : entries) {
+                this->budget_.release(this->client_, entry);
+            }
+        }
+
+        /// Number of get() requests served from the cache.
+        std::size_t hits() const
+        {
+            std::lock_guard<std::mutex> guard(this->state_->lock);
+
+            return this->state_->hits;
+        }
+
+        /// Number of get() requests that computed the value.
+        std::size_t misses() const
+        {
+            std::lock_guard<std::mutex> guard(this->state_->lock);
+
+            return this->state_->misses;
+        }
+
+    private:
+        struct Item
+        {
+            std::shared_ptr<const Value> value;
+            ECLMemoryBudget::EntryID     entry{0};
+        };
+
+        /// Cache contents.  Shared with eviction callback so that the
+        /// budget never calls into a destroyed cache.
+        struct State
+        {
+            mutable std::mutex lock;
+
+            std::map<Key, Item>                     items;
+            std::map<ECLMemoryBudget::EntryID, Key> keys;
+
+            ECLMemoryBudget::EntryID nextEntry{0};
+
+            std::size_t hits{0};
+            std::size_t misses{0};
+
+            void erase(const ECLMemoryBudget::EntryID entry)
+            {
+                std::lock_guard<std::mutex> guard(this->lock);
+
+                auto k = this->keys.find(entry);
+                if (k == this->keys.end()) {
+                    return;
+                }
+
+                this->items.erase(k->second);
+                this->keys.erase(k);
+            }
+        };
+
+        SizeFunction             size_;
+        ECLMemoryBudget&         budget_;
+        std::shared_ptr<State>   state_;
+        ECLMemoryBudget::ClientID client_{0};
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLMEMORYBUDGET_HEADER_INCLUDED
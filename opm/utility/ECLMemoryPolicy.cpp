@@ -0,0 +1,311 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLMemoryPolicy.hpp>
+
+#include <opm/utility/ECLExecutor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/// \file
+///
+/// Implementation of large array allocation policy.
+
+namespace {
+    /// Size of bookkeeping area in front of every block.  Holds the
+    /// total length of the underlying mapping (zero for heap blocks) and
+    /// preserves alignment of the user part.
+    const auto headerSize = std::size_t{64};
+
+    std::size_t& mappedLength(void* block)
+    {
+        return *static_cast<std::size_t*>(block);
+    }
+
+    const auto hugePageSize = std::size_t(1) << 21;
+
+    std::mutex& stateLock()
+    {
+        static std::mutex lock;
+
+        return lock;
+    }
+
+    Opm::ECLMemory::Policy& currentPolicy()
+    {
+        static Opm::ECLMemory::Policy policy;
+
+        return policy;
+    }
+
+    Opm::ECLMemory::Statistics& currentStatistics()
+    {
+        static Opm::ECLMemory::Statistics stats;
+
+        return stats;
+    }
+
+    /// Bit mask of online NUMA nodes.  Empty if not available.
+    std::vector<unsigned long> onlineNodes()
+    {
+        auto mask = std::vector<unsigned long>{};
+
+        std::ifstream is("/sys/devices/system/node/online");
+        auto list = std::string{};
+
+        if (! std::getline(is, list)) {
+            return mask;
+        }
+
+        // Format: "0", "0-1" or "0-3,8-11".
+        const auto bits = 8 * sizeof(unsigned long);
+        auto       pos  = std::string::size_type{0};
+
+        while (pos < list.size()) {
+            auto end = list.find(',', pos);
+            if (end == std::string::npos) { end = list.size(); }
+
+            const auto range = list.substr(pos, end - pos);
+            const auto dash  = range.find('-');
+
+            const auto lo = std::stoul(range.substr(0, dash));
+            const auto hi = (dash == std::string::npos)
+                ? lo : std::stoul(range.substr(dash + 1));
+
+            for (auto node = lo; node <= hi; ++node) {
+                if (mask.size() <= node / bits) {
+                    mask.resize(node/bits + 1, 0);
+                }
+
+                mask[node / bits] |= 1ul << (node % bits);
+            }
+
+            pos = end + 1;
+        }
+
+        return mask;
+    }
+
+    bool interleave(void* addr, const std::size_t len)
+    {
+#if defined(SYS_mbind)
+        static const auto nodes = onlineNodes();
+
+        if (nodes.empty()) {
+            return false;
+        }
+
+        const int MPOL_INTERLEAVE_ = 3;
+        const auto maxnode = 8 * sizeof(unsigned long) * nodes.size() + 1;
+
+        return ::syscall(SYS_mbind, addr, len, MPOL_INTERLEAVE_,
+                         nodes.data(), maxnode, 0) == 0;
+#else
+        static_cast<void>(addr);
+        static_cast<void>(len);
+
+        return false;
+#endif
+    }
+
+    /// Zero-fill block in parallel over the same element ranges as the
+    /// kernel loops, so that pages are placed on the nodes of the threads
+    /// that are likely to process them.  Likely, but not certain: the
+    /// executor may assign a range to different threads in this loop and
+    /// in the kernel loop (e.g., through work stealing).  Pages that
+    /// straddle range boundaries go to whichever thread writes first.
+    void firstTouch(void*             addr,
+                    const std::size_t len,
+                    const std::size_t elementSize,
+                    const std::size_t grain)
+    {
+        const auto esz = std::max(elementSize, std::size_t{1});
+        const auto nel = (len + esz - 1) / esz;
+
+        auto* base = static_cast<char*>(addr);
+
+        Opm::ECLExecution::parallelFor(nel, std::max(grain, std::size_t{1}),
+            [base, len, esz]
+            (const std::size_t begin, const std::size_t end)
+        {
+            const auto b = begin * esz;
+            const auto e = std::min(end * esz, len);
+
+            std::memset(base + b, 0, e - b);
+        });
+    }
+
+    /// Map large block according to policy.  Null if mapping fails.
+    void* mapBlock(const std::size_t              bytes,
+                   const Opm::ECLMemory::Policy&  policy,
+                   Opm::ECLMemory::Statistics&    stats)
+    {
+        using Opm::ECLMemory::HugePages;
+        using Opm::ECLMemory::Placement;
+
+        auto len  = bytes;
+        auto* ptr = MAP_FAILED;
+
+        if (policy.hugePages == HugePages::Explicit) {
+#if defined(MAP_HUGETLB)
+            len = ((bytes + hugePageSize - 1) / hugePageSize) * hugePageSize;
+
+            ptr = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+            if (ptr == MAP_FAILED) {
+                len = bytes;
+                stats.fallbacks += 1;
+            }
+            else {
+                stats.hugePageBytes += len;
+            }
+        }
+
+        if (ptr == MAP_FAILED) {
+            ptr = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (ptr == MAP_FAILED) {
+                return nullptr;
+            }
+
+            if (policy.hugePages == HugePages::Transparent) {
+#if defined(MADV_HUGEPAGE)
+                if (::madvise(ptr, len, MADV_HUGEPAGE) == 0) {
+                    stats.hugePageBytes += len;
+                }
+                else {
+                    stats.fallbacks += 1;
+                }
+#else
+                stats.fallbacks += 1;
+#endif
+            }
+        }
+
+        if (policy.placement == Placement::Interleave) {
+            if (interleave(ptr, len)) {
+                stats.interleavedBytes += len;
+            }
+            else {
+                stats.fallbacks += 1;
+            }
+        }
+
+        mappedLength(ptr) = len;
+
+        stats.largeAllocations += 1;
+        stats.largeBytes       += len;
+
+        return ptr;
+    }
+} // Anonymous namespace
+
+void Opm::ECLMemory::setPolicy(const Policy& policy)
+{
+    std::lock_guard<std::mutex> guard(stateLock());
+
+    currentPolicy() = policy;
+}
+
+Opm::ECLMemory::Policy Opm::ECLMemory::policy()
+{
+    std::lock_guard<std::mutex> guard(stateLock());
+
+    return currentPolicy();
+}
+
+Opm::ECLMemory::Statistics Opm::ECLMemory::statistics()
+{
+    std::lock_guard<std::mutex> guard(stateLock());
+
+    return currentStatistics();
+}
+
+void Opm::ECLMemory::resetStatistics()
+{
+    std::lock_guard<std::mutex> guard(stateLock());
+
+    currentStatistics() = Statistics{};
+}
+
+void* Opm::ECLMemory::allocate(const std::size_t bytes,
+                               const std::size_t elementSize)
+{
+    const auto total = bytes + headerSize;
+    const auto pol   = policy();
+
+    void* block = nullptr;
+
+    if (bytes >= pol.threshold) {
+        std::lock_guard<std::mutex> guard(stateLock());
+
+        block = mapBlock(total, pol, currentStatistics());
+    }
+
+    if (block == nullptr) {
+        block = ::operator new(total);
+        mappedLength(block) = 0;
+    }
+    else if (pol.placement == Placement::FirstTouch) {
+        // Outside lock.  Touching pages runs on the executor's threads.
+        const auto len = mappedLength(block);
+
+        firstTouch(static_cast<char*>(block) + headerSize,
+                   len - headerSize, elementSize, pol.grain);
+
+        std::lock_guard<std::mutex> guard(stateLock());
+        currentStatistics().firstTouchBytes += len;
+    }
+
+    return static_cast<char*>(block) + headerSize;
+}
+
+void Opm::ECLMemory::deallocate(void* p)
+{
+    if (p == nullptr) {
+        return;
+    }
+
+    auto* block = static_cast<char*>(p) - headerSize;
+
+    if (const auto len = mappedLength(block)) {
+        ::munmap(block, len);
+    }
+    else {
+        ::operator delete(block);
+    }
+}
@@ -0,0 +1,196 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLMEMORYPOLICY_HEADER_INCLUDED
+#define OPM_ECLMEMORYPOLICY_HEADER_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+/// \file
+///
+/// Allocation policy for large library arrays.
+///
+/// Arrays that are streamed by parallel kernels are allocated through
+/// ECLLargeArrayAllocator.  Allocations of at least Policy::threshold
+/// bytes are mapped directly from the operating system and may be
+///
+///   - placed by first touch from the threads of the default executor
+///     (ECLExecution), over element ranges of the kernels' grain size,
+///     so that each thread's portion resides on its local NUMA node,
+///   - interleaved page by page across all NUMA nodes, or
+///   - backed by transparent or explicit (hugetlbfs) huge pages.
+///
+/// First touch placement is best effort.  Executors, in particular the
+/// built-in work-stealing pool, do not bind subranges to threads, so the
+/// thread that touches a particular element range is not guaranteed to
+/// be the thread that processes the same range in a later kernel loop.
+/// Use Placement::Interleave for placement that does not depend on
+/// scheduling.
+///
+/// Smaller allocations use the regular heap.  Requested features that the
+/// platform does not support fall back to regular pages and are counted
+/// in Statistics::fallbacks.
+
+namespace Opm {
+
+    namespace ECLMemory {
+
+        /// Page placement of large allocations.
+        enum class Placement {
+            /// Operating system default.  Typically, pages are placed
+            /// on the node of the thread that first writes them, which is
+            /// usually the thread that loads the data.
+            Default,
+
+            /// Zero-fill pages in parallel through the default executor.
+            FirstTouch,
+
+            /// Interleave pages across all online NUMA nodes.
+            Interleave,
+        };
+
+        /// Huge page usage of large allocations.
+        enum class HugePages {
+            /// Regular pages only.
+            None,
+
+            /// Advise the kernel to back the mapping with transparent
+            /// huge pages.
+            Transparent,
+
+            /// Explicit huge pages (MAP_HUGETLB).  Requires preallocated
+            /// huge pages.
+            Explicit,
+        };
+
+        /// Allocation policy.
+        struct Policy {
+            Placement placement{Placement::Default};
+            HugePages hugePages{HugePages::None};
+
+            /// Minimum size, in bytes, of allocations subject to the
+            /// policy.
+            std::size_t threshold{std::size_t(1) << 21};
+
+            /// Number of array elements per first touch subrange.
+            /// Should match the grain of the kernel loops that stream
+            /// the arrays, e.g., the per-connection loop of
+            /// ECLFluxCalc::flux().
+            std::size_t grain{4096};
+        };
+
+        /// Allocation counters.
+        struct Statistics {
+            /// Number of allocations and bytes subject to the policy.
+            std::size_t largeAllocations{0};
+            std::size_t largeBytes{0};
+
+            /// Bytes placed by parallel first touch.
+            std::size_t firstTouchBytes{0};
+
+            /// Bytes interleaved across NUMA nodes.
+            std::size_t interleavedBytes{0};
+
+            /// Bytes backed by, or advised to use, huge pages.
+            std::size_t hugePageBytes{0};
+
+            /// Number of requested features that were unavailable.
+            std::size_t fallbacks{0};
+        };
+
+        /// Install allocation policy.  Affects subsequent allocations
+        /// only.
+        void setPolicy(const Policy& policy);
+
+        /// Retrieve current allocation policy.
+        Policy policy();
+
+        /// Retrieve allocation counters accumulated since program start
+        /// or the most recent call to resetStatistics().
+        Statistics statistics();
+
+        /// Reset allocation counters.
+        void resetStatistics();
+
+        /// Allocate memory block according to current policy.
+        ///
+        /// \param[in] bytes Size of memory block.
+        ///
+        /// \param[in] elementSize Size of each array element.  First
+        ///    touch partitions the block into ranges of Policy::grain
+        ///    elements.
+        ///
+        /// \return Memory block aligned for any fundamental type.
+        void* allocate(const std::size_t bytes,
+                       const std::size_t elementSize = 1);
+
+        /// Release memory block obtained from allocate().
+        ///
+        /// \param[in] p Memory block.  Null is ignored.
+        void deallocate(void* p);
+
+    } // namespace ECLMemory
+
+    /// Standard allocator that obtains memory through ECLMemory.
+    template <typename T>
+    class ECLLargeArrayAllocator
+    {
+    public:
+        using value_type = T;
+
+        ECLLargeArrayAllocator() = default;
+
+        template <typename U>
+        ECLLargeArrayAllocator(const ECLLargeArrayAllocator<U>&)
+        {}
+
+        T* allocate(const std::size_t n)
+        {
+            return static_cast<T*>
+                (ECLMemory::allocate(n * sizeof(T), sizeof(T)));
+        }
+
+        void deallocate(T* p, const std::size_t)
+        {
+            ECLMemory::deallocate(p);
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(const ECLLargeArrayAllocator<T>&,
+                    const ECLLargeArrayAllocator<U>&)
+    {
+        return true;
+    }
+
+    template <typename T, typename U>
+    bool operator!=(const ECLLargeArrayAllocator<T>&,
+                    const ECLLargeArrayAllocator<U>&)
+    {
+        return false;
+    }
+
+    /// Convenience alias for vectors allocated through ECLMemory.
+    template <typename T>
+    using ECLLargeArray = std::vector<T, ECLLargeArrayAllocator<T>>;
+
+} // namespace Opm
+
+#endif // OPM_ECLMEMORYPOLICY_HEADER_INCLUDED
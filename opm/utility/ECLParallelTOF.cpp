@@ -0,0 +1,1124 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLParallelTOF.hpp>
+
+#include <opm/utility/ECLExecutor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// \file
+///
+/// Implementation of \c ECLParallelTOF interface.
+
+namespace {
+    /// Minimum number of components per parallel subrange.  Levels with
+    /// fewer components are solved in the calling thread.
+    const std::size_t levelGrain = 256;
+
+    /// Adjacency lists in compressed sparse row format.
+    struct Adjacency
+    {
+        /// Start of each cell's neighbours.  Size number of cells + 1.
+        std::vector<std::size_t> start;
+
+        /// Neighbour cells.
+        std::vector<int> cell;
+
+        /// Magnitude of flux between cell and neighbour.
+        std::vector<double> flux;
+    };
+
+    /// Directed flux graph.
+    struct UpwindGraph
+    {
+        /// Downstream neighbours of each cell.
+        Adjacency down;
+
+        /// Upstream neighbours of each cell.
+        Adjacency up;
+
+        /// Total inter-cell influx of each cell.
+        std::vector<double> influx;
+    };
+
+    /// Strongly connected components in topological order, i.e., each
+    /// component is downstream of all components upstream of it.
+    struct Components
+    {
+        /// Start of each component's cells.  Size number of components
+        /// + 1.
+        std::vector<std::size_t> start;
+
+        /// Cells of each component.
+        std::vector<int> cells;
+
+        /// Component of each cell.
+        std::vector<std::size_t> id;
+    };
+
+    /// Components grouped by level.
+    struct Schedule
+    {
+        /// Start of each level's components.  Size number of levels + 1.
+        std::vector<std::size_t> start;
+
+        /// Components of each level.
+        std::vector<std::size_t> component;
+    };
+
+    void checkSize(const std::size_t  actual,
+                   const std::size_t  expected,
+                   const std::string& what)
+    {
+        if (actual != expected) {
+            std::ostringstream os;
+
+            os << what << " Size (" << actual
+               << ") Does Not Match Expected Size (" << expected << ')';
+
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+    void fillAdjacency(const std::size_t              numCells,
+                       const std::vector<int>&        from,
+                       const std::vector<int>&        to,
+                       const std::vector<double>&     flux,
+                       Adjacency&                     adj)
+    {
+        adj.start.assign(numCells + 1, 0);
+
+        for (const auto& c : from) {
+            adj.start[c + 1] += 1;
+        }
+
+        std::partial_sum(adj.start.begin(), adj.start.end(),
+                         adj.start.begin());
+
+        adj.cell.resize(from.size());
+        adj.flux.resize(from.size());
+
+        auto pos = std::vector<std::size_t>(adj.start.begin(),
+                                            adj.start.end() - 1);
+
+        for (auto n = from.size(), e = 0*n; e < n; ++e) {
+            const auto ix = pos[from[e]]++;
+
+            adj.cell[ix] = to[e];
+            adj.flux[ix] = flux[e];
+        }
+    }
+
+    UpwindGraph upwindGraph(const std::size_t          numCells,
+                            const std::vector<int>&    neighbours,
+                            const std::vector<double>& connFlux,
+                            const double               sign)
+    {
+        auto from = std::vector<int>{};
+        auto to   = std::vector<int>{};
+        auto flux = std::vector<double>{};
+
+        auto g = UpwindGraph{};
+        g.influx.assign(numCells, 0.0);
+
+        for (auto n = connFlux.size(), conn = 0*n; conn < n; ++conn) {
+            const auto q = sign * connFlux[conn];
+
+            if (q == 0.0) { continue; }
+
+            const auto fwd = q > 0.0;
+
+            from.push_back(neighbours[2*conn + (fwd ? 0 : 1)]);
+            to  .push_back(neighbours[2*conn + (fwd ? 1 : 0)]);
+            flux.push_back(std::abs(q));
+
+            g.influx[to.back()] += flux.back();
+        }
+
+        fillAdjacency(numCells, from, to, flux, g.down);
+        fillAdjacency(numCells, to, from, flux, g.up);
+
+        return g;
+    }
+
+    /// Tarjan's algorithm with an explicit call stack.  The components are
+    /// emitted downstream first and renumbered into topological order.
+    Components stronglyConnectedComponents(const Adjacency& down)
+    {
+        const auto numCells = down.start.size() - 1;
+
+        struct Frame
+        {
+            int         cell;
+            std::size_t edge;
+        };
+
+        auto index   = std::vector<int>(numCells, -1);
+        auto lowlink = std::vector<int>(numCells, 0);
+        auto onStack = std::vector<bool>(numCells, false);
+
+        auto stack = std::vector<int>{};
+        auto call  = std::vector<Frame>{};
+
+        auto emitted = std::vector<std::size_t>{ 0 };
+        auto cells   = std::vector<int>{};
+        cells.reserve(numCells);
+
+        auto next = 0;
+        auto visit = [&](const int cell)
+        {
+            index[cell] = lowlink[cell] = next++;
+
+            stack.push_back(cell);
+            onStack[cell] = true;
+
+            call.push_back(Frame{ cell, down.start[cell] });
+        };
+
+        for (auto root = 0*numCells; root < numCells; ++root) {
+            if (index[root] >= 0) { continue; }
+
+            visit(static_cast<int>(root));
+
+            while (! call.empty()) {
+                const auto v = call.back().cell;
+
+                if (call.back().edge < down.start[v + 1]) {
+                    const auto w = down.cell[call.back().edge++];
+
+                    if (index[w] < 0) {
+                        visit(w);
+                    }
+                    else if (onStack[w]) {
+                        lowlink[v] = std::min(lowlink[v], index[w]);
+                    }
+
+                    continue;
+                }
+
+                call.pop_back();
+
+                if (! call.empty()) {
+                    const auto u = call.back().cell;
+
+                    lowlink[u] = std::min(lowlink[u], lowlink[v]);
+                }
+
+                if (lowlink[v] == index[v]) {
+                    auto w = -1;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+
+                        onStack[w] = false;
+                        cells.push_back(w);
+                    } while (w != v);
+
+                    emitted.push_back(cells.size());
+                }
+            }
+        }
+
+        // Reverse emission order.
+        const auto ncomp = emitted.size() - 1;
+
+        auto comp = Components{};
+        comp.start.reserve(ncomp + 1);
+        comp.cells.reserve(numCells);
+        comp.id.resize(numCells);
+
+        comp.start.push_back(0);
+        for (auto c = 0*ncomp; c < ncomp; ++c) {
+            const auto e = ncomp - 1 - c;
+
+            for (auto i = emitted[e]; i < emitted[e + 1]; ++i) {
+                comp.id[cells[i]] = c;
+                comp.cells.push_back(cells[i]);
+            }
+
+            comp.start.push_back(comp.cells.size());
+        }
+
+        return comp;
+    }
+
+    /// Group components by level.  The level of a component is one
+    /// greater than the highest level of its upstream components and zero
+    /// for components without upstream neighbours.
+    Schedule levelSchedule(const Components& comp,
+                           const Adjacency&  up)
+    {
+        const auto ncomp = comp.start.size() - 1;
+
+        auto level  = std::vector<std::size_t>(ncomp, 0);
+        auto nlevel = std::size_t{0};
+
+        for (auto c = 0*ncomp; c < ncomp; ++c) {
+            auto lvl = std::size_t{0};
+
+            for (auto i = comp.start[c]; i < comp.start[c + 1]; ++i) {
+                const auto cell = comp.cells[i];
+
+                for (auto j = up.start[cell]; j < up.start[cell + 1]; ++j) {
+                    const auto uc = comp.id[up.cell[j]];
+
+                    if (uc != c) {
+                        assert (uc < c);
+
+                        lvl = std::max(lvl, level[uc] + 1);
+                    }
+                }
+            }
+
+            level[c] = lvl;
+            nlevel   = std::max(nlevel, lvl + 1);
+        }
+
+        auto sched = Schedule{};
+        sched.start.assign(nlevel + 1, 0);
+
+        for (const auto& lvl : level) {
+            sched.start[lvl + 1] += 1;
+        }
+
+        std::partial_sum(sched.start.begin(), sched.start.end(),
+                         sched.start.begin());
+
+        sched.component.resize(ncomp);
+
+        auto pos = std::vector<std::size_t>(sched.start.begin(),
+                                            sched.start.end() - 1);
+
+        for (auto c = 0*ncomp; c < ncomp; ++c) {
+            sched.component[pos[level[c]]++] = c;
+        }
+
+        return sched;
+    }
+
+    /// Solve dense linear system by Gaussian elimination with partial
+    /// pivoting.
+    ///
+    /// \param[in] n Number of rows.
+    ///
+    /// \param[in,out] A Coefficient matrix, row major.  Overwritten.
+    ///
+    /// \param[in,out] b Right-hand side on input, solution on output.
+    void solveDense(const std::size_t    n,
+                    std::vector<double>& A,
+                    std::vector<double>& b)
+    {
+        for (auto k = 0*n; k < n; ++k) {
+            auto p = k;
+            for (auto i = k + 1; i < n; ++i) {
+                if (std::abs(A[i*n + k]) > std::abs(A[p*n + k])) { p = i; }
+            }
+
+            if (A[p*n + k] == 0.0) {
+                throw std::runtime_error {
+                    "Singular Component System in Time-of-Flight Solve"
+                };
+            }
+
+            if (p != k) {
+                std::swap_ranges(A.begin() + k*n, A.begin() + (k + 1)*n,
+                                 A.begin() + p*n);
+                std::swap(b[k], b[p]);
+            }
+
+            for (auto i = k + 1; i < n; ++i) {
+                const auto m = A[i*n + k] / A[k*n + k];
+
+                if (m == 0.0) { continue; }
+
+                for (auto j = k + 1; j < n; ++j) {
+                    A[i*n + j] -= m * A[k*n + j];
+                }
+
+                b[i] -= m * b[k];
+            }
+        }
+
+        for (auto k = n; k-- > 0;) {
+            auto s = b[k];
+
+            for (auto j = k + 1; j < n; ++j) {
+                s -= A[k*n + j] * b[j];
+            }
+
+            b[k] = s / A[k*n + k];
+        }
+    }
+
+    /// Source term of each cell.  Positive inflow in the direction of
+    /// interest.
+    std::vector<double> sourceTerm(const std::vector<double>& inflow,
+                                   const double               sign)
+    {
+        auto source = std::vector<double>(inflow.size(), 0.0);
+
+        for (auto n = inflow.size(), i = 0*n; i < n; ++i) {
+            source[i] = std::max(sign * inflow[i], 0.0);
+        }
+
+        return source;
+    }
+
+    /// Total influx of cell.  The source term enters with weight two,
+    /// making the time-of-flight of a source cell half its fill time.
+    double totalInflux(const UpwindGraph&         g,
+                       const std::vector<double>& source,
+                       const int                  cell)
+    {
+        return g.influx[cell] + 2.0*source[cell];
+    }
+
+    /// Whether or not time to fill cell exceeds maximum time-of-flight.
+    /// Such cells have zero tracer concentration.
+    ///
+    /// \param[in] q Total influx of cell.
+    ///
+    /// \param[in] pv Pore-volume of cell.
+    ///
+    /// \param[in] maxTOF Maximum time-of-flight.
+    bool capped(const double q, const double pv, const double maxTOF)
+    {
+        return ! (q > 0.0) || (q < pv / maxTOF);
+    }
+
+    /// Solution of individual components.  Writes only to the cells of
+    /// the component being solved, and reads upstream values, so distinct
+    /// components of the same level may be solved concurrently.
+    class ComponentSolver
+    {
+    public:
+        ComponentSolver(const UpwindGraph&                   g,
+                        const std::vector<double>&           pvol,
+                        const std::vector<double>&           source,
+                        const Opm::ECLParallelTOF::Options&  opt,
+                        std::vector<double>&                 tof,
+                        std::vector<double>&                 conc)
+            : g_     (g)
+            , pvol_  (pvol)
+            , source_(source)
+            , opt_   (opt)
+            , tof_   (tof)
+            , conc_  (conc)
+        {}
+
+        /// Solve component of single cell.
+        void solveCell(const int cell);
+
+        /// Solve multi-cell component as dense linear system.
+        ///
+        /// \param[in] cells Cells of component.  Sorted.
+        void solveDirect(const std::vector<int>& cells);
+
+        /// Solve multi-cell component by Gauss-Seidel iteration.
+        ///
+        /// \param[in] cells Cells of component.
+        ///
+        /// \return Whether or not the iteration converged.
+        bool solveIterative(const std::vector<int>& cells);
+
+    private:
+        const UpwindGraph&                  g_;
+        const std::vector<double>&          pvol_;
+        const std::vector<double>&          source_;
+        const Opm::ECLParallelTOF::Options& opt_;
+
+        /// Time-of-flight.
+        std::vector<double>& tof_;
+
+        /// Concentration of tracer released at all sources, i.e., the
+        /// fraction of each cell's influx that is reachable from a source.
+        std::vector<double>& conc_;
+
+        /// Source cell.  Unit tracer concentration.
+        bool isStart(const int cell) const
+        {
+            return this->source_[cell] > 0.0;
+        }
+
+        double totalInflux(const int cell) const
+        {
+            return ::totalInflux(this->g_, this->source_, cell);
+        }
+
+        bool capped(const int cell) const
+        {
+            return ::capped(this->totalInflux(cell), this->pvol_[cell],
+                            this->opt_.maxTOF);
+        }
+
+        void setCapped(const int cell)
+        {
+            this->tof_[cell]  = this->opt_.maxTOF;
+            this->conc_[cell] = 0.0;
+        }
+    };
+
+    void ComponentSolver::solveCell(const int cell)
+    {
+        if (this->capped(cell)) {
+            this->setCapped(cell);
+            return;
+        }
+
+        const auto& up = this->g_.up;
+
+        auto upTOF  = 0.0;
+        auto upConc = 0.0;
+        for (auto i = up.start[cell]; i < up.start[cell + 1]; ++i) {
+            const auto u = up.cell[i];
+            const auto f = up.flux[i];
+
+            upTOF  += this->tof_[u] * this->conc_[u] * f;
+            upConc += this->conc_[u] * f;
+        }
+
+        const auto q = this->totalInflux(cell);
+        const auto c = this->isStart(cell) ? 1.0 : upConc / q;
+
+        this->conc_[cell] = c;
+        this->tof_[cell]  = (c > 0.0)
+            ? (this->pvol_[cell]*c + upTOF) / (q * c)
+            : this->opt_.maxTOF;
+    }
+
+    void ComponentSolver::solveDirect(const std::vector<int>& cells)
+    {
+        const auto n  = cells.size();
+        const auto& up = this->g_.up;
+
+        auto local = [&cells, n](const int cell) -> std::size_t
+        {
+            const auto i = std::lower_bound(cells.begin(), cells.end(), cell);
+
+            return ((i == cells.end()) || (*i != cell))
+                ? n : static_cast<std::size_t>(i - cells.begin());
+        };
+
+        // A component without sources, capped cells or influx from
+        // outside is not reachable from any source and its system is
+        // singular.
+        auto reachable = false;
+        for (auto i = 0*n; (i < n) && ! reachable; ++i) {
+            const auto cell = cells[i];
+
+            reachable = this->isStart(cell) || this->capped(cell);
+
+            for (auto j = up.start[cell]; j < up.start[cell + 1]; ++j) {
+                reachable = reachable || (local(up.cell[j]) == n);
+            }
+        }
+
+        if (! reachable) {
+            for (const auto& cell : cells) { this->setCapped(cell); }
+            return;
+        }
+
+        auto A = std::vector<double>(n * n);
+        auto b = std::vector<double>(n);
+
+        // 1) Tracer concentration:
+        //      q_i c_i - sum_{u in C} f_ui c_u = sum_{u not in C} f_ui c_u
+        for (auto i = 0*n; i < n; ++i) {
+            const auto cell = cells[i];
+            auto* row = &A[i * n];
+
+            if (this->capped(cell) || this->isStart(cell)) {
+                row[i] = 1.0;
+                b[i]   = this->capped(cell) ? 0.0 : 1.0;
+                continue;
+            }
+
+            row[i] = this->totalInflux(cell);
+
+            for (auto j = up.start[cell]; j < up.start[cell + 1]; ++j) {
+                const auto k = local(up.cell[j]);
+
+                if (k < n) { row[k] -= up.flux[j]; }
+                else       { b[i]   += up.flux[j] * this->conc_[up.cell[j]]; }
+            }
+        }
+
+        solveDense(n, A, b);
+
+        const auto c = b;
+
+        // 2) Tracer-weighted time-of-flight m = tof * c:
+        //      q_i m_i - sum_{u in C} f_ui m_u
+        //          = pv_i c_i + sum_{u not in C} f_ui m_u
+        std::fill(A.begin(), A.end(), 0.0);
+
+        for (auto i = 0*n; i < n; ++i) {
+            const auto cell = cells[i];
+            auto* row = &A[i * n];
+
+            if (this->capped(cell)) {
+                row[i] = 1.0;
+                b[i]   = 0.0;
+                continue;
+            }
+
+            row[i] = this->totalInflux(cell);
+            b[i]   = this->pvol_[cell] * c[i];
+
+            for (auto j = up.start[cell]; j < up.start[cell + 1]; ++j) {
+                const auto u = up.cell[j];
+                const auto k = local(u);
+
+                if (k < n) { row[k] -= up.flux[j]; }
+                else {
+                    b[i] += up.flux[j] * this->tof_[u] * this->conc_[u];
+                }
+            }
+        }
+
+        solveDense(n, A, b);
+
+        for (auto i = 0*n; i < n; ++i) {
+            const auto cell = cells[i];
+
+            if (this->capped(cell) || ! (c[i] > 0.0)) {
+                this->setCapped(cell);
+                continue;
+            }
+
+            this->conc_[cell] = c[i];
+            this->tof_[cell]  = b[i] / c[i];
+        }
+    }
+
+    bool ComponentSolver::solveIterative(const std::vector<int>& cells)
+    {
+        const auto tol = this->opt_.tolerance;
+
+        for (auto it = 0*this->opt_.maxIterations;
+             it < this->opt_.maxIterations; ++it)
+        {
+            auto converged = true;
+
+            for (const auto& cell : cells) {
+                const auto t = this->tof_[cell];
+                const auto c = this->conc_[cell];
+
+                this->solveCell(cell);
+
+                converged = converged
+                    && ! (std::abs(this->tof_ [cell] - t) >
+                          tol * std::abs(this->tof_ [cell]))
+                    && ! (std::abs(this->conc_[cell] - c) >
+                          tol * std::abs(this->conc_[cell]));
+            }
+
+            if (converged) { return true; }
+        }
+
+        return false;
+    }
+
+    /// Propagation of a block of tracers through the upwind graph.  Each
+    /// cell holds one concentration per lane, i.e., per start set, in a
+    /// contiguous array of fixed size so the lane loops vectorise.  Only
+    /// cells reachable from the block's start cells are visited.
+    template <std::size_t Lanes>
+    class TracerBlock
+    {
+    public:
+        using SparseTracer = Opm::ECLParallelTOF::SparseTracer;
+
+        TracerBlock(const UpwindGraph&                  g,
+                    const Components&                   comp,
+                    const std::vector<double>&          q,
+                    const std::vector<bool>&            capped,
+                    const Opm::ECLParallelTOF::Options& opt)
+            : g_     (g)
+            , comp_  (comp)
+            , q_     (q)
+            , capped_(capped)
+            , opt_   (opt)
+            , slot_  (q.size(), -1)
+        {}
+
+        /// Solve tracers of single block of start sets.
+        ///
+        /// \param[in] startSets Start cells of each tracer.
+        ///
+        /// \param[in] first First start set of block.
+        ///
+        /// \param[in] n Number of start sets in block.  At most \c
+        ///    Lanes.
+        ///
+        /// \param[out] tracers Concentration of each tracer.  Elements
+        ///    \code [first .. first + n) \endcode assigned.
+        void solve(const std::vector<std::vector<int>>& startSets,
+                   const std::size_t                    first,
+                   const std::size_t                    n,
+                   std::vector<SparseTracer>&           tracers);
+
+    private:
+        const UpwindGraph&                  g_;
+        const Components&                   comp_;
+        const std::vector<double>&          q_;
+        const std::vector<bool>&            capped_;
+        const Opm::ECLParallelTOF::Options& opt_;
+
+        /// Position of each cell in touched_.  Negative one (-1) for
+        /// cells not reached by current block.
+        std::vector<int> slot_;
+
+        /// Cells reached by current block.
+        std::vector<int> touched_;
+
+        /// Bit mask of lanes for which each touched cell is a start cell.
+        std::vector<unsigned int> start_;
+
+        /// Concentrations.  Lanes of touched cell \c k at offset \code
+        /// k * Lanes \endcode.
+        std::vector<double> conc_;
+
+        void touch(const int cell)
+        {
+            if (this->slot_[cell] < 0) {
+                this->slot_[cell] = static_cast<int>(this->touched_.size());
+
+                this->touched_.push_back(cell);
+                this->start_  .push_back(0);
+            }
+        }
+
+        /// Update concentrations of single cell from its upstream
+        /// neighbours.
+        ///
+        /// \return Largest change in concentration across all lanes.
+        double update(const int cell);
+    };
+
+    template <std::size_t Lanes>
+    double TracerBlock<Lanes>::update(const int cell)
+    {
+        const auto& up = this->g_.up;
+        const auto  s  = static_cast<std::size_t>(this->slot_[cell]);
+
+        double c[Lanes] = {};
+
+        if (! this->capped_[cell]) {
+            for (auto j = up.start[cell]; j < up.start[cell + 1]; ++j) {
+                const auto su = this->slot_[up.cell[j]];
+
+                if (su < 0) { continue; }
+
+                const auto  f  = up.flux[j];
+                const auto* cu = &this->conc_[su * Lanes];
+
+                for (auto l = 0*Lanes; l < Lanes; ++l) {
+                    c[l] += f * cu[l];
+                }
+            }
+
+            const auto q    = this->q_[cell];
+            const auto mask = this->start_[s];
+
+            for (auto l = 0*Lanes; l < Lanes; ++l) {
+                c[l] = ((mask >> l) & 1u) ? 1.0 : c[l] / q;
+            }
+        }
+
+        auto* conc   = &this->conc_[s * Lanes];
+        auto  change = 0.0;
+
+        for (auto l = 0*Lanes; l < Lanes; ++l) {
+            change  = std::max(change, std::abs(c[l] - conc[l]));
+            conc[l] = c[l];
+        }
+
+        return change;
+    }
+
+    template <std::size_t Lanes>
+    void TracerBlock<Lanes>::
+    solve(const std::vector<std::vector<int>>& startSets,
+          const std::size_t                    first,
+          const std::size_t                    n,
+          std::vector<SparseTracer>&           tracers)
+    {
+        assert (n <= Lanes);
+
+        for (auto l = 0*n; l < n; ++l) {
+            for (const auto& cell : startSets[first + l]) {
+                this->touch(cell);
+
+                this->start_[this->slot_[cell]] |= 1u << l;
+            }
+        }
+
+        // Cells reachable from start cells.  touched_ doubles as the
+        // breadth-first queue.
+        const auto& down = this->g_.down;
+        for (auto k = 0*this->touched_.size(); k < this->touched_.size(); ++k)
+        {
+            const auto cell = this->touched_[k];
+
+            for (auto j = down.start[cell]; j < down.start[cell + 1]; ++j) {
+                this->touch(down.cell[j]);
+            }
+        }
+
+        this->conc_.assign(this->touched_.size() * Lanes, 0.0);
+
+        // Reached components in topological order.  Components are
+        // either fully reached or not at all.
+        auto comps = std::vector<std::size_t>{};
+        comps.reserve(this->touched_.size());
+        for (const auto& cell : this->touched_) {
+            comps.push_back(this->comp_.id[cell]);
+        }
+
+        std::sort(comps.begin(), comps.end());
+        comps.erase(std::unique(comps.begin(), comps.end()), comps.end());
+
+        for (const auto& c : comps) {
+            const auto cb = this->comp_.start[c];
+            const auto ce = this->comp_.start[c + 1];
+
+            if (ce - cb == 1) {
+                this->update(this->comp_.cells[cb]);
+                continue;
+            }
+
+            for (auto it = 0*this->opt_.maxIterations;
+                 it < this->opt_.maxIterations; ++it)
+            {
+                auto change = 0.0;
+                for (auto i = cb; i < ce; ++i) {
+                    change = std::max(change,
+                                      this->update(this->comp_.cells[i]));
+                }
+
+                if (! (change > this->opt_.tolerance)) { break; }
+            }
+        }
+
+        // Extract non-zero concentrations in ascending cell order.
+        auto order = std::vector<std::size_t>(this->touched_.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::sort(order.begin(), order.end(),
+                  [this](const std::size_t i, const std::size_t j)
+                  {
+                      return this->touched_[i] < this->touched_[j];
+                  });
+
+        for (auto l = 0*n; l < n; ++l) {
+            auto& t = tracers[first + l];
+
+            for (const auto& k : order) {
+                const auto c = this->conc_[k*Lanes + l];
+
+                if (c > 0.0) {
+                    t.cells        .push_back(this->touched_[k]);
+                    t.concentration.push_back(c);
+                }
+            }
+        }
+
+        // Reset for next block.
+        for (const auto& cell : this->touched_) {
+            this->slot_[cell] = -1;
+        }
+
+        this->touched_.clear();
+        this->start_  .clear();
+    }
+
+    template <std::size_t Lanes>
+    void solveTracerBlocks(const UpwindGraph&                   g,
+                           const Components&                    comp,
+                           const std::vector<double>&           q,
+                           const std::vector<bool>&             capped,
+                           const Opm::ECLParallelTOF::Options&  opt,
+                           const std::vector<std::vector<int>>& startSets,
+                           const std::size_t                    begin,
+                           const std::size_t                    end,
+                           std::vector<Opm::ECLParallelTOF::SparseTracer>&
+                           tracers)
+    {
+        auto block = TracerBlock<Lanes>{ g, comp, q, capped, opt };
+
+        const auto nsets = startSets.size();
+
+        for (auto b = begin; b < end; ++b) {
+            const auto first = b * Lanes;
+
+            block.solve(startSets, first,
+                        std::min(Lanes, nsets - first), tracers);
+        }
+    }
+} // Anonymous
+
+Opm::ECLParallelTOF::ECLParallelTOF(const std::size_t numCells,
+                                    std::vector<int>  neighbours,
+                                    const Options&    opt)
+    : numCells_  (numCells)
+    , neighbours_(std::move(neighbours))
+    , opt_       (opt)
+{
+    if (this->neighbours_.size() % 2 != 0) {
+        throw std::invalid_argument {
+            "Neighbourship Table Must Contain Pairs of Cells"
+        };
+    }
+
+    for (const auto& cell : this->neighbours_) {
+        if ((cell < 0) || (static_cast<std::size_t>(cell) >= numCells)) {
+            std::ostringstream os;
+
+            os << "Neighbour Cell " << cell
+               << " Outside Valid Range [0.." << numCells << ')';
+
+            throw std::invalid_argument(os.str());
+        }
+    }
+
+    if ((this->opt_.tracerLanes != 8) && (this->opt_.tracerLanes != 16)) {
+        throw std::invalid_argument {
+            "Number of Tracer Lanes Must be 8 or 16"
+        };
+    }
+}
+
+void Opm::ECLParallelTOF::assignPoreVolume(std::vector<double> pvol)
+{
+    checkSize(pvol.size(), this->numCells(), "Pore-Volume");
+
+    this->pvol_ = std::move(pvol);
+}
+
+void Opm::ECLParallelTOF::assignConnectionFlux(std::vector<double> flux)
+{
+    checkSize(flux.size(), this->numConnections(), "Connection Flux");
+
+    this->flux_ = std::move(flux);
+}
+
+void Opm::ECLParallelTOF::assignInflowFlux(std::vector<double> inflow)
+{
+    checkSize(inflow.size(), this->numCells(), "Inflow Flux");
+
+    this->inflow_ = std::move(inflow);
+}
+
+Opm::ECLParallelTOF::Solution
+Opm::ECLParallelTOF::solve(const Direction             dir,
+                           const ECLCancellationToken& token) const
+{
+    this->checkAssigned();
+
+    const auto sign   = (dir == Direction::Forward) ? 1.0 : -1.0;
+    const auto source = sourceTerm(this->inflow_, sign);
+
+    const auto g = upwindGraph(this->numCells(), this->neighbours_,
+                               this->flux_, sign);
+
+    const auto comp  = stronglyConnectedComponents(g.down);
+    const auto sched = levelSchedule(comp, g.up);
+
+    auto sol = Solution{};
+    auto& stats = sol.statistics;
+
+    stats.numLevels     = sched.start.size() - 1;
+    stats.numComponents = comp.start.size() - 1;
+
+    for (auto l = 0*stats.numLevels; l < stats.numLevels; ++l) {
+        stats.widestLevel = std::max(stats.widestLevel,
+                                     sched.start[l + 1] - sched.start[l]);
+    }
+
+    for (auto c = 0*stats.numComponents; c < stats.numComponents; ++c) {
+        const auto size = comp.start[c + 1] - comp.start[c];
+
+        stats.largestComponent = std::max(stats.largestComponent, size);
+
+        if (size > this->opt_.maxDirectSize) {
+            stats.numIterativeSolves += 1;
+        }
+        else if (size > 1) {
+            stats.numDirectSolves += 1;
+        }
+    }
+
+    auto& tof  = sol.timeOfFlight;
+    auto  conc = std::vector<double>(this->numCells(), 0.0);
+    tof.assign(this->numCells(), 0.0);
+
+    auto solver = ComponentSolver {
+        g, this->pvol_, source, this->opt_, tof, conc
+    };
+
+    std::atomic<std::size_t> unconverged{ 0 };
+
+    for (auto l = 0*stats.numLevels; l < stats.numLevels; ++l) {
+        const auto first = sched.start[l];
+        const auto width = sched.start[l + 1] - first;
+
+        auto body = [&](const std::size_t begin, const std::size_t end)
+        {
+            for (auto k = begin; k < end; ++k) {
+                const auto c  = sched.component[first + k];
+                const auto cb = comp.start[c];
+                const auto ce = comp.start[c + 1];
+
+                if (ce - cb == 1) {
+                    solver.solveCell(comp.cells[cb]);
+                    continue;
+                }
+
+                auto cells = std::vector<int>(comp.cells.begin() + cb,
+                                              comp.cells.begin() + ce);
+
+                if (cells.size() <= this->opt_.maxDirectSize) {
+                    std::sort(cells.begin(), cells.end());
+                    solver.solveDirect(cells);
+                }
+                else if (! solver.solveIterative(cells)) {
+                    ++unconverged;
+                }
+            }
+        };
+
+        if (width <= levelGrain) {
+            // Not worth dispatching to the executor.
+            token.throwIfCancelled();
+            body(0, width);
+        }
+        else {
+            ECLExecution::parallelFor(width, levelGrain, token, body);
+        }
+    }
+
+    stats.numUnconverged = unconverged;
+
+    for (auto& t : tof) {
+        t = std::min(t, this->opt_.maxTOF);
+    }
+
+    return sol;
+}
+
+std::vector<Opm::ECLParallelTOF::SparseTracer>
+Opm::ECLParallelTOF::
+solveTracers(const Direction                      dir,
+             const std::vector<std::vector<int>>& startSets,
+             const ECLCancellationToken&          token) const
+{
+    this->checkAssigned();
+
+    for (auto n = startSets.size(), k = 0*n; k < n; ++k) {
+        for (const auto& cell : startSets[k]) {
+            if ((cell < 0) ||
+                (static_cast<std::size_t>(cell) >= this->numCells()))
+            {
+                std::ostringstream os;
+
+                os << "Start Cell " << cell << " of Start Set " << k
+                   << " Outside Valid Range [0.." << this->numCells()
+                   << ')';
+
+                throw std::invalid_argument(os.str());
+            }
+        }
+    }
+
+    const auto sign   = (dir == Direction::Forward) ? 1.0 : -1.0;
+    const auto source = sourceTerm(this->inflow_, sign);
+
+    const auto g = upwindGraph(this->numCells(), this->neighbours_,
+                               this->flux_, sign);
+
+    const auto comp = stronglyConnectedComponents(g.down);
+
+    auto q      = std::vector<double>(this->numCells());
+    auto capped = std::vector<bool>  (this->numCells());
+    for (auto n = this->numCells(), i = 0*n; i < n; ++i) {
+        const auto cell = static_cast<int>(i);
+
+        q[i]      = totalInflux(g, source, cell);
+        capped[i] = ::capped(q[i], this->pvol_[i], this->opt_.maxTOF);
+    }
+
+    auto tracers = std::vector<SparseTracer>(startSets.size());
+
+    const auto lanes  = this->opt_.tracerLanes;
+    const auto nblock = (startSets.size() + lanes - 1) / lanes;
+
+    ECLExecution::parallelFor(nblock, 1, token,
+        [&](const std::size_t begin, const std::size_t end)
+    {
+        if (lanes == 16) {
+            solveTracerBlocks<16>(g, comp, q, capped, this->opt_,
+                                  startSets, begin, end, tracers);
+        }
+        else {
+            solveTracerBlocks<8>(g, comp, q, capped, this->opt_,
+                                 startSets, begin, end, tracers);
+        }
+    });
+
+    return tracers;
+}
+
+std::size_t Opm::ECLParallelTOF::numCells() const
+{
+    return this->numCells_;
+}
+
+std::size_t Opm::ECLParallelTOF::numConnections() const
+{
+    return this->neighbours_.size() / 2;
+}
+
+void Opm::ECLParallelTOF::checkAssigned() const
+{
+    if ((this->pvol_  .size() != this->numCells()) ||
+        (this->flux_  .size() != this->numConnections()) ||
+        (this->inflow_.size() != this->numCells()))
+    {
+        throw std::logic_error {
+            "Pore-Volume, Connection Flux and Inflow Flux "
+            "Must be Assigned Before Solving"
+        };
+    }
+}
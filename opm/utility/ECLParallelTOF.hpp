@@ -0,0 +1,255 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLPARALLELTOF_HEADER_INCLUDED
+#define OPM_ECLPARALLELTOF_HEADER_INCLUDED
+
+#include <opm/utility/ECLCancellation.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/// \file
+///
+/// Level-scheduled, parallel time-of-flight solver operating directly on
+/// the connection graph of an \c ECLGraph.
+
+namespace Opm {
+
+    /// Time-of-flight engine that solves independent parts of the upwind
+    /// graph concurrently.
+    ///
+    /// The connection fluxes define a directed graph whose strongly
+    /// connected components (SCCs) form an acyclic graph.  Each component
+    /// is assigned a level, one greater than the highest level of any
+    /// component immediately upstream of it.  Components on the same level
+    /// do not depend on one another and are solved in parallel through
+    /// ECLExecution::parallelFor(), one level after the other.
+    ///
+    /// Cell-wise update formulae, including time-of-flight capping and the
+    /// treatment of well cells, are those of the serial solver in \code
+    /// FlowDiagnostics::Toolbox \endcode so results agree with the global
+    /// time-of-flight of computeInjectionDiagnostics() and
+    /// computeProductionDiagnostics() to within solver tolerance.
+    /// Components of more than one cell are solved as small dense linear
+    /// systems or, if large, by Gauss-Seidel iteration.
+    class ECLParallelTOF
+    {
+    public:
+        /// Flow direction of time-of-flight.
+        enum class Direction {
+            /// Time since injection.  Sources are cells of positive
+            /// inflow.
+            Forward,
+
+            /// Time until production.  Sources are cells of negative
+            /// inflow (i.e., outflow) and the fluxes are reversed.
+            Reverse,
+        };
+
+        /// Solver parameters.
+        struct Options
+        {
+            /// Default parameters.  Time-of-flight capped at 200 years.
+            Options()
+                : maxTOF        (200.0 * 365.0 * 24.0 * 60.0 * 60.0)
+                , maxDirectSize (64)
+                , tolerance     (1.0e-12)
+                , maxIterations (10000)
+                , tracerLanes   (8)
+            {}
+
+            /// Upper bound on time-of-flight values (seconds).  Also
+            /// reported for cells not reachable from any source.
+            double maxTOF;
+
+            /// Largest component, in number of cells, solved as a dense
+            /// linear system.  Larger components are solved iteratively.
+            std::size_t maxDirectSize;
+
+            /// Relative convergence tolerance of iterative component
+            /// solves.  Absolute for tracer concentrations, which do not
+            /// exceed one.
+            double tolerance;
+
+            /// Maximum number of Gauss-Seidel sweeps per component.
+            std::size_t maxIterations;
+
+            /// Number of start sets propagated together in a single pass
+            /// of solveTracers().  Must be 8 or 16.
+            std::size_t tracerLanes;
+        };
+
+        /// Structure of upwind graph and amount of work of one solve.
+        struct Statistics
+        {
+            /// Number of levels, i.e., sequential parallel loops.
+            std::size_t numLevels{0};
+
+            /// Number of strongly connected components.
+            std::size_t numComponents{0};
+
+            /// Largest number of components on a single level.
+            std::size_t widestLevel{0};
+
+            /// Number of cells in largest component.
+            std::size_t largestComponent{0};
+
+            /// Number of multi-cell components solved as dense systems.
+            std::size_t numDirectSolves{0};
+
+            /// Number of components solved by Gauss-Seidel iteration.
+            std::size_t numIterativeSolves{0};
+
+            /// Number of iteratively solved components that did not reach
+            /// the convergence tolerance.
+            std::size_t numUnconverged{0};
+        };
+
+        /// Result of time-of-flight solve.
+        struct Solution
+        {
+            /// Time-of-flight (seconds) of each cell, capped at
+            /// Options::maxTOF.
+            std::vector<double> timeOfFlight;
+
+            /// Work statistics.
+            Statistics statistics;
+        };
+
+        /// Tracer concentration of a single start set.  Cells not listed
+        /// have zero concentration.
+        struct SparseTracer
+        {
+            /// Cells of non-zero concentration.  Ascending.
+            std::vector<int> cells;
+
+            /// Concentration in each of \c cells.
+            std::vector<double> concentration;
+        };
+
+        /// Constructor.
+        ///
+        /// \param[in] numCells Number of active cells.
+        ///
+        /// \param[in] neighbours Connection graph.  The \c i-th connection
+        ///    is between cells \code neighbours[2*i + 0] \endcode and \code
+        ///    neighbours[2*i + 1] \endcode.  Typically the result of
+        ///    ECLGraph::neighbours().
+        ///
+        /// \param[in] opt Solver parameters.
+        ECLParallelTOF(const std::size_t numCells,
+                       std::vector<int>  neighbours,
+                       const Options&    opt = Options{});
+
+        /// Assign static pore-volumes.
+        ///
+        /// \param[in] pvol Pore-volume of each cell.  Size must equal the
+        ///    number of cells.
+        void assignPoreVolume(std::vector<double> pvol);
+
+        /// Assign total (all phases) connection fluxes.
+        ///
+        /// \param[in] flux Flux on each connection.  Positive values
+        ///    denote flow from the first to the second cell of the
+        ///    connection.  Size must equal the number of connections.
+        void assignConnectionFlux(std::vector<double> flux);
+
+        /// Assign total (all phases) well inflow.
+        ///
+        /// \param[in] inflow Inflow into each cell.  Positive in injection
+        ///    cells and negative in production cells.  Size must equal the
+        ///    number of cells.
+        void assignInflowFlux(std::vector<double> inflow);
+
+        /// Compute time-of-flight from currently assigned fluxes.
+        ///
+        /// \param[in] dir Flow direction.
+        ///
+        /// \param[in] token Cancellation token.  Checked between levels
+        ///    and between subranges of each level.  Throws
+        ///    ECLOperationCancelled once cancelled.
+        ///
+        /// \return Time-of-flight of each cell and work statistics.
+        Solution solve(const Direction             dir,
+                       const ECLCancellationToken& token =
+                           ECLCancellationToken{}) const;
+
+        /// Compute tracer concentrations of multiple start sets (e.g.,
+        /// the completed cells of each well) from currently assigned
+        /// fluxes.
+        ///
+        /// Equivalent to the local solutions of \code
+        /// FlowDiagnostics::Toolbox \endcode, but all start sets share the
+        /// upwind graph and its topological ordering.  The start sets are
+        /// processed in blocks of Options::tracerLanes, with one lane of
+        /// each cell's concentration vector per start set, and each block
+        /// visits only the cells reachable from its start cells.  Blocks
+        /// are solved in parallel.
+        ///
+        /// \param[in] dir Flow direction.  Forward for injector tracers,
+        ///    Reverse for producer tracers.
+        ///
+        /// \param[in] startSets Cells in which each tracer is released at
+        ///    unit concentration.
+        ///
+        /// \param[in] token Cancellation token.  Checked between blocks
+        ///    of start sets.  Throws ECLOperationCancelled once cancelled.
+        ///
+        /// \return Concentration of each tracer.  Same order as \p
+        ///    startSets.
+        std::vector<SparseTracer>
+        solveTracers(const Direction                      dir,
+                     const std::vector<std::vector<int>>& startSets,
+                     const ECLCancellationToken&          token =
+                         ECLCancellationToken{}) const;
+
+        /// Retrieve number of cells.
+        std::size_t numCells() const;
+
+        /// Retrieve number of connections.
+        std::size_t numConnections() const;
+
+    private:
+        /// Number of active cells.
+        std::size_t numCells_;
+
+        /// Connection graph.
+        std::vector<int> neighbours_;
+
+        /// Solver parameters.
+        Options opt_;
+
+        /// Pore-volume of each cell.
+        std::vector<double> pvol_;
+
+        /// Total flux on each connection.
+        std::vector<double> flux_;
+
+        /// Total well inflow into each cell.
+        std::vector<double> inflow_;
+
+        /// Throw \c std::logic_error unless all fluxes and pore-volumes
+        /// have been assigned.
+        void checkAssigned() const;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLPARALLELTOF_HEADER_INCLUDED
@@ -22,9 +22,12 @@
 
 #include <opm/utility/ECLTableInterpolation1D.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <exception>
+#include <limits>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
@@ -64,6 +67,7 @@ namespace Opm { namespace Interp1D { namespace PiecewisePolynomial {
         explicit Linear(Extrapolation&& extrap)
             : extrap_(std::forward<Extrapolation>(extrap))
             , nCols_ (0)
+            , single_(false)
         {}
 
         /// Constructor.
@@ -111,18 +115,81 @@ namespace Opm { namespace Interp1D { namespace PiecewisePolynomial {
                const ValueTransform&              xTransform,
                const std::vector<ValueTransform>& colTransform);
 
+        /// Remove table nodes that are reproduced by linear interpolation
+        /// between the remaining nodes.
+        ///
+        /// A node is redundant if all dependent variates at that node
+        /// match the linear interpolant between the nearest retained
+        /// neighbours to within a relative tolerance.  This includes
+        /// repeated (duplicate) rows and interior nodes of collinear runs.
+        /// End points and discontinuities are always retained, so the
+        /// interpolant's values--including extrapolation--are unchanged.
+        ///
+        /// \param[in] tolerance Relative tolerance, measured against the
+        ///    larger magnitude of the two bracketing ordinates.  Zero (the
+        ///    default) removes only nodes that are reproduced exactly.
+        ///    Negative values disable simplification.
+        ///
+        /// \return Number of removed nodes.
+        std::size_t simplify(const double tolerance = 0.0);
+
+        /// Store ordinates of dependent variates in single precision.
+        ///
+        /// Halves the size of the ordinate table.  Evaluation still
+        /// converts ordinates to double precision and accumulates the
+        /// interpolated values in double precision.  Abscissas are not
+        /// affected, so point classification and saturation end points
+        /// are unchanged.
+        ///
+        /// Tables with ordinates that \c float cannot represent--values
+        /// outside its range or non-zero values that would round to
+        /// zero--retain double precision storage.  This preserves the
+        /// sign of every ordinate and, hence, critical saturations.
+        ///
+        /// \return Rounding error incurred by the conversion.  Empty
+        ///    (zero values) if the table retains its current storage.
+        RoundingError useSinglePrecision();
+
+        /// Whether or not ordinates are stored in single precision.
+        bool singlePrecision() const
+        {
+            return this->single_;
+        }
+
         /// Classify an input point according to the range of the
         /// interpolant's configured independent variate.
         ///
         /// Classification is performed according to the configured policy
-        /// for treating the sort order of the input range.
+        /// for treating the sort order of the input range.  Long tables
+        /// use an Eytzinger-layout search index.
         ///
         /// \param[in] x Input point.
         ///
         /// \return Classification of the input point \p x.
         LocalInterpPoint classifyPoint(const double x) const
         {
-            return LocalInterpPoint::identify(this->x_, x, Ascending_P{});
+            return LocalInterpPoint::identify(this->x_, x, this->search_,
+                                              Ascending_P{});
+        }
+
+        /// Classify an input point according to the range of the
+        /// interpolant's configured independent variate, starting from
+        /// the interval in which the point was previously localized.
+        ///
+        /// \param[in] x Input point.
+        ///
+        /// \param[in,out] hints Interval hint cache for sequence of input
+        ///    points.
+        ///
+        /// \param[in] i Index of \p x in sequence of input points.
+        ///
+        /// \return Classification of the input point \p x.
+        LocalInterpPoint classifyPoint(const double       x,
+                                       IntervalHintCache& hints,
+                                       const std::size_t  i) const
+        {
+            return LocalInterpPoint::identify(this->x_, x, this->search_,
+                                              hints, i, Ascending_P{});
         }
 
         /// Evaluate interpolant of particular dependent variable at
@@ -215,9 +282,20 @@ namespace Opm { namespace Interp1D { namespace PiecewisePolynomial {
 
         /// Ordinates of dependent variates, compressed to valid points of
         /// input range.  Stored with column index (dependent variate ID)
-        /// cycling the most rapidly.
+        /// cycling the most rapidly.  Empty in single precision mode.
         std::vector<double> y_;
 
+        /// Single precision ordinates.  Same layout as \c y_.  Empty
+        /// unless single precision mode is active.
+        std::vector<float> yf_;
+
+        /// Whether or not ordinates are stored in \c yf_.
+        bool single_;
+
+        /// Accelerated search structure for abscissas.  Active only for
+        /// long tables.
+        EytzingerIndex search_;
+
         /// Evaluate interpolant of particular dependent variable at
         /// particular input point.
         ///
@@ -250,6 +328,66 @@ namespace Opm { namespace Interp1D { namespace PiecewisePolynomial {
             return t*yr + (1.0 - t)*yl;
         }
 
+        /// Predicate for whether or not a run of table nodes is reproduced
+        /// by linear interpolation between two other nodes.
+        ///
+        /// \param[in] left Row index of left bracketing node.
+        ///
+        /// \param[in] first Row index of first node in run.
+        ///
+        /// \param[in] last Row index of last node in run.
+        ///
+        /// \param[in] right Row index of right bracketing node.
+        ///
+        /// \param[in] tolerance Relative tolerance.
+        ///
+        /// \return Whether or not all dependent variates in rows \code
+        ///    [first, last] \endcode match the interpolant between rows
+        ///    \p left and \p right.
+        bool reproducible(const std::size_t left,
+                          const std::size_t first,
+                          const std::size_t last,
+                          const std::size_t right,
+                          const double      tolerance) const
+        {
+            const auto xl = this->x_[left];
+            const auto xr = this->x_[right];
+
+            auto same = [tolerance](const double a, const double b,
+                                    const double scale)
+            {
+                return std::abs(a - b) <= tolerance*scale;
+            };
+
+            for (auto row = first; row <= last; ++row) {
+                for (auto col = 0*this->nCols_; col < this->nCols_; ++col) {
+                    const auto yl = this->y(left , col);
+                    const auto yr = this->y(right, col);
+                    const auto yi = this->y(row  , col);
+
+                    const auto scale = std::max(std::abs(yl), std::abs(yr));
+
+                    if (xr == xl) {
+                        // Repeated abscissa.  Node is redundant only if
+                        // all three rows match.
+                        if (! (same(yi, yl, scale) && same(yi, yr, scale))) {
+                            return false;
+                        }
+
+                        continue;
+                    }
+
+                    const auto t = (this->x_[row] - xl) / (xr - xl);
+
+                    if (! same(yi, t*yr + (1.0 - t)*yl, scale)) {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
         /// Retrieve value of ordinate at specified row and column pair.
         ///
         /// \param[in] row Row index.
@@ -263,10 +401,19 @@ namespace Opm { namespace Interp1D { namespace PiecewisePolynomial {
             // Recall: this->y_ stored with column index cycling the most
             // rapidly.
 
+            const auto k = row*this->nCols_ + col;
+
             assert (col < this->nCols_);
-            assert (row*this->nCols_ + col < this->y_.size());
 
-            return this->y_[row*this->nCols_ + col];
+            if (this->single_) {
+                assert (k < this->yf_.size());
+
+                return this->yf_[k];
+            }
+
+            assert (k < this->y_.size());
+
+            return this->y_[k];
         }
     };
 
@@ -281,6 +428,7 @@ namespace Opm { namespace Interp1D { namespace PiecewisePolynomial {
            const std::vector<ValueTransform>& colTransform)
         : extrap_(std::forward<Extrapolation>(extrap))
         , nCols_ (colIt.size())
+        , single_(false)
     {
         // There must be at least one dependent variable/result variable.
         assert (colIt.size() >= 1);
@@ -341,6 +489,105 @@ namespace Opm { namespace Interp1D { namespace PiecewisePolynomial {
                 "No Interpolation Intervals of Non-Zero Size"
             };
         }
+
+        this->search_ = EytzingerIndex(this->x_);
+    }
+
+    template <class Extrapolation, bool IsAscendingRange>
+    std::size_t
+    Linear<Extrapolation, IsAscendingRange>::
+    simplify(const double tolerance)
+    {
+        const auto nRows = this->x_.size();
+
+        if ((tolerance < 0.0) || (nRows < 3)) {
+            return 0;
+        }
+
+        // Greedy pass.  Extend the current run of candidate nodes,
+        // [first, i], for as long as the entire run is reproduced by the
+        // interpolant between the last retained node and node i+1.
+        auto keep  = std::vector<std::size_t>{ 0 };
+        auto first = std::size_t{1};
+
+        for (auto i = first; i + 1 < nRows; ++i) {
+            if (! this->reproducible(keep.back(), first, i, i + 1, tolerance)) {
+                keep.push_back(i);
+                first = i + 1;
+            }
+        }
+
+        keep.push_back(nRows - 1);
+
+        const auto nRemoved = nRows - keep.size();
+        if (nRemoved == 0) {
+            return 0;
+        }
+
+        auto x = std::vector<double>{};  x.reserve(keep.size());
+        auto y = std::vector<double>{};  y.reserve(keep.size() * this->nCols_);
+
+        for (const auto& row : keep) {
+            x.push_back(this->x_[row]);
+
+            for (auto col = 0*this->nCols_; col < this->nCols_; ++col) {
+                y.push_back(this->y(row, col));
+            }
+        }
+
+        this->x_.swap(x);
+
+        if (this->single_) {
+            // Exact.  All retained ordinates originate in yf_.
+            this->yf_.assign(y.begin(), y.end());
+        }
+        else {
+            this->y_.swap(y);
+        }
+
+        this->search_ = EytzingerIndex(this->x_);
+
+        return nRemoved;
+    }
+
+    template <class Extrapolation, bool IsAscendingRange>
+    RoundingError
+    Linear<Extrapolation, IsAscendingRange>::useSinglePrecision()
+    {
+        auto error = RoundingError{};
+
+        if (this->single_) {
+            return error;
+        }
+
+        const auto fmax = std::numeric_limits<float>::max();
+
+        auto yf = std::vector<float>{};  yf.reserve(this->y_.size());
+
+        for (const auto& yi : this->y_) {
+            if (std::isfinite(yi) && (std::abs(yi) > fmax)) {
+                // Not representable.  Keep double precision ordinates.
+                return RoundingError{};
+            }
+
+            yf.push_back(static_cast<float>(yi));
+
+            if ((yi != 0.0) && (yf.back() == 0.0f)) {
+                // Underflow.  Keep double precision ordinates.
+                return RoundingError{};
+            }
+
+            error.update(yi, yf.back());
+        }
+
+        this->yf_.swap(yf);
+
+        // Release double precision storage.
+        std::vector<double>{}.swap(this->y_);
+
+        this->single_ = true;
+
+        return error;
     }
 
 }}} // Opm::Interp1D::PiecewisePolynomial
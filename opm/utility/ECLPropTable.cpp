@@ -26,10 +26,12 @@ Opm::SatFuncInterpolant::SingleTable::
 SingleTable(ElmIt               xBegin,
             ElmIt               xEnd,
             const ConvertUnits& convert,
-            std::vector<ElmIt>& colIt)
+            std::vector<ElmIt>& colIt,
+            const double        simplifyTol)
     : interp_(Extrap{}, xBegin, xEnd, colIt,
               convert.indep, convert.column)
 {
+    this->interp_.simplify(simplifyTol);
 }
 
 std::vector<double>
@@ -48,6 +50,67 @@ interpolate(const ResultColumn&        c,
     return y;
 }
 
+std::vector<std::vector<double>>
+Opm::SatFuncInterpolant::SingleTable::
+interpolate(const std::vector<ResultColumn>& c,
+            const std::vector<double>&       x) const
+{
+    auto y = std::vector<std::vector<double>>(c.size());
+    for (auto& yc : y) { yc.reserve(x.size()); }
+
+    for (const auto& xi : x) {
+        // Classify once, evaluate all requested columns.
+        const auto pt = this->interp_.classifyPoint(xi);
+
+        for (auto n = c.size(), j = 0*n; j < n; ++j) {
+            y[j].push_back(this->interp_.evaluate(c[j].i, pt));
+        }
+    }
+
+    return y;
+}
+
+std::vector<double>
+Opm::SatFuncInterpolant::SingleTable::
+interpolate(const ResultColumn&          c,
+            const std::vector<double>&   x,
+            Interp1D::IntervalHintCache& hints) const
+{
+    auto y = std::vector<double>{};  y.reserve(x.size());
+
+    hints.prepare(x.size());
+
+    for (auto n = x.size(), i = 0*n; i < n; ++i) {
+        const auto pt = this->interp_.classifyPoint(x[i], hints, i);
+
+        y.push_back(this->interp_.evaluate(c.i, pt));
+    }
+
+    return y;
+}
+
+std::vector<std::vector<double>>
+Opm::SatFuncInterpolant::SingleTable::
+interpolate(const std::vector<ResultColumn>& c,
+            const std::vector<double>&       x,
+            Interp1D::IntervalHintCache&     hints) const
+{
+    auto y = std::vector<std::vector<double>>(c.size());
+    for (auto& yc : y) { yc.reserve(x.size()); }
+
+    hints.prepare(x.size());
+
+    for (auto n = x.size(), i = 0*n; i < n; ++i) {
+        const auto pt = this->interp_.classifyPoint(x[i], hints, i);
+
+        for (auto m = c.size(), j = 0*m; j < m; ++j) {
+            y[j].push_back(this->interp_.evaluate(c[j].i, pt));
+        }
+    }
+
+    return y;
+}
+
 double
 Opm::SatFuncInterpolant::SingleTable::connateSat() const
 {
@@ -96,10 +159,17 @@ Opm::SatFuncInterpolant::SingleTable::saturationPoints() const
     return this->interp_.independentVariable();
 }
 
+Opm::Interp1D::RoundingError
+Opm::SatFuncInterpolant::SingleTable::useSinglePrecision()
+{
+    return this->interp_.useSinglePrecision();
+}
+
 // =====================================================================
 
 Opm::SatFuncInterpolant::SatFuncInterpolant(const ECLPropTableRawData& raw,
-                                            const ConvertUnits&        convert)
+                                            const ConvertUnits&        convert,
+                                            const double               simplifyTol)
     : nResCols_(raw.numCols - 1)
 {
     using ElmIt = ::Opm::ECLPropTableRawData::ElementIterator;
@@ -117,11 +187,12 @@ Opm::SatFuncInterpolant::SatFuncInterpolant(const ECLPropTableRawData& raw,
     }
 
     this->table_ = MakeInterpolants<SingleTable>::fromRawData(raw,
-        [&convert](ElmIt xBegin, ElmIt xEnd, std::vector<ElmIt>& colIt)
+        [&convert, simplifyTol]
+        (ElmIt xBegin, ElmIt xEnd, std::vector<ElmIt>& colIt)
     {
         // Note: this constructor needs to advance each 'colIt' across
         // distance(xBegin, xEnd) entries.
-        return SingleTable(xBegin, xEnd, convert, colIt);
+        return SingleTable(xBegin, xEnd, convert, colIt, simplifyTol);
     });
 }
 
@@ -145,6 +216,72 @@ Opm::SatFuncInterpolant::interpolate(const InTable&             t,
     return this->table_[t.i].interpolate(c, x);
 }
 
+std::vector<std::vector<double>>
+Opm::SatFuncInterpolant::interpolate(const InTable&                   t,
+                                     const std::vector<ResultColumn>& c,
+                                     const std::vector<double>&       x) const
+{
+    if (t.i >= this->table_.size()) {
+        throw std::invalid_argument {
+            "Invalid Table ID"
+        };
+    }
+
+    for (const auto& ci : c) {
+        if (ci.i >= this->nResCols_) {
+            throw std::invalid_argument {
+                "Invalid Result Column ID"
+            };
+        }
+    }
+
+    return this->table_[t.i].interpolate(c, x);
+}
+
+std::vector<double>
+Opm::SatFuncInterpolant::interpolate(const InTable&               t,
+                                     const ResultColumn&          c,
+                                     const std::vector<double>&   x,
+                                     Interp1D::IntervalHintCache& hints) const
+{
+    if (t.i >= this->table_.size()) {
+        throw std::invalid_argument {
+            "Invalid Table ID"
+        };
+    }
+
+    if (c.i >= this->nResCols_) {
+        throw std::invalid_argument {
+            "Invalid Result Column ID"
+        };
+    }
+
+    return this->table_[t.i].interpolate(c, x, hints);
+}
+
+std::vector<std::vector<double>>
+Opm::SatFuncInterpolant::interpolate(const InTable&                   t,
+                                     const std::vector<ResultColumn>& c,
+                                     const std::vector<double>&       x,
+                                     Interp1D::IntervalHintCache&     hints) const
+{
+    if (t.i >= this->table_.size()) {
+        throw std::invalid_argument {
+            "Invalid Table ID"
+        };
+    }
+
+    for (const auto& ci : c) {
+        if (ci.i >= this->nResCols_) {
+            throw std::invalid_argument {
+                "Invalid Result Column ID"
+            };
+        }
+    }
+
+    return this->table_[t.i].interpolate(c, x, hints);
+}
+
 std::vector<double>
 Opm::SatFuncInterpolant::connateSat() const
 {
@@ -195,3 +332,15 @@ Opm::SatFuncInterpolant::saturationPoints(const InTable& t) const
 
     return this->table_[t.i].saturationPoints();
 }
+
+Opm::Interp1D::RoundingError
+Opm::SatFuncInterpolant::useSinglePrecision()
+{
+    auto error = Interp1D::RoundingError{};
+
+    for (auto& table : this->table_) {
+        error += table.useSinglePrecision();
+    }
+
+    return error;
+}
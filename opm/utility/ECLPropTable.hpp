@@ -186,8 +186,16 @@ namespace Opm {
         /// \param[in] convert Unit conversion support.  Mostly applicable
         ///    to capillary pressure.  Assumed to convert raw table data to
         ///    strict SI unit conventions.
+        ///
+        /// \param[in] simplifyTol Relative tolerance for removing table
+        ///    nodes that are reproduced by linear interpolation between
+        ///    their neighbours (duplicate rows, interior points of
+        ///    collinear runs).  Negative (the default) retains all nodes,
+        ///    so curves and values are those of the input table.  Zero
+        ///    removes only nodes that are reproduced exactly.
         SatFuncInterpolant(const ECLPropTableRawData& raw,
-                           const ConvertUnits&        convert);
+                           const ConvertUnits&        convert,
+                           const double               simplifyTol = -1.0);
 
         /// Wrapper type to disambiguate API usage.  Represents a table ID.
         struct InTable {
@@ -216,6 +224,69 @@ namespace Opm {
                     const ResultColumn&        c,
                     const std::vector<double>& x) const;
 
+        /// Evaluate multiple result columns of 1D interpolant in sequence
+        /// of points.
+        ///
+        /// Classifies each point \code x[i] \endcode against the table's
+        /// independent variate only once and reuses that classification
+        /// for all requested columns.  Typically used to compute relative
+        /// permeability and capillary pressure in a single pass.
+        ///
+        /// \param[in] t ID of sub-table of interpolant.
+        ///
+        /// \param[in] c IDs of result columns/dependent variables.
+        ///
+        /// \param[in] x Points at which to evaluate interpolant.
+        ///
+        /// \return Function values of dependent variables \p c evaluated
+        ///    at points \p x in table \p t.  In particular, the \c j-th
+        ///    element of the result holds the values of column \code c[j]
+        ///    \endcode.
+        std::vector<std::vector<double>>
+        interpolate(const InTable&                   t,
+                    const std::vector<ResultColumn>& c,
+                    const std::vector<double>&       x) const;
+
+        /// Evaluate 1D interpolant in sequence of points using warm-start
+        /// interval hints.
+        ///
+        /// \param[in] t ID of sub-table of interpolant.
+        ///
+        /// \param[in] c ID of result column/dependent variable.
+        ///
+        /// \param[in] x Points at which to evaluate interpolant.
+        ///
+        /// \param[in,out] hints Interval hints for the sequence \p x.
+        ///    Typically retained by the caller between calls with the same
+        ///    set of cells.  Reset if its size does not match \p x.
+        ///
+        /// \return Function values of dependent variable \p c evaluated at
+        ///    points \p x in table \p t.
+        std::vector<double>
+        interpolate(const InTable&               t,
+                    const ResultColumn&          c,
+                    const std::vector<double>&   x,
+                    Interp1D::IntervalHintCache& hints) const;
+
+        /// Evaluate multiple result columns of 1D interpolant in sequence
+        /// of points using a single, warm-started classification pass.
+        ///
+        /// \param[in] t ID of sub-table of interpolant.
+        ///
+        /// \param[in] c IDs of result columns/dependent variables.
+        ///
+        /// \param[in] x Points at which to evaluate interpolant.
+        ///
+        /// \param[in,out] hints Interval hints for the sequence \p x.
+        ///
+        /// \return Function values of dependent variables \p c evaluated
+        ///    at points \p x in table \p t.  One vector per column.
+        std::vector<std::vector<double>>
+        interpolate(const InTable&                   t,
+                    const std::vector<ResultColumn>& c,
+                    const std::vector<double>&       x,
+                    Interp1D::IntervalHintCache&     hints) const;
+
         /// Retrieve connate saturation from all tables.
         std::vector<double> connateSat() const;
 
@@ -235,6 +306,17 @@ namespace Opm {
         ///    to particular saturation region.
         const std::vector<double>& saturationPoints(const InTable& t) const;
 
+        /// Store ordinates of all tables in single precision.
+        ///
+        /// Halves the working set of the result columns, allowing more
+        /// saturation regions to remain cache resident during per-cell
+        /// evaluation.  Interpolation still accumulates in double
+        /// precision and saturation points are unaffected.
+        ///
+        /// \return Rounding error of all converted tables relative to the
+        ///    original double precision tables.
+        Interp1D::RoundingError useSinglePrecision();
+
     private:
         /// Single tabulated 1D interpolant.
         class SingleTable
@@ -260,10 +342,14 @@ namespace Opm {
             ///    advanced across all rows of the SingleTable (including
             ///    sentinel/invalid nodes) which makes the pointers valid
             ///    for the next table if relevant (and called in a loop).
+            ///
+            /// \param[in] simplifyTol Relative tolerance for removing
+            ///    redundant table nodes.  Negative to retain all nodes.
             SingleTable(ElmIt               xBegin,
                         ElmIt               xEnd,
                         const ConvertUnits& convert,
-                        std::vector<ElmIt>& colIt);
+                        std::vector<ElmIt>& colIt,
+                        const double        simplifyTol);
 
             /// Evaluate 1D interpolant in sequence of points.
             ///
@@ -279,6 +365,52 @@ namespace Opm {
             interpolate(const ResultColumn&        c,
                         const std::vector<double>& x) const;
 
+            /// Evaluate multiple result columns of 1D interpolant in
+            /// sequence of points using a single classification pass.
+            ///
+            /// \param[in] c IDs of result columns/dependent variables.
+            ///
+            /// \param[in] x Points at which to evaluate interpolant.
+            ///
+            /// \return Function values of dependent variables \p c
+            ///    evaluated at points \p x.  One vector per column.
+            std::vector<std::vector<double>>
+            interpolate(const std::vector<ResultColumn>& c,
+                        const std::vector<double>&       x) const;
+
+            /// Evaluate 1D interpolant in sequence of points using
+            /// warm-start interval hints.
+            ///
+            /// \param[in] c ID of result column/dependent variable.
+            ///
+            /// \param[in] x Points at which to evaluate interpolant.
+            ///
+            /// \param[in,out] hints Interval hints for the sequence \p x.
+            ///
+            /// \return Function values of dependent variable \p c
+            ///    evaluated at points \p x.
+            std::vector<double>
+            interpolate(const ResultColumn&          c,
+                        const std::vector<double>&   x,
+                        Interp1D::IntervalHintCache& hints) const;
+
+            /// Evaluate multiple result columns of 1D interpolant in
+            /// sequence of points using a single, warm-started
+            /// classification pass.
+            ///
+            /// \param[in] c IDs of result columns/dependent variables.
+            ///
+            /// \param[in] x Points at which to evaluate interpolant.
+            ///
+            /// \param[in,out] hints Interval hints for the sequence \p x.
+            ///
+            /// \return Function values of dependent variables \p c
+            ///    evaluated at points \p x.  One vector per column.
+            std::vector<std::vector<double>>
+            interpolate(const std::vector<ResultColumn>& c,
+                        const std::vector<double>&       x,
+                        Interp1D::IntervalHintCache&     hints) const;
+
             /// Retrieve connate saturation in table.
             double connateSat() const;
 
@@ -292,6 +424,11 @@ namespace Opm {
             /// Retrieve unscaled sample points of independent variable.
             const std::vector<double>& saturationPoints() const;
 
+            /// Store ordinates in single precision.
+            ///
+            /// \return Rounding error incurred by the conversion.
+            Interp1D::RoundingError useSinglePrecision();
+
         private:
             /// Extrapolation policy for property evaluator/interpolant.
             using Extrap = ::Opm::Interp1D::PiecewisePolynomial::
@@ -232,13 +232,38 @@ recipFvfGasViscDerivVapOil(const ::Opm::ECLUnits::UnitSystem& usys)
 
 // =====================================================================
 
+void Opm::ECLPVT::IntervalHints::enable(const bool on)
+{
+    this->enabled = on;
+
+    if (! on) {
+        *this = IntervalHints{};
+    }
+}
+
+Opm::ECLPVT::IntervalHints::Statistics
+Opm::ECLPVT::IntervalHints::statistics() const
+{
+    auto stats = this->outer.statistics();
+
+    stats += this->left .statistics();
+    stats += this->right.statistics();
+
+    return stats;
+}
+
+// =====================================================================
+
 Opm::ECLPVT::PVDx::PVDx(ElemIt               xBegin,
                         ElemIt               xEnd,
                         const ConvertUnits&  convert,
-                        std::vector<ElemIt>& colIt)
+                        std::vector<ElemIt>& colIt,
+                        const double         simplifyTol)
     : interp_(Extrap{}, xBegin, xEnd, colIt,
               convert.indep, convert.column)
-{}
+{
+    this->interp_.simplify(simplifyTol);
+}
 
 std::vector<double>
 Opm::ECLPVT::PVDx::formationVolumeFactor(const std::vector<double>& p) const
@@ -273,6 +298,23 @@ Opm::ECLPVT::PVDx::getPvtCurve(const RawCurve curve) const
     return extractRawPVTCurve(this->interp_, curve);
 }
 
+void Opm::ECLPVT::PVDx::useIntervalHints(const bool enable)
+{
+    this->hints_.enable(enable);
+}
+
+Opm::ECLPVT::IntervalHints::Statistics
+Opm::ECLPVT::PVDx::intervalHintStatistics() const
+{
+    return this->hints_.statistics();
+}
+
+Opm::Interp1D::RoundingError
+Opm::ECLPVT::PVDx::useSinglePrecision()
+{
+    return this->interp_.useSinglePrecision();
+}
+
 // =====================================================================
 
 std::vector<double>
@@ -436,6 +436,34 @@ namespace Opm { namespace ECLPVT {
         return FlowDiagnostics::Graph { std::move(x), std::move(y) };
     }
 
+    /// Optional warm-start interval hints for a single property
+    /// evaluator.  Disabled by default.
+    struct IntervalHints
+    {
+        using Statistics = ::Opm::Interp1D::IntervalHintCache::Statistics;
+
+        /// Whether or not to maintain interval hints.
+        bool enabled{false};
+
+        /// Hints for primary lookup key (e.g., dissolved gas-oil ratio) or
+        /// for the sole independent variable of a PVDx table.
+        ::Opm::Interp1D::IntervalHintCache outer;
+
+        /// Hints for inner (pressure) variable in left sub-table of
+        /// PVTx evaluators.
+        ::Opm::Interp1D::IntervalHintCache left;
+
+        /// Hints for inner (pressure) variable in right sub-table of
+        /// PVTx evaluators.
+        ::Opm::Interp1D::IntervalHintCache right;
+
+        /// Enable or disable hints.  Disabling discards all hints.
+        void enable(const bool on);
+
+        /// Combined hit rate statistics of all constituent caches.
+        Statistics statistics() const;
+    };
+
     /// Evaluate pressure-dependent properties (formation volume factor,
     /// viscosity &c) for dead oil (PVDO) or dry gas (PVDG) from tabulated
     /// functions as represented in an ECL result set (ECLInitData).
@@ -460,10 +488,17 @@ namespace Opm { namespace ECLPVT {
         ///    beginning of a single table's dependent variables columns.
         ///    On output, advanced across \code std::distance(xBegin, xEnd)
         ///    \endcode rows/entries.
+        ///
+        /// \param[in] simplifyTol Relative tolerance for removing table
+        ///    nodes that are reproduced by linear interpolation between
+        ///    their neighbours.  Negative (the default) retains all nodes, so
+        ///    curves and values are those of the input table.  Zero removes
+        ///    only nodes that are reproduced exactly.
         PVDx(ElemIt               xBegin,
              ElemIt               xEnd,
              const ConvertUnits&  convert,
-             std::vector<ElemIt>& colIt);
+             std::vector<ElemIt>& colIt,
+             const double         simplifyTol = -1.0);
 
         /// Evaluate the phase FVF in selection of pressure points.
         ///
@@ -496,6 +531,23 @@ namespace Opm { namespace ECLPVT {
         ///    \endcode
         FlowDiagnostics::Graph getPvtCurve(const RawCurve curve) const;
 
+        /// Enable or disable warm-start interval hints.  When enabled, the
+        /// interval of each pressure point is remembered by position and
+        /// checked first in the next call to formationVolumeFactor() or
+        /// viscosity().
+        ///
+        /// \param[in] enable Whether or not to maintain interval hints.
+        void useIntervalHints(const bool enable);
+
+        /// Retrieve hit rate statistics of warm-start interval hints.
+        IntervalHints::Statistics intervalHintStatistics() const;
+
+        /// Store property table in single precision.  Evaluation still
+        /// accumulates in double precision.
+        ///
+        /// \return Rounding error relative to double precision table.
+        Interp1D::RoundingError useSinglePrecision();
+
     private:
         /// Extrapolation policy for property evaluator/interpolant.
         using Extrap = ::Opm::Interp1D::PiecewisePolynomial::
@@ -518,10 +570,23 @@ namespace Opm { namespace ECLPVT {
         /// gas (Pg).
         Backend interp_;
 
+        /// Warm-start interval hints.  Mutable because they do not affect
+        /// evaluation results.
+        mutable IntervalHints hints_;
+
         /// Translate pressure value to evaluation point and identify
         /// relevant extrapolation case if needed.
-        EvalPt getInterpPoint(const double p) const
+        ///
+        /// \param[in] p Pressure value.
+        ///
+        /// \param[in] i Position of \p p in current sequence of pressure
+        ///    values.  Identifies interval hint.
+        EvalPt getInterpPoint(const double p, const std::size_t i) const
         {
+            if (this->hints_.enabled) {
+                return this->interp_.classifyPoint(p, this->hints_.outer, i);
+            }
+
             return this->interp_.classifyPoint(p);
         }
 
@@ -552,8 +617,12 @@ namespace Opm { namespace ECLPVT {
             auto result = std::vector<double>{};
             result.reserve(p.size());
 
-            for (const auto& pi : p) {
-                result.push_back(eval(this->getInterpPoint(pi)));
+            if (this->hints_.enabled) {
+                this->hints_.outer.prepare(p.size());
+            }
+
+            for (auto n = p.size(), i = 0*n; i < n; ++i) {
+                result.push_back(eval(this->getInterpPoint(p[i], i)));
             }
 
             return result;
@@ -567,10 +636,24 @@ namespace Opm { namespace ECLPVT {
     class PVTx
     {
     public:
+        /// Constructor.
+        ///
+        /// \param[in] key Primary lookup key (e.g., Rs) of each
+        ///    sub-table.
+        ///
+        /// \param[in] propInterp Interpolant of each sub-table.
+        ///
+        /// \param[in] simplifyTol Relative tolerance for removing
+        ///    sub-table nodes that are reproduced by linear interpolation
+        ///    between their neighbours.  Negative (the default) retains
+        ///    all nodes, so curves and values are those of the input
+        ///    table.  Zero removes only nodes that are reproduced exactly.
         PVTx(std::vector<double>              key,
-             std::vector<SubtableInterpolant> propInterp)
+             std::vector<SubtableInterpolant> propInterp,
+             const double                     simplifyTol = -1.0)
             : key_       (std::move(key))
             , propInterp_(std::move(propInterp))
+            , keySearch_ (key_)
         {
             if (this->key_.size() != this->propInterp_.size()) {
                 throw std::invalid_argument {
@@ -585,6 +668,10 @@ namespace Opm { namespace ECLPVT {
                     "Must Have At Least Two Inner Tables"
                 };
             }
+
+            for (auto& interp : this->propInterp_) {
+                interp.simplify(simplifyTol);
+            }
         }
 
         struct PrimaryKey
@@ -676,6 +763,40 @@ namespace Opm { namespace ECLPVT {
             return this->mainPvtCurve(curve);
         }
 
+        /// Enable or disable warm-start interval hints.  When enabled, the
+        /// primary key interval and the inner sub-table intervals of each
+        /// sampling point are remembered by position and checked first in
+        /// the next call to formationVolumeFactor() or viscosity().
+        ///
+        /// \param[in] enable Whether or not to maintain interval hints.
+        void useIntervalHints(const bool enable)
+        {
+            this->hints_.enable(enable);
+        }
+
+        /// Retrieve hit rate statistics of warm-start interval hints.
+        IntervalHints::Statistics intervalHintStatistics() const
+        {
+            return this->hints_.statistics();
+        }
+
+        /// Store property sub-tables in single precision.  Evaluation
+        /// still accumulates in double precision.  Primary key is not
+        /// affected.
+        ///
+        /// \return Combined rounding error of all sub-tables relative to
+        ///    double precision tables.
+        Interp1D::RoundingError useSinglePrecision()
+        {
+            auto error = Interp1D::RoundingError{};
+
+            for (auto& interp : this->propInterp_) {
+                error += interp.useSinglePrecision();
+            }
+
+            return error;
+        }
+
     private:
         using InnerEvalPoint = typename std::decay<
             decltype(std::declval<SubtableInterpolant>().classifyPoint(0.0))
@@ -692,11 +813,28 @@ namespace Opm { namespace ECLPVT {
         std::vector<double> key_;
         std::vector<SubtableInterpolant> propInterp_;
 
+        /// Search index for primary key.  Active for long tables only.
+        ::Opm::Interp1D::EytzingerIndex keySearch_;
+
+        /// Warm-start interval hints.  Mutable because they do not affect
+        /// evaluation results.
+        mutable IntervalHints hints_;
+
         InnerInterpPoint getInterpPoint(const std::size_t i,
-                                        const double      x) const
+                                        const double      x,
+                                        const std::size_t pos) const
         {
             assert ((i + 1) < this->propInterp_.size());
 
+            if (this->hints_.enabled) {
+                return {
+                    this->propInterp_[i + 0]
+                        .classifyPoint(x, this->hints_.left, pos),
+                    this->propInterp_[i + 1]
+                        .classifyPoint(x, this->hints_.right, pos)
+                };
+            }
+
             return {
                 this->propInterp_[i + 0].classifyPoint(x),
                 this->propInterp_[i + 1].classifyPoint(x)
@@ -706,13 +844,14 @@ namespace Opm { namespace ECLPVT {
         template <class Function>
         auto interpolate(Function&&              func,
                          const OuterInterpPoint& outer,
-                         const double            x) const
+                         const double            x,
+                         const std::size_t       pos) const
             -> decltype(func(outer.interval, std::declval<InnerEvalPoint>()))
         {
             assert (outer.cat == ::Opm::Interp1D::PointCategory::InRange);
 
             const auto pt =
-                this->getInterpPoint(outer.interval, x);
+                this->getInterpPoint(outer.interval, x, pos);
 
             const auto yLeft  = func(outer.interval + 0, pt.left);
             const auto yRight = func(outer.interval + 1, pt.right);
@@ -727,14 +866,15 @@ namespace Opm { namespace ECLPVT {
         template <class Function>
         auto extrapLeft(Function&&              func,
                         const OuterInterpPoint& outer,
-                        const double            x) const
+                        const double            x,
+                        const std::size_t       pos) const
             -> decltype(func(outer.interval, std::declval<InnerEvalPoint>()))
         {
             assert (outer.cat == ::Opm::Interp1D::PointCategory::LeftOfRange);
             assert (outer.interval == 0*this->key_.size());
 
             const auto pt =
-                this->getInterpPoint(outer.interval, x);
+                this->getInterpPoint(outer.interval, x, pos);
 
             const auto yLeft  = func(0, pt.left);
             const auto yRight = func(1, pt.right);
@@ -748,7 +888,8 @@ namespace Opm { namespace ECLPVT {
         template <class Function>
         auto extrapRight(Function&&              func,
                          const OuterInterpPoint& outer,
-                         const double            x) const
+                         const double            x,
+                         const std::size_t       pos) const
             -> decltype(func(outer.interval, std::declval<InnerEvalPoint>()))
         {
             const auto nIntervals = this->key_.size() - 1;
@@ -756,7 +897,7 @@ namespace Opm { namespace ECLPVT {
             assert (outer.cat == ::Opm::Interp1D::PointCategory::RightOfRange);
             assert (outer.interval == nIntervals);
 
-            const auto pt = this->getInterpPoint(nIntervals - 1, x);
+            const auto pt = this->getInterpPoint(nIntervals - 1, x, pos);
 
             const auto yLeft  = func(nIntervals - 1, pt.left);
             const auto yRight = func(nIntervals - 0, pt.right);
@@ -769,27 +910,33 @@ namespace Opm { namespace ECLPVT {
         }
 
         template <class Function>
-        auto evaluate(const double key,
-                      const double x,
-                      Function&&   func) const
+        auto evaluate(const double      key,
+                      const double      x,
+                      const std::size_t pos,
+                      Function&&        func) const
             -> decltype(func(std::declval<OuterInterpPoint>().interval,
                              std::declval<InnerEvalPoint>()))
         {
-            const auto outer = ::Opm::Interp1D::PiecewisePolynomial::
-                LocalInterpPoint::identify(this->key_, key);
+            using LocalInterpPoint = ::Opm::Interp1D::
+                PiecewisePolynomial::LocalInterpPoint;
+
+            const auto outer = this->hints_.enabled
+                ? LocalInterpPoint::identify(this->key_, key, this->keySearch_,
+                                             this->hints_.outer, pos)
+                : LocalInterpPoint::identify(this->key_, key, this->keySearch_);
 
             switch (outer.cat) {
             case ::Opm::Interp1D::PointCategory::InRange:
                 return this->interpolate(std::forward<Function>(func),
-                                         outer, x);
+                                         outer, x, pos);
 
             case ::Opm::Interp1D::PointCategory::LeftOfRange:
                 return this->extrapLeft(std::forward<Function>(func),
-                                        outer, x);
+                                        outer, x, pos);
 
             case ::Opm::Interp1D::PointCategory::RightOfRange:
                 return this->extrapRight(std::forward<Function>(func),
-                                         outer, x);
+                                         outer, x, pos);
             }
 
             throw std::logic_error {
@@ -817,9 +964,15 @@ namespace Opm { namespace ECLPVT {
 
             result.reserve(nVals);
 
+            if (this->hints_.enabled) {
+                this->hints_.outer.prepare(nVals);
+                this->hints_.left .prepare(nVals);
+                this->hints_.right.prepare(nVals);
+            }
+
             for (auto i = 0*nVals; i < nVals; ++i) {
                 const auto q =
-                    this->evaluate(key.data[i], x.data[i],
+                    this->evaluate(key.data[i], x.data[i], i,
                                    std::forward<InnerFunction>(ifunc));
 
                 result.push_back(ofunc(q));
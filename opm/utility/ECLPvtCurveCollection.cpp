@@ -266,10 +266,11 @@ namespace {
 
 Opm::ECLPVT::ECLPvtCurveCollection::
 ECLPvtCurveCollection(const ECLGraph&        G,
-                      const ECLInitFileData& init)
+                      const ECLInitFileData& init,
+                      const double           simplifyTol)
     : pvtnum_       (pvtnumVector(G, init))
-    , gas_          (CreateGasPVTInterpolant::fromECLOutput(init))
-    , oil_          (CreateOilPVTInterpolant::fromECLOutput(init))
+    , gas_          (CreateGasPVTInterpolant::fromECLOutput(init, simplifyTol))
+    , oil_          (CreateOilPVTInterpolant::fromECLOutput(init, simplifyTol))
     , usys_native_  (ECLUnits::serialisedUnitConventions(init))
     , usys_internal_(ECLUnits::internalUnitConventions())
 {}
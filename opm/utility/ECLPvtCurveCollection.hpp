@@ -56,8 +56,15 @@ namespace Opm { namespace ECLPVT {
         ///
         /// \param[in] init Container of tabulated PVT functions for all PVT
         ///    regions in the model \p G.
+        ///
+        /// \param[in] simplifyTol Relative tolerance for removing table
+        ///    nodes that are reproduced by linear interpolation between
+        ///    their neighbours.  Negative (the default) retains all nodes,
+        ///    so PVT curves have the nodes of the input tables.  Zero
+        ///    removes only nodes that are reproduced exactly.
         ECLPvtCurveCollection(const ECLGraph&        G,
-                              const ECLInitFileData& init);
+                              const ECLInitFileData& init,
+                              const double           simplifyTol = -1.0);
 
         /// Define a collection of units of measure for output purposes.
         ///
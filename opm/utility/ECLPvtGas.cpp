@@ -101,6 +101,13 @@ public:
     virtual std::vector<Opm::FlowDiagnostics::Graph>
     getPvtCurve(const Opm::ECLPVT::RawCurve curve) const = 0;
 
+    virtual void useIntervalHints(const bool enable) = 0;
+
+    virtual Opm::ECLPVT::IntervalHints::Statistics
+    intervalHintStatistics() const = 0;
+
+    virtual Opm::Interp1D::RoundingError useSinglePrecision() = 0;
+
     virtual std::unique_ptr<PVxGBase> clone() const = 0;
 };
 
@@ -115,8 +122,9 @@ public:
     DryGas(ElemIt               xBegin,
            ElemIt               xEnd,
            const ConvertUnits&  convert,
-           std::vector<ElemIt>& colIt)
-        : interpolant_(xBegin, xEnd, convert, colIt)
+           std::vector<ElemIt>& colIt,
+           const double         simplifyTol)
+        : interpolant_(xBegin, xEnd, convert, colIt, simplifyTol)
     {}
 
     virtual std::vector<double>
@@ -139,6 +147,22 @@ public:
         return { this->interpolant_.getPvtCurve(curve) };
     }
 
+    virtual void useIntervalHints(const bool enable) override
+    {
+        this->interpolant_.useIntervalHints(enable);
+    }
+
+    virtual Opm::ECLPVT::IntervalHints::Statistics
+    intervalHintStatistics() const override
+    {
+        return this->interpolant_.intervalHintStatistics();
+    }
+
+    virtual Opm::Interp1D::RoundingError useSinglePrecision() override
+    {
+        return this->interpolant_.useSinglePrecision();
+    }
+
     virtual std::unique_ptr<PVxGBase> clone() const override
     {
         return std::unique_ptr<PVxGBase>(new DryGas(*this));
@@ -160,8 +184,9 @@ public:
         Linear<Extrap, /* IsAscendingRange = */ false>;
 
     WetGas(std::vector<double>              key,
-           std::vector<SubtableInterpolant> propInterp)
-        : interp_(std::move(key), std::move(propInterp))
+           std::vector<SubtableInterpolant> propInterp,
+           const double                     simplifyTol)
+        : interp_(std::move(key), std::move(propInterp), simplifyTol)
     {}
 
     virtual std::vector<double>
@@ -196,6 +221,22 @@ public:
         return this->interp_.getPvtCurve(curve);
     }
 
+    virtual void useIntervalHints(const bool enable) override
+    {
+        this->interp_.useIntervalHints(enable);
+    }
+
+    virtual Opm::ECLPVT::IntervalHints::Statistics
+    intervalHintStatistics() const override
+    {
+        return this->interp_.intervalHintStatistics();
+    }
+
+    virtual Opm::Interp1D::RoundingError useSinglePrecision() override
+    {
+        return this->interp_.useSinglePrecision();
+    }
+
     virtual std::unique_ptr<PVxGBase> clone() const override
     {
         return std::unique_ptr<PVxGBase>(new WetGas(*this));
@@ -212,7 +253,8 @@ private:
 namespace {
     std::vector<std::unique_ptr<PVxGBase>>
     createDryGas(const ::Opm::ECLPropTableRawData& raw,
-                 const int                         usys)
+                 const int                         usys,
+                 const double                      simplifyTol)
     {
         using PVTInterp = std::unique_ptr<PVxGBase>;
         using ElmIt     = ::Opm::ECLPropTableRawData::ElementIterator;
@@ -223,9 +265,12 @@ namespace {
         const auto cvrt = createDryGasUnitConverter(usys);
 
         return ::Opm::MakeInterpolants<PVTInterp>::fromRawData(raw,
-            [&cvrt](ElmIt xBegin, ElmIt xEnd, std::vector<ElmIt>& colIt)
+            [&cvrt, simplifyTol]
+            (ElmIt xBegin, ElmIt xEnd, std::vector<ElmIt>& colIt)
         {
-            return PVTInterp{ new DryGas(xBegin, xEnd, cvrt, colIt) };
+            return PVTInterp {
+                new DryGas(xBegin, xEnd, cvrt, colIt, simplifyTol)
+            };
         });
     }
 
@@ -251,7 +296,8 @@ namespace {
 
     std::vector<std::unique_ptr<PVxGBase>>
     createWetGas(const ::Opm::ECLPropTableRawData& raw,
-                 const int                         usys)
+                 const int                         usys,
+                 const double                      simplifyTol)
     {
         auto ret = std::vector<std::unique_ptr<PVxGBase>>{};
         ret.reserve(raw.numTables);
@@ -290,7 +336,7 @@ namespace {
                 {
                     std::make_move_iterator(std::begin(sti) + begin),
                     std::make_move_iterator(std::begin(sti) + end)
-                }));
+                }, simplifyTol));
         }
 
         return ret;
@@ -298,7 +344,8 @@ namespace {
 
     std::vector<std::unique_ptr<PVxGBase>>
     createPVTFunction(const ::Opm::ECLPropTableRawData& raw,
-                      const int                         usys)
+                      const int                         usys,
+                      const double                      simplifyTol)
     {
         if (raw.numPrimary == 0) {
             // Malformed Gas PVT table.
@@ -329,10 +376,10 @@ namespace {
         }
 
         if (raw.numPrimary == 1) {
-            return createDryGas(raw, usys);
+            return createDryGas(raw, usys, simplifyTol);
         }
 
-        return createWetGas(raw, usys);
+        return createWetGas(raw, usys, simplifyTol);
     }
 
     std::vector<std::unique_ptr<PVxGBase>>
@@ -364,7 +411,8 @@ private:
 public:
     Impl(const ECLPropTableRawData& raw,
          const int                  usys,
-         std::vector<double>        rhoS);
+         std::vector<double>        rhoS,
+         const double               simplifyTol);
 
     Impl(const Impl& rhs);
     Impl(Impl&& rhs);
@@ -395,6 +443,12 @@ public:
     getPvtCurve(const RegIdx   region,
                 const RawCurve curve) const;
 
+    void useIntervalHints(const bool enable);
+
+    IntervalHints::Statistics intervalHintStatistics() const;
+
+    Interp1D::RoundingError useSinglePrecision();
+
 private:
     std::vector<EvalPtr> eval_;
     std::vector<double>  rhoS_;
@@ -405,8 +459,9 @@ private:
 Opm::ECLPVT::Gas::Impl::
 Impl(const ECLPropTableRawData& raw,
      const int                  usys,
-     std::vector<double>        rhoS)
-    : eval_(createPVTFunction(raw, usys))
+     std::vector<double>        rhoS,
+     const double               simplifyTol)
+    : eval_(createPVTFunction(raw, usys, simplifyTol))
     , rhoS_(std::move(rhoS))
 {}
 
@@ -470,6 +525,37 @@ getPvtCurve(const RegIdx   region,
     return this->eval_[region]->getPvtCurve(curve);
 }
 
+void Opm::ECLPVT::Gas::Impl::useIntervalHints(const bool enable)
+{
+    for (auto& eval : this->eval_) {
+        eval->useIntervalHints(enable);
+    }
+}
+
+Opm::ECLPVT::IntervalHints::Statistics
+Opm::ECLPVT::Gas::Impl::intervalHintStatistics() const
+{
+    auto stats = IntervalHints::Statistics{};
+
+    for (const auto& eval : this->eval_) {
+        stats += eval->intervalHintStatistics();
+    }
+
+    return stats;
+}
+
+Opm::Interp1D::RoundingError
+Opm::ECLPVT::Gas::Impl::useSinglePrecision()
+{
+    auto error = Interp1D::RoundingError{};
+
+    for (auto& eval : this->eval_) {
+        error += eval->useSinglePrecision();
+    }
+
+    return error;
+}
+
 void
 Opm::ECLPVT::Gas::Impl::validateRegIdx(const RegIdx region) const
 {
@@ -489,8 +575,9 @@ Opm::ECLPVT::Gas::Impl::validateRegIdx(const RegIdx region) const
 
 Opm::ECLPVT::Gas::Gas(const ECLPropTableRawData& raw,
                       const int                  usys,
-                      std::vector<double>        rhoS)
-    : pImpl_(new Impl(raw, usys, std::move(rhoS)))
+                      std::vector<double>        rhoS,
+                      const double               simplifyTol)
+    : pImpl_(new Impl(raw, usys, std::move(rhoS), simplifyTol))
 {}
 
 Opm::ECLPVT::Gas::~Gas()
@@ -551,11 +638,28 @@ getPvtCurve(const RawCurve curve,
     return this->pImpl_->getPvtCurve(region, curve);
 }
 
+void Opm::ECLPVT::Gas::useIntervalHints(const bool enable)
+{
+    this->pImpl_->useIntervalHints(enable);
+}
+
+Opm::ECLPVT::IntervalHints::Statistics
+Opm::ECLPVT::Gas::intervalHintStatistics() const
+{
+    return this->pImpl_->intervalHintStatistics();
+}
+
+Opm::Interp1D::RoundingError Opm::ECLPVT::Gas::useSinglePrecision()
+{
+    return this->pImpl_->useSinglePrecision();
+}
+
 // =====================================================================
 
 std::unique_ptr<Opm::ECLPVT::Gas>
 Opm::ECLPVT::CreateGasPVTInterpolant::
-fromECLOutput(const ECLInitFileData& init)
+fromECLOutput(const ECLInitFileData& init,
+              const double           simplifyTol)
 {
     using GPtr = ::std::unique_ptr<Opm::ECLPVT::Gas>;
 
@@ -602,6 +706,7 @@ fromECLOutput(const ECLInitFileData& init)
     auto rhoS = surfaceMassDensity(init, ECLPhaseIndex::Vapour);
 
     return GPtr{
-        new Gas(raw, ih[ INTEHEAD_UNIT_INDEX ], std::move(rhoS))
+        new Gas(raw, ih[ INTEHEAD_UNIT_INDEX ], std::move(rhoS),
+                simplifyTol)
     };
 }
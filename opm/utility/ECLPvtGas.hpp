@@ -51,9 +51,16 @@ namespace Opm { namespace ECLPVT {
         /// \param[in] rhoS Mass density of gas at surface conditions.
         ///    Typically computed by \code ECLPVT::surfaceMassDensity()
         ///    \endcode.
+        ///
+        /// \param[in] simplifyTol Relative tolerance for removing table
+        ///    nodes that are reproduced by linear interpolation between
+        ///    their neighbours.  Negative (the default) retains all nodes, so
+        ///    curves and values are those of the input table.  Zero removes
+        ///    only nodes that are reproduced exactly.
         Gas(const ECLPropTableRawData& raw,
             const int                  usys,
-            std::vector<double>        rhoS);
+            std::vector<double>        rhoS,
+            const double               simplifyTol = -1.0);
 
         /// Destructor.
         ~Gas();
@@ -179,6 +186,37 @@ namespace Opm { namespace ECLPVT {
         getPvtCurve(const RawCurve curve,
                     const int      region) const;
 
+        /// Enable or disable warm-start interval hints in all PVT regions.
+        ///
+        /// When enabled, each region's evaluator remembers the table
+        /// intervals of the sampling points, by position, and checks those
+        /// intervals and their neighbours first in the next evaluation.
+        /// Repeated evaluation of the same region subset across report
+        /// steps will then mostly avoid the full table search.  Results are
+        /// unaffected.  Disabled by default.  Disabling discards all hints.
+        ///
+        /// \param[in] enable Whether or not to maintain interval hints.
+        void useIntervalHints(const bool enable);
+
+        /// Retrieve accumulated hit rate statistics of warm-start interval
+        /// hints across all PVT regions.
+        ///
+        /// \return Hint statistics.  All zero unless interval hints have
+        ///    been enabled.
+        IntervalHints::Statistics intervalHintStatistics() const;
+
+        /// Store property tables of all PVT regions in single precision.
+        ///
+        /// Halves the size of the tabulated properties, allowing more
+        /// regions to remain cache resident.  Evaluation still
+        /// accumulates in double precision.  Call once, immediately after
+        /// construction, and compare the result to the accuracy required
+        /// by the application.
+        ///
+        /// \return Rounding error of the stored tables relative to the
+        ///    original, double precision tables.
+        Interp1D::RoundingError useSinglePrecision();
+
     private:
         /// Implementation class.
         class Impl;
@@ -195,10 +233,14 @@ namespace Opm { namespace ECLPVT {
         ///
         /// \param[in] init ECL result set INIT file representation.
         ///
+        /// \param[in] simplifyTol Tolerance for removing redundant PVT
+        ///    table nodes.  See constructor of class Gas.
+        ///
         /// \return Gas PVT interpolant.  Nullpointer if gas is not an
         ///    active phase in the result set.
         static std::unique_ptr<Gas>
-        fromECLOutput(const ECLInitFileData& init);
+        fromECLOutput(const ECLInitFileData& init,
+                      const double           simplifyTol = -1.0);
     };
 }} // Opm::ECLPVT
 
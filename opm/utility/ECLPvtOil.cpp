@@ -98,6 +98,13 @@ public:
     virtual std::vector<Opm::FlowDiagnostics::Graph>
     getPvtCurve(const Opm::ECLPVT::RawCurve curve) const = 0;
 
+    virtual void useIntervalHints(const bool enable) = 0;
+
+    virtual Opm::ECLPVT::IntervalHints::Statistics
+    intervalHintStatistics() const = 0;
+
+    virtual Opm::Interp1D::RoundingError useSinglePrecision() = 0;
+
     virtual std::unique_ptr<PVxOBase> clone() const = 0;
 };
 
@@ -112,8 +119,9 @@ public:
     DeadOil(ElemIt               xBegin,
             ElemIt               xEnd,
             const ConvertUnits&  convert,
-            std::vector<ElemIt>& colIt)
-        : interpolant_(xBegin, xEnd, convert, colIt)
+            std::vector<ElemIt>& colIt,
+            const double         simplifyTol)
+        : interpolant_(xBegin, xEnd, convert, colIt, simplifyTol)
     {}
 
     virtual std::vector<double>
@@ -136,6 +144,22 @@ public:
         return { this->interpolant_.getPvtCurve(curve) };
     }
 
+    virtual void useIntervalHints(const bool enable) override
+    {
+        this->interpolant_.useIntervalHints(enable);
+    }
+
+    virtual Opm::ECLPVT::IntervalHints::Statistics
+    intervalHintStatistics() const override
+    {
+        return this->interpolant_.intervalHintStatistics();
+    }
+
+    virtual Opm::Interp1D::RoundingError useSinglePrecision() override
+    {
+        return this->interpolant_.useSinglePrecision();
+    }
+
     virtual std::unique_ptr<PVxOBase> clone() const override
     {
         return std::unique_ptr<PVxOBase>(new DeadOil(*this));
@@ -157,8 +181,9 @@ public:
         Linear<Extrap, /* IsAscendingRange = */ true>;
 
     LiveOil(std::vector<double>              key,
-            std::vector<SubtableInterpolant> propInterp)
-        : interp_(std::move(key), std::move(propInterp))
+            std::vector<SubtableInterpolant> propInterp,
+            const double                     simplifyTol)
+        : interp_(std::move(key), std::move(propInterp), simplifyTol)
     {}
 
     virtual std::vector<double>
@@ -193,6 +218,22 @@ public:
         return this->interp_.getPvtCurve(curve);
     }
 
+    virtual void useIntervalHints(const bool enable) override
+    {
+        this->interp_.useIntervalHints(enable);
+    }
+
+    virtual Opm::ECLPVT::IntervalHints::Statistics
+    intervalHintStatistics() const override
+    {
+        return this->interp_.intervalHintStatistics();
+    }
+
+    virtual Opm::Interp1D::RoundingError useSinglePrecision() override
+    {
+        return this->interp_.useSinglePrecision();
+    }
+
     virtual std::unique_ptr<PVxOBase> clone() const override
     {
         return std::unique_ptr<PVxOBase>(new LiveOil(*this));
@@ -227,7 +268,8 @@ private:
 namespace {
     std::vector<std::unique_ptr<PVxOBase>>
     createDeadOil(const ::Opm::ECLPropTableRawData& raw,
-                  const int                         usys)
+                  const int                         usys,
+                  const double                      simplifyTol)
     {
         using PVTInterp = std::unique_ptr<PVxOBase>;
         using ElmIt     = ::Opm::ECLPropTableRawData::ElementIterator;
@@ -238,9 +280,12 @@ namespace {
         const auto cvrt = deadOilUnitConverter(usys);
 
         return ::Opm::MakeInterpolants<PVTInterp>::fromRawData(raw,
-            [&cvrt](ElmIt xBegin, ElmIt xEnd, std::vector<ElmIt>& colIt)
+            [&cvrt, simplifyTol]
+            (ElmIt xBegin, ElmIt xEnd, std::vector<ElmIt>& colIt)
         {
-            return PVTInterp{ new DeadOil(xBegin, xEnd, cvrt, colIt) };
+            return PVTInterp {
+                new DeadOil(xBegin, xEnd, cvrt, colIt, simplifyTol)
+            };
         });
     }
 
@@ -266,7 +311,8 @@ namespace {
 
     std::vector<std::unique_ptr<PVxOBase>>
     createLiveOil(const ::Opm::ECLPropTableRawData& raw,
-                  const int                         usys)
+                  const int                         usys,
+                  const double                      simplifyTol)
     {
         auto ret = std::vector<std::unique_ptr<PVxOBase>>{};
         ret.reserve(raw.numTables);
@@ -305,7 +351,7 @@ namespace {
                 {
                     std::make_move_iterator(std::begin(sti) + begin),
                     std::make_move_iterator(std::begin(sti) + end)
-                }));
+                }, simplifyTol));
         }
 
         return ret;
@@ -313,7 +359,8 @@ namespace {
 
     std::vector<std::unique_ptr<PVxOBase>>
     createPVTFunction(const ::Opm::ECLPropTableRawData& raw,
-                      const int                         usys)
+                      const int                         usys,
+                      const double                      simplifyTol)
     {
         if (raw.numPrimary == 0) {
             // Malformed Gas PVT table.
@@ -344,10 +391,10 @@ namespace {
         }
 
         if (raw.numPrimary == 1) {
-            return createDeadOil(raw, usys);
+            return createDeadOil(raw, usys, simplifyTol);
         }
 
-        return createLiveOil(raw, usys);
+        return createLiveOil(raw, usys, simplifyTol);
     }
 
     std::vector<std::unique_ptr<PVxOBase>>
@@ -379,7 +426,8 @@ private:
 public:
     Impl(const ECLPropTableRawData& raw,
          const int                  usys,
-         std::vector<double>        rhoS);
+         std::vector<double>        rhoS,
+         const double               simplifyTol);
 
     Impl(const Impl& rhs);
     Impl(Impl&& rhs);
@@ -410,6 +458,12 @@ public:
     getPvtCurve(const RegIdx   region,
                 const RawCurve curve) const;
 
+    void useIntervalHints(const bool enable);
+
+    IntervalHints::Statistics intervalHintStatistics() const;
+
+    Interp1D::RoundingError useSinglePrecision();
+
 private:
     std::vector<EvalPtr> eval_;
     std::vector<double>  rhoS_;
@@ -420,8 +474,9 @@ private:
 Opm::ECLPVT::Oil::Impl::
 Impl(const ECLPropTableRawData& raw,
      const int                  usys,
-     std::vector<double>        rhoS)
-    : eval_(createPVTFunction(raw, usys))
+     std::vector<double>        rhoS,
+     const double               simplifyTol)
+    : eval_(createPVTFunction(raw, usys, simplifyTol))
     , rhoS_(std::move(rhoS))
 {}
 
@@ -485,6 +540,37 @@ getPvtCurve(const RegIdx   region,
     return this->eval_[region]->getPvtCurve(curve);
 }
 
+void Opm::ECLPVT::Oil::Impl::useIntervalHints(const bool enable)
+{
+    for (auto& eval : this->eval_) {
+        eval->useIntervalHints(enable);
+    }
+}
+
+Opm::ECLPVT::IntervalHints::Statistics
+Opm::ECLPVT::Oil::Impl::intervalHintStatistics() const
+{
+    auto stats = IntervalHints::Statistics{};
+
+    for (const auto& eval : this->eval_) {
+        stats += eval->intervalHintStatistics();
+    }
+
+    return stats;
+}
+
+Opm::Interp1D::RoundingError
+Opm::ECLPVT::Oil::Impl::useSinglePrecision()
+{
+    auto error = Interp1D::RoundingError{};
+
+    for (auto& eval : this->eval_) {
+        error += eval->useSinglePrecision();
+    }
+
+    return error;
+}
+
 void
 Opm::ECLPVT::Oil::Impl::validateRegIdx(const RegIdx region) const
 {
@@ -504,8 +590,9 @@ Opm::ECLPVT::Oil::Impl::validateRegIdx(const RegIdx region) const
 
 Opm::ECLPVT::Oil::Oil(const ECLPropTableRawData& raw,
                       const int                  usys,
-                      std::vector<double>        rhoS)
-    : pImpl_(new Impl(raw, usys, std::move(rhoS)))
+                      std::vector<double>        rhoS,
+                      const double               simplifyTol)
+    : pImpl_(new Impl(raw, usys, std::move(rhoS), simplifyTol))
 {}
 
 Opm::ECLPVT::Oil::~Oil()
@@ -566,11 +653,28 @@ getPvtCurve(const RawCurve curve,
     return this->pImpl_->getPvtCurve(region, curve);
 }
 
+void Opm::ECLPVT::Oil::useIntervalHints(const bool enable)
+{
+    this->pImpl_->useIntervalHints(enable);
+}
+
+Opm::ECLPVT::IntervalHints::Statistics
+Opm::ECLPVT::Oil::intervalHintStatistics() const
+{
+    return this->pImpl_->intervalHintStatistics();
+}
+
+Opm::Interp1D::RoundingError Opm::ECLPVT::Oil::useSinglePrecision()
+{
+    return this->pImpl_->useSinglePrecision();
+}
+
 // =====================================================================
 
 std::unique_ptr<Opm::ECLPVT::Oil>
 Opm::ECLPVT::CreateOilPVTInterpolant::
-fromECLOutput(const ECLInitFileData& init)
+fromECLOutput(const ECLInitFileData& init,
+              const double           simplifyTol)
 {
     using OPtr = std::unique_ptr<Opm::ECLPVT::Oil>;
 
@@ -617,6 +721,7 @@ fromECLOutput(const ECLInitFileData& init)
     auto rhoS = surfaceMassDensity(init, ECLPhaseIndex::Liquid);
 
     return OPtr{
-        new Oil(raw, ih[ INTEHEAD_UNIT_INDEX ], std::move(rhoS))
+        new Oil(raw, ih[ INTEHEAD_UNIT_INDEX ], std::move(rhoS),
+                simplifyTol)
     };
 }
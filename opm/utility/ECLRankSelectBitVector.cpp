@@ -0,0 +1,245 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLRankSelectBitVector.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+/// \file
+///
+/// Implementation of \c ECLRankSelectBitVector interface.
+
+namespace {
+    /// Number of bits per storage word.
+    const std::size_t wordBits = 64;
+
+    /// Number of storage words per rank sample.
+    const std::size_t blockWords = 4;
+
+    std::size_t popCount(std::uint64_t w)
+    {
+#if defined(__GNUC__)
+        return static_cast<std::size_t>
+            (__builtin_popcountll(static_cast<unsigned long long>(w)));
+#else
+        w = w - ((w >> 1) & 0x5555555555555555ull);
+        w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+        w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0full;
+
+        return static_cast<std::size_t>((w * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    /// Position of k-th set bit (zero based) in word.  Word must have at
+    /// least k+1 set bits.
+    std::size_t selectInWord(std::uint64_t w, std::size_t k)
+    {
+        for (; k > 0; --k) {
+            w &= w - 1;         // Clear lowest set bit.
+        }
+
+        assert (w != 0);
+
+        auto pos = std::size_t{0};
+        for (; (w & 1) == 0; w >>= 1) { ++pos; }
+
+        return pos;
+    }
+
+    std::size_t numWords(const std::size_t size)
+    {
+        return (size + wordBits - 1) / wordBits;
+    }
+} // Anonymous
+
+Opm::ECLRankSelectBitVector::ECLRankSelectBitVector()
+    : size_(0)
+{
+    this->buildRankSamples();
+}
+
+Opm::ECLRankSelectBitVector::
+ECLRankSelectBitVector(const std::vector<bool>& bits)
+    : size_(bits.size())
+    , bits_(numWords(bits.size()), 0)
+{
+    for (auto n = bits.size(), i = 0*n; i < n; ++i) {
+        if (bits[i]) {
+            this->bits_[i / wordBits] |= Word{1} << (i % wordBits);
+        }
+    }
+
+    this->buildRankSamples();
+}
+
+Opm::ECLRankSelectBitVector::
+ECLRankSelectBitVector(const std::size_t               size,
+                       const std::vector<std::size_t>& members)
+    : size_(size)
+    , bits_(numWords(size), 0)
+{
+    for (auto n = members.size(), k = 0*n; k < n; ++k) {
+        const auto i = members[k];
+
+        if ((i >= size) || ((k > 0) && (i <= members[k - 1]))) {
+            std::ostringstream os;
+
+            os << "Subset Member " << i << " at Position " << k
+               << " is Out of Order or Outside Index Range [0.."
+               << size << ')';
+
+            throw std::invalid_argument(os.str());
+        }
+
+        this->bits_[i / wordBits] |= Word{1} << (i % wordBits);
+    }
+
+    this->buildRankSamples();
+}
+
+std::size_t Opm::ECLRankSelectBitVector::size() const
+{
+    return this->size_;
+}
+
+std::size_t Opm::ECLRankSelectBitVector::count() const
+{
+    return static_cast<std::size_t>(this->blockRank_.back());
+}
+
+bool Opm::ECLRankSelectBitVector::test(const std::size_t i) const
+{
+    assert (i < this->size_);
+
+    return ((this->bits_[i / wordBits] >> (i % wordBits)) & 1) != 0;
+}
+
+std::size_t Opm::ECLRankSelectBitVector::rank(const std::size_t i) const
+{
+    assert (i <= this->size_);
+
+    const auto word  = i / wordBits;
+    const auto block = word / blockWords;
+
+    auto r = static_cast<std::size_t>(this->blockRank_[block]);
+
+    for (auto w = block * blockWords; w < word; ++w) {
+        r += popCount(this->bits_[w]);
+    }
+
+    const auto bit = i % wordBits;
+    if (bit > 0) {
+        r += popCount(this->bits_[word] & ((Word{1} << bit) - 1));
+    }
+
+    return r;
+}
+
+int Opm::ECLRankSelectBitVector::position(const std::size_t i) const
+{
+    if ((i >= this->size_) || ! this->test(i)) {
+        return -1;
+    }
+
+    return static_cast<int>(this->rank(i));
+}
+
+std::vector<int>
+Opm::ECLRankSelectBitVector::position(const std::vector<std::size_t>& i) const
+{
+    auto pos = std::vector<int>{};
+    pos.reserve(i.size());
+
+    for (const auto& ix : i) {
+        pos.push_back(this->position(ix));
+    }
+
+    return pos;
+}
+
+std::size_t Opm::ECLRankSelectBitVector::select(const std::size_t k) const
+{
+    if (k >= this->count()) {
+        std::ostringstream os;
+
+        os << "Subset Position " << k << " Out of Range [0.."
+           << this->count() << ')';
+
+        throw std::out_of_range(os.str());
+    }
+
+    // Last block whose preceding count does not exceed k.
+    const auto b = std::upper_bound(this->blockRank_.begin(),
+                                    this->blockRank_.end(), Word{k});
+
+    const auto block = static_cast<std::size_t>
+        (std::distance(this->blockRank_.begin(), b) - 1);
+
+    auto remain = k - static_cast<std::size_t>(this->blockRank_[block]);
+
+    for (auto w = block * blockWords; ; ++w) {
+        assert (w < this->bits_.size());
+
+        const auto n = popCount(this->bits_[w]);
+
+        if (remain < n) {
+            return w*wordBits + selectInWord(this->bits_[w], remain);
+        }
+
+        remain -= n;
+    }
+}
+
+std::size_t Opm::ECLRankSelectBitVector::memoryUsage() const
+{
+    return (this->bits_.size() + this->blockRank_.size()) * sizeof(Word);
+}
+
+void Opm::ECLRankSelectBitVector::buildRankSamples()
+{
+    const auto nblock = (this->bits_.size() + blockWords - 1) / blockWords;
+
+    this->blockRank_.assign(nblock + 1, 0);
+
+    auto r = Word{0};
+
+    for (auto b = 0*nblock; b < nblock; ++b) {
+        this->blockRank_[b] = r;
+
+        const auto end = std::min((b + 1) * blockWords, this->bits_.size());
+
+        for (auto w = b * blockWords; w < end; ++w) {
+            r += popCount(this->bits_[w]);
+        }
+    }
+
+    this->blockRank_.back() = r;
+}
@@ -0,0 +1,139 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLRANKSELECTBITVECTOR_HEADER_INCLUDED
+#define OPM_ECLRANKSELECTBITVECTOR_HEADER_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \file
+///
+/// Succinct representation of a subset of a contiguous index range, e.g.,
+/// the active cells of a Cartesian grid.
+
+namespace Opm {
+
+    /// Immutable bit vector with constant time rank queries.
+    ///
+    /// Bit \c i is set if index \c i is a member of the subset.  The rank
+    /// of index \c i, i.e., the number of set bits preceding \c i, is then
+    /// the position of \c i within the subset.  In other words, the rank
+    /// maps global cell indices to active cell indices and select maps
+    /// active cell indices back to global cell indices.
+    ///
+    /// The bits are stored in 64-bit words.  The number of set bits
+    /// preceding each block of four words is sampled in an additional
+    /// 64-bit word, so the structure uses 1.25 bits per index in total
+    /// compared to 32 bits for an explicit array of active cell indices.
+    /// A rank query is one table lookup and at most four population
+    /// counts.  A select query is a binary search over the samples.
+    class ECLRankSelectBitVector
+    {
+    public:
+        /// Default constructor.  Empty index range.
+        ECLRankSelectBitVector();
+
+        /// Constructor.
+        ///
+        /// \param[in] bits Subset membership of each index.
+        explicit ECLRankSelectBitVector(const std::vector<bool>& bits);
+
+        /// Constructor.
+        ///
+        /// \param[in] size Number of indices in range.
+        ///
+        /// \param[in] members Indices of subset.  Must be strictly
+        ///    increasing and less than \p size.
+        ECLRankSelectBitVector(const std::size_t               size,
+                               const std::vector<std::size_t>& members);
+
+        /// Number of indices in range.
+        std::size_t size() const;
+
+        /// Number of indices in subset (number of set bits).
+        std::size_t count() const;
+
+        /// Subset membership of single index.
+        ///
+        /// \param[in] i Index.  Must be less than size().
+        bool test(const std::size_t i) const;
+
+        /// Number of set bits preceding a particular index.
+        ///
+        /// \param[in] i Index.  Must not exceed size().
+        ///
+        /// \return Number of set bits in the range \code [0 .. i)
+        ///    \endcode.
+        std::size_t rank(const std::size_t i) const;
+
+        /// Position of particular index within subset.
+        ///
+        /// \param[in] i Index.
+        ///
+        /// \return Rank of \p i if \p i is a member of the subset.
+        ///    Negative one (-1) if \p i is not a member or if \code i >=
+        ///    size() \endcode.
+        int position(const std::size_t i) const;
+
+        /// Positions of sequence of indices within subset.
+        ///
+        /// Batched form of position().  Ascending input sequences access
+        /// the rank samples and bit words sequentially.
+        ///
+        /// \param[in] i Sequence of indices.
+        ///
+        /// \return Position of each index within subset.  Negative one
+        ///    (-1) for non-members and indices outside the range.
+        std::vector<int> position(const std::vector<std::size_t>& i) const;
+
+        /// Index of particular subset member.  Inverse of rank().
+        ///
+        /// \param[in] k Position within subset.
+        ///
+        /// \return Index of the \p k-th set bit (zero based).
+        ///
+        /// Throws \c std::out_of_range if \code k >= count() \endcode.
+        std::size_t select(const std::size_t k) const;
+
+        /// Number of bytes occupied by bits and rank samples.
+        std::size_t memoryUsage() const;
+
+    private:
+        using Word = std::uint64_t;
+
+        /// Number of indices in range.
+        std::size_t size_;
+
+        /// Subset membership bits.  Bit \code i % 64 \endcode of word
+        /// \code i / 64 \endcode represents index \c i.
+        std::vector<Word> bits_;
+
+        /// Number of set bits preceding each block of words.  One
+        /// additional trailing element holds the total count.
+        std::vector<Word> blockRank_;
+
+        /// Compute rank samples from membership bits.
+        void buildRankSamples();
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLRANKSELECTBITVECTOR_HEADER_INCLUDED
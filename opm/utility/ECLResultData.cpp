@@ -22,6 +22,8 @@
 #endif
 
 #include <opm/utility/ECLResultData.hpp>
+#include <opm/utility/ECLMemoryBudget.hpp>
+#include <opm/utility/ECLStaticArrayCache.hpp>
 
 #include <cassert>
 #include <ctime>
@@ -29,6 +31,7 @@
 #include <initializer_list>
 #include <iomanip>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -709,6 +712,25 @@ namespace {
 
         return os.str();
     }
+
+    /// Identity of decoded result vector: report step, vector name and
+    /// grid name.
+    using DecodedArrayKey = std::tuple<int, std::string, std::string>;
+
+    /// Cache of decoded floating-point result vectors.
+    using DecodedArrayCache =
+        Opm::ECLBudgetedCache<DecodedArrayKey, std::vector<double>>;
+
+    std::unique_ptr<DecodedArrayCache> makeDecodedArrayCache()
+    {
+        return std::unique_ptr<DecodedArrayCache> {
+            new DecodedArrayCache("Restart Arrays",
+                [](const std::vector<double>& x)
+            {
+                return x.capacity() * sizeof x[0];
+            })
+        };
+    }
 } // namespace Anonymous
 
 // ======================================================================
@@ -988,6 +1010,19 @@ private:
     /// Current active result-set view.
     mutable const ecl_file_view_type* activeBlock_{ nullptr };
 
+    /// Report step of current active result-set view.
+    int step_{ -1 };
+
+    /// Decoded floating-point result vectors of all selected report
+    /// steps.  Retained subject to the process-wide ECLMemoryBudget.
+    std::unique_ptr<DecodedArrayCache> decoded_;
+
+    /// Decode result vector in current active view.
+    template <typename T>
+    std::vector<T>
+    decodeKeywordData(const std::string& vector,
+                      const std::string& gridName) const;
+
     /// Support for passing \code *this \endcode to ERT functions that
     /// require an \c ecl_file_type, particularly the function that selects
     /// the file's global view--ecl_file_get_global_view().
@@ -1012,6 +1047,7 @@ Opm::ECLRestartData::Impl::Impl(Path prefix)
     , result_      (openResultSet(deriveRestartPath(prefix_)))
     , firstKeyword_(firstFileKeyword(result_.get()))
     , isUnified_   (firstKeyword_ == "SEQNUM")
+    , decoded_     (makeDecodedArrayCache())
 {}
 
 Opm::ECLRestartData::Impl::Impl(std::shared_ptr<ecl_file_type> rstrt)
@@ -1019,6 +1055,7 @@ Opm::ECLRestartData::Impl::Impl(std::shared_ptr<ecl_file_type> rstrt)
     , result_      (std::move(rstrt))
     , firstKeyword_(firstFileKeyword(result_.get()))
     , isUnified_   (firstKeyword_ == "SEQNUM")
+    , decoded_     (makeDecodedArrayCache())
 {}
 
 Opm::ECLRestartData::Impl::Impl(const Impl& rhs)
@@ -1026,6 +1063,7 @@ Opm::ECLRestartData::Impl::Impl(const Impl& rhs)
     , result_      (openResultSet(deriveRestartPath(prefix_)))
     , firstKeyword_(firstFileKeyword(result_.get()))
     , isUnified_   (rhs.isUnified_)
+    , decoded_     (makeDecodedArrayCache())
 {}
 
 Opm::ECLRestartData::Impl::Impl(Impl&& rhs)
@@ -1033,6 +1071,7 @@ Opm::ECLRestartData::Impl::Impl(Impl&& rhs)
     , result_      (std::move(rhs.result_))
     , firstKeyword_(std::move(rhs.firstKeyword_))
     , isUnified_   (rhs.isUnified_)
+    , decoded_     (std::move(rhs.decoded_))
 {}
 
 bool Opm::ECLRestartData::Impl::selectReportStep(const int step)
@@ -1042,6 +1081,7 @@ bool Opm::ECLRestartData::Impl::selectReportStep(const int step)
     }
 
     this->gridIDCache_.reset();
+    this->step_ = step;
 
     if (auto* globView = ecl_file_get_global_view(*this)) {
         if (isUnified_) {
@@ -1096,6 +1136,32 @@ namespace Opm {
     std::vector<T>
     ECLRestartData::Impl::keywordData(const std::string& vector,
                                       const std::string& gridName) const
+    {
+        return this->template decodeKeywordData<T>(vector, gridName);
+    }
+
+    template <>
+    std::vector<double>
+    ECLRestartData::Impl::keywordData(const std::string& vector,
+                                      const std::string& gridName) const
+    {
+        if (! this->decoded_->enabled()) {
+            return this->decodeKeywordData<double>(vector, gridName);
+        }
+
+        const auto key = DecodedArrayKey { this->step_, vector, gridName };
+
+        return *this->decoded_->get(key, [this, &vector, &gridName]()
+        {
+            return this->decodeKeywordData<double>(vector, gridName);
+        });
+    }
+
+    template <typename T>
+    std::vector<T>
+    ECLRestartData::Impl::
+    decodeKeywordData(const std::string& vector,
+                      const std::string& gridName) const
     {
         if (! this->haveKeywordData(vector, gridName)) {
             std::ostringstream os;
@@ -1185,6 +1251,10 @@ public:
 
     const ecl_file_type* getRawFilePtr() const;
 
+    /// Access cache of linearised static arrays.  Shared with all copies
+    /// of this object.
+    ECLStaticArrayCache& staticArrayCache() const;
+
     /// Query current result-set view for availability of particular named
     /// result vector in particular enumerated grid.
     ///
@@ -1276,6 +1346,10 @@ private:
     /// Sections of the INIT result set.
     ECLImpl::InitFileSections sections_;
 
+    /// Keyword arrays linearised on active cells.  Shared with copies,
+    /// which refer to the same underlying data.
+    std::shared_ptr<ECLStaticArrayCache> staticArrays_;
+
     mutable const ecl_file_view_type* activeBlock_{ nullptr };
 
     /// Negative look-up cache for haveKeywordData() queries.
@@ -1302,27 +1376,31 @@ private:
 };
 
 Opm::ECLInitFileData::Impl::Impl(Path initFile)
-    : prefix_  (initFile.stem())
-    , initFile_(openResultSet(deriveInitPath(std::move(initFile))))
-    , sections_(initFile_.get())
+    : prefix_      (initFile.stem())
+    , initFile_    (openResultSet(deriveInitPath(std::move(initFile))))
+    , sections_    (initFile_.get())
+    , staticArrays_(std::make_shared<ECLStaticArrayCache>())
 {}
 
 Opm::ECLInitFileData::Impl::Impl(std::shared_ptr<ecl_file_type> initFile)
-    : prefix_  (Path(ecl_file_get_src_file(initFile.get())).stem())
-    , initFile_(std::move(initFile))
-    , sections_(initFile_.get())
+    : prefix_      (Path(ecl_file_get_src_file(initFile.get())).stem())
+    , initFile_    (std::move(initFile))
+    , sections_    (initFile_.get())
+    , staticArrays_(std::make_shared<ECLStaticArrayCache>())
 {}
 
 Opm::ECLInitFileData::Impl::Impl(const Impl& rhs)
-    : prefix_  (rhs.prefix_)
-    , initFile_(rhs.initFile_)
-    , sections_(initFile_.get())
+    : prefix_      (rhs.prefix_)
+    , initFile_    (rhs.initFile_)
+    , sections_    (initFile_.get())
+    , staticArrays_(rhs.staticArrays_)
 {}
 
 Opm::ECLInitFileData::Impl::Impl(Impl&& rhs)
-    : prefix_  (std::move(rhs.prefix_))
-    , initFile_(std::move(rhs.initFile_))
-    , sections_(std::move(rhs.sections_))
+    : prefix_      (std::move(rhs.prefix_))
+    , initFile_    (std::move(rhs.initFile_))
+    , sections_    (std::move(rhs.sections_))
+    , staticArrays_(std::move(rhs.staticArrays_))
 {}
 
 const ecl_file_type*
@@ -1331,6 +1409,12 @@ Opm::ECLInitFileData::Impl::getRawFilePtr() const
     return this->initFile_.get();
 }
 
+Opm::ECLStaticArrayCache&
+Opm::ECLInitFileData::Impl::staticArrayCache() const
+{
+    return *this->staticArrays_;
+}
+
 bool
 Opm::ECLInitFileData::Impl::
 haveKeywordData(const std::string& vector,
@@ -1685,6 +1769,12 @@ Opm::ECLInitFileData::getRawFilePtr() const
     return this->pImpl_->getRawFilePtr();
 }
 
+Opm::ECLStaticArrayCache&
+Opm::ECLInitFileData::staticArrayCache() const
+{
+    return this->pImpl_->staticArrayCache();
+}
+
 namespace Opm {
 
     template <typename T>
@@ -42,6 +42,7 @@ extern "C" {
 namespace Opm {
 
     class ECLGraph;
+    class ECLStaticArrayCache;
 
     /// Representation of an ECLIPSE Restart result-set.
     ///
@@ -266,7 +267,8 @@ namespace Opm {
         keywordData(const std::string& vector,
                     const std::string& gridID = "") const;
 
-        // Grant class ECLGraph privileged access to getRawFilePtr().
+        // Grant class ECLGraph privileged access to getRawFilePtr() and
+        // staticArrayCache().
         friend class ECLGraph;
 
     private:
@@ -281,6 +283,14 @@ namespace Opm {
         ///
         /// \return Handle to underlying ERT representation of result-set.
         const ecl_file_type* getRawFilePtr() const;
+
+        /// Access cache of keyword arrays linearised on active cells.
+        ///
+        /// Shared by all copies of this object.  Populated by class
+        /// ECLGraph.
+        ///
+        /// \return Static array cache.
+        ECLStaticArrayCache& staticArrayCache() const;
     };
 } // namespace Opm
 
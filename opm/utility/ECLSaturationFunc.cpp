@@ -24,6 +24,7 @@
 #include <opm/utility/ECLSaturationFunc.hpp>
 
 #include <opm/utility/ECLEndPointScaling.hpp>
+#include <opm/utility/ECLExecutor.hpp>
 #include <opm/utility/ECLGraph.hpp>
 #include <opm/utility/ECLPropTable.hpp>
 #include <opm/utility/ECLRegionMapping.hpp>
@@ -38,6 +39,7 @@
 #include <functional>
 #include <memory>
 #include <iterator>
+#include <map>
 #include <string>
 #include <utility>
 
@@ -122,6 +124,9 @@ namespace {
 // =====================================================================
 
 namespace {
+    /// Optional warm-start interval hints.  Null if not in use.
+    using Hints = ::Opm::Interp1D::IntervalHintCache*;
+
     namespace Gas {
         namespace Details {
             Opm::ECLPropTableRawData
@@ -137,9 +142,11 @@ namespace {
         public:
             SatFunction(const std::vector<int>&    tabdims,
                         const std::vector<double>& tab,
-                        const int                  usys)
+                        const int                  usys,
+                        const double               simplifyTol)
                 : func_(Details::tableData(tabdims, tab),
-                        Details::unitConverter(usys))
+                        Details::unitConverter(usys),
+                        simplifyTol)
             {}
 
             std::vector<double> sgco() const
@@ -157,23 +164,56 @@ namespace {
                 return this->func_.maximumSat();
             }
 
+            Opm::Interp1D::RoundingError useSinglePrecision()
+            {
+                return this->func_.useSinglePrecision();
+            }
+
             std::vector<double>
             krg(const std::size_t          regID,
-                const std::vector<double>& sg) const
+                const std::vector<double>& sg,
+                Hints                      hints = nullptr) const
             {
                 const auto t = this->table(regID);
                 const auto c = this->krcol();
 
+                if (hints != nullptr) {
+                    return this->func_.interpolate(t, c, sg, *hints);
+                }
+
                 return this->func_.interpolate(t, c, sg);
             }
 
             std::vector<double>
             pcgo(const std::size_t          regID,
-                 const std::vector<double>& sg) const
+                 const std::vector<double>& sg,
+                 Hints                      hints = nullptr) const
             {
                 const auto t = this->table(regID);
                 const auto c = this->pccol();
 
+                if (hints != nullptr) {
+                    return this->func_.interpolate(t, c, sg, *hints);
+                }
+
+                return this->func_.interpolate(t, c, sg);
+            }
+
+            std::vector<std::vector<double>>
+            krgAndPcgo(const std::size_t          regID,
+                       const std::vector<double>& sg,
+                       Hints                      hints = nullptr) const
+            {
+                const auto t = this->table(regID);
+                const auto c = std::vector<Opm::SatFuncInterpolant::ResultColumn> {
+                    this->krcol(), this->pccol()
+                };
+
+                // Single classification pass for both kr and pc.
+                if (hints != nullptr) {
+                    return this->func_.interpolate(t, c, sg, *hints);
+                }
+
                 return this->func_.interpolate(t, c, sg);
             }
 
@@ -220,9 +260,11 @@ namespace {
         public:
             KrFunction(const std::vector<int>&    tabdims,
                        const bool                 isTwoP,
-                       const std::vector<double>& tab)
+                       const std::vector<double>& tab,
+                       const double               simplifyTol)
                 : func_(Details::tableData(tabdims, isTwoP, tab),
-                        Details::unitConverter(isTwoP))
+                        Details::unitConverter(isTwoP),
+                        simplifyTol)
                 , twop_(isTwoP)
             {}
 
@@ -248,6 +290,11 @@ namespace {
                 return this->func_.maximumSat();
             }
 
+            Opm::Interp1D::RoundingError useSinglePrecision()
+            {
+                return this->func_.useSinglePrecision();
+            }
+
             struct SGas {
                 std::vector<double> data;
             };
@@ -260,14 +307,21 @@ namespace {
                 std::vector<double> data;
             };
 
+            /// Optional interval hints for O/G and O/W sub-systems.
+            struct SubSysHints {
+                Hints og;
+                Hints ow;
+            };
+
             std::vector<double>
-            kro(const std::size_t regID,
-                const SOil&       so_g,
-                const SGas&       sg,
-                const SOil&       so_w,
-                const SWat&       sw) const
+            kro(const std::size_t  regID,
+                const SOil&        so_g,
+                const SGas&        sg,
+                const SOil&        so_w,
+                const SWat&        sw,
+                const SubSysHints& hints = SubSysHints{ nullptr, nullptr }) const
             {
-                return this->kroImpl(regID, so_g, sg, so_w, sw);
+                return this->kroImpl(regID, so_g, sg, so_w, sw, hints);
             }
 
             std::vector<double>
@@ -299,16 +353,18 @@ namespace {
         protected:
             std::vector<double>
             krog(const std::size_t          regID,
-                 const std::vector<double>& so) const
+                 const std::vector<double>& so,
+                 Hints                      hints = nullptr) const
             {
-                return this->eval(regID, this->gas_column(), so);
+                return this->eval(regID, this->gas_column(), so, hints);
             }
 
             std::vector<double>
             krow(const std::size_t          regID,
-                 const std::vector<double>& so) const
+                 const std::vector<double>& so,
+                 Hints                      hints = nullptr) const
             {
-                return this->eval(regID, this->wat_column(), so);
+                return this->eval(regID, this->wat_column(), so, hints);
             }
 
         private:
@@ -351,17 +407,24 @@ namespace {
             std::vector<double>
             eval(const std::size_t          regID,
                  const ResCol               c,
-                 const std::vector<double>& so) const
+                 const std::vector<double>& so,
+                 Hints                      hints) const
             {
+                if (hints != nullptr) {
+                    return this->func_
+                        .interpolate(this->table(regID), c, so, *hints);
+                }
+
                 return this->func_.interpolate(this->table(regID), c, so);
             }
 
             virtual std::vector<double>
-            kroImpl(const std::size_t regID,
-                    const SOil&       so_g,
-                    const SGas&       sg,
-                    const SOil&       so_w,
-                    const SWat&       sw) const = 0;
+            kroImpl(const std::size_t  regID,
+                    const SOil&        so_g,
+                    const SGas&        sg,
+                    const SOil&        so_w,
+                    const SWat&        sw,
+                    const SubSysHints& hints) const = 0;
         };
 
         class TwoPhase : public KrFunction
@@ -371,8 +434,9 @@ namespace {
 
             TwoPhase(const SubSys               subsys,
                      const std::vector<int>&    tabdims,
-                     const std::vector<double>& tab)
-                : KrFunction(tabdims, true, tab)
+                     const std::vector<double>& tab,
+                     const double               simplifyTol)
+                : KrFunction(tabdims, true, tab, simplifyTol)
                 , subsys_   (subsys)
             {}
 
@@ -385,18 +449,19 @@ namespace {
             SubSys subsys_;
 
             virtual std::vector<double>
-            kroImpl(const std::size_t regID,
-                    const SOil&       so_g,
-                    const SGas&    /* sg */,
-                    const SOil&       so_w,
-                    const SWat&    /* sw */) const override
+            kroImpl(const std::size_t  regID,
+                    const SOil&        so_g,
+                    const SGas&     /* sg */,
+                    const SOil&        so_w,
+                    const SWat&     /* sw */,
+                    const SubSysHints& hints) const override
             {
                 switch (this->subsys_) {
                 case SubSys::OilGas:
-                    return this->krog(regID, so_g.data);
+                    return this->krog(regID, so_g.data, hints.og);
 
                 case SubSys::OilWater:
-                    return this->krow(regID, so_w.data);
+                    return this->krow(regID, so_w.data, hints.ow);
                 }
 
                 return {};
@@ -408,8 +473,9 @@ namespace {
         public:
             ECLStdThreePhase(const std::vector<int>&    tabdims,
                              const std::vector<double>& tab,
-                             std::vector<double>        swco)
-                : KrFunction(tabdims, false, tab)
+                             std::vector<double>        swco,
+                             const double               simplifyTol)
+                : KrFunction(tabdims, false, tab, simplifyTol)
                 , swco_     (std::move(swco))
             {}
 
@@ -422,14 +488,15 @@ namespace {
             std::vector<double> swco_;
 
             virtual std::vector<double>
-            kroImpl(const std::size_t regID,
-                    const SOil&       so_g,
-                    const SGas&       sg,
-                    const SOil&       so_w,
-                    const SWat&       sw) const override
+            kroImpl(const std::size_t  regID,
+                    const SOil&        so_g,
+                    const SGas&        sg,
+                    const SOil&        so_w,
+                    const SWat&        sw,
+                    const SubSysHints& hints) const override
             {
-                const auto kr_og = this->krog(regID, so_g.data);
-                const auto kr_ow = this->krow(regID, so_w.data);
+                const auto kr_og = this->krog(regID, so_g.data, hints.og);
+                const auto kr_ow = this->krow(regID, so_w.data, hints.ow);
 
                 const auto swco = this->swco_[regID];
 
@@ -468,9 +535,11 @@ namespace {
         public:
             SatFunction(const std::vector<int>&    tabdims,
                         const std::vector<double>& tab,
-                        const int                  usys)
+                        const int                  usys,
+                        const double               simplifyTol)
                 : func_(Details::tableData(tabdims, tab),
-                        Details::unitConverter(usys))
+                        Details::unitConverter(usys),
+                        simplifyTol)
             {}
 
             std::vector<double> swco() const
@@ -488,23 +557,56 @@ namespace {
                 return this->func_.maximumSat();
             }
 
+            Opm::Interp1D::RoundingError useSinglePrecision()
+            {
+                return this->func_.useSinglePrecision();
+            }
+
             std::vector<double>
             krw(const std::size_t          regID,
-                const std::vector<double>& sw) const
+                const std::vector<double>& sw,
+                Hints                      hints = nullptr) const
             {
                 const auto t = this->table(regID);
                 const auto c = this->krcol();
 
+                if (hints != nullptr) {
+                    return this->func_.interpolate(t, c, sw, *hints);
+                }
+
                 return this->func_.interpolate(t, c, sw);
             }
 
             std::vector<double>
             pcow(const std::size_t          regID,
-                 const std::vector<double>& sw) const
+                 const std::vector<double>& sw,
+                 Hints                      hints = nullptr) const
             {
                 const auto t = this->table(regID);
                 const auto c = this->pccol();
 
+                if (hints != nullptr) {
+                    return this->func_.interpolate(t, c, sw, *hints);
+                }
+
+                return this->func_.interpolate(t, c, sw);
+            }
+
+            std::vector<std::vector<double>>
+            krwAndPcow(const std::size_t          regID,
+                       const std::vector<double>& sw,
+                       Hints                      hints = nullptr) const
+            {
+                const auto t = this->table(regID);
+                const auto c = std::vector<Opm::SatFuncInterpolant::ResultColumn> {
+                    this->krcol(), this->pccol()
+                };
+
+                // Single classification pass for both kr and pc.
+                if (hints != nullptr) {
+                    return this->func_.interpolate(t, c, sw, *hints);
+                }
+
                 return this->func_.interpolate(t, c, sw);
             }
 
@@ -684,18 +786,32 @@ public:
 
     void init(const ECLGraph&        G,
               const ECLInitFileData& init,
-              const bool             useEPS);
+              const bool             useEPS,
+              const double           simplifyTol);
 
     std::vector<double>
     relperm(const ECLGraph&             G,
             const ECLRestartData&       rstrt,
-            const ECLPhaseIndex         p) const;
+            const ECLPhaseIndex         p,
+            const ECLCancellationToken& token) const;
+
+    SatFuncValues
+    relpermAndCapPress(const ECLGraph&             G,
+                       const ECLRestartData&       rstrt,
+                       const ECLPhaseIndex         p,
+                       const ECLCancellationToken& token) const;
 
     std::vector<FlowDiagnostics::Graph>
     getSatFuncCurve(const std::vector<RawCurve>& func,
                     const int                    activeCell,
                     const bool                   useEPS) const;
 
+    void useIntervalHints(const bool enable);
+
+    Interp1D::IntervalHintCache::Statistics intervalHintStatistics() const;
+
+    Interp1D::RoundingError useSinglePrecision();
+
 private:
     class EPSEvaluator
     {
@@ -1099,9 +1215,34 @@ private:
 
     std::unique_ptr<EPSEvaluator> eps_;
 
+    /// Field-wide evaluations that maintain interval hints.
+    enum class HintedCurve {
+        KrGas, KrWat, KrOG, KrOW, KrPcGas, KrPcWat, PcGas, PcWat,
+    };
+
+    /// Whether or not to maintain interval hints in field-wide
+    /// evaluations.
+    bool useHints_{false};
+
+    /// Interval hints for each hinted curve and region, for the region's
+    /// (fixed) subset of active cells.
+    mutable std::map<std::pair<HintedCurve, int>,
+                     Interp1D::IntervalHintCache> hints_;
+
+    Interp1D::IntervalHintCache*
+    hintCache(const HintedCurve curve, const int reg) const
+    {
+        if (! this->useHints_) {
+            return nullptr;
+        }
+
+        return &this->hints_[std::make_pair(curve, reg)];
+    }
+
     void initRelPermInterp(const EPSEvaluator::ActPh& active,
                            const ECLInitFileData&     init,
-                           const int                  usys);
+                           const int                  usys,
+                           const double               simplifyTol);
 
     void initEPS(const EPSEvaluator::ActPh& active,
                  const bool                 use3PtScaling,
@@ -1109,9 +1250,10 @@ private:
                  const ECLInitFileData&     init);
 
     std::vector<double>
-    kro(const ECLGraph&       G,
-        const ECLRestartData& rstrt,
-        const bool            useEPS = true) const;
+    kro(const ECLGraph&             G,
+        const ECLRestartData&       rstrt,
+        const ECLCancellationToken& token,
+        const bool                  useEPS = true) const;
 
     FlowDiagnostics::Graph
     kroCurve(const ECLRegionMapping&    rmap,
@@ -1121,9 +1263,10 @@ private:
              const bool                 useEPS) const;
 
     std::vector<double>
-    krg(const ECLGraph&       G,
-        const ECLRestartData& rstrt,
-        const bool            useEPS = true) const;
+    krg(const ECLGraph&             G,
+        const ECLRestartData&       rstrt,
+        const ECLCancellationToken& token,
+        const bool                  useEPS = true) const;
 
     FlowDiagnostics::Graph
     krgCurve(const ECLRegionMapping&    rmap,
@@ -1131,6 +1274,12 @@ private:
              const std::vector<double>& sg,
              const bool                 useEPS) const;
 
+    SatFuncValues
+    krgPcgo(const ECLGraph&             G,
+            const ECLRestartData&       rstrt,
+            const ECLCancellationToken& token,
+            const bool                  useEPS = true) const;
+
     FlowDiagnostics::Graph
     pcgoCurve(const ECLRegionMapping&    rmap,
               const std::size_t          regID,
@@ -1138,9 +1287,10 @@ private:
               const bool                 useEPS) const;
 
     std::vector<double>
-    krw(const ECLGraph&       G,
-        const ECLRestartData& rstrt,
-        const bool            useEPS = true) const;
+    krw(const ECLGraph&             G,
+        const ECLRestartData&       rstrt,
+        const ECLCancellationToken& token,
+        const bool                  useEPS = true) const;
 
     FlowDiagnostics::Graph
     krwCurve(const ECLRegionMapping&    rmap,
@@ -1148,6 +1298,12 @@ private:
              const std::vector<double>& sw,
              const bool                 useEPS) const;
 
+    SatFuncValues
+    krwPcow(const ECLGraph&             G,
+            const ECLRestartData&       rstrt,
+            const ECLCancellationToken& token,
+            const bool                  useEPS = true) const;
+
     FlowDiagnostics::Graph
     pcowCurve(const ECLRegionMapping&    rmap,
               const std::size_t          regID,
@@ -1213,12 +1369,26 @@ private:
     }
 
     template <class RegionOperation>
-    void regionLoop(const ECLRegionMapping& rmap,
-                    RegionOperation&&       regOp) const
+    void regionLoop(const ECLRegionMapping&     rmap,
+                    const ECLCancellationToken& token,
+                    RegionOperation&&           regOp) const
     {
-        for (const auto& regID : rmap.activeRegions()) {
-            regOp(regID, rmap);
-        }
+        const auto regions = rmap.activeRegions();
+
+        // Regions write to disjoint cell subsets, but interval hints are
+        // created on demand in a shared map.  Process regions serially if
+        // hints are enabled.
+        const auto grain = this->useHints_
+            ? regions.size() : std::size_t{1};
+
+        ECLExecution::parallelFor(regions.size(), grain, token,
+            [&regions, &rmap, &regOp]
+            (const std::size_t begin, const std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i) {
+                regOp(regions[i], rmap);
+            }
+        });
     }
 };
 
@@ -1235,6 +1405,8 @@ Opm::ECLSaturationFunc::Impl::Impl(Impl&& rhs)
     , oil_   (std::move(rhs.oil_ ))
     , gas_   (std::move(rhs.gas_ ))
     , wat_   (std::move(rhs.wat_ ))
+    , useHints_(rhs.useHints_)
+    , hints_   (std::move(rhs.hints_))
 {}
 
 // ---------------------------------------------------------------------
@@ -1242,7 +1414,8 @@ Opm::ECLSaturationFunc::Impl::Impl(Impl&& rhs)
 void
 Opm::ECLSaturationFunc::Impl::init(const ECLGraph&        G,
                                    const ECLInitFileData& init,
-                                   const bool             useEPS)
+                                   const bool             useEPS,
+                                   const double           simplifyTol)
 {
     // Extract INTEHEAD from main grid
     const auto& ih   = init.keywordData<int>(INTEHEAD_KW);
@@ -1250,7 +1423,8 @@ Opm::ECLSaturationFunc::Impl::init(const ECLGraph&        G,
 
     const auto active = EPSEvaluator::ActPh{iphs};
 
-    this->initRelPermInterp(active, init, ih[INTEHEAD_UNIT_INDEX]);
+    this->initRelPermInterp(active, init, ih[INTEHEAD_UNIT_INDEX],
+                            simplifyTol);
 
     if (useEPS) {
         const auto& lh = init.keywordData<bool>(LOGIHEAD_KW);
@@ -1272,7 +1446,8 @@ void
 Opm::ECLSaturationFunc::
 Impl::initRelPermInterp(const EPSEvaluator::ActPh& active,
                         const ECLInitFileData&     init,
-                        const int                  usys)
+                        const int                  usys,
+                        const double               simplifyTol)
 {
     const auto isThreePh =
         active.oil && active.gas && active.wat;
@@ -1282,11 +1457,13 @@ Impl::initRelPermInterp(const EPSEvaluator::ActPh& active,
     const auto& tab     = init.keywordData<double>("TAB");
 
     if (active.gas) {
-        this->gas_.reset(new Gas::SatFunction(tabdims, tab, usys));
+        this->gas_.reset(new Gas::SatFunction(tabdims, tab, usys,
+                                              simplifyTol));
     }
 
     if (active.wat) {
-        this->wat_.reset(new Water::SatFunction(tabdims, tab, usys));
+        this->wat_.reset(new Water::SatFunction(tabdims, tab, usys,
+                                                simplifyTol));
     }
 
     if (active.oil) {
@@ -1296,12 +1473,14 @@ Impl::initRelPermInterp(const EPSEvaluator::ActPh& active,
             if (active.gas) {
                 const auto subsys = KrModel::SubSys::OilGas;
 
-                this->oil_.reset(new KrModel(subsys, tabdims, tab));
+                this->oil_.reset(new KrModel(subsys, tabdims, tab,
+                                             simplifyTol));
             }
             else if (active.wat) {
                 const auto subsys = KrModel::SubSys::OilWater;
 
-                this->oil_.reset(new KrModel(subsys, tabdims, tab));
+                this->oil_.reset(new KrModel(subsys, tabdims, tab,
+                                             simplifyTol));
             }
             else {
                 throw std::invalid_argument {
@@ -1313,7 +1492,8 @@ Impl::initRelPermInterp(const EPSEvaluator::ActPh& active,
         if (isThreePh) {
             using KrModel = Oil::ECLStdThreePhase;
 
-            this->oil_.reset(new KrModel(tabdims, tab, this->wat_->swco()));
+            this->oil_.reset(new KrModel(tabdims, tab, this->wat_->swco(),
+                                         simplifyTol));
         }
     }
 }
@@ -1334,7 +1514,8 @@ Impl::initEPS(const EPSEvaluator::ActPh& active,
 // #####################################################################
 
 Opm::ECLSaturationFunc::Impl::Impl(const Impl& rhs)
-    : rmap_(rhs.rmap_)
+    : rmap_    (rhs.rmap_)
+    , useHints_(rhs.useHints_)
 {
     if (rhs.oil_) {
         // Polymorphic object must use clone().
@@ -1354,19 +1535,43 @@ Opm::ECLSaturationFunc::Impl::Impl(const Impl& rhs)
 
 std::vector<double>
 Opm::ECLSaturationFunc::Impl::
-relperm(const ECLGraph&       G,
-        const ECLRestartData& rstrt,
-        const ECLPhaseIndex   p) const
+relperm(const ECLGraph&             G,
+        const ECLRestartData&       rstrt,
+        const ECLPhaseIndex         p,
+        const ECLCancellationToken& token) const
+{
+    switch (p) {
+    case ECLPhaseIndex::Aqua:
+        return this->krw(G, rstrt, token);
+
+    case ECLPhaseIndex::Liquid:
+        return this->kro(G, rstrt, token);
+
+    case ECLPhaseIndex::Vapour:
+        return this->krg(G, rstrt, token);
+    }
+
+    return {};
+}
+
+Opm::ECLSaturationFunc::SatFuncValues
+Opm::ECLSaturationFunc::Impl::
+relpermAndCapPress(const ECLGraph&             G,
+                   const ECLRestartData&       rstrt,
+                   const ECLPhaseIndex         p,
+                   const ECLCancellationToken& token) const
 {
     switch (p) {
     case ECLPhaseIndex::Aqua:
-        return this->krw(G, rstrt);
+        return this->krwPcow(G, rstrt, token);
 
     case ECLPhaseIndex::Liquid:
-        return this->kro(G, rstrt);
+        // Capillary pressure is defined relative to the oil phase, so
+        // there is no separate oil capillary pressure function.
+        return SatFuncValues{ this->kro(G, rstrt, token), {} };
 
     case ECLPhaseIndex::Vapour:
-        return this->krg(G, rstrt);
+        return this->krgPcgo(G, rstrt, token);
     }
 
     return {};
@@ -1503,11 +1708,54 @@ getSatFuncCurve(const std::vector<RawCurve>& func,
     return graph;
 }
 
+void
+Opm::ECLSaturationFunc::Impl::useIntervalHints(const bool enable)
+{
+    this->useHints_ = enable;
+
+    if (! enable) {
+        this->hints_.clear();
+    }
+}
+
+Opm::Interp1D::IntervalHintCache::Statistics
+Opm::ECLSaturationFunc::Impl::intervalHintStatistics() const
+{
+    auto stats = Interp1D::IntervalHintCache::Statistics{};
+
+    for (const auto& hint : this->hints_) {
+        stats += hint.second.statistics();
+    }
+
+    return stats;
+}
+
+Opm::Interp1D::RoundingError
+Opm::ECLSaturationFunc::Impl::useSinglePrecision()
+{
+    auto error = Interp1D::RoundingError{};
+
+    if (this->oil_) {
+        error += this->oil_->useSinglePrecision();
+    }
+
+    if (this->gas_) {
+        error += this->gas_->useSinglePrecision();
+    }
+
+    if (this->wat_) {
+        error += this->wat_->useSinglePrecision();
+    }
+
+    return error;
+}
+
 std::vector<double>
 Opm::ECLSaturationFunc::Impl::
-kro(const ECLGraph&       G,
-    const ECLRestartData& rstrt,
-    const bool            useEPS) const
+kro(const ECLGraph&             G,
+    const ECLRestartData&       rstrt,
+    const ECLCancellationToken& token,
+    const bool                  useEPS) const
 {
     auto kr = std::vector<double>{};
 
@@ -1529,7 +1777,7 @@ kro(const ECLGraph&       G,
     kr.resize(so_g.size(), 0.0);
 
     // Compute relative permeability per region.
-    this->regionLoop(this->rmap_,
+    this->regionLoop(this->rmap_, token,
         [this, &so_g, &so_w, &sg, &sw, &kr]
         (const int               reg,
          const ECLRegionMapping& rmap)
@@ -1554,8 +1802,13 @@ kro(const ECLGraph&       G,
 
         // Region ID 'reg' is traditional, ECL-style one-based region ID
         // (SATNUM).  Subtract one to create valid table index.
+        const auto hints = Oil::KrFunction::SubSysHints {
+            this->hintCache(HintedCurve::KrOG, reg),
+            this->hintCache(HintedCurve::KrOW, reg)
+        };
+
         const auto& kro_reg =
-            this->oil_->kro(reg - 1, So_g, Sg, So_w, Sw);
+            this->oil_->kro(reg - 1, So_g, Sg, So_w, Sw, hints);
 
         this->scatterRegionResults(reg, rmap, kro_reg, kr);
     });
@@ -1614,9 +1867,10 @@ kroCurve(const ECLRegionMapping&    rmap,
 
 std::vector<double>
 Opm::ECLSaturationFunc::Impl::
-krg(const ECLGraph&       G,
-    const ECLRestartData& rstrt,
-    const bool            useEPS) const
+krg(const ECLGraph&             G,
+    const ECLRestartData&       rstrt,
+    const ECLCancellationToken& token,
+    const bool                  useEPS) const
 {
     auto kr = std::vector<double>{};
 
@@ -1636,7 +1890,7 @@ krg(const ECLGraph&       G,
     kr.resize(sg.size(), 0.0);
 
     // Compute relative permeability per region.
-    this->regionLoop(this->rmap_,
+    this->regionLoop(this->rmap_, token,
         [this, &sg, &kr](const int               reg,
                          const ECLRegionMapping& rmap)
     {
@@ -1646,7 +1900,8 @@ krg(const ECLGraph&       G,
         // Region ID 'reg' is traditional, ECL-style one-based region ID
         // (SATNUM).  Subtract one to create valid table index.
         const auto krg_reg =
-            this->gas_->krg(reg - 1, sg_reg);
+            this->gas_->krg(reg - 1, sg_reg,
+                            this->hintCache(HintedCurve::KrGas, reg));
 
         this->scatterRegionResults(reg, rmap, krg_reg, kr);
     });
@@ -1690,6 +1945,79 @@ krgCurve(const ECLRegionMapping&    rmap,
     };
 }
 
+Opm::ECLSaturationFunc::SatFuncValues
+Opm::ECLSaturationFunc::Impl::
+krgPcgo(const ECLGraph&             G,
+        const ECLRestartData&       rstrt,
+        const ECLCancellationToken& token,
+        const bool                  useEPS) const
+{
+    auto result = SatFuncValues{};
+
+    if (! this->gas_) {
+        return result;
+    }
+
+    auto sg = G.rawLinearisedCellData<double>(rstrt, "SGAS");
+
+    // Allocate result.  Member function scatterRegionResult() depends on
+    // having an allocated result vector into which to write the values from
+    // a single region.
+    result.relperm .resize(sg.size(), 0.0);
+    result.capPress.resize(sg.size(), 0.0);
+
+    if (useEPS && this->eps_) {
+        // Relative permeability and capillary pressure are subject to
+        // distinct end-point scaling whence the scaled saturations differ
+        // and the table lookup cannot be shared.  Evaluate separately.
+        auto sg_pc = sg;
+
+        this->eps_->scaleKrGas(this->rmap_, sg);
+        this->eps_->scalePcGO(this->rmap_, sg_pc);
+
+        this->regionLoop(this->rmap_, token,
+            [this, &sg, &sg_pc, &result]
+            (const int reg, const ECLRegionMapping& rmap)
+        {
+            // Region ID 'reg' is traditional, ECL-style one-based region
+            // ID (SATNUM).  Subtract one to create valid table index.
+            const auto krg_reg = this->gas_->krg(reg - 1,
+                this->gatherRegionSubset(reg, rmap, sg),
+                this->hintCache(HintedCurve::KrGas, reg));
+
+            const auto pcgo_reg = this->gas_->pcgo(reg - 1,
+                this->gatherRegionSubset(reg, rmap, sg_pc),
+                this->hintCache(HintedCurve::PcGas, reg));
+
+            this->scatterRegionResults(reg, rmap, krg_reg, result.relperm);
+            this->scatterRegionResults(reg, rmap, pcgo_reg, result.capPress);
+        });
+
+        return result;
+    }
+
+    // Compute relative permeability and capillary pressure per region
+    // from a single table lookup.
+    this->regionLoop(this->rmap_, token,
+        [this, &sg, &result](const int               reg,
+                              const ECLRegionMapping& rmap)
+    {
+        const auto sg_reg =
+            this->gatherRegionSubset(reg, rmap, sg);
+
+        // Region ID 'reg' is traditional, ECL-style one-based region ID
+        // (SATNUM).  Subtract one to create valid table index.
+        const auto krpc_reg =
+            this->gas_->krgAndPcgo(reg - 1, sg_reg,
+                this->hintCache(HintedCurve::KrPcGas, reg));
+
+        this->scatterRegionResults(reg, rmap, krpc_reg[0], result.relperm);
+        this->scatterRegionResults(reg, rmap, krpc_reg[1], result.capPress);
+    });
+
+    return result;
+}
+
 Opm::FlowDiagnostics::Graph
 Opm::ECLSaturationFunc::Impl::
 pcgoCurve(const ECLRegionMapping&    rmap,
@@ -1728,9 +2056,10 @@ pcgoCurve(const ECLRegionMapping&    rmap,
 
 std::vector<double>
 Opm::ECLSaturationFunc::Impl::
-krw(const ECLGraph&       G,
-    const ECLRestartData& rstrt,
-    const bool            useEPS) const
+krw(const ECLGraph&             G,
+    const ECLRestartData&       rstrt,
+    const ECLCancellationToken& token,
+    const bool                  useEPS) const
 {
     auto kr = std::vector<double>{};
 
@@ -1750,7 +2079,7 @@ krw(const ECLGraph&       G,
     kr.resize(sw.size(), 0.0);
 
     // Compute relative permeability per region.
-    this->regionLoop(this->rmap_,
+    this->regionLoop(this->rmap_, token,
         [this, &sw, &kr](const int               reg,
                          const ECLRegionMapping& rmap)
     {
@@ -1760,7 +2089,8 @@ krw(const ECLGraph&       G,
         // Region ID 'reg' is traditional, ECL-style one-based region ID
         // (SATNUM).  Subtract one to create valid table index.
         const auto krw_reg =
-            this->wat_->krw(reg - 1, sw_reg);
+            this->wat_->krw(reg - 1, sw_reg,
+                            this->hintCache(HintedCurve::KrWat, reg));
 
         this->scatterRegionResults(reg, rmap, krw_reg, kr);
     });
@@ -1804,6 +2134,79 @@ krwCurve(const ECLRegionMapping&    rmap,
     };
 }
 
+Opm::ECLSaturationFunc::SatFuncValues
+Opm::ECLSaturationFunc::Impl::
+krwPcow(const ECLGraph&             G,
+        const ECLRestartData&       rstrt,
+        const ECLCancellationToken& token,
+        const bool                  useEPS) const
+{
+    auto result = SatFuncValues{};
+
+    if (! this->wat_) {
+        return result;
+    }
+
+    auto sw = G.rawLinearisedCellData<double>(rstrt, "SWAT");
+
+    // Allocate result.  Member function scatterRegionResult() depends on
+    // having an allocated result vector into which to write the values from
+    // a single region.
+    result.relperm .resize(sw.size(), 0.0);
+    result.capPress.resize(sw.size(), 0.0);
+
+    if (useEPS && this->eps_) {
+        // Relative permeability and capillary pressure are subject to
+        // distinct end-point scaling whence the scaled saturations differ
+        // and the table lookup cannot be shared.  Evaluate separately.
+        auto sw_pc = sw;
+
+        this->eps_->scaleKrWat(this->rmap_, sw);
+        this->eps_->scalePcOW(this->rmap_, sw_pc);
+
+        this->regionLoop(this->rmap_, token,
+            [this, &sw, &sw_pc, &result]
+            (const int reg, const ECLRegionMapping& rmap)
+        {
+            // Region ID 'reg' is traditional, ECL-style one-based region
+            // ID (SATNUM).  Subtract one to create valid table index.
+            const auto krw_reg = this->wat_->krw(reg - 1,
+                this->gatherRegionSubset(reg, rmap, sw),
+                this->hintCache(HintedCurve::KrWat, reg));
+
+            const auto pcow_reg = this->wat_->pcow(reg - 1,
+                this->gatherRegionSubset(reg, rmap, sw_pc),
+                this->hintCache(HintedCurve::PcWat, reg));
+
+            this->scatterRegionResults(reg, rmap, krw_reg, result.relperm);
+            this->scatterRegionResults(reg, rmap, pcow_reg, result.capPress);
+        });
+
+        return result;
+    }
+
+    // Compute relative permeability and capillary pressure per region
+    // from a single table lookup.
+    this->regionLoop(this->rmap_, token,
+        [this, &sw, &result](const int               reg,
+                              const ECLRegionMapping& rmap)
+    {
+        const auto sw_reg =
+            this->gatherRegionSubset(reg, rmap, sw);
+
+        // Region ID 'reg' is traditional, ECL-style one-based region ID
+        // (SATNUM).  Subtract one to create valid table index.
+        const auto krpc_reg =
+            this->wat_->krwAndPcow(reg - 1, sw_reg,
+                this->hintCache(HintedCurve::KrPcWat, reg));
+
+        this->scatterRegionResults(reg, rmap, krpc_reg[0], result.relperm);
+        this->scatterRegionResults(reg, rmap, krpc_reg[1], result.capPress);
+    });
+
+    return result;
+}
+
 Opm::FlowDiagnostics::Graph
 Opm::ECLSaturationFunc::Impl::
 pcowCurve(const ECLRegionMapping&    rmap,
@@ -1943,10 +2346,11 @@ extractRawTableEndPoints(const EPSEvaluator::ActPh& active) const
 Opm::ECLSaturationFunc::
 ECLSaturationFunc(const ECLGraph&        G,
                   const ECLInitFileData& init,
-                  const bool             useEPS)
+                  const bool             useEPS,
+                  const double           simplifyTol)
     : pImpl_(new Impl(G, init))
 {
-    this->pImpl_->init(G, init, useEPS);
+    this->pImpl_->init(G, init, useEPS, simplifyTol);
 }
 
 Opm::ECLSaturationFunc::~ECLSaturationFunc()
@@ -1978,11 +2382,22 @@ Opm::ECLSaturationFunc::operator=(const ECLSaturationFunc& rhs)
 
 std::vector<double>
 Opm::ECLSaturationFunc::
-relperm(const ECLGraph&       G,
-        const ECLRestartData& rstrt,
-        const ECLPhaseIndex   p) const
+relperm(const ECLGraph&             G,
+        const ECLRestartData&       rstrt,
+        const ECLPhaseIndex         p,
+        const ECLCancellationToken& token) const
+{
+    return this->pImpl_->relperm(G, rstrt, p, token);
+}
+
+Opm::ECLSaturationFunc::SatFuncValues
+Opm::ECLSaturationFunc::
+relpermAndCapPress(const ECLGraph&             G,
+                   const ECLRestartData&       rstrt,
+                   const ECLPhaseIndex         p,
+                   const ECLCancellationToken& token) const
 {
-    return this->pImpl_->relperm(G, rstrt, p);
+    return this->pImpl_->relpermAndCapPress(G, rstrt, p, token);
 }
 
 std::vector<Opm::FlowDiagnostics::Graph>
@@ -1993,3 +2408,20 @@ getSatFuncCurve(const std::vector<RawCurve>& func,
 {
     return this->pImpl_->getSatFuncCurve(func, activeCell, useEPS);
 }
+
+void Opm::ECLSaturationFunc::useIntervalHints(const bool enable)
+{
+    this->pImpl_->useIntervalHints(enable);
+}
+
+Opm::Interp1D::IntervalHintCache::Statistics
+Opm::ECLSaturationFunc::intervalHintStatistics() const
+{
+    return this->pImpl_->intervalHintStatistics();
+}
+
+Opm::Interp1D::RoundingError
+Opm::ECLSaturationFunc::useSinglePrecision()
+{
+    return this->pImpl_->useSinglePrecision();
+}
@@ -21,7 +21,9 @@
 #define OPM_ECLSATURATIONFUNC_HEADER_INCLUDED
 
 #include <opm/flowdiagnostics/DerivedQuantities.hpp>
+#include <opm/utility/ECLCancellation.hpp>
 #include <opm/utility/ECLPhaseIndex.hpp>
+#include <opm/utility/ECLTableInterpolation1D.hpp>
 
 #include <memory>
 #include <vector>
@@ -77,6 +79,19 @@ namespace Opm {
             ECLPhaseIndex thisPh;
         };
 
+        /// Relative permeability and capillary pressure values of a
+        /// single phase in all active cells.
+        struct SatFuncValues
+        {
+            /// Relative permeability values.
+            std::vector<double> relperm;
+
+            /// Capillary pressure values in strict SI units (Pascal).
+            /// Pcow for the aqueous phase, Pcgo for the vapour phase and
+            /// empty for the liquid (oil) phase.
+            std::vector<double> capPress;
+        };
+
         /// Constructor
         ///
         /// \param[in] G Connected topology of current model's active cells.
@@ -96,9 +111,16 @@ namespace Opm {
         ///
         ///    Default value (\c true) means that effects of EPS are
         ///    included if requisite data is present in the INIT result.
+        ///
+        /// \param[in] simplifyTol Relative tolerance for removing table
+        ///    nodes that are reproduced by linear interpolation between
+        ///    their neighbours.  Negative (the default) retains all nodes,
+        ///    so saturation function curves have the nodes of the input
+        ///    tables.  Zero removes only nodes that are reproduced exactly.
         ECLSaturationFunc(const ECLGraph&        G,
                           const ECLInitFileData& init,
-                          const bool             useEPS = true);
+                          const bool             useEPS      = true,
+                          const double           simplifyTol = -1.0);
 
         /// Destructor.
         ~ECLSaturationFunc();
@@ -152,13 +174,49 @@ namespace Opm {
         /// \param[in] p Phase for which to compute relative permeability
         ///    values.
         ///
+        /// \param[in] token Cancellation token.  Checked per region.
+        ///    Throws ECLOperationCancelled once cancelled.
+        ///
         /// \return Derived relative permeability values of active phase \p
         ///    p for all active cells in model \p G.  Empty if phase \p p is
         ///    not actually active in the current result set.
         std::vector<double>
-        relperm(const ECLGraph&       G,
-                const ECLRestartData& rstrt,
-                const ECLPhaseIndex   p) const;
+        relperm(const ECLGraph&             G,
+                const ECLRestartData&       rstrt,
+                const ECLPhaseIndex         p,
+                const ECLCancellationToken& token =
+                    ECLCancellationToken{}) const;
+
+        /// Compute relative permeability and capillary pressure values in
+        /// all active cells for a single phase.
+        ///
+        /// Both quantities are derived from a single pass over the
+        /// tabulated saturation function when end-point scaling is
+        /// inactive.  Otherwise, the distinct kr and pc scaling of the
+        /// phase saturation requires separate table lookups.
+        ///
+        /// \param[in] G Connected topology of current model's active cells.
+        ///
+        /// \param[in] rstrt ECLIPSE restart vectors.  Result set view
+        ///    assumed to be positioned at a particular report step of
+        ///    interest.
+        ///
+        /// \param[in] p Phase for which to compute saturation function
+        ///    values.
+        ///
+        /// \param[in] token Cancellation token.  Checked per region.
+        ///    Throws ECLOperationCancelled once cancelled.
+        ///
+        /// \return Derived relative permeability and capillary pressure
+        ///    values of active phase \p p for all active cells in model \p
+        ///    G.  Both members empty if phase \p p is not active in the
+        ///    current result set.
+        SatFuncValues
+        relpermAndCapPress(const ECLGraph&             G,
+                           const ECLRestartData&       rstrt,
+                           const ECLPhaseIndex         p,
+                           const ECLCancellationToken& token =
+                               ECLCancellationToken{}) const;
 
         /// Retrieve 2D graph representations of sequence of effective
         /// saturation functions in a single cell.
@@ -224,6 +282,42 @@ namespace Opm {
                         const int                    activeCell,
                         const bool                   useEPS = true) const;
 
+        /// Enable or disable warm-start interval hints in field-wide
+        /// evaluations (member functions \code relperm() \endcode and
+        /// \code relpermAndCapPress() \endcode).
+        ///
+        /// When enabled, the engine remembers the table interval of each
+        /// active cell's saturation and checks that interval and its
+        /// neighbours first on the next evaluation.  Most cells stay in
+        /// the same interval between consecutive report steps, so this
+        /// usually avoids the full table search.  Results are unaffected.
+        /// Disabled by default.  Disabling discards all hints.
+        ///
+        /// \param[in] enable Whether or not to maintain interval hints.
+        void useIntervalHints(const bool enable);
+
+        /// Retrieve accumulated hit rate statistics of warm-start interval
+        /// hints across all saturation functions and regions.
+        ///
+        /// \return Hint statistics.  All zero unless interval hints have
+        ///    been enabled.
+        Interp1D::IntervalHintCache::Statistics
+        intervalHintStatistics() const;
+
+        /// Store saturation function tables of all regions in single
+        /// precision.
+        ///
+        /// Halves the size of the tabulated relative permeability and
+        /// capillary pressure values, allowing more saturation regions to
+        /// remain cache resident during per-cell evaluation.
+        /// Interpolation still accumulates in double precision, and
+        /// saturation points, end points and critical saturations are
+        /// unaffected.  Call once, immediately after construction.
+        ///
+        /// \return Rounding error of the stored tables relative to the
+        ///    original, double precision tables.
+        Interp1D::RoundingError useSinglePrecision();
+
     private:
         /// Implementation backend.
         class Impl;
@@ -0,0 +1,699 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLSharedFields.hpp>
+
+#include <opm/utility/ECLGraph.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// \file
+///
+/// Implementation of shared memory field publication.
+
+namespace {
+    namespace Shared {
+        /// Identifies directory segments.
+        const char magic[8] = { 'O', 'P', 'M', 'S', 'H', 'F', 'L', 'D' };
+
+        /// Version of directory layout.  Increment on incompatible change.
+        const std::uint32_t formatVersion = 1;
+
+        /// Directory header.  Start of directory segment.
+        struct Header {
+            char          magic[8];
+            std::uint32_t formatVersion;
+            std::uint32_t maxFields;
+
+            /// Sequence lock.  Odd while publisher updates the directory.
+            /// Also serves as directory version.
+            std::atomic<std::uint64_t> sequence;
+
+            /// Number of valid directory entries.
+            std::uint64_t numFields;
+        };
+
+        /// Directory entry.  Directory segment holds 'maxFields' of these
+        /// immediately following the header.
+        struct Entry {
+            char          name[64];
+            char          segment[128];
+            std::uint32_t type;
+            std::int32_t  step;
+            std::uint64_t size;
+            std::uint64_t generation;
+        };
+
+        std::size_t directorySize(const std::size_t maxFields)
+        {
+            return sizeof(Header) + maxFields*sizeof(Entry);
+        }
+
+        Entry* entries(Header* h)
+        {
+            return reinterpret_cast<Entry*>(h + 1);
+        }
+
+        const Entry* entries(const Header* h)
+        {
+            return reinterpret_cast<const Entry*>(h + 1);
+        }
+
+        void throwSystemError(const std::string& what)
+        {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        /// RAII wrapper around a memory mapping.
+        class Mapping
+        {
+        public:
+            Mapping() = default;
+
+            Mapping(void* addr, const std::size_t len)
+                : addr_(addr), len_(len)
+            {}
+
+            ~Mapping()
+            {
+                if (this->addr_ != nullptr) {
+                    ::munmap(this->addr_, this->len_);
+                }
+            }
+
+            Mapping(Mapping&& rhs)
+                : addr_(rhs.addr_), len_(rhs.len_)
+            {
+                rhs.addr_ = nullptr;
+                rhs.len_  = 0;
+            }
+
+            Mapping& operator=(Mapping&& rhs)
+            {
+                std::swap(this->addr_, rhs.addr_);
+                std::swap(this->len_ , rhs.len_);
+
+                return *this;
+            }
+
+            Mapping(const Mapping&) = delete;
+            Mapping& operator=(const Mapping&) = delete;
+
+            void* get() const
+            {
+                return this->addr_;
+            }
+
+            std::size_t size() const
+            {
+                return this->len_;
+            }
+
+        private:
+            void*       addr_{nullptr};
+            std::size_t len_{0};
+        };
+
+        /// Create new, writable segment.  Fails if segment exists.
+        Mapping create(const std::string& name, const std::size_t len)
+        {
+            const auto fd = ::shm_open(name.c_str(),
+                                       O_CREAT | O_EXCL | O_RDWR, 0644);
+            if (fd < 0) {
+                throwSystemError("Failed to Create Shared Segment " + name);
+            }
+
+            if (::ftruncate(fd, static_cast<off_t>(len)) != 0) {
+                const auto err = errno;
+                ::close(fd);  ::shm_unlink(name.c_str());
+
+                errno = err;
+                throwSystemError("Failed to Size Shared Segment " + name);
+            }
+
+            auto* addr = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                                MAP_SHARED, fd, 0);
+            ::close(fd);
+
+            if (addr == MAP_FAILED) {
+                const auto err = errno;
+                ::shm_unlink(name.c_str());
+
+                errno = err;
+                throwSystemError("Failed to Map Shared Segment " + name);
+            }
+
+            return Mapping{ addr, len };
+        }
+
+        /// Map existing segment read-only.  Returns empty mapping if the
+        /// segment does not exist.
+        Mapping openReadOnly(const std::string& name)
+        {
+            const auto fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0) {
+                if (errno == ENOENT) { return Mapping{}; }
+
+                throwSystemError("Failed to Open Shared Segment " + name);
+            }
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                const auto err = errno;
+                ::close(fd);
+
+                errno = err;
+                throwSystemError("Failed to Query Shared Segment " + name);
+            }
+
+            const auto len = static_cast<std::size_t>(st.st_size);
+
+            auto* addr = ::mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+
+            if (addr == MAP_FAILED) {
+                throwSystemError("Failed to Map Shared Segment " + name);
+            }
+
+            return Mapping{ addr, len };
+        }
+
+        void validateName(const std::string& name,
+                          const std::size_t  maxLen,
+                          const char*        what)
+        {
+            if (name.empty() || (name.size() >= maxLen) ||
+                (name.find('/') != std::string::npos))
+            {
+                throw std::invalid_argument {
+                    std::string("Invalid ") + what + " Name '" + name + '\''
+                };
+            }
+        }
+
+        template <typename T>
+        struct ElementType;
+
+        template <>
+        struct ElementType<double> {
+            static constexpr ::Opm::ECLSharedFieldType value =
+                ::Opm::ECLSharedFieldType::Double;
+        };
+
+        template <>
+        struct ElementType<int> {
+            static constexpr ::Opm::ECLSharedFieldType value =
+                ::Opm::ECLSharedFieldType::Int;
+        };
+    } // namespace Shared
+} // Anonymous namespace
+
+// =====================================================================
+// Class ECLSharedFieldPublisher::Impl
+// ---------------------------------------------------------------------
+
+class Opm::ECLSharedFieldPublisher::Impl
+{
+public:
+    Impl(const std::string& name,
+         const std::size_t  maxFields);
+
+    ~Impl();
+
+    template <typename T>
+    void publish(const std::string&    field,
+                 const std::vector<T>& x,
+                 const int             step);
+
+private:
+    /// Directory segment name.
+    std::string name_;
+
+    /// Directory segment.
+    Shared::Mapping dir_;
+
+    Shared::Header* header() const
+    {
+        return static_cast<Shared::Header*>(this->dir_.get());
+    }
+
+    Shared::Entry* find(const std::string& field) const;
+};
+
+Opm::ECLSharedFieldPublisher::Impl::Impl(const std::string& name,
+                                         const std::size_t  maxFields)
+    : name_('/' + name)
+{
+    Shared::validateName(name, 128 - 64, "Publication");
+
+    if (maxFields == 0) {
+        throw std::invalid_argument {
+            "Shared Field Directory Must Admit At Least One Field"
+        };
+    }
+
+    this->dir_ = Shared::create(this->name_,
+                                Shared::directorySize(maxFields));
+
+    auto* h = new (this->dir_.get()) Shared::Header{};
+
+    std::copy(std::begin(Shared::magic), std::end(Shared::magic), h->magic);
+    h->formatVersion = Shared::formatVersion;
+    h->maxFields     = static_cast<std::uint32_t>(maxFields);
+    h->numFields     = 0;
+
+    h->sequence.store(0, std::memory_order_release);
+}
+
+Opm::ECLSharedFieldPublisher::Impl::~Impl()
+{
+    const auto* h = this->header();
+    const auto* e = Shared::entries(h);
+
+    for (auto n = h->numFields, i = 0*n; i < n; ++i) {
+        if (e[i].segment[0] != '\0') {
+            ::shm_unlink(e[i].segment);
+        }
+    }
+
+    ::shm_unlink(this->name_.c_str());
+}
+
+Shared::Entry*
+Opm::ECLSharedFieldPublisher::Impl::find(const std::string& field) const
+{
+    auto* h = this->header();
+    auto* e = Shared::entries(h);
+
+    for (auto n = h->numFields, i = 0*n; i < n; ++i) {
+        if (field == e[i].name) {
+            return &e[i];
+        }
+    }
+
+    return nullptr;
+}
+
+template <typename T>
+void
+Opm::ECLSharedFieldPublisher::Impl::publish(const std::string&    field,
+                                            const std::vector<T>& x,
+                                            const int             step)
+{
+    Shared::validateName(field, sizeof(Shared::Entry::name), "Field");
+
+    auto* h = this->header();
+    auto* e = this->find(field);
+
+    if ((e == nullptr) && (h->numFields == h->maxFields)) {
+        throw std::length_error {
+            "Shared Field Directory Full"
+        };
+    }
+
+    const auto generation = (e == nullptr) ? 1 : e->generation + 1;
+
+    // Write values to new data segment first.  Empty fields have no data
+    // segment.
+    auto segment = std::string{};
+    if (! x.empty()) {
+        segment = this->name_ + '.' + field + '.' + std::to_string(generation);
+
+        if (segment.size() >= sizeof(Shared::Entry::segment)) {
+            throw std::invalid_argument {
+                "Shared Segment Name Too Long for '" + field + '\''
+            };
+        }
+
+        const auto data = Shared::create(segment, x.size() * sizeof(T));
+
+        std::memcpy(data.get(), x.data(), x.size() * sizeof(T));
+    }
+
+    auto previous = (e == nullptr) ? std::string{} : std::string(e->segment);
+
+    // Then switch directory entry over to the new segment.
+    h->sequence.fetch_add(1, std::memory_order_acq_rel);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (e == nullptr) {
+        e = Shared::entries(h) + h->numFields;
+
+        *e = Shared::Entry{};
+        std::strncpy(e->name, field.c_str(), sizeof e->name - 1);
+
+        h->numFields += 1;
+    }
+
+    std::memset(e->segment, 0, sizeof e->segment);
+    std::strncpy(e->segment, segment.c_str(), sizeof e->segment - 1);
+
+    e->type       = static_cast<std::uint32_t>(Shared::ElementType<T>::value);
+    e->step       = static_cast<std::int32_t>(step);
+    e->size       = x.size();
+    e->generation = generation;
+
+    h->sequence.fetch_add(1, std::memory_order_release);
+
+    // Consumers that already mapped the previous segment keep their view.
+    if (! previous.empty()) {
+        ::shm_unlink(previous.c_str());
+    }
+}
+
+// =====================================================================
+// Class ECLSharedFieldPublisher
+// ---------------------------------------------------------------------
+
+Opm::ECLSharedFieldPublisher::
+ECLSharedFieldPublisher(const std::string& name,
+                        const std::size_t  maxFields)
+    : pImpl_(new Impl(name, maxFields))
+{}
+
+Opm::ECLSharedFieldPublisher::~ECLSharedFieldPublisher()
+{}
+
+Opm::ECLSharedFieldPublisher::
+ECLSharedFieldPublisher(ECLSharedFieldPublisher&& rhs)
+    : pImpl_(std::move(rhs.pImpl_))
+{}
+
+Opm::ECLSharedFieldPublisher&
+Opm::ECLSharedFieldPublisher::operator=(ECLSharedFieldPublisher&& rhs)
+{
+    this->pImpl_ = std::move(rhs.pImpl_);
+
+    return *this;
+}
+
+void
+Opm::ECLSharedFieldPublisher::publish(const std::string&         field,
+                                      const std::vector<double>& x,
+                                      const int                  step)
+{
+    this->pImpl_->publish(field, x, step);
+}
+
+void
+Opm::ECLSharedFieldPublisher::publish(const std::string&      field,
+                                      const std::vector<int>& x,
+                                      const int               step)
+{
+    this->pImpl_->publish(field, x, step);
+}
+
+void
+Opm::ECLSharedFieldPublisher::publishStatic(const ECLGraph& G)
+{
+    this->publish("NEIGHBOURS", G.neighbours());
+    this->publish("PORV"      , G.poreVolume());
+    this->publish("TRAN"      , G.transmissibility());
+}
+
+// =====================================================================
+// Class ECLSharedFieldReader::Impl
+// ---------------------------------------------------------------------
+
+class Opm::ECLSharedFieldReader::Impl
+{
+public:
+    explicit Impl(const std::string& name);
+
+    std::vector<Shared::Entry> snapshot() const;
+
+    std::size_t version() const;
+
+    template <typename T>
+    View<T> field(const std::string& name) const;
+
+private:
+    /// Directory segment.
+    Shared::Mapping dir_;
+
+    /// Data segments of current generations mapped so far, keyed by
+    /// segment name.  Shared with outstanding views.
+    mutable std::map<std::string,
+                     std::shared_ptr<const Shared::Mapping>> segments_;
+
+    const Shared::Header* header() const
+    {
+        return static_cast<const Shared::Header*>(this->dir_.get());
+    }
+
+    /// Release references to data segments no longer in directory.
+    void dropStale(const std::vector<Shared::Entry>& entries) const;
+};
+
+Opm::ECLSharedFieldReader::Impl::Impl(const std::string& name)
+{
+    Shared::validateName(name, 128 - 64, "Publication");
+
+    this->dir_ = Shared::openReadOnly('/' + name);
+
+    if (this->dir_.get() == nullptr) {
+        throw std::invalid_argument {
+            "Shared Field Publication '" + name + "' Does Not Exist"
+        };
+    }
+
+    const auto* h = this->header();
+
+    if ((this->dir_.size() < sizeof(Shared::Header)) ||
+        ! std::equal(std::begin(Shared::magic), std::end(Shared::magic),
+                     h->magic) ||
+        (h->formatVersion != Shared::formatVersion) ||
+        (this->dir_.size() < Shared::directorySize(h->maxFields)))
+    {
+        throw std::runtime_error {
+            "Shared Field Publication '" + name + "' Incompatible"
+        };
+    }
+}
+
+std::vector<Shared::Entry>
+Opm::ECLSharedFieldReader::Impl::snapshot() const
+{
+    const auto* h = this->header();
+
+    auto entries = std::vector<Shared::Entry>{};
+
+    while (true) {
+        const auto seq = h->sequence.load(std::memory_order_acquire);
+
+        if ((seq % 2) != 0) {
+            // Publisher is updating directory.
+            std::this_thread::yield();
+            continue;
+        }
+
+        const auto n = std::min(static_cast<std::uint64_t>(h->maxFields),
+                                h->numFields);
+
+        const auto* e = Shared::entries(h);
+        entries.assign(e, e + n);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (h->sequence.load(std::memory_order_relaxed) == seq) {
+            return entries;
+        }
+    }
+}
+
+std::size_t
+Opm::ECLSharedFieldReader::Impl::version() const
+{
+    auto seq = this->header()->sequence.load(std::memory_order_acquire);
+
+    return static_cast<std::size_t>(seq / 2);
+}
+
+void
+Opm::ECLSharedFieldReader::Impl::
+dropStale(const std::vector<Shared::Entry>& entries) const
+{
+    auto m = this->segments_.begin();
+
+    while (m != this->segments_.end()) {
+        const auto current = std::any_of(entries.begin(), entries.end(),
+            [&m](const Shared::Entry& e)
+        {
+            return m->first == e.segment;
+        });
+
+        if (current) {
+            ++m;
+        }
+        else {
+            // Unmapped here unless referenced by an outstanding view.
+            m = this->segments_.erase(m);
+        }
+    }
+}
+
+template <typename T>
+Opm::ECLSharedFieldReader::View<T>
+Opm::ECLSharedFieldReader::Impl::field(const std::string& name) const
+{
+    // Publisher may replace the segment between directory snapshot and
+    // mapping.  Retry with a fresh snapshot in that case.
+    for (auto attempt = 0; attempt < 16; ++attempt) {
+        const auto entries = this->snapshot();
+
+        this->dropStale(entries);
+
+        auto e = std::find_if(entries.begin(), entries.end(),
+            [&name](const Shared::Entry& entry)
+        {
+            return name == entry.name;
+        });
+
+        if (e == entries.end()) {
+            throw std::invalid_argument {
+                "Unknown Shared Field '" + name + '\''
+            };
+        }
+
+        if (e->type !=
+            static_cast<std::uint32_t>(Shared::ElementType<T>::value))
+        {
+            throw std::invalid_argument {
+                "Shared Field '" + name + "' Has Different Element Type"
+            };
+        }
+
+        const auto size = static_cast<std::size_t>(e->size);
+        if (size == 0) {
+            return View<T>{ nullptr, 0, nullptr };
+        }
+
+        auto m = this->segments_.find(e->segment);
+        if (m == this->segments_.end()) {
+            auto data = Shared::openReadOnly(e->segment);
+
+            if (data.get() == nullptr) {
+                // Replaced in the mean time.
+                continue;
+            }
+
+            auto seg = std::make_shared<const Shared::Mapping>
+                (std::move(data));
+
+            m = this->segments_.emplace(e->segment, std::move(seg)).first;
+        }
+
+        const auto& segment = m->second;
+
+        if (segment->size() < size * sizeof(T)) {
+            throw std::runtime_error {
+                "Shared Field '" + name + "' Truncated"
+            };
+        }
+
+        return View<T>{ static_cast<const T*>(segment->get()), size,
+                        segment };
+    }
+
+    throw std::runtime_error {
+        "Shared Field '" + name + "' Changing Too Rapidly"
+    };
+}
+
+// =====================================================================
+// Class ECLSharedFieldReader
+// ---------------------------------------------------------------------
+
+Opm::ECLSharedFieldReader::ECLSharedFieldReader(const std::string& name)
+    : pImpl_(new Impl(name))
+{}
+
+Opm::ECLSharedFieldReader::~ECLSharedFieldReader()
+{}
+
+Opm::ECLSharedFieldReader::ECLSharedFieldReader(ECLSharedFieldReader&& rhs)
+    : pImpl_(std::move(rhs.pImpl_))
+{}
+
+Opm::ECLSharedFieldReader&
+Opm::ECLSharedFieldReader::operator=(ECLSharedFieldReader&& rhs)
+{
+    this->pImpl_ = std::move(rhs.pImpl_);
+
+    return *this;
+}
+
+std::vector<Opm::ECLSharedFieldReader::FieldInfo>
+Opm::ECLSharedFieldReader::fields() const
+{
+    auto info = std::vector<FieldInfo>{};
+
+    for (const auto& e : this->pImpl_->snapshot()) {
+        info.push_back(FieldInfo {
+            std::string(e.name),
+            static_cast<ECLSharedFieldType>(e.type),
+            static_cast<std::size_t>(e.size),
+            static_cast<int>(e.step),
+            static_cast<std::size_t>(e.generation)
+        });
+    }
+
+    return info;
+}
+
+std::size_t Opm::ECLSharedFieldReader::version() const
+{
+    return this->pImpl_->version();
+}
+
+Opm::ECLSharedFieldReader::View<double>
+Opm::ECLSharedFieldReader::doubleField(const std::string& field) const
+{
+    return this->pImpl_->field<double>(field);
+}
+
+Opm::ECLSharedFieldReader::View<int>
+Opm::ECLSharedFieldReader::intField(const std::string& field) const
+{
+    return this->pImpl_->field<int>(field);
+}
@@ -0,0 +1,235 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLSHAREDFIELDS_HEADER_INCLUDED
+#define OPM_ECLSHAREDFIELDS_HEADER_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// \file
+///
+/// Publication of computed fields (fluxes, time-of-flight, static graph
+/// arrays &c) in named POSIX shared memory segments for zero-copy,
+/// read-only consumption by other processes on the same host.
+///
+/// A publication consists of a directory segment, named by the
+/// publication, and one data segment per published field.  The directory
+/// holds a versioned header and one entry per field.  Republishing a field
+/// creates a new data segment and atomically switches the directory entry
+/// over to it.  Consumers that mapped the previous data segment keep a
+/// valid, unchanged view of the previous values.
+
+namespace Opm {
+
+    class ECLGraph;
+
+    /// Element type of a published field.
+    enum class ECLSharedFieldType { Double, Int };
+
+    /// Producer side of a shared memory publication.
+    class ECLSharedFieldPublisher
+    {
+    public:
+        /// Constructor.
+        ///
+        /// Creates the directory segment.  Fails if a publication of the
+        /// same name already exists.
+        ///
+        /// \param[in] name Publication name.  Non-empty and must not
+        ///    contain a slash ('/').  Forms the basis of all shared memory
+        ///    segment names.
+        ///
+        /// \param[in] maxFields Maximum number of distinct fields in
+        ///    publication.
+        explicit ECLSharedFieldPublisher(const std::string& name,
+                                         const std::size_t  maxFields = 256);
+
+        /// Destructor.  Removes all segments of the publication.  Existing
+        /// consumer mappings remain valid.
+        ~ECLSharedFieldPublisher();
+
+        /// Move constructor.
+        ECLSharedFieldPublisher(ECLSharedFieldPublisher&& rhs);
+
+        /// Move assignment operator.
+        ECLSharedFieldPublisher& operator=(ECLSharedFieldPublisher&& rhs);
+
+        /// Disabled copy constructor.
+        ECLSharedFieldPublisher(const ECLSharedFieldPublisher&) = delete;
+
+        /// Disabled assignment operator.
+        ECLSharedFieldPublisher&
+        operator=(const ECLSharedFieldPublisher&) = delete;
+
+        /// Publish or republish floating-point field.
+        ///
+        /// \param[in] field Field name.  Non-empty, at most 63 characters,
+        ///    and must not contain a slash ('/').
+        ///
+        /// \param[in] x Field values.
+        ///
+        /// \param[in] step Report step to which the values pertain.
+        ///    Negative (default) for static fields.
+        void publish(const std::string&         field,
+                     const std::vector<double>& x,
+                     const int                  step = -1);
+
+        /// Publish or republish integer field.
+        ///
+        /// \param[in] field Field name.  Non-empty, at most 63 characters,
+        ///    and must not contain a slash ('/').
+        ///
+        /// \param[in] x Field values.
+        ///
+        /// \param[in] step Report step to which the values pertain.
+        ///    Negative (default) for static fields.
+        void publish(const std::string&      field,
+                     const std::vector<int>& x,
+                     const int               step = -1);
+
+        /// Publish static arrays of connection graph.
+        ///
+        /// Publishes fields "NEIGHBOURS" (integer), "PORV" and "TRAN"
+        /// (floating-point) as defined by member functions neighbours(),
+        /// poreVolume() and transmissibility() of class ECLGraph.
+        ///
+        /// \param[in] G Connection graph.
+        void publishStatic(const ECLGraph& G);
+
+    private:
+        /// Implementation class.
+        class Impl;
+
+        /// Pointer to implementation.
+        std::unique_ptr<Impl> pImpl_;
+    };
+
+    /// Consumer side of a shared memory publication.
+    class ECLSharedFieldReader
+    {
+    public:
+        /// Directory entry of single published field.
+        struct FieldInfo {
+            /// Field name.
+            std::string name;
+
+            /// Element type.
+            ECLSharedFieldType type;
+
+            /// Number of elements.
+            std::size_t size;
+
+            /// Report step.  Negative for static fields.
+            int step;
+
+            /// Number of times the field has been published.
+            std::size_t generation;
+        };
+
+        /// Read-only view of published field values.  Valid for as long
+        /// as the view, or a copy of it, exists--even if the field is
+        /// subsequently republished or the reader object from which it
+        /// was obtained is destroyed.
+        template <typename T>
+        struct View {
+            /// Field values.  Null if field is empty.
+            const T* data;
+
+            /// Number of elements.
+            std::size_t size;
+
+            /// Shared ownership of underlying data segment mapping.  Null
+            /// if field is empty.
+            std::shared_ptr<const void> segment;
+
+            const T* begin() const { return this->data; }
+            const T* end()   const { return this->data + this->size; }
+        };
+
+        /// Constructor.
+        ///
+        /// Maps directory segment of existing publication read-only.
+        ///
+        /// \param[in] name Publication name.
+        explicit ECLSharedFieldReader(const std::string& name);
+
+        /// Destructor.  Unmaps directory and all data segments not
+        /// referenced by outstanding views.
+        ~ECLSharedFieldReader();
+
+        /// Move constructor.
+        ECLSharedFieldReader(ECLSharedFieldReader&& rhs);
+
+        /// Move assignment operator.
+        ECLSharedFieldReader& operator=(ECLSharedFieldReader&& rhs);
+
+        /// Disabled copy constructor.
+        ECLSharedFieldReader(const ECLSharedFieldReader&) = delete;
+
+        /// Disabled assignment operator.
+        ECLSharedFieldReader& operator=(const ECLSharedFieldReader&) = delete;
+
+        /// Retrieve consistent snapshot of directory.
+        ///
+        /// \return All fields currently published.
+        std::vector<FieldInfo> fields() const;
+
+        /// Retrieve directory version.  Changes whenever any field is
+        /// (re-)published.
+        std::size_t version() const;
+
+        /// Map current values of floating-point field.
+        ///
+        /// Releases the reader's references to data segments of earlier
+        /// generations of all fields.  Such segments are unmapped once the
+        /// last view of them is destroyed.
+        ///
+        /// \param[in] field Field name.
+        ///
+        /// \return Read-only view of field values.  Throws an exception of
+        ///    type \c std::invalid_argument if the field is unknown or not
+        ///    of floating-point type.
+        View<double> doubleField(const std::string& field) const;
+
+        /// Map current values of integer field.
+        ///
+        /// Releases the reader's references to data segments of earlier
+        /// generations of all fields as in doubleField().
+        ///
+        /// \param[in] field Field name.
+        ///
+        /// \return Read-only view of field values.  Throws an exception of
+        ///    type \c std::invalid_argument if the field is unknown or not
+        ///    of integer type.
+        View<int> intField(const std::string& field) const;
+
+    private:
+        /// Implementation class.
+        class Impl;
+
+        /// Pointer to implementation.
+        std::unique_ptr<Impl> pImpl_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLSHAREDFIELDS_HEADER_INCLUDED
@@ -0,0 +1,639 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLSpatialIndex.hpp>
+
+#include <opm/utility/ECLGraph.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <ert/ecl/ecl_grid.h>
+#include <ert/util/ert_unique_ptr.hpp>
+
+/// \file
+///
+/// Implementation of \c ECLSpatialIndex interface.
+
+namespace {
+    namespace Geometry {
+        using Point = ::Opm::ECLSpatialIndex::Point;
+        using CellCorners = ::Opm::ECLSpatialIndex::CellCorners;
+
+        Point difference(const Point& a, const Point& b)
+        {
+            return { { a[0] - b[0], a[1] - b[1], a[2] - b[2] } };
+        }
+
+        double distanceSquared(const Point& a, const Point& b)
+        {
+            const auto d = difference(a, b);
+
+            return d[0]*d[0] + d[1]*d[1] + d[2]*d[2];
+        }
+
+        /// Whether or not cell is empty, i.e., has at least one
+        /// non-finite corner coordinate.
+        bool isEmpty(const CellCorners& x)
+        {
+            for (const auto& corner : x) {
+                for (const auto& coord : corner) {
+                    if (! std::isfinite(coord)) {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        /// Six times the signed volume of tetrahedron (a,b,c,d).
+        double tetVolume(const Point& a, const Point& b,
+                         const Point& c, const Point& d)
+        {
+            const auto u = difference(b, a);
+            const auto v = difference(c, a);
+            const auto w = difference(d, a);
+
+            return u[0]*(v[1]*w[2] - v[2]*w[1])
+                -  u[1]*(v[0]*w[2] - v[2]*w[0])
+                +  u[2]*(v[0]*w[1] - v[1]*w[0]);
+        }
+
+        /// Point-in-tetrahedron predicate.  Points on the boundary are
+        /// considered inside.
+        bool tetContains(const Point& a, const Point& b,
+                         const Point& c, const Point& d,
+                         const Point& p)
+        {
+            const auto vol = tetVolume(a, b, c, d);
+
+            if (! (std::abs(vol) > 0.0)) {
+                // Degenerate (e.g., collapsed pinch-out).
+                return false;
+            }
+
+            // Sub-volumes have the same sign as 'vol' if 'p' is inside.
+            // Allow for small relative round-off on the boundary.
+            const auto tol = -1.0e-10 * vol*vol;
+
+            return (tetVolume(p, b, c, d) * vol >= tol)
+                && (tetVolume(a, p, c, d) * vol >= tol)
+                && (tetVolume(a, b, p, d) * vol >= tol)
+                && (tetVolume(a, b, c, p) * vol >= tol);
+        }
+
+        /// Point-in-cell predicate.  Cell represented as union of six
+        /// tetrahedra sharing the diagonal between corners 0 and 7.
+        bool cellContains(const CellCorners& x, const Point& p)
+        {
+            // Quick rejection using cell's bounding box.
+            for (auto d = 0*x[0].size(); d < x[0].size(); ++d) {
+                auto lo = x[0][d];
+                auto hi = x[0][d];
+
+                for (const auto& corner : x) {
+                    lo = std::min(lo, corner[d]);
+                    hi = std::max(hi, corner[d]);
+                }
+
+                if ((p[d] < lo) || (p[d] > hi)) {
+                    return false;
+                }
+            }
+
+            static const int tets[6][2] = {
+                { 1, 3 }, { 1, 5 }, { 2, 3 },
+                { 2, 6 }, { 4, 5 }, { 4, 6 },
+            };
+
+            for (const auto& t : tets) {
+                if (tetContains(x[0], x[t[0]], x[t[1]], x[7], p)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    } // namespace Geometry
+
+    namespace Cache {
+        /// Identifies spatial index cache files.
+        const char magic[8] = { 'O', 'P', 'M', 'S', 'I', 'D', 'X', '1' };
+
+        template <typename T>
+        void writeVector(std::ostream& os, const std::vector<T>& v)
+        {
+            const auto n = static_cast<std::uint64_t>(v.size());
+
+            os.write(reinterpret_cast<const char*>(&n), sizeof n);
+            os.write(reinterpret_cast<const char*>(v.data()),
+                     v.size() * sizeof(T));
+        }
+
+        template <typename T>
+        std::vector<T> readVector(std::istream& is)
+        {
+            auto n = std::uint64_t{0};
+            is.read(reinterpret_cast<char*>(&n), sizeof n);
+
+            if (! is) {
+                throw std::runtime_error {
+                    "Spatial Index Cache File Truncated"
+                };
+            }
+
+            auto v = std::vector<T>(static_cast<std::size_t>(n));
+            is.read(reinterpret_cast<char*>(v.data()), v.size() * sizeof(T));
+
+            if (! is) {
+                throw std::runtime_error {
+                    "Spatial Index Cache File Truncated"
+                };
+            }
+
+            return v;
+        }
+    } // namespace Cache
+
+    namespace ECL {
+        using GridPtr = ::ERT::ert_unique_ptr<ecl_grid_type, ecl_grid_free>;
+
+        const ecl_grid_type*
+        getGrid(const ecl_grid_type* G, const int gridID)
+        {
+            assert ((gridID >= 0) && "Grid ID must be non-negative");
+
+            if (gridID == ECL_GRID_MAINGRID_LGR_NR) {
+                return G;
+            }
+
+            return ecl_grid_iget_lgr(G, gridID - 1);
+        }
+    } // namespace ECL
+} // Anonymous namespace
+
+// ======================================================================
+
+Opm::ECLSpatialIndex::ECLSpatialIndex(std::vector<CellCorners> cells)
+    : cells_(std::move(cells))
+{
+    this->computeCentroids();
+    this->buildHierarchy();
+}
+
+Opm::ECLSpatialIndex::ECLSpatialIndex(std::vector<CellCorners> cells,
+                                      std::vector<Node>        nodes,
+                                      std::vector<int>         order)
+    : cells_(std::move(cells))
+    , nodes_(std::move(nodes))
+    , order_(std::move(order))
+{
+    this->checkHierarchy();
+    this->computeCentroids();
+}
+
+Opm::ECLSpatialIndex::CellCorners
+Opm::ECLSpatialIndex::emptyCell()
+{
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    auto x = CellCorners{};
+    for (auto& corner : x) {
+        corner.fill(nan);
+    }
+
+    return x;
+}
+
+Opm::ECLSpatialIndex
+Opm::ECLSpatialIndex::fromECLGrid(const boost::filesystem::path& grid,
+                                  const ECLGraph&                G)
+{
+    const auto ecl = ECL::GridPtr {
+        ecl_grid_load_case(grid.generic_string().c_str())
+    };
+
+    if (! ecl) {
+        std::ostringstream os;
+
+        os << "Failed to load ECL Grid from "
+           << grid.generic_string();
+
+        throw std::invalid_argument(os.str());
+    }
+
+    const auto& gridNames = G.activeGrids();
+
+    // Cells not visited below (i.e., LGR host cells) remain empty.
+    auto cells = std::vector<CellCorners>(G.numCells(), emptyCell());
+
+    for (auto nGrids = static_cast<int>(gridNames.size()), gridID = 0*nGrids;
+         gridID < nGrids; ++gridID)
+    {
+        const auto* g = ECL::getGrid(ecl.get(), gridID);
+
+        for (auto nglob = ecl_grid_get_global_size(g), glob = 0*nglob;
+             glob < nglob; ++glob)
+        {
+            auto ijk = std::array<int,3>{};
+            ecl_grid_get_ijk1(g, glob, &ijk[0], &ijk[1], &ijk[2]);
+
+            // Negative for inactive cells and for cells subdivided by an
+            // LGR.  The refined cells are included through their own grid.
+            const auto act = G.activeCell(ijk, gridNames[gridID]);
+            if (act < 0) { continue; }
+
+            auto& x = cells[act];
+
+            for (auto corner = 0; corner < 8; ++corner) {
+                auto& pt = x[corner];
+
+                ecl_grid_get_cell_corner_xyz1(g, glob, corner,
+                                              &pt[0], &pt[1], &pt[2]);
+            }
+        }
+    }
+
+    return ECLSpatialIndex(std::move(cells));
+}
+
+Opm::ECLSpatialIndex
+Opm::ECLSpatialIndex::load(const boost::filesystem::path& cache)
+{
+    boost::filesystem::ifstream is(cache, std::ios::in | std::ios::binary);
+
+    if (! is) {
+        std::ostringstream os;
+
+        os << "Failed to open Spatial Index Cache File "
+           << cache.generic_string();
+
+        throw std::invalid_argument(os.str());
+    }
+
+    char magic[sizeof Cache::magic];
+    is.read(magic, sizeof magic);
+
+    if (! is || ! std::equal(std::begin(magic), std::end(magic),
+                             std::begin(Cache::magic)))
+    {
+        throw std::runtime_error {
+            "File " + cache.generic_string() +
+            " is Not a Spatial Index Cache File"
+        };
+    }
+
+    auto cells = Cache::readVector<CellCorners>(is);
+    auto nodes = Cache::readVector<Node>(is);
+    auto order = Cache::readVector<int>(is);
+
+    return ECLSpatialIndex(std::move(cells), std::move(nodes),
+                           std::move(order));
+}
+
+void
+Opm::ECLSpatialIndex::save(const boost::filesystem::path& cache) const
+{
+    boost::filesystem::ofstream os(cache, std::ios::out   |
+                                          std::ios::trunc |
+                                          std::ios::binary);
+
+    os.write(Cache::magic, sizeof Cache::magic);
+
+    Cache::writeVector(os, this->cells_);
+    Cache::writeVector(os, this->nodes_);
+    Cache::writeVector(os, this->order_);
+
+    if (! os) {
+        std::ostringstream msg;
+
+        msg << "Failed to write Spatial Index Cache File "
+            << cache.generic_string();
+
+        throw std::runtime_error(msg.str());
+    }
+}
+
+std::size_t
+Opm::ECLSpatialIndex::numCells() const
+{
+    return this->cells_.size();
+}
+
+std::vector<int>
+Opm::ECLSpatialIndex::locate(const std::vector<Point>& points) const
+{
+    auto cells = std::vector<int>{};
+    cells.reserve(points.size());
+
+    for (const auto& p : points) {
+        cells.push_back(this->containingCell(p));
+    }
+
+    return cells;
+}
+
+std::vector<int>
+Opm::ECLSpatialIndex::cellsWithinRadius(const Point& p,
+                                        const double radius) const
+{
+    const auto query = Box {
+        { { p[0] - radius, p[1] - radius, p[2] - radius } },
+        { { p[0] + radius, p[1] + radius, p[2] + radius } }
+    };
+
+    const auto r2 = radius * radius;
+
+    auto cells = std::vector<int>{};
+
+    this->visitCandidates(query, [this, &p, r2, &cells](const int cell)
+    {
+        if (Geometry::distanceSquared(this->centroid_[cell], p) <= r2) {
+            cells.push_back(cell);
+        }
+    });
+
+    std::sort(cells.begin(), cells.end());
+
+    return cells;
+}
+
+std::vector<std::vector<int>>
+Opm::ECLSpatialIndex::cellsWithinRadius(const std::vector<Point>& points,
+                                        const double              radius) const
+{
+    auto cells = std::vector<std::vector<int>>{};
+    cells.reserve(points.size());
+
+    for (const auto& p : points) {
+        cells.push_back(this->cellsWithinRadius(p, radius));
+    }
+
+    return cells;
+}
+
+void Opm::ECLSpatialIndex::computeCentroids()
+{
+    this->centroid_.clear();
+    this->centroid_.reserve(this->cells_.size());
+
+    for (const auto& x : this->cells_) {
+        auto c = Point{ { 0.0, 0.0, 0.0 } };
+
+        for (const auto& corner : x) {
+            for (auto d = 0*c.size(); d < c.size(); ++d) {
+                c[d] += corner[d] / x.size();
+            }
+        }
+
+        this->centroid_.push_back(c);
+    }
+}
+
+void Opm::ECLSpatialIndex::buildHierarchy()
+{
+    // Maximum number of cells in a leaf.
+    const auto leafSize = std::size_t{8};
+
+    const auto nCells = this->cells_.size();
+
+    this->nodes_.clear();
+    this->order_.clear();
+
+    for (auto cell = 0*nCells; cell < nCells; ++cell) {
+        if (! Geometry::isEmpty(this->cells_[cell])) {
+            this->order_.push_back(static_cast<int>(cell));
+        }
+    }
+
+    const auto nOrder = this->order_.size();
+
+    if (nOrder == 0) {
+        return;
+    }
+
+    auto cellBox = std::vector<Box>{};
+    cellBox.reserve(nCells);
+
+    for (const auto& x : this->cells_) {
+        auto box = Box{ x[0], x[0] };
+
+        for (const auto& corner : x) {
+            for (auto d = 0*corner.size(); d < corner.size(); ++d) {
+                box.lo[d] = std::min(box.lo[d], corner[d]);
+                box.hi[d] = std::max(box.hi[d], corner[d]);
+            }
+        }
+
+        cellBox.push_back(box);
+    }
+
+    struct Range {
+        std::size_t node;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    this->nodes_.push_back(Node{});
+
+    auto work = std::vector<Range>{ Range{ 0, 0, nOrder } };
+
+    while (! work.empty()) {
+        const auto r = work.back();  work.pop_back();
+
+        const auto first = this->order_.begin();
+
+        auto box    = cellBox[*(first + r.begin)];
+        auto cbox   = Box{ this->centroid_[*(first + r.begin)],
+                           this->centroid_[*(first + r.begin)] };
+
+        for (auto i = r.begin; i < r.end; ++i) {
+            const auto  cell = this->order_[i];
+            const auto& cb   = cellBox[cell];
+            const auto& c    = this->centroid_[cell];
+
+            for (auto d = 0*c.size(); d < c.size(); ++d) {
+                box.lo[d]  = std::min(box.lo[d] , cb.lo[d]);
+                box.hi[d]  = std::max(box.hi[d] , cb.hi[d]);
+                cbox.lo[d] = std::min(cbox.lo[d], c[d]);
+                cbox.hi[d] = std::max(cbox.hi[d], c[d]);
+            }
+        }
+
+        if (r.end - r.begin <= leafSize) {
+            this->nodes_[r.node] = Node{ box, r.begin, r.end - r.begin };
+            continue;
+        }
+
+        // Split at median centroid along axis of largest extent.
+        auto axis = std::size_t{0};
+        for (auto d = std::size_t{1}; d < cbox.lo.size(); ++d) {
+            if (cbox.hi[d] - cbox.lo[d] > cbox.hi[axis] - cbox.lo[axis]) {
+                axis = d;
+            }
+        }
+
+        const auto mid = r.begin + (r.end - r.begin)/2;
+
+        std::nth_element(first + r.begin, first + mid, first + r.end,
+            [this, axis](const int c1, const int c2)
+        {
+            return this->centroid_[c1][axis] < this->centroid_[c2][axis];
+        });
+
+        const auto left = this->nodes_.size();
+        this->nodes_.push_back(Node{});
+        this->nodes_.push_back(Node{});
+
+        this->nodes_[r.node] = Node{ box, left, 0 };
+
+        work.push_back(Range{ left + 0, r.begin, mid   });
+        work.push_back(Range{ left + 1, mid    , r.end });
+    }
+}
+
+void Opm::ECLSpatialIndex::checkHierarchy() const
+{
+    const auto nCells = this->cells_.size();
+    const auto nNodes = this->nodes_.size();
+    const auto nOrder = this->order_.size();
+
+    auto inconsistent = []()
+    {
+        throw std::runtime_error {
+            "Spatial Index Cache File Inconsistent"
+        };
+    };
+
+    if ((nOrder > nCells) || (this->nodes_.empty() != (nOrder == 0))) {
+        inconsistent();
+    }
+
+    // Each non-empty cell exactly once, no empty cells.
+    auto seen = std::vector<bool>(nCells, false);
+    for (const auto& cell : this->order_) {
+        if ((cell < 0) || (static_cast<std::size_t>(cell) >= nCells) ||
+            seen[cell] || Geometry::isEmpty(this->cells_[cell]))
+        {
+            inconsistent();
+        }
+
+        seen[cell] = true;
+    }
+
+    auto nNonEmpty = std::size_t{0};
+    for (const auto& x : this->cells_) {
+        nNonEmpty += ! Geometry::isEmpty(x);
+    }
+
+    if (nNonEmpty != nOrder) {
+        inconsistent();
+    }
+
+    // Leaf ranges within 'order_'.  Children follow their parent which
+    // guarantees that traversal terminates.
+    for (auto node = 0*nNodes; node < nNodes; ++node) {
+        const auto& n = this->nodes_[node];
+
+        if (n.count > 0) {
+            if ((n.first > nOrder) || (n.count > nOrder - n.first)) {
+                inconsistent();
+            }
+        }
+        else if ((n.first <= node) || (n.first >= nNodes - 1)) {
+            inconsistent();
+        }
+    }
+}
+
+template <class Visitor>
+void Opm::ECLSpatialIndex::visitCandidates(const Box& query,
+                                           Visitor&&  visit) const
+{
+    if (this->nodes_.empty()) {
+        return;
+    }
+
+    auto overlap = [&query](const Box& box)
+    {
+        for (auto d = 0*box.lo.size(); d < box.lo.size(); ++d) {
+            if ((box.hi[d] < query.lo[d]) || (box.lo[d] > query.hi[d])) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    auto work = std::vector<std::size_t>{ 0 };
+
+    while (! work.empty()) {
+        const auto& node = this->nodes_[work.back()];  work.pop_back();
+
+        if (! overlap(node.box)) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (auto i = node.first; i < node.first + node.count; ++i) {
+                visit(this->order_[i]);
+            }
+        }
+        else {
+            work.push_back(node.first + 0);
+            work.push_back(node.first + 1);
+        }
+    }
+}
+
+int Opm::ECLSpatialIndex::containingCell(const Point& p) const
+{
+    auto cell = -1;
+
+    this->visitCandidates(Box{ p, p }, [this, &p, &cell](const int c)
+    {
+        if (((cell < 0) || (c < cell)) &&
+            Geometry::cellContains(this->cells_[c], p))
+        {
+            cell = c;
+        }
+    });
+
+    return cell;
+}
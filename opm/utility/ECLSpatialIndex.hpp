@@ -0,0 +1,219 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLSPATIALINDEX_HEADER_INCLUDED
+#define OPM_ECLSPATIALINDEX_HEADER_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+/// \file
+///
+/// Facility for locating active cells of an ECLIPSE result set from
+/// points in physical space.
+
+namespace Opm {
+
+    class ECLGraph;
+
+    /// Bounding volume hierarchy over the corner-point geometry of a
+    /// model's active cells.
+    ///
+    /// Supports batched point location ("which active cell contains point
+    /// (x,y,z)") and proximity queries ("which active cells have their
+    /// centroid within distance r of point (x,y,z)").  Active cells are
+    /// identified by their index in the linear, global numbering of class
+    /// ECLGraph.  Cells of local grid refinements are indexed directly and
+    /// host cells that are subdivided by an LGR are excluded.
+    ///
+    /// Excluded cells are represented as empty cells, i.e., cells with at
+    /// least one non-finite (e.g., NaN) corner coordinate.  Empty cells
+    /// keep their slot in the active cell numbering but are not entered
+    /// into the hierarchy and are never reported by any query.
+    ///
+    /// Coordinates are in the units of the grid file.
+    class ECLSpatialIndex
+    {
+    public:
+        /// Point in physical space.
+        using Point = std::array<double, 3>;
+
+        /// Corner-point geometry of a single cell.  Standard ECL corner
+        /// ordering, i.e., I cycling most rapidly, then J, then K:
+        ///
+        /// \code
+        ///    0:(i  ,j  ,k  )  1:(i+1,j  ,k  )
+        ///    2:(i  ,j+1,k  )  3:(i+1,j+1,k  )
+        ///    4:(i  ,j  ,k+1)  5:(i+1,j  ,k+1)
+        ///    6:(i  ,j+1,k+1)  7:(i+1,j+1,k+1)
+        /// \endcode
+        using CellCorners = std::array<Point, 8>;
+
+        /// Constructor.
+        ///
+        /// \param[in] cells Corner-point geometry of all active cells.
+        ///    Element \c i is the geometry of active cell \c i.  Use
+        ///    emptyCell() for cells that should not be located.
+        explicit ECLSpatialIndex(std::vector<CellCorners> cells);
+
+        /// Geometry of an empty cell.  All corner coordinates NaN.
+        static CellCorners emptyCell();
+
+        /// Named constructor.  Build index from on-disk grid.
+        ///
+        /// \param[in] grid Name or prefix of ECL grid (i.e., .GRID or
+        ///    .EGRID) file.  Should be the same grid from which \p G was
+        ///    constructed.
+        ///
+        /// \param[in] G Connection graph that defines the active cell
+        ///    numbering.
+        ///
+        /// \return Spatial index over the active cells of \p G.
+        static ECLSpatialIndex
+        fromECLGrid(const boost::filesystem::path& grid,
+                    const ECLGraph&                G);
+
+        /// Named constructor.  Restore index from cache file previously
+        /// created by member function save().
+        ///
+        /// Throws \c std::runtime_error if the file is truncated or if
+        /// its node or cell indices are inconsistent with its number of
+        /// cells.
+        ///
+        /// \param[in] cache Name of cache file.
+        ///
+        /// \return Spatial index.
+        static ECLSpatialIndex
+        load(const boost::filesystem::path& cache);
+
+        /// Write index to cache file.
+        ///
+        /// The format is a native-endian binary dump intended for reuse on
+        /// the same platform.  It is not a portable exchange format.
+        ///
+        /// \param[in] cache Name of cache file.  Overwritten if it exists.
+        void save(const boost::filesystem::path& cache) const;
+
+        /// Retrieve number of active cells in index.  Includes empty
+        /// cells.
+        std::size_t numCells() const;
+
+        /// Locate active cells containing a sequence of points.
+        ///
+        /// \param[in] points Sequence of points in physical space.
+        ///
+        /// \return Active cell index of cell containing each point.
+        ///    Negative one (-1) for points outside all active cells.  If
+        ///    a point is on the boundary between two or more cells, the
+        ///    least active cell index is returned.
+        std::vector<int> locate(const std::vector<Point>& points) const;
+
+        /// Find active cells in neighbourhood of single point.
+        ///
+        /// \param[in] p Point in physical space.
+        ///
+        /// \param[in] radius Search radius.
+        ///
+        /// \return Active cell indices of all cells whose centroid is
+        ///    within distance \p radius of \p p.  Sorted ascendingly.
+        std::vector<int>
+        cellsWithinRadius(const Point& p, const double radius) const;
+
+        /// Find active cells in neighbourhoods of sequence of points.
+        ///
+        /// \param[in] points Sequence of points in physical space.
+        ///
+        /// \param[in] radius Search radius.
+        ///
+        /// \return Collection of results of cellsWithinRadius(), one for
+        ///    each point.
+        std::vector<std::vector<int>>
+        cellsWithinRadius(const std::vector<Point>& points,
+                          const double              radius) const;
+
+    private:
+        /// Axis-aligned bounding box.
+        struct Box {
+            Point lo;
+            Point hi;
+        };
+
+        /// Node of bounding volume hierarchy.
+        struct Node {
+            /// Bounding box of all cells beneath this node.
+            Box box;
+
+            /// Leaf: Start of node's range in \c order_.  Internal: Index
+            /// of left child.  The right child immediately follows the
+            /// left child.
+            std::size_t first;
+
+            /// Number of cells in leaf.  Zero for internal nodes.
+            std::size_t count;
+        };
+
+        /// Corner-point geometry of all active cells.
+        std::vector<CellCorners> cells_;
+
+        /// Centroid of each active cell.
+        std::vector<Point> centroid_;
+
+        /// Nodes of bounding volume hierarchy.  Root is element zero.
+        std::vector<Node> nodes_;
+
+        /// Non-empty active cells permuted into leaf order.
+        std::vector<int> order_;
+
+        /// Constructor.  Restore from previously computed hierarchy.
+        /// Throws \c std::runtime_error unless \p nodes and \p order
+        /// form a valid hierarchy over the non-empty \p cells.
+        ECLSpatialIndex(std::vector<CellCorners> cells,
+                        std::vector<Node>        nodes,
+                        std::vector<int>         order);
+
+        /// Compute cell centroids from corner-point geometry.
+        void computeCentroids();
+
+        /// Build bounding volume hierarchy.
+        void buildHierarchy();
+
+        /// Verify that restored hierarchy references only non-empty cells
+        /// and that all node indices are within bounds.
+        void checkHierarchy() const;
+
+        /// Visit all cells in leaves whose bounding box intersects a
+        /// query box.
+        ///
+        /// \param[in] query Query box.
+        ///
+        /// \param[in] visit Call-back.  Invoked as \code visit(cell)
+        ///    \endcode for each candidate active cell.
+        template <class Visitor>
+        void visitCandidates(const Box& query, Visitor&& visit) const;
+
+        /// Locate active cell containing single point.
+        int containingCell(const Point& p) const;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLSPATIALINDEX_HEADER_INCLUDED
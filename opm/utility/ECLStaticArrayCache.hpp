@@ -0,0 +1,215 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLSTATICARRAYCACHE_HEADER_INCLUDED
+#define OPM_ECLSTATICARRAYCACHE_HEADER_INCLUDED
+
+#include <opm/utility/ECLMemoryBudget.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// \file
+///
+/// Cache of static (INIT) keyword arrays linearised on active cells.
+
+namespace Opm {
+
+    /// Map from (cell layout, keyword) pairs to linearised static arrays.
+    ///
+    /// Each instance of class ECLInitFileData owns a cache that is shared
+    /// by all of its copies.  Class ECLGraph routes its INIT queries
+    /// through the cache, so that saturation function, end-point scaling,
+    /// PVT and flux set-up decode and linearise each keyword once, no
+    /// matter how many factories request it.
+    ///
+    /// Unlike class ECLBudgetedCache, entries are never evicted.  Static
+    /// arrays are few, are needed for the lifetime of the model, and
+    /// recomputing them would mean decoding the INIT file again.  The
+    /// cache nevertheless registers with an ECLMemoryBudget as a
+    /// non-evictable client, so that its arrays appear in the budget's
+    /// usage report and leave less room for evictable caches.  All member
+    /// functions are thread-safe.
+    class ECLStaticArrayCache
+    {
+    public:
+        /// Identity of single linearised array: cell layout (typically the
+        /// identity of an ECLGraph) and keyword name.
+        using Key = std::pair<std::size_t, std::string>;
+
+        /// Constructor.
+        ///
+        /// \param[in] budget Memory budget charged for cached arrays.
+        ///    Must outlive the cache.
+        explicit ECLStaticArrayCache(ECLMemoryBudget& budget =
+                                     ECLMemoryBudget::instance())
+            : budget_(budget)
+            , client_(budget.registerClient("Static INIT arrays",
+                                            ECLMemoryBudget::Evictor{}))
+        {}
+
+        /// Destructor.  Releases all charged memory.
+        ~ECLStaticArrayCache()
+        {
+            this->budget_.unregisterClient(this->client_);
+        }
+
+        /// Disabled copy constructor.
+        ECLStaticArrayCache(const ECLStaticArrayCache&) = delete;
+
+        /// Disabled assignment operator.
+        ECLStaticArrayCache& operator=(const ECLStaticArrayCache&) = delete;
+
+        /// Retrieve linearised array, computing it if not yet cached.
+        ///
+        /// \tparam T Element type.  Must be \c int or \c double.
+        ///
+        /// \param[in] key Array identity.
+        ///
+        /// \param[in] compute Function that computes the array.  Invoked
+        ///    as \code compute() \endcode with the cache locked, so that
+        ///    concurrent requests never decode the same keyword twice.
+        ///    If \p compute throws, nothing is cached.
+        ///
+        /// \return Array associated to \p key.
+        template <typename T, class Compute>
+        std::shared_ptr<const std::vector<T>>
+        get(const Key& key, Compute&& compute)
+        {
+            std::lock_guard<std::mutex> guard(this->lock_);
+
+            auto& entries = this->entries(static_cast<const T*>(nullptr));
+
+            auto i = entries.find(key);
+            if (i != entries.end()) {
+                this->hits_ += 1;
+
+                return i->second.value;
+            }
+
+            auto x = std::make_shared<const std::vector<T>>(compute());
+
+            this->misses_ += 1;
+
+            const auto entry = ++this->nextEntry_;
+
+            entries.emplace(key, Item<T>{ x, entry });
+
+            // Non-evictable client.  Always retained.
+            this->budget_.charge(this->client_, entry,
+                                 x->size() * sizeof(T));
+
+            return x;
+        }
+
+        /// Drop all entries.
+        void clear()
+        {
+            std::lock_guard<std::mutex> guard(this->lock_);
+
+            for (const auto& i : this->int_) {
+                this->budget_.release(this->client_, i.second.entry);
+            }
+
+            for (const auto& d : this->double_) {
+                this->budget_.release(this->client_, d.second.entry);
+            }
+
+            this->int_   .clear();
+            this->double_.clear();
+        }
+
+        /// Number of get requests served from the cache.
+        std::size_t hits() const
+        {
+            std::lock_guard<std::mutex> guard(this->lock_);
+
+            return this->hits_;
+        }
+
+        /// Number of get requests that computed the array.
+        std::size_t misses() const
+        {
+            std::lock_guard<std::mutex> guard(this->lock_);
+
+            return this->misses_;
+        }
+
+        /// Total size, in bytes, of all cached arrays.
+        std::size_t bytes() const
+        {
+            std::lock_guard<std::mutex> guard(this->lock_);
+
+            auto size = std::size_t{0};
+
+            for (const auto& i : this->int_) {
+                size += i.second.value->size() * sizeof(int);
+            }
+
+            for (const auto& d : this->double_) {
+                size += d.second.value->size() * sizeof(double);
+            }
+
+            return size;
+        }
+
+    private:
+        /// Cached array and its identity in the memory budget.
+        template <typename T>
+        struct Item
+        {
+            std::shared_ptr<const std::vector<T>> value;
+            ECLMemoryBudget::EntryID              entry;
+        };
+
+        template <typename T>
+        using Entries = std::map<Key, Item<T>>;
+
+        ECLMemoryBudget&          budget_;
+        ECLMemoryBudget::ClientID client_;
+
+        ECLMemoryBudget::EntryID nextEntry_{0};
+
+        mutable std::mutex lock_;
+
+        Entries<int>    int_;
+        Entries<double> double_;
+
+        std::size_t hits_{0};
+        std::size_t misses_{0};
+
+        Entries<int>& entries(const int*)
+        {
+            return this->int_;
+        }
+
+        Entries<double>& entries(const double*)
+        {
+            return this->double_;
+        }
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLSTATICARRAYCACHE_HEADER_INCLUDED
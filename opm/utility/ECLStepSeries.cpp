@@ -0,0 +1,449 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLStepSeries.hpp>
+
+#include <opm/utility/ECLByteCodec.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+/// \file
+///
+/// Implementation of \c ECLStepSeries interface.
+
+namespace {
+    /// Largest magnitude of a quantised value.  Leaves headroom for
+    /// differences of two quantised values in 64 bits.
+    const double maxQuantised = 4.0e18;
+
+    std::uint64_t bits(const double x)
+    {
+        auto w = std::uint64_t{0};
+        std::memcpy(&w, &x, sizeof w);
+
+        return w;
+    }
+
+    double value(const std::uint64_t w)
+    {
+        auto x = 0.0;
+        std::memcpy(&x, &w, sizeof x);
+
+        return x;
+    }
+
+    /// Map signed difference, in two's complement, to unsigned word with
+    /// few significant bits when the difference is small in magnitude.
+    std::uint64_t zigzag(const std::uint64_t d)
+    {
+        return (d << 1) ^ (std::uint64_t{0} - (d >> 63));
+    }
+
+    std::uint64_t unzigzag(const std::uint64_t z)
+    {
+        return (z >> 1) ^ (std::uint64_t{0} - (z & 1));
+    }
+
+    namespace File {
+        /// Identifies step series files.
+        const char magic[8] = { 'O', 'P', 'M', 'S', 'T', 'E', 'P', '1' };
+
+        /// Position of single encoded step relative to the start of the
+        /// step section.
+        struct DirectoryEntry
+        {
+            std::uint64_t offset;
+            std::uint64_t size;
+        };
+
+        template <typename T>
+        void write(std::ostream& os, const T& x)
+        {
+            os.write(reinterpret_cast<const char*>(&x), sizeof x);
+        }
+
+        template <typename T>
+        T read(std::istream& is)
+        {
+            auto x = T{};
+            is.read(reinterpret_cast<char*>(&x), sizeof x);
+
+            if (! is) {
+                throw std::runtime_error("Step Series File Truncated");
+            }
+
+            return x;
+        }
+    } // namespace File
+} // Anonymous namespace
+
+Opm::ECLStepSeries::ECLStepSeries(const std::size_t numValues,
+                                  const Options&    opt)
+    : numValues_(numValues)
+    , opt_      (opt)
+{
+    if (this->opt_.keyframeInterval < 1) {
+        throw std::invalid_argument {
+            "Keyframe Interval Must be Positive"
+        };
+    }
+
+    if (! (this->opt_.tolerance >= 0.0) ||
+        ! std::isfinite(this->opt_.tolerance))
+    {
+        throw std::invalid_argument {
+            "Step Series Tolerance Must be Finite and Non-Negative"
+        };
+    }
+}
+
+Opm::ECLStepSeries
+Opm::ECLStepSeries::load(const boost::filesystem::path& file)
+{
+    boost::filesystem::ifstream is(file, std::ios::in | std::ios::binary);
+
+    if (! is) {
+        std::ostringstream os;
+
+        os << "Failed to open Step Series File "
+           << file.generic_string();
+
+        throw std::invalid_argument(os.str());
+    }
+
+    char magic[sizeof File::magic];
+    is.read(magic, sizeof magic);
+
+    if (! is || ! std::equal(std::begin(magic), std::end(magic),
+                             std::begin(File::magic)))
+    {
+        throw std::runtime_error {
+            "File " + file.generic_string() +
+            " is Not a Step Series File"
+        };
+    }
+
+    const auto nval = File::read<std::uint64_t>(is);
+
+    auto opt = Options{};
+    opt.keyframeInterval = File::read<std::int32_t>(is);
+    opt.tolerance        = File::read<double>(is);
+
+    auto series = ECLStepSeries(static_cast<std::size_t>(nval), opt);
+
+    const auto nstep = static_cast<std::size_t>
+        (File::read<std::uint64_t>(is));
+
+    series.steps_.resize(nstep);
+    for (auto& step : series.steps_) {
+        step = File::read<std::int32_t>(is);
+    }
+
+    auto dir = std::vector<File::DirectoryEntry>(nstep);
+    for (auto& e : dir) {
+        e = File::read<File::DirectoryEntry>(is);
+    }
+
+    const auto start = is.tellg();
+
+    series.frames_.resize(nstep);
+    for (auto i = 0*nstep; i < nstep; ++i) {
+        auto& frame = series.frames_[i];
+
+        is.seekg(start + static_cast<std::streamoff>(dir[i].offset));
+
+        frame.resize(static_cast<std::size_t>(dir[i].size));
+        is.read(reinterpret_cast<char*>(frame.data()), frame.size());
+
+        if (! is) {
+            throw std::runtime_error("Step Series File Truncated");
+        }
+    }
+
+    if (nstep > 0) {
+        // Reference for subsequent append().
+        series.last_ = series.stepWords(nstep - 1);
+    }
+
+    return series;
+}
+
+void
+Opm::ECLStepSeries::save(const boost::filesystem::path& file) const
+{
+    boost::filesystem::ofstream os(file, std::ios::out   |
+                                         std::ios::trunc |
+                                         std::ios::binary);
+
+    os.write(File::magic, sizeof File::magic);
+
+    File::write(os, static_cast<std::uint64_t>(this->numValues_));
+    File::write(os, static_cast<std::int32_t>(this->opt_.keyframeInterval));
+    File::write(os, this->opt_.tolerance);
+
+    File::write(os, static_cast<std::uint64_t>(this->steps_.size()));
+    for (const auto& step : this->steps_) {
+        File::write(os, static_cast<std::int32_t>(step));
+    }
+
+    auto offset = std::uint64_t{0};
+    for (const auto& frame : this->frames_) {
+        const auto size = static_cast<std::uint64_t>(frame.size());
+
+        File::write(os, File::DirectoryEntry{ offset, size });
+
+        offset += size;
+    }
+
+    for (const auto& frame : this->frames_) {
+        os.write(reinterpret_cast<const char*>(frame.data()),
+                 frame.size());
+    }
+
+    if (! os) {
+        std::ostringstream msg;
+
+        msg << "Failed to write Step Series File "
+            << file.generic_string();
+
+        throw std::runtime_error(msg.str());
+    }
+}
+
+void
+Opm::ECLStepSeries::append(const int                  reportStep,
+                           const std::vector<double>& values)
+{
+    if (! this->steps_.empty() && (reportStep <= this->steps_.back())) {
+        std::ostringstream os;
+
+        os << "Report Step " << reportStep
+           << " Does Not Follow Last Step in Series ("
+           << this->steps_.back() << ')';
+
+        throw std::invalid_argument(os.str());
+    }
+
+    if (values.size() != this->numValues_) {
+        std::ostringstream os;
+
+        os << "Step Values (" << values.size()
+           << ") Do Not Match Series Size ("
+           << this->numValues_ << ')';
+
+        throw std::invalid_argument(os.str());
+    }
+
+    auto words = this->toWords(values);
+
+    const auto pos = this->steps_.size();
+    const auto empty = Words{};
+
+    this->frames_.push_back(this->encode(words,
+        this->isKeyframe(pos) ? empty : this->last_));
+
+    this->steps_.push_back(reportStep);
+
+    this->last_ = std::move(words);
+}
+
+std::vector<double>
+Opm::ECLStepSeries::values(const int reportStep) const
+{
+    return this->fromWords(this->stepWords(this->position(reportStep)));
+}
+
+bool Opm::ECLStepSeries::hasStep(const int reportStep) const
+{
+    return std::binary_search(this->steps_.begin(), this->steps_.end(),
+                              reportStep);
+}
+
+const std::vector<int>& Opm::ECLStepSeries::reportSteps() const
+{
+    return this->steps_;
+}
+
+std::size_t Opm::ECLStepSeries::numValues() const
+{
+    return this->numValues_;
+}
+
+const Opm::ECLStepSeries::Options&
+Opm::ECLStepSeries::options() const
+{
+    return this->opt_;
+}
+
+std::size_t Opm::ECLStepSeries::compressedSize() const
+{
+    auto size = std::size_t{0};
+
+    for (const auto& frame : this->frames_) {
+        size += frame.size();
+    }
+
+    return size;
+}
+
+bool Opm::ECLStepSeries::isKeyframe(const std::size_t pos) const
+{
+    return (pos % this->opt_.keyframeInterval) == 0;
+}
+
+Opm::ECLStepSeries::Words
+Opm::ECLStepSeries::toWords(const std::vector<double>& values) const
+{
+    auto words = Words(values.size(), 0);
+
+    if (! (this->opt_.tolerance > 0.0)) {
+        std::transform(values.begin(), values.end(), words.begin(), &bits);
+
+        return words;
+    }
+
+    const auto scale = 1.0 / (2.0 * this->opt_.tolerance);
+
+    for (auto n = values.size(), i = 0*n; i < n; ++i) {
+        const auto q = values[i] * scale;
+
+        if (! std::isfinite(q) || (std::abs(q) > maxQuantised)) {
+            std::ostringstream os;
+
+            os << "Value " << values[i] << " at Position " << i
+               << " Cannot be Quantised to Tolerance "
+               << this->opt_.tolerance;
+
+            throw std::invalid_argument(os.str());
+        }
+
+        words[i] = static_cast<std::uint64_t>(std::llround(q));
+    }
+
+    return words;
+}
+
+std::vector<double>
+Opm::ECLStepSeries::fromWords(const Words& words) const
+{
+    auto values = std::vector<double>(words.size(), 0.0);
+
+    if (! (this->opt_.tolerance > 0.0)) {
+        std::transform(words.begin(), words.end(), values.begin(), &value);
+
+        return values;
+    }
+
+    const auto quantum = 2.0 * this->opt_.tolerance;
+
+    for (auto n = words.size(), i = 0*n; i < n; ++i) {
+        values[i] = quantum * static_cast<double>
+            (static_cast<std::int64_t>(words[i]));
+    }
+
+    return values;
+}
+
+std::vector<unsigned char>
+Opm::ECLStepSeries::encode(const Words& words, const Words& prev) const
+{
+    const auto lossless = ! (this->opt_.tolerance > 0.0);
+
+    auto diff = Words(words.size(), 0);
+
+    for (auto n = words.size(), i = 0*n; i < n; ++i) {
+        // Keyframes: Difference to previous value of same step.
+        const auto ref = prev.empty()
+            ? ((i > 0) ? words[i - 1] : std::uint64_t{0})
+            : prev[i];
+
+        diff[i] = lossless ? (words[i] ^ ref) : zigzag(words[i] - ref);
+    }
+
+    return ECLByteCodec::encode(diff);
+}
+
+Opm::ECLStepSeries::Words
+Opm::ECLStepSeries::decode(const std::vector<unsigned char>& code,
+                           const Words&                      prev) const
+{
+    const auto lossless = ! (this->opt_.tolerance > 0.0);
+
+    auto words = ECLByteCodec::decode<std::uint64_t>(code, this->numValues_);
+
+    for (auto n = words.size(), i = 0*n; i < n; ++i) {
+        const auto ref = prev.empty()
+            ? ((i > 0) ? words[i - 1] : std::uint64_t{0})
+            : prev[i];
+
+        words[i] = lossless ? (words[i] ^ ref) : (unzigzag(words[i]) + ref);
+    }
+
+    return words;
+}
+
+Opm::ECLStepSeries::Words
+Opm::ECLStepSeries::stepWords(const std::size_t pos) const
+{
+    auto key = pos - (pos % this->opt_.keyframeInterval);
+
+    auto words = this->decode(this->frames_[key], Words{});
+
+    for (++key; key <= pos; ++key) {
+        words = this->decode(this->frames_[key], words);
+    }
+
+    return words;
+}
+
+std::size_t Opm::ECLStepSeries::position(const int reportStep) const
+{
+    auto i = std::lower_bound(this->steps_.begin(), this->steps_.end(),
+                              reportStep);
+
+    if ((i == this->steps_.end()) || (*i != reportStep)) {
+        std::ostringstream os;
+
+        os << "Report Step " << reportStep
+           << " Not Available in Step Series";
+
+        throw std::invalid_argument(os.str());
+    }
+
+    return static_cast<std::size_t>(std::distance(this->steps_.begin(), i));
+}
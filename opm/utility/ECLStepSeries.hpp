@@ -0,0 +1,180 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLSTEPSERIES_HEADER_INCLUDED
+#define OPM_ECLSTEPSERIES_HEADER_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+/// \file
+///
+/// Compressed storage of a cell field across a sequence of report steps.
+
+namespace Opm {
+
+    /// Sequence of per-step values of a single field--e.g., PRESSURE or
+    /// SWAT on all active cells--compressed along the time axis.
+    ///
+    /// Every \c keyframeInterval-th step is stored as a keyframe that is
+    /// decoded on its own.  All other steps are stored as differences to
+    /// their predecessor.  Retrieving a step decodes the nearest preceding
+    /// keyframe and applies at most \code keyframeInterval - 1 \endcode
+    /// differences.
+    ///
+    /// Two modes are supported:
+    ///
+    ///   - Lossless (tolerance zero).  Differences are the XOR of the IEEE
+    ///     754 bit patterns of consecutive steps.  Values are restored bit
+    ///     for bit, including non-finite values.
+    ///
+    ///   - Bounded error (tolerance \c tol positive).  Values are quantised
+    ///     to multiples of \code 2*tol \endcode, and differences are taken
+    ///     between quantised values of consecutive steps.  Restored values
+    ///     deviate from the input by at most \c tol (up to rounding in the
+    ///     final multiplication) and errors do not accumulate across
+    ///     steps.  All values must be finite.
+    ///
+    /// In both modes the differences are compressed with ECLByteCodec.
+    class ECLStepSeries
+    {
+    public:
+        /// Construction parameters.
+        struct Options
+        {
+            /// Default parameters.  Lossless, keyframe every eighth step.
+            Options()
+                : keyframeInterval(8)
+                , tolerance       (0.0)
+            {}
+
+            /// Number of steps between keyframes.  Positive.
+            int keyframeInterval;
+
+            /// Maximum absolute error of restored values.  Zero for
+            /// lossless compression.
+            double tolerance;
+        };
+
+        /// Constructor.
+        ///
+        /// \param[in] numValues Number of values per step.  Typically the
+        ///    number of active cells.
+        ///
+        /// \param[in] opt Construction parameters.
+        explicit ECLStepSeries(const std::size_t numValues,
+                               const Options&    opt = Options{});
+
+        /// Named constructor.  Restore series from file previously created
+        /// by member function save().
+        ///
+        /// \param[in] file Name of series file.
+        ///
+        /// \return Series.  Additional steps may be appended.
+        static ECLStepSeries load(const boost::filesystem::path& file);
+
+        /// Write series to file.
+        ///
+        /// The file contains a header, the report step IDs, a directory of
+        /// the byte offset and size of each encoded step, and the encoded
+        /// steps.  Clients may fetch the steps between a keyframe and a
+        /// target step by byte range.  Native-endian binary format.
+        ///
+        /// \param[in] file Name of series file.  Overwritten if it exists.
+        void save(const boost::filesystem::path& file) const;
+
+        /// Append values of next report step.
+        ///
+        /// \param[in] reportStep Report step ID.  Must be greater than all
+        ///    previously appended IDs.
+        ///
+        /// \param[in] values Field values.  Size must equal numValues().
+        void append(const int reportStep, const std::vector<double>& values);
+
+        /// Retrieve values of single report step.
+        ///
+        /// \param[in] reportStep Report step ID passed to append().
+        ///
+        /// \return Field values of \p reportStep.
+        std::vector<double> values(const int reportStep) const;
+
+        /// Whether or not series contains particular report step.
+        bool hasStep(const int reportStep) const;
+
+        /// Retrieve IDs of all report steps in series, ascending.
+        const std::vector<int>& reportSteps() const;
+
+        /// Retrieve number of values per step.
+        std::size_t numValues() const;
+
+        /// Retrieve construction parameters.
+        const Options& options() const;
+
+        /// Retrieve total size, in bytes, of all encoded steps.
+        std::size_t compressedSize() const;
+
+    private:
+        /// Word representation of a step.  IEEE 754 bit patterns in
+        /// lossless mode, quantised values in bounded error mode.
+        using Words = std::vector<std::uint64_t>;
+
+        std::size_t numValues_;
+        Options     opt_;
+
+        std::vector<int> steps_;
+
+        /// Encoded steps, in order of steps_.
+        std::vector<std::vector<unsigned char>> frames_;
+
+        /// Word representation of last appended step.  Reference for
+        /// next difference.
+        Words last_;
+
+        /// Whether or not step at position in steps_ is a keyframe.
+        bool isKeyframe(const std::size_t pos) const;
+
+        /// Convert field values to word representation.
+        Words toWords(const std::vector<double>& values) const;
+
+        /// Convert word representation to field values.
+        std::vector<double> fromWords(const Words& words) const;
+
+        /// Encode step from word representation of step and predecessor.
+        /// Predecessor empty for keyframes.
+        std::vector<unsigned char>
+        encode(const Words& words, const Words& prev) const;
+
+        /// Decode step.  Predecessor empty for keyframes.
+        Words decode(const std::vector<unsigned char>& code,
+                     const Words&                      prev) const;
+
+        /// Reconstruct word representation of step at position in
+        /// steps_ from nearest preceding keyframe.
+        Words stepWords(const std::size_t pos) const;
+
+        /// Position of step in steps_.  Throws if not present.
+        std::size_t position(const int reportStep) const;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLSTEPSERIES_HEADER_INCLUDED
@@ -0,0 +1,481 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLSummaryData.hpp>
+
+#include <opm/utility/ECLCaseUtilities.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+/// \file
+///
+/// Implementation of direct summary file reader.
+
+namespace {
+    /// Minimal sequential reader of unformatted (binary) ECL files.
+    ///
+    /// Such files are sequences of keywords.  Each keyword is a 16-byte
+    /// header record (name, element count, element type) followed by zero
+    /// or more data records, all framed by Fortran record markers and
+    /// stored in big-endian byte order.
+    namespace ECLBinary {
+        std::uint32_t bigEndian(const char* p)
+        {
+            const auto* u = reinterpret_cast<const unsigned char*>(p);
+
+            return (std::uint32_t(u[0]) << 24) | (std::uint32_t(u[1]) << 16)
+                |  (std::uint32_t(u[2]) <<  8) |  std::uint32_t(u[3]);
+        }
+
+        std::string trimmed(const char* p, const std::size_t n)
+        {
+            auto s = std::string(p, n);
+
+            const auto e = s.find_last_not_of(' ');
+
+            return (e == std::string::npos)
+                ? std::string{} : s.substr(0, e + 1);
+        }
+
+        struct Header {
+            std::string name;
+            std::size_t count;
+            std::string type;
+            std::size_t elemSize;
+
+            std::size_t bytes() const
+            {
+                return this->count * this->elemSize;
+            }
+        };
+
+        class Reader
+        {
+        public:
+            explicit Reader(const boost::filesystem::path& file)
+                : file_(file)
+                , is_  (file, std::ios::in | std::ios::binary)
+            {
+                if (! this->is_) {
+                    throw std::invalid_argument {
+                        "Failed to open " + file.generic_string()
+                    };
+                }
+            }
+
+            /// Read next keyword header.
+            ///
+            /// \return Whether or not a header was available.
+            bool next(Header& h)
+            {
+                char buf[4 + 16 + 4];
+
+                this->is_.read(buf, sizeof buf);
+
+                if (this->is_.gcount() == 0) {
+                    return false;
+                }
+
+                if (! this->is_ || (bigEndian(buf) != 16) ||
+                    (bigEndian(buf + 20) != 16))
+                {
+                    this->corrupt();
+                }
+
+                h.name     = trimmed(buf + 4, 8);
+                h.count    = bigEndian(buf + 12);
+                h.type     = std::string(buf + 16, 4);
+                h.elemSize = elementSize(h.type);
+
+                return true;
+            }
+
+            /// Read all data records of current keyword.
+            ///
+            /// \return Raw, big-endian data elements.
+            std::vector<char> data(const Header& h)
+            {
+                auto x = std::vector<char>(h.bytes());
+
+                this->records(h, [this, &x](const std::size_t offset,
+                                            const std::size_t n)
+                {
+                    this->is_.read(x.data() + offset, n);
+                });
+
+                return x;
+            }
+
+            /// Skip all data records of current keyword.
+            void skip(const Header& h)
+            {
+                this->records(h, [this](const std::size_t /* offset */,
+                                        const std::size_t n)
+                {
+                    this->is_.seekg(n, std::ios::cur);
+                });
+            }
+
+        private:
+            boost::filesystem::path     file_;
+            boost::filesystem::ifstream is_;
+
+            static std::size_t elementSize(const std::string& type)
+            {
+                if ((type == "INTE") || (type == "REAL") ||
+                    (type == "LOGI"))
+                {
+                    return 4;
+                }
+
+                if (type == "DOUB") { return 8; }
+                if (type == "CHAR") { return 8; }
+                if (type == "MESS") { return 0; }
+
+                if ((type[0] == 'C') && (type[1] == '0')) {
+                    // C0nn: Strings of nn characters.
+                    return std::stoul(type.substr(1));
+                }
+
+                throw std::invalid_argument {
+                    "Unsupported Element Type '" + type + '\''
+                };
+            }
+
+            /// Traverse data records of current keyword.
+            template <class Action>
+            void records(const Header& h, Action&& action)
+            {
+                auto remaining = h.bytes();
+                auto offset    = std::size_t{0};
+
+                while (remaining > 0) {
+                    char m[4];
+
+                    this->is_.read(m, sizeof m);
+                    const auto n = std::size_t{ bigEndian(m) };
+
+                    if (! this->is_ || (n > remaining)) {
+                        this->corrupt();
+                    }
+
+                    action(offset, n);
+
+                    this->is_.read(m, sizeof m);
+                    if (! this->is_ || (bigEndian(m) != n)) {
+                        this->corrupt();
+                    }
+
+                    offset    += n;
+                    remaining -= n;
+                }
+            }
+
+            [[noreturn]] void corrupt() const
+            {
+                throw std::runtime_error {
+                    "File " + this->file_.generic_string() +
+                    " is Not a Valid Unformatted ECL File"
+                };
+            }
+        };
+
+        std::vector<int> intData(const std::vector<char>& raw)
+        {
+            auto x = std::vector<int>(raw.size() / 4);
+
+            for (auto n = x.size(), i = 0*n; i < n; ++i) {
+                x[i] = static_cast<int>(bigEndian(raw.data() + 4*i));
+            }
+
+            return x;
+        }
+
+        float floatElement(const char* p)
+        {
+            const auto u = bigEndian(p);
+
+            auto f = 0.0f;
+            std::memcpy(&f, &u, sizeof f);
+
+            return f;
+        }
+
+        std::vector<std::string>
+        stringData(const std::vector<char>& raw, const std::size_t width)
+        {
+            auto x = std::vector<std::string>{};
+
+            if (width == 0) { return x; }
+
+            x.reserve(raw.size() / width);
+
+            for (auto n = raw.size() / width, i = 0*n; i < n; ++i) {
+                x.push_back(trimmed(raw.data() + i*width, width));
+            }
+
+            return x;
+        }
+    } // namespace ECLBinary
+
+    boost::filesystem::path
+    unformattedSummaryFile(const boost::filesystem::path& file,
+                           const std::string&             ext)
+    {
+        if (file.empty() || (file.extension() != ext)) {
+            throw std::invalid_argument {
+                "Result Set Does Not Have Unformatted " + ext + " File"
+            };
+        }
+
+        return file;
+    }
+
+    bool isFieldName(const std::string& wgname)
+    {
+        return wgname.empty() || (wgname == ":+:+:+:+");
+    }
+} // Anonymous namespace
+
+// =====================================================================
+// Struct ECLSummaryData::TimeSeries
+// ---------------------------------------------------------------------
+
+int
+Opm::ECLSummaryData::TimeSeries::timeStepAtReport(const int step) const
+{
+    // Report step IDs are non-decreasing.  Find last time step of 'step'.
+    auto i = std::upper_bound(this->reportStep.begin(),
+                              this->reportStep.end(), step);
+
+    if ((i == this->reportStep.begin()) || (*(i - 1) != step)) {
+        return -1;
+    }
+
+    return static_cast<int>(std::distance(this->reportStep.begin(), i)) - 1;
+}
+
+// =====================================================================
+// Class ECLSummaryData
+// ---------------------------------------------------------------------
+
+Opm::ECLSummaryData::
+ECLSummaryData(const boost::filesystem::path& smspec,
+               const boost::filesystem::path& unsmry)
+    : unsmry_(unsmry)
+{
+    auto keywords = std::vector<std::string>{};
+    auto wgnames  = std::vector<std::string>{};
+    auto nums     = std::vector<int>{};
+    auto units    = std::vector<std::string>{};
+
+    {
+        ECLBinary::Reader spec{ smspec };
+        auto h    = ECLBinary::Header{};
+
+        while (spec.next(h)) {
+            if (h.name == "KEYWORDS") {
+                keywords = ECLBinary::stringData(spec.data(h), h.elemSize);
+            }
+            else if ((h.name == "WGNAMES") || (h.name == "NAMES")) {
+                wgnames = ECLBinary::stringData(spec.data(h), h.elemSize);
+            }
+            else if (h.name == "NUMS") {
+                nums = ECLBinary::intData(spec.data(h));
+            }
+            else if (h.name == "UNITS") {
+                units = ECLBinary::stringData(spec.data(h), h.elemSize);
+            }
+            else {
+                spec.skip(h);
+            }
+        }
+    }
+
+    this->numColumns_ = keywords.size();
+    this->timeColumn_ = this->numColumns_;
+
+    if ((wgnames.size() != this->numColumns_) ||
+        (! nums .empty() && (nums .size() != this->numColumns_)) ||
+        (! units.empty() && (units.size() != this->numColumns_)))
+    {
+        throw std::runtime_error {
+            "Inconsistent Summary Specification in "
+            + smspec.generic_string()
+        };
+    }
+
+    for (auto n = this->numColumns_, i = 0*n; i < n; ++i) {
+        const auto& kw   = keywords[i];
+        const auto  name = isFieldName(wgnames[i])
+            ? std::string{} : wgnames[i];
+
+        if (kw == "TIME") {
+            this->timeColumn_ = i;
+        }
+
+        auto& col = this->index_[std::make_tuple(kw, name)];
+        col.push_back(Column{ nums.empty() ? 0 : nums[i], i,
+                              units.empty() ? std::string{} : units[i] });
+
+        if (! name.empty() && (col.size() == 1)) {
+            this->names_[kw].push_back(name);
+        }
+    }
+}
+
+Opm::ECLSummaryData::
+ECLSummaryData(const ECLCaseUtilities::ResultSet& rset)
+    : ECLSummaryData(unformattedSummaryFile(rset.summarySpecFile(),
+                                            ".SMSPEC"),
+                     unformattedSummaryFile(rset.unifiedSummaryFile(),
+                                            ".UNSMRY"))
+{}
+
+bool
+Opm::ECLSummaryData::hasVector(const Key& key) const
+{
+    return this->column(key) != nullptr;
+}
+
+std::vector<std::string>
+Opm::ECLSummaryData::names(const std::string& keyword) const
+{
+    auto i = this->names_.find(keyword);
+
+    if (i == this->names_.end()) {
+        return {};
+    }
+
+    return i->second;
+}
+
+std::string
+Opm::ECLSummaryData::unit(const Key& key) const
+{
+    const auto* col = this->column(key);
+
+    return (col == nullptr) ? std::string{} : col->unit;
+}
+
+Opm::ECLSummaryData::TimeSeries
+Opm::ECLSummaryData::extract(const std::vector<Key>& vectors) const
+{
+    auto cols = std::vector<std::size_t>{};
+    cols.reserve(vectors.size());
+
+    for (const auto& key : vectors) {
+        const auto* col = this->column(key);
+
+        if (col == nullptr) {
+            std::ostringstream os;
+
+            os << "Summary Vector (" << key.keyword << ", "
+               << (key.name.empty() ? std::string("Field") : key.name)
+               << ", " << key.num << ") Unavailable or Ambiguous";
+
+            throw std::invalid_argument(os.str());
+        }
+
+        cols.push_back(col->index);
+    }
+
+    auto ts = TimeSeries{};
+    ts.values.resize(vectors.size());
+
+    ECLBinary::Reader smry{ this->unsmry_ };
+    auto h      = ECLBinary::Header{};
+    auto report = 0;
+
+    while (smry.next(h)) {
+        if (h.name == "SEQHDR") {
+            // Start of new report step.
+            ++report;
+            smry.skip(h);
+        }
+        else if (h.name == "PARAMS") {
+            if (h.count < this->numColumns_ || (h.type != "REAL")) {
+                throw std::runtime_error {
+                    "Summary File " + this->unsmry_.generic_string() +
+                    " Inconsistent With Specification"
+                };
+            }
+
+            const auto raw = smry.data(h);
+
+            for (auto n = cols.size(), v = 0*n; v < n; ++v) {
+                ts.values[v].push_back
+                    (ECLBinary::floatElement(raw.data() + 4*cols[v]));
+            }
+
+            if (this->timeColumn_ < this->numColumns_) {
+                ts.time.push_back(ECLBinary::floatElement
+                                  (raw.data() + 4*this->timeColumn_));
+            }
+
+            ts.reportStep.push_back(report);
+        }
+        else {
+            smry.skip(h);
+        }
+    }
+
+    return ts;
+}
+
+const Opm::ECLSummaryData::Column*
+Opm::ECLSummaryData::column(const Key& key) const
+{
+    const auto name = isFieldName(key.name) ? std::string{} : key.name;
+
+    auto i = this->index_.find(std::make_tuple(key.keyword, name));
+
+    if (i == this->index_.end()) {
+        return nullptr;
+    }
+
+    const auto& cols = i->second;
+
+    if (key.num == 0) {
+        return (cols.size() == 1) ? &cols.front() : nullptr;
+    }
+
+    auto c = std::find_if(cols.begin(), cols.end(),
+        [&key](const Column& col)
+    {
+        return col.num == key.num;
+    });
+
+    return (c == cols.end()) ? nullptr : &*c;
+}
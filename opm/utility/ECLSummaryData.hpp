@@ -0,0 +1,183 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLSUMMARYDATA_HEADER_INCLUDED
+#define OPM_ECLSUMMARYDATA_HEADER_INCLUDED
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+/// \file
+///
+/// Direct reader for unified ECLIPSE summary result sets (SMSPEC/UNSMRY).
+
+namespace Opm {
+
+    namespace ECLCaseUtilities {
+        class ResultSet;
+    } // namespace ECLCaseUtilities
+
+    /// Extract time series of selected summary vectors--typically well or
+    /// group rates such as WOPR, WWIR or GOPR--for all time steps of a
+    /// simulation run.
+    ///
+    /// The specification (SMSPEC) file is loaded once to form an index from
+    /// (keyword, well/group name, number) triples to PARAMS columns.
+    /// Extracting any number of vectors is then a single sequential pass
+    /// over the unified summary (UNSMRY) file that decodes only the
+    /// requested columns.
+    ///
+    /// Only unformatted, unified summary files are supported.  Values are
+    /// reported in the units of the result set.
+    class ECLSummaryData
+    {
+    public:
+        /// Identity of single summary vector.
+        struct Key {
+            /// Summary keyword, e.g., "WOPR", "GWIR" or "FOPT".
+            std::string keyword;
+
+            /// Well or group name.  Empty for field and other vectors that
+            /// are not associated with a well or group.
+            std::string name;
+
+            /// Numeric qualifier (e.g., cell or region number).  Zero (the
+            /// default) matches any value, provided the keyword/name pair
+            /// identifies a unique vector.
+            int num;
+
+            /// Constructor.
+            Key(std::string kw, std::string nm = "", const int n = 0)
+                : keyword(std::move(kw)), name(std::move(nm)), num(n)
+            {}
+        };
+
+        /// Values of selected vectors at all time steps.
+        struct TimeSeries {
+            /// Simulated time (TIME vector, usually days) at each time
+            /// step.  Empty if the summary does not contain TIME.
+            std::vector<double> time;
+
+            /// Report step to which each time step belongs.  Time steps
+            /// between report steps k-1 and k belong to report step k.
+            std::vector<int> reportStep;
+
+            /// Vector values.  One element per selected key, each with one
+            /// value per time step.
+            std::vector<std::vector<double>> values;
+
+            /// Index of the last time step of a report step, i.e., the
+            /// time step whose values correspond to the restart data of
+            /// that step.
+            ///
+            /// \param[in] step Report step ID.
+            ///
+            /// \return Time step index.  Negative if no time step belongs
+            ///    to \p step.
+            int timeStepAtReport(const int step) const;
+        };
+
+        /// Constructor.
+        ///
+        /// \param[in] smspec Name of summary specification file.
+        ///
+        /// \param[in] unsmry Name of unified summary file.
+        ECLSummaryData(const boost::filesystem::path& smspec,
+                       const boost::filesystem::path& unsmry);
+
+        /// Constructor.
+        ///
+        /// Fails (throws an exception of type \c std::invalid_argument) if
+        /// the result set does not have an unformatted, unified summary.
+        ///
+        /// \param[in] rset Result set.
+        explicit ECLSummaryData(const ECLCaseUtilities::ResultSet& rset);
+
+        /// Query for availability of summary vector.
+        ///
+        /// \param[in] key Summary vector identity.
+        bool hasVector(const Key& key) const;
+
+        /// Retrieve names of all wells or groups for which a particular
+        /// keyword is available.
+        ///
+        /// \param[in] keyword Summary keyword, e.g., "WOPR".
+        ///
+        /// \return Well or group names in order of first appearance in
+        ///    specification file.
+        std::vector<std::string> names(const std::string& keyword) const;
+
+        /// Retrieve unit string of summary vector.
+        ///
+        /// \param[in] key Summary vector identity.
+        std::string unit(const Key& key) const;
+
+        /// Extract time series of selected vectors in a single pass.
+        ///
+        /// Fails (throws an exception of type \c std::invalid_argument) if
+        /// any of the keys does not identify a unique summary vector.
+        ///
+        /// \param[in] vectors Selected summary vectors.
+        ///
+        /// \return Values of all selected vectors at all time steps.
+        TimeSeries extract(const std::vector<Key>& vectors) const;
+
+    private:
+        /// Specification of single PARAMS column.
+        struct Column {
+            int         num;
+            std::size_t index;
+            std::string unit;
+        };
+
+        using Index =
+            std::map<std::tuple<std::string, std::string>,
+                     std::vector<Column>>;
+
+        /// Name of unified summary file.
+        boost::filesystem::path unsmry_;
+
+        /// Keyword/name to column index.
+        Index index_;
+
+        /// Well/group names per keyword, in order of first appearance.
+        std::map<std::string, std::vector<std::string>> names_;
+
+        /// Number of PARAMS columns.
+        std::size_t numColumns_{0};
+
+        /// Column of TIME vector.  Equal to numColumns_ if absent.
+        std::size_t timeColumn_{0};
+
+        /// Locate PARAMS column of single vector.
+        ///
+        /// \return Pointer to column or null if key does not identify a
+        ///    unique vector.
+        const Column* column(const Key& key) const;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLSUMMARYDATA_HEADER_INCLUDED
@@ -21,23 +21,90 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <exception>
 #include <functional>
+#include <limits>
 #include <stdexcept>
 #include <utility>
 #include <vector>
 
 namespace Details {
+    std::size_t trailingOnes(std::size_t k)
+    {
+#if defined(__GNUC__)
+        // Note: ~k != 0 because k < 2^(CHAR_BIT * sizeof k - 1).
+        return __builtin_ctzll(~static_cast<unsigned long long>(k));
+#else
+        auto n = std::size_t{0};
+        for (; (k & 1u) != 0; k >>= 1) { ++n; }
+
+        return n;
+#endif
+    }
+
+    void prefetch(const double* p)
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(p);
+#else
+        static_cast<void>(p);
+#endif
+    }
+
+    void buildEytzinger(const std::vector<double>& xi,
+                        const std::size_t          k,
+                        std::size_t&               i,
+                        std::vector<double>&       tree,
+                        std::vector<std::size_t>&  rank)
+    {
+        // In-order traversal of implicit tree assigns sorted elements.
+        // Recursion depth is log2(xi.size()).
+        if (k < tree.size()) {
+            buildEytzinger(xi, 2*k + 0, i, tree, rank);
+
+            tree[k] = xi[i];
+            rank[k] = i++;
+
+            buildEytzinger(xi, 2*k + 1, i, tree, rank);
+        }
+    }
+
+    template <class Compare>
+    std::size_t
+    eytzingerLowerBound(const std::vector<double>&      tree,
+                        const std::vector<std::size_t>& rank,
+                        const double                    x,
+                        Compare&&                       compare)
+    {
+        const auto n = tree.size() - 1;
+
+        // Descend from root.  Go right (2k+1) if tree[k] compares less
+        // than 'x' and left (2k) otherwise.  Loop trip count depends on
+        // the tree height only.
+        auto k = std::size_t{1};
+        while (k <= n) {
+            // Nodes 8k .. 8k+7 (three levels down) typically share a
+            // single cache line.
+            prefetch(tree.data() + std::min(8*k, n));
+
+            k = 2*k + static_cast<std::size_t>(compare(tree[k], x));
+        }
+
+        // Undo trailing right turns plus the final left turn to recover
+        // the last node that did not compare less than 'x'.  Zero if no
+        // such node exists (i.e., 'x' is beyond the range).
+        k >>= trailingOnes(k) + 1;
+
+        return (k == 0) ? n : rank[k];
+    }
+
     template <class Compare>
     std::vector<double>::size_type
     intervalInRange(const std::vector<double>& abscissas,
                     const double               x,
                     Compare&&                  compare)
     {
-        // Verify that 'x' is within range.  Order of arguments matters.
-        assert (! compare(x, abscissas.front()));
-        assert (! compare(abscissas.back(), x));
-
         const auto b = std::begin(abscissas);
         const auto p =
             std::lower_bound(b, std::end(abscissas), x,
@@ -45,20 +112,15 @@ namespace Details {
 
         assert (p != std::end(abscissas));
 
-        // p = lower_bound() => p identifies *right-hand* (upper) end-point
-        // of interval (insertion point) => (p - b) is index of right-hand
-        // end-point.  Consequently (p - b) - 1 is index of *left-hand*
-        // end-point and the point with which we associate the pertinent
-        // interval.  Special case handling for p == b.
-
-        return (p == b) ? 0 : (p - b) - 1;
+        return p - b;
     }
 
-    template <class Compare>
+    template <class Compare, class LowerBound>
     Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint
     identifyPoint(const std::vector<double>& xi,
                   const double               x,
-                  Compare&&                  compare)
+                  Compare&&                  compare,
+                  LowerBound&&               lowerBound)
     {
         namespace PP = ::Opm::Interp1D::PiecewisePolynomial;
         using PCat   = ::Opm::Interp1D::PointCategory;
@@ -80,7 +142,17 @@ namespace Details {
         }
 
         // Common case: x \in [min(xi), max(xi)]
-        const auto interval = intervalInRange(xi, x, compare);
+        //
+        // p = lower_bound() => p identifies *right-hand* (upper) end-point
+        // of interval (insertion point) => p is index of right-hand
+        // end-point.  Consequently p - 1 is index of *left-hand* end-point
+        // and the point with which we associate the pertinent interval.
+        // Special case handling for p == 0.
+        const auto p = lowerBound(x);
+
+        assert (p < xi.size());
+
+        const auto interval = (p == 0) ? p : p - 1;
 
         assert ((interval + 1 < xi.size()) || (xi.size() == 1));
 
@@ -101,12 +173,231 @@ namespace Details {
             };
         }
 
-        return identifyPoint(xi, x, std::forward<Compare>(compare));
+        return identifyPoint(xi, x, compare, [&xi, &compare](const double y)
+        {
+            return intervalInRange(xi, y, compare);
+        });
+    }
+
+    template <class IsAscending, class Compare>
+    Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint
+    identify(const std::vector<double>&          xi,
+             const double                        x,
+             const Opm::Interp1D::EytzingerIndex& index,
+             Compare&&                           compare)
+    {
+        if (! index.active()) {
+            return identify(xi, x, std::forward<Compare>(compare));
+        }
+
+        return identifyPoint(xi, x, compare, [&index](const double y)
+        {
+            return index.lowerBound(y, IsAscending{});
+        });
+    }
+
+    template <class IsAscending, class Compare>
+    Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint
+    identify(const std::vector<double>&           xi,
+             const double                         x,
+             const Opm::Interp1D::EytzingerIndex& index,
+             Opm::Interp1D::IntervalHintCache&    hints,
+             const std::size_t                    i,
+             Compare&&                            compare)
+    {
+        using Outcome = Opm::Interp1D::IntervalHintCache::Outcome;
+
+        if (xi.size() < 2) {
+            // No intervals.  Nothing to remember.
+            return identify<IsAscending>(xi, x, index,
+                                         std::forward<Compare>(compare));
+        }
+
+        const auto nIntervals = xi.size() - 1;
+
+        // Whether or not point 'y' is in interval 'k' as defined by
+        // lower_bound() semantics.  Left end-point of interval 0 included.
+        auto inInterval = [&xi, &compare, nIntervals]
+            (const std::size_t k, const double y) -> bool
+        {
+            return (k < nIntervals)
+                && ((k == 0) ? ! compare(y, xi[0]) : compare(xi[k], y))
+                && ! compare(xi[k + 1], y);
+        };
+
+        // Search callback invoked only for points inside the tabulated
+        // range.
+        auto outcome = Outcome::Extrapolated;
+
+        // Identified interval 'k' expressed as lower_bound() position k+1.
+        const auto pt = identifyPoint(xi, x, compare,
+            [&xi, &index, &hints, i, nIntervals, &compare, &inInterval,
+             &outcome](const double y) -> std::size_t
+        {
+            const auto h = hints.hint(i);
+
+            if (h < nIntervals) {
+                if (inInterval(h, y)) {
+                    outcome = Outcome::Hit;
+                    return h + 1;
+                }
+
+                if (inInterval(h + 1, y)) {
+                    outcome = Outcome::NeighbourHit;
+                    return h + 2;
+                }
+
+                if ((h > 0) && inInterval(h - 1, y)) {
+                    outcome = Outcome::NeighbourHit;
+                    return h;
+                }
+            }
+
+            outcome = Outcome::Miss;
+
+            return index.active()
+                ? index.lowerBound(y, IsAscending{})
+                : intervalInRange(xi, y, compare);
+        });
+
+        hints.update(i, std::min(pt.interval, nIntervals - 1), outcome);
+
+        return pt;
     }
 } // Anonymous
 
 // =====================================================================
 
+double
+Opm::Interp1D::IntervalHintCache::Statistics::hitRate() const
+{
+    const auto inRange = this->lookups - this->extrapolated;
+
+    if (inRange == 0) {
+        return 0.0;
+    }
+
+    return static_cast<double>(this->hits + this->neighbourHits)
+        / static_cast<double>(inRange);
+}
+
+Opm::Interp1D::IntervalHintCache::Statistics&
+Opm::Interp1D::IntervalHintCache::Statistics::operator+=(const Statistics& rhs)
+{
+    this->lookups       += rhs.lookups;
+    this->hits          += rhs.hits;
+    this->neighbourHits += rhs.neighbourHits;
+    this->extrapolated  += rhs.extrapolated;
+
+    return *this;
+}
+
+void
+Opm::Interp1D::IntervalHintCache::prepare(const std::size_t numPoints)
+{
+    if (numPoints != this->interval_.size()) {
+        // Different sequence.  Existing hints are meaningless.
+        this->interval_.assign(numPoints,
+                               std::numeric_limits<std::size_t>::max());
+    }
+}
+
+void
+Opm::Interp1D::IntervalHintCache::update(const std::size_t i,
+                                         const std::size_t interval,
+                                         const Outcome     outcome)
+{
+    assert (i < this->interval_.size());
+
+    this->interval_[i] = interval;
+
+    this->stats_.lookups += 1;
+
+    switch (outcome) {
+    case Outcome::Hit:
+        this->stats_.hits += 1;
+        break;
+
+    case Outcome::NeighbourHit:
+        this->stats_.neighbourHits += 1;
+        break;
+
+    case Outcome::Extrapolated:
+        this->stats_.extrapolated += 1;
+        break;
+
+    case Outcome::Miss:
+        break;
+    }
+}
+
+// =====================================================================
+
+void
+Opm::Interp1D::RoundingError::update(const double original,
+                                     const double stored)
+{
+    const auto diff = std::abs(stored - original);
+
+    this->numValues  += 1;
+    this->maxAbsolute = std::max(this->maxAbsolute, diff);
+
+    if (original != 0.0) {
+        this->maxRelative =
+            std::max(this->maxRelative, diff / std::abs(original));
+    }
+}
+
+Opm::Interp1D::RoundingError&
+Opm::Interp1D::RoundingError::operator+=(const RoundingError& rhs)
+{
+    this->numValues  += rhs.numValues;
+    this->maxAbsolute = std::max(this->maxAbsolute, rhs.maxAbsolute);
+    this->maxRelative = std::max(this->maxRelative, rhs.maxRelative);
+
+    return *this;
+}
+
+// =====================================================================
+
+Opm::Interp1D::EytzingerIndex::EytzingerIndex(const std::vector<double>& xi)
+{
+    if (xi.size() < minimumSize()) {
+        // Ordinary binary search is faster for short sequences.
+        return;
+    }
+
+    this->tree_.resize(xi.size() + 1, 0.0);
+    this->rank_.resize(xi.size() + 1, 0);
+
+    auto i = std::size_t{0};
+    Details::buildEytzinger(xi, 1, i, this->tree_, this->rank_);
+
+    assert (i == xi.size());
+}
+
+std::size_t
+Opm::Interp1D::EytzingerIndex::lowerBound(const double x,
+                                          std::true_type) const
+{
+    assert (this->active());
+
+    return Details::eytzingerLowerBound(this->tree_, this->rank_, x,
+                                        std::less<double>{});
+}
+
+std::size_t
+Opm::Interp1D::EytzingerIndex::lowerBound(const double x,
+                                          std::false_type) const
+{
+    assert (this->active());
+
+    return Details::eytzingerLowerBound(this->tree_, this->rank_, x,
+                                        std::greater<double>{});
+}
+
+// =====================================================================
+
 Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint
 Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint::
 identify(const std::vector<double>& xi,
@@ -122,3 +413,47 @@ identify(const std::vector<double>& xi,
 {
     return Details::identify(xi, x, std::greater<double>{});
 }
+
+Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint
+Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint::
+identify(const std::vector<double>& xi,
+         const double               x,
+         const EytzingerIndex&      index, std::true_type)
+{
+    return Details::identify<std::true_type>(xi, x, index,
+                                             std::less<double>{});
+}
+
+Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint
+Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint::
+identify(const std::vector<double>& xi,
+         const double               x,
+         const EytzingerIndex&      index, std::false_type)
+{
+    return Details::identify<std::false_type>(xi, x, index,
+                                              std::greater<double>{});
+}
+
+Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint
+Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint::
+identify(const std::vector<double>& xi,
+         const double               x,
+         const EytzingerIndex&      index,
+         IntervalHintCache&         hints,
+         const std::size_t          i, std::true_type)
+{
+    return Details::identify<std::true_type>(xi, x, index, hints, i,
+                                             std::less<double>{});
+}
+
+Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint
+Opm::Interp1D::PiecewisePolynomial::LocalInterpPoint::
+identify(const std::vector<double>& xi,
+         const double               x,
+         const EytzingerIndex&      index,
+         IntervalHintCache&         hints,
+         const std::size_t          i, std::false_type)
+{
+    return Details::identify<std::false_type>(xi, x, index, hints, i,
+                                              std::greater<double>{});
+}
@@ -21,6 +21,7 @@
 #define OPM_ECLTABLEINTERPOLATION1D_HEADER_INCLUDED
 
 #include <cassert>
+#include <cstddef>
 #include <type_traits>
 #include <vector>
 
@@ -45,6 +46,234 @@ namespace Opm { namespace Interp1D {
         RightOfRange,
     };
 
+    /// Search accelerator for long, sorted sequences of abscissas.
+    ///
+    /// Stores a copy of the abscissas in Eytzinger (breadth-first) order,
+    /// i.e., as an implicit, complete binary search tree in which the
+    /// children of node \c k are located at positions \c 2k and \c 2k+1.
+    /// A search walks the tree from the root using branch-free steps only
+    /// and touches memory in a predictable pattern that is amenable to
+    /// prefetching.  This outperforms an ordinary binary search only for
+    /// tables of more than a few dozen rows, so the index is formed only
+    /// for sequences of at least \code minimumSize() \endcode elements.
+    class EytzingerIndex
+    {
+    public:
+        /// Default constructor.
+        ///
+        /// Creates an inactive index.
+        EytzingerIndex() = default;
+
+        /// Constructor.
+        ///
+        /// \param[in] xi Sequence of abscissas, sorted either ascendingly
+        ///    or descendingly.  Search index formed only if \code
+        ///    xi.size() >= minimumSize() \endcode.
+        explicit EytzingerIndex(const std::vector<double>& xi);
+
+        /// Minimum number of abscissas for which to form a search index.
+        static constexpr std::size_t minimumSize()
+        {
+            return 64;
+        }
+
+        /// Whether or not this search index has been formed.  Inactive
+        /// indices must not be used to search a sequence.
+        bool active() const
+        {
+            return ! this->tree_.empty();
+        }
+
+        /// Locate position of first element of ascendingly sorted
+        /// sequence that is not less than particular value.
+        ///
+        /// Equivalent to \code std::lower_bound(begin(xi), end(xi), x)
+        /// - begin(xi) \endcode.
+        ///
+        /// \param[in] x Sample point.
+        ///
+        /// \param[in] is_ascending Tagged dispatch overload
+        ///    disambiguation object.  Unused.
+        ///
+        /// \return Position in original sequence.  Equal to number of
+        ///    abscissas if all elements compare less than \p x.
+        std::size_t lowerBound(const double   x,
+                               std::true_type is_ascending) const;
+
+        /// Locate position of first element of descendingly sorted
+        /// sequence that is not greater than particular value.
+        ///
+        /// Equivalent to \code std::lower_bound(begin(xi), end(xi), x,
+        /// std::greater<double>{}) - begin(xi) \endcode.
+        ///
+        /// \param[in] x Sample point.
+        ///
+        /// \param[in] is_ascending Tagged dispatch overload
+        ///    disambiguation object.  Unused.
+        ///
+        /// \return Position in original sequence.  Equal to number of
+        ///    abscissas if all elements compare greater than \p x.
+        std::size_t lowerBound(const double    x,
+                               std::false_type is_ascending) const;
+
+    private:
+        /// Abscissas in breadth-first order.  One-based indexing, element
+        /// zero is unused.
+        std::vector<double> tree_;
+
+        /// Position in original sequence of each node of \c tree_.
+        std::vector<std::size_t> rank_;
+    };
+
+    /// Warm-start interval hints for a fixed sequence of sample points.
+    ///
+    /// Remembers the interval in which each point of a sequence was last
+    /// localized.  When the same sequence is classified again--e.g., the
+    /// pressures or saturations of a fixed set of cells at the next report
+    /// step--the remembered interval and its immediate neighbours are
+    /// checked before resorting to a full search.  Hints never affect the
+    /// classification result, only the cost of computing it.
+    class IntervalHintCache
+    {
+    public:
+        /// Hit rate statistics.
+        struct Statistics
+        {
+            /// Total number of classified points.
+            std::size_t lookups{0};
+
+            /// Number of points found in their hinted interval.
+            std::size_t hits{0};
+
+            /// Number of points found in an interval adjacent to their
+            /// hinted interval.
+            std::size_t neighbourHits{0};
+
+            /// Number of points outside the tabulated range.  These never
+            /// require a search and are not included in \c hits.
+            std::size_t extrapolated{0};
+
+            /// Fraction of lookups inside the tabulated range that did not
+            /// require a full search.  Zero if there have been no such
+            /// lookups.
+            double hitRate() const;
+
+            /// Accumulate statistics from other cache.
+            ///
+            /// \param[in] rhs Other statistics.
+            ///
+            /// \return \code *this \endcode.
+            Statistics& operator+=(const Statistics& rhs);
+        };
+
+        /// Outcome of a single, hinted lookup.
+        enum class Outcome {
+            /// Point in hinted interval.
+            Hit,
+
+            /// Point in interval adjacent to hinted interval.
+            NeighbourHit,
+
+            /// Full search required.
+            Miss,
+
+            /// Point outside tabulated range.  No search required.
+            Extrapolated,
+        };
+
+        /// Prepare cache for classifying a sequence of sample points.
+        ///
+        /// Existing hints are retained if the sequence has the same number
+        /// of points as the previous sequence and discarded otherwise.
+        ///
+        /// \param[in] numPoints Number of points in sample sequence.
+        void prepare(const std::size_t numPoints);
+
+        /// Number of points in currently prepared sequence.
+        std::size_t size() const
+        {
+            return this->interval_.size();
+        }
+
+        /// Retrieve interval hint of particular point.
+        ///
+        /// \param[in] i Point index.  Must be less than \code size()
+        ///    \endcode.
+        ///
+        /// \return Interval in which point \p i was previously localized.
+        ///    Greater than all valid interval indices if no such interval
+        ///    exists.
+        std::size_t hint(const std::size_t i) const
+        {
+            assert (i < this->interval_.size());
+
+            return this->interval_[i];
+        }
+
+        /// Record result of hinted lookup.
+        ///
+        /// \param[in] i Point index.  Must be less than \code size()
+        ///    \endcode.
+        ///
+        /// \param[in] interval Interval in which to localize point \p i.
+        ///
+        /// \param[in] outcome Whether or not the lookup was able to use
+        ///    the previous hint.
+        void update(const std::size_t i,
+                    const std::size_t interval,
+                    const Outcome     outcome);
+
+        /// Retrieve accumulated hit rate statistics.
+        const Statistics& statistics() const
+        {
+            return this->stats_;
+        }
+
+        /// Clear accumulated hit rate statistics.  Retains hints.
+        void resetStatistics()
+        {
+            this->stats_ = Statistics{};
+        }
+
+    private:
+        /// Interval hint of each point in sequence.
+        std::vector<std::size_t> interval_;
+
+        /// Accumulated hit rate statistics.
+        Statistics stats_;
+    };
+
+    /// Accuracy of reduced precision table storage.
+    ///
+    /// Summarises the differences between tabulated values and their
+    /// single precision (\c float) representations.
+    struct RoundingError
+    {
+        /// Number of values stored in reduced precision.
+        std::size_t numValues{0};
+
+        /// Largest absolute difference between original and stored value.
+        double maxAbsolute{0.0};
+
+        /// Largest difference relative to magnitude of original value.
+        /// Zero-valued originals are not included.
+        double maxRelative{0.0};
+
+        /// Include single value in summary.
+        ///
+        /// \param[in] original Tabulated value.
+        ///
+        /// \param[in] stored Value as represented in reduced precision.
+        void update(const double original, const double stored);
+
+        /// Combine summaries of multiple tables.
+        ///
+        /// \param[in] rhs Other summary.
+        ///
+        /// \return \code *this \endcode.
+        RoundingError& operator+=(const RoundingError& rhs);
+    };
+
     /// Functionality for interpolating functions of a single variate using
     /// piecewise polynomials.
     namespace PiecewisePolynomial {
@@ -395,6 +624,119 @@ namespace Opm { namespace Interp1D {
             identify(const std::vector<double>& xi,
                      const double               x,
                      std::false_type is_ascending);
+
+            /// Identify point category and, usually, particular interval in
+            /// which a specific point is localized.
+            ///
+            /// Overload for ascendingly sorted abscissas with accompanying
+            /// search index.  Falls back to an ordinary binary search if
+            /// the index is not active.
+            ///
+            /// \param[in] xi Sequence of separating abscissas representing
+            ///    non-overlapping intervals of an independent variable.
+            ///
+            /// \param[in] x Sample point.
+            ///
+            /// \param[in] index Search index formed from \p xi.
+            ///
+            /// \param[in] is_ascending Tagged dispatch overload
+            ///    disambiguation object.  Unused.
+            ///
+            /// \return Sample point localized with respect to the abscissas
+            ///    \p xi.
+            static LocalInterpPoint
+            identify(const std::vector<double>& xi,
+                     const double               x,
+                     const EytzingerIndex&      index,
+                     std::true_type is_ascending = std::true_type{});
+
+            /// Identify point category and, usually, particular interval in
+            /// which a specific point is localized.
+            ///
+            /// Overload for descendingly sorted abscissas with accompanying
+            /// search index.  Falls back to an ordinary binary search if
+            /// the index is not active.
+            ///
+            /// \param[in] xi Sequence of separating abscissas representing
+            ///    non-overlapping intervals of an independent variable.
+            ///
+            /// \param[in] x Sample point.
+            ///
+            /// \param[in] index Search index formed from \p xi.
+            ///
+            /// \param[in] is_ascending Tagged dispatch overload
+            ///    disambiguation object.  Unused.
+            ///
+            /// \return Sample point localized with respect to the abscissas
+            ///    \p xi.
+            static LocalInterpPoint
+            identify(const std::vector<double>& xi,
+                     const double               x,
+                     const EytzingerIndex&      index,
+                     std::false_type is_ascending);
+
+            /// Identify point category and interval using previously
+            /// identified interval as starting point.
+            ///
+            /// Overload for ascendingly sorted abscissas.  Checks interval
+            /// hint and its immediate neighbours before falling back to a
+            /// full search using the search \p index.  Records outcome in
+            /// the hint cache.
+            ///
+            /// \param[in] xi Sequence of separating abscissas representing
+            ///    non-overlapping intervals of an independent variable.
+            ///
+            /// \param[in] x Sample point.
+            ///
+            /// \param[in] index Search index formed from \p xi.
+            ///
+            /// \param[in,out] hints Interval hint cache.
+            ///
+            /// \param[in] i Index of \p x in sequence of sample points
+            ///    represented by \p hints.
+            ///
+            /// \param[in] is_ascending Tagged dispatch overload
+            ///    disambiguation object.  Unused.
+            ///
+            /// \return Sample point localized with respect to the abscissas
+            ///    \p xi.
+            static LocalInterpPoint
+            identify(const std::vector<double>& xi,
+                     const double               x,
+                     const EytzingerIndex&      index,
+                     IntervalHintCache&         hints,
+                     const std::size_t          i,
+                     std::true_type is_ascending = std::true_type{});
+
+            /// Identify point category and interval using previously
+            /// identified interval as starting point.
+            ///
+            /// Overload for descendingly sorted abscissas.
+            ///
+            /// \param[in] xi Sequence of separating abscissas representing
+            ///    non-overlapping intervals of an independent variable.
+            ///
+            /// \param[in] x Sample point.
+            ///
+            /// \param[in] index Search index formed from \p xi.
+            ///
+            /// \param[in,out] hints Interval hint cache.
+            ///
+            /// \param[in] i Index of \p x in sequence of sample points
+            ///    represented by \p hints.
+            ///
+            /// \param[in] is_ascending Tagged dispatch overload
+            ///    disambiguation object.  Unused.
+            ///
+            /// \return Sample point localized with respect to the abscissas
+            ///    \p xi.
+            static LocalInterpPoint
+            identify(const std::vector<double>& xi,
+                     const double               x,
+                     const EytzingerIndex&      index,
+                     IntervalHintCache&         hints,
+                     const std::size_t          i,
+                     std::false_type is_ascending);
         };
 
     } // PiecewisePolynomial
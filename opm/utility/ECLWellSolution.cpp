@@ -29,8 +29,12 @@
 #include <ert/ecl/ecl_kw_magic.h>
 #include <ert/ecl_well/well_const.h>
 #include <cmath>
+#include <cstddef>
+#include <map>
 #include <stdexcept>
 #include <sstream>
+#include <tuple>
+#include <utility>
 
 namespace Opm
 {
@@ -129,6 +133,37 @@ namespace Opm
         enum { IWEL_TYPE_PRODUCER = 1 };
 
 
+
+
+        // Whether or not restart block provides the dynamic well data
+        // needed to compute completion rates in a particular grid.
+        bool haveRateData(const ECLRestartData& restart,
+                          const std::string&    gridName)
+        {
+            return restart.haveKeywordData(IWEL_KW, gridName)
+                && restart.haveKeywordData("XWEL" , gridName)
+                && restart.haveKeywordData(ICON_KW, gridName)
+                && restart.haveKeywordData("XCON" , gridName);
+        }
+
+
+
+
+        // Return index of name in table, appending it if not present.
+        std::size_t intern(const std::string&                  name,
+                           std::map<std::string, std::size_t>& index,
+                           std::vector<std::string>&           table)
+        {
+            auto i = index.find(name);
+            if (i == index.end()) {
+                i = index.emplace(name, table.size()).first;
+                table.push_back(name);
+            }
+
+            return i->second;
+        }
+
+
     } // anonymous namespace
 
 
@@ -171,10 +206,7 @@ namespace Opm
     {
         // Check if result set provides complete set of well solution data.
         if (! (restart.haveKeywordData(ZWEL_KW, gridName) &&
-               restart.haveKeywordData(IWEL_KW, gridName) &&
-               restart.haveKeywordData("XWEL" , gridName) &&
-               restart.haveKeywordData(ICON_KW, gridName) &&
-               restart.haveKeywordData("XCON" , gridName)))
+               haveRateData(restart, gridName)))
         {
             // Not all requisite keywords present in this grid.  Can't
             // create a well solution.
@@ -247,4 +279,156 @@ namespace Opm
 
 
 
+    ECLWellSolution::RateHistory
+    ECLWellSolution::history(const ECLRestartData&           restart,
+                             const std::vector<int>&         steps,
+                             const std::vector<std::string>& grids,
+                             const ECLCancellationToken&     token) const
+    {
+        using CompletionID = std::tuple<std::size_t, std::size_t,
+                                        int, int, int>;
+
+        RateHistory hist;
+        hist.steps     = steps;
+        hist.gridNames = grids;
+
+        std::map<std::string, std::size_t> wellIndex;
+        std::map<CompletionID, std::size_t> compIndex;
+
+        // Interned well ID of each restart file well position, per grid.
+        std::vector<std::vector<std::size_t>> wellID(grids.size());
+
+        // Non-zero rates and injecting wells of each step.  The number of
+        // columns is not known until all steps have been visited.
+        std::vector<std::vector<std::pair<std::size_t, double>>>
+            stepRates(steps.size());
+        std::vector<std::vector<std::size_t>> stepInjectors(steps.size());
+
+        for (auto nstep = steps.size(), s = 0*nstep; s < nstep; ++s) {
+            token.throwIfCancelled();
+
+            if (! restart.selectReportStep(steps[s])) {
+                std::ostringstream os;
+
+                os << "Report Step " << steps[s]
+                   << " Not Available in Restart Result Set";
+
+                throw std::invalid_argument(os.str());
+            }
+
+            for (auto ngrid = grids.size(), g = 0*ngrid; g < ngrid; ++g) {
+                const auto& gridName = grids[g];
+
+                if (! haveRateData(restart, gridName)) {
+                    continue;
+                }
+
+                INTEHEAD ih(restart.keywordData<int>(INTEHEAD_KW, gridName));
+                if (ih.nwell == 0) {
+                    continue;
+                }
+
+                // Wells keep their position once defined, so names need
+                // only be decoded when new wells appear.
+                auto& id = wellID[g];
+                if (id.size() < static_cast<std::size_t>(ih.nwell)) {
+                    if (! restart.haveKeywordData(ZWEL_KW, gridName)) {
+                        continue;
+                    }
+
+                    const auto zwel =
+                        restart.keywordData<std::string>(ZWEL_KW, gridName);
+
+                    for (auto w = id.size(); w < std::size_t(ih.nwell); ++w) {
+                        const auto name = trimSpacesRight(zwel[w * ih.nzwel]);
+
+                        id.push_back(intern(name, wellIndex, hist.wellNames));
+                    }
+                }
+
+                const double qr_unit = resRateUnit(ih.unit);
+
+                const auto iwel = restart.keywordData<int>   (IWEL_KW, gridName);
+                const auto xwel = restart.keywordData<double>("XWEL" , gridName);
+                const auto icon = restart.keywordData<int>   (ICON_KW, gridName);
+                const auto xcon = restart.keywordData<double>("XCON" , gridName);
+
+                for (int well = 0; well < ih.nwell; ++well) {
+                    const bool is_producer =
+                        iwel[well * ih.niwel + IWEL_TYPE_INDEX] == IWEL_TYPE_PRODUCER;
+
+                    if (! is_producer) {
+                        stepInjectors[s].push_back(id[well]);
+                    }
+
+                    // Same selection criteria as readWellData().
+                    const double well_reservoir_inflow_rate =
+                        -unit::convert::from(xwel[well * ih.nxwel + XWEL_RESV_INDEX], qr_unit);
+                    if (std::fabs(well_reservoir_inflow_rate) < rate_threshold_) {
+                        continue;
+                    }
+
+                    const int ncon = iwel[well * ih.niwel + IWEL_CONNECTIONS_INDEX];
+                    for (int comp_index = 0; comp_index < ncon; ++comp_index) {
+                        const int icon_offset = (well*ih.ncwma + comp_index) * ih.nicon;
+                        const int xcon_offset = (well*ih.ncwma + comp_index) * ih.nxcon;
+
+                        // Note: subtracting 1 from indices (Fortran -> C convention).
+                        const auto key = CompletionID {
+                            g, id[well],
+                            icon[icon_offset + ICON_I_INDEX] - 1,
+                            icon[icon_offset + ICON_J_INDEX] - 1,
+                            icon[icon_offset + ICON_K_INDEX] - 1
+                        };
+
+                        auto c = compIndex.find(key);
+                        if (c == compIndex.end()) {
+                            c = compIndex.emplace(key, hist.completions.size()).first;
+
+                            RateHistory::Completion comp;
+                            comp.well = id[well];
+                            comp.grid = g;
+                            comp.ijk  = { { std::get<2>(key),
+                                            std::get<3>(key),
+                                            std::get<4>(key) } };
+
+                            hist.completions.push_back(comp);
+                        }
+
+                        // Note: taking the negative input, to get inflow rate.
+                        const double rate = -unit::convert::from(xcon[xcon_offset + XCON_QR_INDEX], qr_unit);
+
+                        if (disallow_crossflow_ && ((rate < 0.0) != is_producer)) {
+                            continue;
+                        }
+
+                        stepRates[s].emplace_back(c->second, rate);
+                    }
+                }
+            }
+        }
+
+        // Expand to dense step-by-completion and step-by-well matrices.
+        const auto ncomp = hist.completions.size();
+        const auto nwell = hist.wellNames.size();
+
+        hist.rates.assign(steps.size() * ncomp, 0.0);
+        hist.isInjector.assign(steps.size() * nwell, 0);
+
+        for (auto nstep = steps.size(), s = 0*nstep; s < nstep; ++s) {
+            for (const auto& r : stepRates[s]) {
+                hist.rates[s*ncomp + r.first] = r.second;
+            }
+
+            for (const auto& w : stepInjectors[s]) {
+                hist.isInjector[s*nwell + w] = 1;
+            }
+        }
+
+        return hist;
+    }
+
+
+
+
 } // namespace Opm
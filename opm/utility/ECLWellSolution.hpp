@@ -21,7 +21,10 @@
 #ifndef OPM_ECLWELLSOLUTION_HEADER_INCLUDED
 #define OPM_ECLWELLSOLUTION_HEADER_INCLUDED
 
+#include <opm/utility/ECLCancellation.hpp>
+
 #include <array>
+#include <cstddef>
 #include <string>
 #include <utility>
 #include <vector>
@@ -61,6 +64,82 @@ namespace Opm
         std::vector<WellData> solution(const ECLRestartData& restart,
                                        const std::vector<std::string>& grids) const;
 
+        /// Well topology and completion-level reservoir rates for a
+        /// sequence of report steps.
+        ///
+        /// Well and grid names are stored once and referred to by index.
+        /// Each completion is identified by its well, grid and Cartesian
+        /// location and occupies a single column of the rate matrix,
+        /// whether or not it is open at a particular report step.
+        struct RateHistory
+        {
+            struct Completion
+            {
+                std::size_t well;       // Index into wellNames.
+                std::size_t grid;       // Index into gridNames.
+                std::array<int, 3> ijk; // Cartesian location in grid.
+            };
+
+            /// Report steps, in order of extraction.
+            std::vector<int> steps;
+
+            /// Grid names.  Empty string for main grid.
+            std::vector<std::string> gridNames;
+
+            /// Interned well names, in order of first appearance.
+            std::vector<std::string> wellNames;
+
+            /// Completion topology, in order of first appearance.
+            std::vector<Completion> completions;
+
+            /// Whether or not a well is an injector at a particular step.
+            /// Row major, steps.size() rows by wellNames.size() columns.
+            std::vector<char> isInjector;
+
+            /// Total reservoir inflow rates in SI units (m^3/s).  Row
+            /// major, steps.size() rows by completions.size() columns.
+            /// Zero for completions that are shut, cross-flowing (if
+            /// disallowed) or that belong to wells below the rate
+            /// threshold at that step.
+            std::vector<double> rates;
+
+            /// Reservoir inflow rate of single completion at single step.
+            ///
+            /// \param[in] stepIx Index into \c steps.
+            /// \param[in] compIx Index into \c completions.
+            double rate(const std::size_t stepIx,
+                        const std::size_t compIx) const
+            {
+                return this->rates[stepIx*this->completions.size() + compIx];
+            }
+        };
+
+        /// Extract well solutions of multiple report steps in one pass.
+        ///
+        /// Selects each report step exactly once, in the order given, and
+        /// decodes only the INTEHEAD, IWEL, XWEL, ICON and XCON keywords.
+        /// Well names (ZWEL) are decoded only when a grid reports wells
+        /// that have not been seen before, relying on wells keeping their
+        /// restart file position once defined.
+        ///
+        /// Will throw if any of the requested steps is not available in
+        /// the result set.
+        ///
+        /// \param[in] restart Restart result set.  Its currently
+        ///    selected report step is changed by this function.
+        ///
+        /// \param[in] steps Report steps for which to extract rates.
+        ///
+        /// \param[in] grids Grids for which to extract rates.
+        ///
+        /// \param[in] token Cancellation token.  Checked once per report
+        ///    step.  Throws ECLOperationCancelled once cancelled.
+        RateHistory history(const ECLRestartData& restart,
+                            const std::vector<int>& steps,
+                            const std::vector<std::string>& grids,
+                            const ECLCancellationToken& token =
+                                ECLCancellationToken{}) const;
+
     private:
         // Data members.
         double rate_threshold_;
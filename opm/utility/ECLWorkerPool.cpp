@@ -0,0 +1,313 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <opm/utility/ECLWorkerPool.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/// \file
+///
+/// Implementation of pool of forked worker processes.
+
+namespace {
+    void throwSystemError(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    /// Write entire buffer to file descriptor.  Child side.
+    void writeAll(const int fd, const std::string& buffer)
+    {
+        const auto* p = buffer.data();
+        auto        n = buffer.size();
+
+        while (n > 0) {
+            const auto k = ::write(fd, p, n);
+
+            if (k < 0) {
+                if (errno == EINTR) { continue; }
+
+                return;
+            }
+
+            p += k;
+            n -= static_cast<std::size_t>(k);
+        }
+    }
+
+    /// Run task and terminate worker process.  Never returns.
+    [[noreturn]] void
+    runWorker(const int fd, const Opm::ECLWorkerPool::Task& task)
+    {
+        auto status = 0;
+        auto output = std::string{};
+
+        try {
+            output = task();
+        }
+        catch (const std::exception& e) {
+            status = 1;
+            output = e.what();
+        }
+        catch (...) {
+            status = 1;
+            output = "Unknown Exception in Worker Task";
+        }
+
+        writeAll(fd, output);
+        ::close(fd);
+
+        // Bypass atexit() handlers and static destructors that belong to
+        // the parent process.
+        std::fflush(nullptr);
+        ::_exit(status);
+    }
+
+    int exitStatus(const int wstatus)
+    {
+        if (WIFEXITED(wstatus)) {
+            return WEXITSTATUS(wstatus);
+        }
+
+        if (WIFSIGNALED(wstatus)) {
+            return -WTERMSIG(wstatus);
+        }
+
+        return -1;
+    }
+} // Anonymous namespace
+
+// =====================================================================
+// Class ECLWorkerPool::Impl
+// ---------------------------------------------------------------------
+
+class Opm::ECLWorkerPool::Impl
+{
+public:
+    explicit Impl(const std::size_t maxWorkers);
+
+    std::size_t submit(Task task);
+
+    std::vector<Result> wait();
+
+    std::size_t running() const
+    {
+        return this->workers_.size();
+    }
+
+private:
+    /// Running worker process.
+    struct Worker {
+        /// Process ID.
+        pid_t pid;
+
+        /// Read end of result pipe.
+        int fd;
+
+        /// Position in results_.
+        std::size_t ticket;
+
+        /// Output received so far.
+        std::string output;
+    };
+
+    /// Maximum number of concurrently running workers.
+    std::size_t maxWorkers_;
+
+    /// Currently running workers.
+    std::vector<Worker> workers_;
+
+    /// Results of tasks submitted since previous call to wait().
+    std::vector<Result> results_;
+
+    /// Receive pending output from running workers and reap those that
+    /// have finished.  Blocks until at least one worker makes progress.
+    void pump();
+
+    /// Collect exit status of worker whose result pipe is closed.
+    void reap(const std::size_t w);
+};
+
+Opm::ECLWorkerPool::Impl::Impl(const std::size_t maxWorkers)
+    : maxWorkers_(maxWorkers)
+{
+    if (maxWorkers == 0) {
+        throw std::invalid_argument {
+            "Worker Pool Must Admit At Least One Worker"
+        };
+    }
+}
+
+std::size_t
+Opm::ECLWorkerPool::Impl::submit(Task task)
+{
+    while (this->workers_.size() >= this->maxWorkers_) {
+        this->pump();
+    }
+
+    int fd[2];
+    if (::pipe(fd) != 0) {
+        throwSystemError("Failed to Create Worker Result Pipe");
+    }
+
+    // Don't duplicate buffered output in the child.
+    std::fflush(nullptr);
+
+    const auto pid = ::fork();
+
+    if (pid < 0) {
+        const auto err = errno;
+        ::close(fd[0]);  ::close(fd[1]);
+
+        errno = err;
+        throwSystemError("Failed to Fork Worker Process");
+    }
+
+    if (pid == 0) {
+        // Child.  Release pipes of sibling workers.
+        ::close(fd[0]);
+
+        for (const auto& w : this->workers_) {
+            ::close(w.fd);
+        }
+
+        runWorker(fd[1], task);
+    }
+
+    ::close(fd[1]);
+
+    const auto ticket = this->results_.size();
+
+    this->results_.push_back(Result{ 0, std::string{} });
+    this->workers_.push_back(Worker{ pid, fd[0], ticket, std::string{} });
+
+    return ticket;
+}
+
+std::vector<Opm::ECLWorkerPool::Result>
+Opm::ECLWorkerPool::Impl::wait()
+{
+    while (! this->workers_.empty()) {
+        this->pump();
+    }
+
+    auto results = std::vector<Result>{};
+    results.swap(this->results_);
+
+    return results;
+}
+
+void Opm::ECLWorkerPool::Impl::pump()
+{
+    auto pfd = std::vector<pollfd>{};
+    pfd.reserve(this->workers_.size());
+
+    for (const auto& w : this->workers_) {
+        pfd.push_back(pollfd{ w.fd, POLLIN, 0 });
+    }
+
+    if (::poll(pfd.data(), pfd.size(), -1) < 0) {
+        if (errno == EINTR) { return; }
+
+        throwSystemError("Failed to Poll Worker Result Pipes");
+    }
+
+    // Traverse backwards so that reaping does not disturb the indices of
+    // workers not yet visited.
+    for (auto w = pfd.size(); w-- > 0; ) {
+        if (pfd[w].revents == 0) { continue; }
+
+        char buffer[4096];
+        const auto k = ::read(pfd[w].fd, buffer, sizeof buffer);
+
+        if (k > 0) {
+            this->workers_[w].output.append(buffer, k);
+        }
+        else if ((k == 0) || (errno != EINTR)) {
+            this->reap(w);
+        }
+    }
+}
+
+void Opm::ECLWorkerPool::Impl::reap(const std::size_t w)
+{
+    auto& worker = this->workers_[w];
+
+    ::close(worker.fd);
+
+    auto wstatus = 0;
+    while ((::waitpid(worker.pid, &wstatus, 0) < 0) && (errno == EINTR)) {
+    }
+
+    auto& result  = this->results_[worker.ticket];
+    result.status = exitStatus(wstatus);
+    result.output = std::move(worker.output);
+
+    this->workers_.erase(this->workers_.begin() + w);
+}
+
+// =====================================================================
+// Class ECLWorkerPool
+// ---------------------------------------------------------------------
+
+Opm::ECLWorkerPool::ECLWorkerPool(const std::size_t maxWorkers)
+    : pImpl_(new Impl(maxWorkers))
+{}
+
+Opm::ECLWorkerPool::~ECLWorkerPool()
+{
+    try {
+        this->pImpl_->wait();
+    }
+    catch (...) {
+        // Nothing sensible to do in a destructor.
+    }
+}
+
+std::size_t Opm::ECLWorkerPool::submit(Task task)
+{
+    return this->pImpl_->submit(std::move(task));
+}
+
+std::vector<Opm::ECLWorkerPool::Result>
+Opm::ECLWorkerPool::wait()
+{
+    return this->pImpl_->wait();
+}
+
+std::size_t Opm::ECLWorkerPool::running() const
+{
+    return this->pImpl_->running();
+}
@@ -0,0 +1,113 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ECLWORKERPOOL_HEADER_INCLUDED
+#define OPM_ECLWORKERPOOL_HEADER_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// \file
+///
+/// Zygote-style pool of forked worker processes.
+///
+/// The calling process loads the static model (ECLGraph,
+/// ECLSaturationFunc, PVT interpolants, region mappings &c) once and then
+/// submits tasks--typically one report step or one query each.  Each task
+/// runs in a freshly forked child process that shares the parent's memory
+/// copy-on-write, so the per-task startup cost is that of fork().
+///
+/// Library loops in worker processes run through an ECLSerialExecutor (see
+/// ECLExecutor.hpp) since the parent's worker threads do not exist in the
+/// child.  Other threads of the parent process must not hold locks that
+/// tasks need.
+
+namespace Opm {
+
+    /// Pool of forked worker processes.
+    class ECLWorkerPool
+    {
+    public:
+        /// Unit of work.  Runs in the child process.  The return value is
+        /// transmitted back to the parent process.  Exceptions escaping the
+        /// task make the worker fail and their message is transmitted
+        /// instead.
+        using Task = std::function<std::string()>;
+
+        /// Outcome of single task.
+        struct Result {
+            /// Exit status of worker process.  Zero if task completed
+            /// normally, one if task threw an exception, other positive
+            /// values if the task exited the process explicitly, and the
+            /// negative signal number if the worker was killed by a signal.
+            int status;
+
+            /// Task's return value, or the exception message if the task
+            /// failed.
+            std::string output;
+        };
+
+        /// Constructor.
+        ///
+        /// \param[in] maxWorkers Maximum number of concurrently running
+        ///    worker processes.  Must be positive.
+        explicit ECLWorkerPool(const std::size_t maxWorkers);
+
+        /// Destructor.  Waits for all outstanding workers.
+        ~ECLWorkerPool();
+
+        /// Disabled copy constructor.
+        ECLWorkerPool(const ECLWorkerPool&) = delete;
+
+        /// Disabled assignment operator.
+        ECLWorkerPool& operator=(const ECLWorkerPool&) = delete;
+
+        /// Run task in new worker process.
+        ///
+        /// Blocks while \c maxWorkers workers are running.
+        ///
+        /// \param[in] task Unit of work.
+        ///
+        /// \return Position of task's result in the return value of the
+        ///    next call to wait().
+        std::size_t submit(Task task);
+
+        /// Wait for all outstanding workers.
+        ///
+        /// \return Results of all tasks submitted since the previous call
+        ///    to wait(), in submission order.
+        std::vector<Result> wait();
+
+        /// Retrieve number of currently running workers.
+        std::size_t running() const;
+
+    private:
+        /// Implementation class.
+        class Impl;
+
+        /// Pointer to implementation.
+        std::unique_ptr<Impl> pImpl_;
+    };
+
+} // namespace Opm
+
+#endif // OPM_ECLWORKERPOOL_HEADER_INCLUDED
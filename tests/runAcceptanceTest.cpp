@@ -300,12 +300,11 @@ namespace {
         return tof;
     }
 
-    void computeErrors(const PoreVolume&                       pv,
-                       const std::vector<double>&              ref,
-                       const ::Opm::FlowDiagnostics::Solution& fd,
-                       AggregateErrors&                        E)
+    void computeErrors(const PoreVolume&          pv,
+                       const std::vector<double>& ref,
+                       const std::vector<double>& tof,
+                       AggregateErrors&           E)
     {
-        const auto tof  = fd.timeOfFlight();
         const auto diff = VectorDifference(tof, ref); //  tof - ref
 
         using Vector1  = std::decay<decltype(diff)>::type;
@@ -330,13 +329,34 @@ namespace {
         E.relative.push_back(std::move(rel));
     }
 
+    /// Whether or not to compute time-of-flight using ECLParallelTOF
+    /// rather than the Toolbox.  Parameter 'solver' ("toolbox" or
+    /// "parallel").
+    bool useParallelSolver(const ::Opm::ParameterGroup& param)
+    {
+        const auto solver =
+            param.getDefault<std::string>("solver", "toolbox");
+
+        if ((solver != "toolbox") && (solver != "parallel")) {
+            throw std::invalid_argument {
+                "Unsupported Time-of-Flight Solver '" + solver + '\''
+            };
+        }
+
+        return solver == "parallel";
+    }
+
     std::array<AggregateErrors, 2>
     sampleDifferences(example::Setup&&        setup,
                       const std::vector<int>& steps)
     {
+        using Direction = ::Opm::ECLParallelTOF::Direction;
+
         const auto start =
             std::vector<Opm::FlowDiagnostics::CellSet>{};
 
+        const auto parallel = useParallelSolver(setup.param);
+
         const auto nDigits = numDigits(steps);
 
         const auto pv = PoreVolume{ setup.graph.poreVolume() };
@@ -355,18 +375,32 @@ namespace {
 
             const auto ref = loadReference(setup.param, step, nDigits);
 
+            if (parallel) {
+                const auto tof = example::initParallelTOF(setup);
+
+                computeErrors(pv, ref.forward,
+                              tof.solve(Direction::Forward).timeOfFlight,
+                              E[0]);
+
+                computeErrors(pv, ref.reverse,
+                              tof.solve(Direction::Reverse).timeOfFlight,
+                              E[1]);
+
+                continue;
+            }
+
             {
                 const auto fwd = setup.toolbox
                     .computeInjectionDiagnostics(start);
 
-                computeErrors(pv, ref.forward, fwd.fd, E[0]);
+                computeErrors(pv, ref.forward, fwd.fd.timeOfFlight(), E[0]);
             }
 
             {
                 const auto rev = setup.toolbox
                     .computeProductionDiagnostics(start);
 
-                computeErrors(pv, ref.reverse, rev.fd, E[1]);
+                computeErrors(pv, ref.reverse, rev.fd.timeOfFlight(), E[1]);
             }
         }
 
@@ -0,0 +1,268 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <examples/exampleSetup.hpp>
+
+#include <opm/utility/ECLCaseUtilities.hpp>
+#include <opm/utility/ECLExecutor.hpp>
+#include <opm/utility/ECLFluxCalc.hpp>
+#include <opm/utility/ECLGraph.hpp>
+#include <opm/utility/ECLMemoryBudget.hpp>
+#include <opm/utility/ECLPhaseIndex.hpp>
+#include <opm/utility/ECLResultData.hpp>
+#include <opm/utility/ECLSaturationFunc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Syntax (typical):
+//   runEquivalenceTest case=<ecl_case_prefix> [max-ulps=4]
+//
+// Runs the optimised, field-wide kernels of a full model--including local
+// grid refinements--side by side with their reference code paths on every
+// report step and compares the results:
+//
+//   - Phase fluxes (ECLFluxCalc) computed by the built-in thread pool
+//     versus a serial executor.  Must match bit for bit.
+//
+//   - Phase fluxes with and without the decoded restart array cache.
+//     Must match bit for bit.
+//
+//   - Relative permeabilities from warm-started interval hints versus
+//     plain table search.  Must match bit for bit.
+//
+//   - Relative permeabilities from the fused kr/Pc evaluation versus
+//     separate evaluation.  May differ by at most 'max-ulps' units in the
+//     last place relative to the largest value.
+
+namespace {
+    std::int64_t orderedBits(const double x)
+    {
+        auto i = std::int64_t{0};
+        std::memcpy(&i, &x, sizeof i);
+
+        return (i < 0) ? std::numeric_limits<std::int64_t>::min() - i : i;
+    }
+
+    /// Maximum distance, in ULPs of the largest magnitude, between two
+    /// result vectors.  Infinite if the vectors' sizes differ.
+    double maxUlpDistance(const std::vector<double>& ref,
+                          const std::vector<double>& opt)
+    {
+        if (ref.size() != opt.size()) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        auto scale   = std::numeric_limits<double>::min();
+        auto maxDiff = 0.0;
+        auto bitwise = true;
+
+        for (auto n = ref.size(), i = 0*n; i < n; ++i) {
+            scale   = std::max(scale, std::abs(ref[i]));
+            maxDiff = std::max(maxDiff, std::abs(ref[i] - opt[i]));
+            bitwise = bitwise && (orderedBits(ref[i]) == orderedBits(opt[i]));
+        }
+
+        if (bitwise) {
+            return 0.0;
+        }
+
+        // Differing values of equal magnitude (e.g., signed zeros) count
+        // as a single ULP.
+        const auto ulp = scale * std::numeric_limits<double>::epsilon();
+
+        return std::max(maxDiff / ulp, 1.0);
+    }
+
+    class Comparison
+    {
+    public:
+        explicit Comparison(const double maxUlps)
+            : maxUlps_(maxUlps)
+        {}
+
+        void bitwise(const std::string&         what,
+                     const int                  step,
+                     const std::vector<double>& ref,
+                     const std::vector<double>& opt)
+        {
+            this->check(what, step, maxUlpDistance(ref, opt), 0.0);
+        }
+
+        void ulpBounded(const std::string&         what,
+                        const int                  step,
+                        const std::vector<double>& ref,
+                        const std::vector<double>& opt)
+        {
+            this->check(what, step, maxUlpDistance(ref, opt),
+                        this->maxUlps_);
+        }
+
+        bool ok() const
+        {
+            return this->ok_;
+        }
+
+    private:
+        double maxUlps_;
+        bool   ok_{true};
+
+        void check(const std::string& what,
+                   const int          step,
+                   const double       ulps,
+                   const double       tol)
+        {
+            if (ulps > tol) {
+                std::cerr << "Step " << step << ": " << what
+                          << " deviates by " << ulps
+                          << " ULPs (limit " << tol << ")\n";
+
+                this->ok_ = false;
+            }
+        }
+    };
+
+    /// Run all library loops in the calling thread while in scope.
+    class SerialExecution
+    {
+    public:
+        SerialExecution()
+        {
+            Opm::ECLExecution::setDefaultExecutor
+                (std::make_shared<Opm::ECLSerialExecutor>());
+        }
+
+        ~SerialExecution()
+        {
+            Opm::ECLExecution::setDefaultExecutor(nullptr);
+        }
+    };
+
+    std::string phaseName(const Opm::ECLPhaseIndex p)
+    {
+        switch (p) {
+        case Opm::ECLPhaseIndex::Aqua:   return "water";
+        case Opm::ECLPhaseIndex::Liquid: return "oil";
+        case Opm::ECLPhaseIndex::Vapour: return "gas";
+        }
+
+        return "unknown";
+    }
+} // namespace Anonymous
+
+int main(int argc, char* argv[])
+try {
+    const auto prm  = example::initParam(argc, argv);
+    const auto rset = example::identifyResultSet(prm);
+
+    const auto init  = Opm::ECLInitFileData(rset.initFile());
+    const auto graph = Opm::ECLGraph::load(rset.gridFile(), init);
+
+    const auto grav   = prm.getDefault("grav", 9.80665);
+    const auto useEPS = prm.getDefault("use_ep_scaling", true);
+
+    const auto calc  = Opm::ECLFluxCalc(graph, init, grav, useEPS);
+    const auto sfunc = Opm::ECLSaturationFunc(graph, init, useEPS);
+
+    auto hinted = sfunc;
+    hinted.useIntervalHints(true);
+
+    auto cmp = Comparison{ prm.getDefault("max-ulps", 4.0) };
+
+    const auto phases = {
+        Opm::ECLPhaseIndex::Aqua,
+        Opm::ECLPhaseIndex::Liquid,
+        Opm::ECLPhaseIndex::Vapour,
+    };
+
+    auto& budget = Opm::ECLMemoryBudget::instance();
+
+    for (const auto& step : rset.reportStepIDs()) {
+        const auto rstrt = Opm::ECLRestartData(rset.restartFile(step));
+
+        if (! rstrt.selectReportStep(step)) {
+            continue;
+        }
+
+        for (const auto& p : phases) {
+            const auto name = phaseName(p);
+
+            auto refFlux = std::vector<double>{};
+            auto refKr   = std::vector<double>{};
+            {
+                const SerialExecution serial{};
+
+                refFlux = calc.flux(rstrt, p);
+                refKr   = sfunc.relperm(graph, rstrt, p);
+            }
+
+            cmp.bitwise(name + " flux (parallel)", step,
+                        refFlux, calc.flux(rstrt, p));
+
+            cmp.bitwise(name + " kr (parallel)", step,
+                        refKr, sfunc.relperm(graph, rstrt, p));
+
+            cmp.bitwise(name + " kr (interval hints)", step,
+                        refKr, hinted.relperm(graph, rstrt, p));
+
+            cmp.ulpBounded(name + " kr (fused kr/pc)", step, refKr,
+                           sfunc.relpermAndCapPress(graph, rstrt, p)
+                           .relperm);
+
+            {
+                budget.setLimit(std::size_t(1) << 30);
+
+                // First call populates cache.  Second reads from it.
+                const auto cold = calc.flux(rstrt, p);
+                const auto warm = calc.flux(rstrt, p);
+
+                budget.setLimit(0);
+
+                cmp.bitwise(name + " flux (array cache, cold)", step,
+                            refFlux, cold);
+                cmp.bitwise(name + " flux (array cache, warm)", step,
+                            refFlux, warm);
+            }
+        }
+    }
+
+    std::cout << (cmp.ok() ? "OK" : "FAIL") << '\n';
+
+    if (! cmp.ok()) {
+        return EXIT_FAILURE;
+    }
+}
+catch (const std::exception& e) {
+    std::cerr << "Caught Exception: " << e.what() << '\n';
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,263 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <examples/exampleSetup.hpp>
+
+#include <opm/utility/ECLCaseUtilities.hpp>
+#include <opm/utility/ECLGraph.hpp>
+#include <opm/utility/ECLResultData.hpp>
+#include <opm/utility/ECLWellSolution.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+// Syntax (typical):
+//   runTopologyTest case=<ecl_case_prefix>
+//
+// Structural consistency checks on a full model--including local grid
+// refinements:
+//
+//   - Well rate history (ECLWellSolution::history()) versus per-step well
+//     solutions (ECLWellSolution::solution()).  Every completion of every
+//     report step must appear in the history's topology table with the
+//     same well name, grid name and Cartesian location, and with the same
+//     reservoir rate.
+//
+//   - Active cell locations.  ECLGraph::activeCell() must invert both
+//     overloads of ECLGraph::cellLocation() for every active cell of every
+//     grid, and out-of-range cells must map to location (-1, -1, -1, -1).
+
+namespace {
+    class Checker
+    {
+    public:
+        void fail(const std::string& what)
+        {
+            std::cerr << what << '\n';
+
+            this->ok_ = false;
+        }
+
+        bool ok() const
+        {
+            return this->ok_;
+        }
+
+    private:
+        bool ok_{true};
+    };
+
+    /// Position of completion in history's topology table.  Number of
+    /// completions if not found.
+    std::size_t
+    findCompletion(const Opm::ECLWellSolution::RateHistory&          hist,
+                   const std::string&                                well,
+                   const Opm::ECLWellSolution::WellData::Completion& comp)
+    {
+        const auto n = hist.completions.size();
+
+        for (auto k = 0*n; k < n; ++k) {
+            const auto& c = hist.completions[k];
+
+            if ((hist.wellNames[c.well] == well) &&
+                (hist.gridNames[c.grid] == comp.gridName) &&
+                (c.ijk == comp.ijk))
+            {
+                return k;
+            }
+        }
+
+        return n;
+    }
+
+    void checkCellLocation(const Opm::ECLGraph& graph,
+                           Checker&             chk)
+    {
+        const auto& grids = graph.activeGrids();
+        const auto  nc    = static_cast<int>(graph.numCells());
+
+        auto cells = std::vector<int>(nc);
+        std::iota(cells.begin(), cells.end(), 0);
+
+        const auto locs = graph.cellLocation(cells);
+
+        if (locs.size() != cells.size()) {
+            std::ostringstream os;
+            os << "Sequence cellLocation() returns " << locs.size()
+               << " locations (expected " << cells.size() << ')';
+
+            chk.fail(os.str());
+            return;
+        }
+
+        for (auto cell = 0; cell < nc; ++cell) {
+            const auto loc = graph.cellLocation(cell);
+
+            std::ostringstream os;
+            os << "Active cell " << cell << " at ("
+               << loc.ijk[0] << ", " << loc.ijk[1] << ", "
+               << loc.ijk[2] << ") of grid " << loc.gridID << ' ';
+
+            if ((loc.gridID != locs[cell].gridID) ||
+                (loc.ijk    != locs[cell].ijk))
+            {
+                chk.fail(os.str() + "differs from sequence cellLocation()");
+            }
+
+            if ((loc.gridID < 0) ||
+                (loc.gridID >= static_cast<int>(grids.size())))
+            {
+                chk.fail(os.str() + "has invalid grid ID");
+                continue;
+            }
+
+            const auto act = graph.activeCell(loc.ijk, grids[loc.gridID]);
+
+            if (act != cell) {
+                os << "maps back to active cell " << act;
+
+                chk.fail(os.str());
+            }
+        }
+
+        for (const auto cell : { -1, nc }) {
+            const auto loc = graph.cellLocation(cell);
+
+            if ((loc.gridID != -1) ||
+                (loc.ijk != std::array<int,3>{{ -1, -1, -1 }}))
+            {
+                std::ostringstream os;
+                os << "Out-of-range cell " << cell
+                   << " has valid location in grid " << loc.gridID;
+
+                chk.fail(os.str());
+            }
+        }
+    }
+
+    void checkWellHistory(const Opm::ECLCaseUtilities::ResultSet& rset,
+                          const Opm::ECLGraph&                    graph,
+                          Checker&                                chk)
+    {
+        const auto wsol  = Opm::ECLWellSolution{};
+        const auto grids = graph.activeGrids();
+
+        // One history per restart file.
+        auto files = std::map<boost::filesystem::path, std::vector<int>>{};
+        for (const auto& step : rset.reportStepIDs()) {
+            files[rset.restartFile(step)].push_back(step);
+        }
+
+        for (const auto& file : files) {
+            const auto& steps = file.second;
+            const auto  rstrt = Opm::ECLRestartData(file.first);
+
+            const auto hist = wsol.history(rstrt, steps, grids);
+
+            for (auto nstep = steps.size(), s = 0*nstep; s < nstep; ++s) {
+                rstrt.selectReportStep(steps[s]);
+
+                auto nonZero = std::size_t{0};
+                for (const auto& well : wsol.solution(rstrt, grids)) {
+                    for (const auto& comp : well.completions) {
+                        const auto k = findCompletion(hist, well.name, comp);
+
+                        std::ostringstream os;
+                        os << "Step " << steps[s] << ": Completion ("
+                           << comp.ijk[0] << ", " << comp.ijk[1] << ", "
+                           << comp.ijk[2] << ") of well " << well.name
+                           << " in grid '" << comp.gridName << "' ";
+
+                        if (k == hist.completions.size()) {
+                            chk.fail(os.str() + "missing from history");
+                            continue;
+                        }
+
+                        const auto q   = comp.reservoir_inflow_rate;
+                        const auto tol = 1.0e-12 * std::abs(q);
+
+                        if (std::abs(hist.rate(s, k) - q) > tol) {
+                            os << "has history rate " << hist.rate(s, k)
+                               << " (expected " << q << ')';
+
+                            chk.fail(os.str());
+                        }
+
+                        nonZero += (q != 0.0);
+                    }
+                }
+
+                auto histNonZero = std::size_t{0};
+                for (auto n = hist.completions.size(), k = 0*n; k < n; ++k) {
+                    histNonZero += (hist.rate(s, k) != 0.0);
+                }
+
+                if (histNonZero != nonZero) {
+                    std::ostringstream os;
+                    os << "Step " << steps[s] << ": History has "
+                       << histNonZero << " flowing completions (expected "
+                       << nonZero << ')';
+
+                    chk.fail(os.str());
+                }
+            }
+        }
+    }
+} // namespace Anonymous
+
+int main(int argc, char* argv[])
+try {
+    const auto prm  = example::initParam(argc, argv);
+    const auto rset = example::identifyResultSet(prm);
+
+    const auto init  = Opm::ECLInitFileData(rset.initFile());
+    const auto graph = Opm::ECLGraph::load(rset.gridFile(), init);
+
+    auto chk = Checker{};
+
+    checkCellLocation(graph, chk);
+    checkWellHistory(rset, graph, chk);
+
+    std::cout << (chk.ok() ? "OK" : "FAIL") << '\n';
+
+    if (! chk.ok()) {
+        return EXIT_FAILURE;
+    }
+}
+catch (const std::exception& e) {
+    std::cerr << "Caught Exception: " << e.what() << '\n';
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,228 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_EXECUTOR
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLCancellation.hpp>
+#include <opm/utility/ECLExecutor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // Fill x[i] = i through executor and verify every index visited once.
+    void checkCoverage(Opm::ECLExecutor& exec,
+                       const std::size_t n,
+                       const std::size_t grain)
+    {
+        auto x = std::vector<int>(n, -1);
+        std::atomic<std::size_t> calls{0};
+
+        exec.parallelFor(n, grain,
+            [&x, &calls](const std::size_t begin, const std::size_t end)
+        {
+            ++calls;
+
+            for (auto i = begin; i < end; ++i) {
+                x[i] += static_cast<int>(i) + 1;
+            }
+        });
+
+        for (auto i = 0*n; i < n; ++i) {
+            BOOST_CHECK_EQUAL(x[i], static_cast<int>(i));
+        }
+
+        BOOST_CHECK(calls.load() <= (n + grain - 1) / grain);
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (Executor)
+
+BOOST_AUTO_TEST_CASE (Serial)
+{
+    Opm::ECLSerialExecutor exec;
+
+    BOOST_CHECK_EQUAL(exec.concurrency(), std::size_t{1});
+
+    checkCoverage(exec, 1000, 7);
+    checkCoverage(exec, 0, 7);
+}
+
+BOOST_AUTO_TEST_CASE (WorkStealing)
+{
+    Opm::ECLWorkStealingExecutor exec{ 4 };
+
+    BOOST_CHECK_EQUAL(exec.concurrency(), std::size_t{4});
+
+    checkCoverage(exec, 100000, 100);
+    checkCoverage(exec, 5, 1);
+    checkCoverage(exec, 1, 10);
+    checkCoverage(exec, 0, 10);
+}
+
+BOOST_AUTO_TEST_CASE (Nested)
+{
+    Opm::ECLWorkStealingExecutor exec{ 3 };
+
+    std::atomic<long> sum{0};
+
+    exec.parallelFor(16, 1,
+        [&exec, &sum](const std::size_t begin, const std::size_t end)
+    {
+        for (auto i = begin; i < end; ++i) {
+            exec.parallelFor(100, 10,
+                [&sum](const std::size_t b, const std::size_t e)
+            {
+                sum += static_cast<long>(e - b);
+            });
+        }
+    });
+
+    BOOST_CHECK_EQUAL(sum.load(), 1600L);
+}
+
+BOOST_AUTO_TEST_CASE (Exception)
+{
+    Opm::ECLWorkStealingExecutor exec{ 2 };
+
+    BOOST_CHECK_THROW(exec.parallelFor(100, 1,
+        [](const std::size_t begin, const std::size_t)
+    {
+        if (begin == 0) {
+            throw std::runtime_error("Failed");
+        }
+    }), std::runtime_error);
+
+    // Pool still usable.
+    checkCoverage(exec, 1000, 10);
+}
+
+BOOST_AUTO_TEST_CASE (DefaultExecutor)
+{
+    using Opm::ECLExecution::defaultExecutor;
+    using Opm::ECLExecution::setDefaultExecutor;
+
+    BOOST_CHECK(defaultExecutor() != nullptr);
+
+    auto serial = std::make_shared<Opm::ECLSerialExecutor>();
+    setDefaultExecutor(serial);
+
+    BOOST_CHECK(defaultExecutor() == serial);
+
+    auto n = std::size_t{0};
+    Opm::ECLExecution::parallelFor(50, 1,
+        [&n](const std::size_t begin, const std::size_t end)
+    {
+        n += end - begin;
+    });
+
+    BOOST_CHECK_EQUAL(n, std::size_t{50});
+
+    setDefaultExecutor(nullptr);
+
+    BOOST_CHECK(defaultExecutor() != serial);
+    BOOST_CHECK(defaultExecutor() != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE (Cancellation)
+{
+    using Token = Opm::ECLCancellationToken;
+
+    {
+        const auto never = Token{};
+
+        never.cancel();
+        BOOST_CHECK(! never.cancelled());
+        BOOST_CHECK_NO_THROW(never.throwIfCancelled());
+    }
+
+    {
+        const auto token = Token::cancellable();
+        const auto copy  = token;
+
+        BOOST_CHECK(! copy.cancelled());
+
+        token.cancel();
+
+        BOOST_CHECK(copy.cancelled());
+        BOOST_CHECK_THROW(copy.throwIfCancelled(),
+                          Opm::ECLOperationCancelled);
+    }
+
+    {
+        const auto expired = Token::withTimeout(std::chrono::seconds(-1));
+        const auto later   = Token::withTimeout(std::chrono::hours(1));
+
+        BOOST_CHECK(expired.cancelled());
+        BOOST_CHECK(! later.cancelled());
+    }
+}
+
+BOOST_AUTO_TEST_CASE (CancelledLoop)
+{
+    Opm::ECLExecution::setDefaultExecutor
+        (std::make_shared<Opm::ECLWorkStealingExecutor>(4));
+
+    const auto token = Opm::ECLCancellationToken::cancellable();
+
+    std::atomic<std::size_t> started{0};
+
+    // Cancel from within first subrange.  Subranges not yet started are
+    // skipped.
+    BOOST_CHECK_THROW(Opm::ECLExecution::parallelFor(1000, 1, token,
+        [&token, &started](const std::size_t, const std::size_t)
+    {
+        ++started;
+        token.cancel();
+    }), Opm::ECLOperationCancelled);
+
+    BOOST_CHECK(started.load() < std::size_t{1000});
+
+    // Already cancelled token runs nothing.
+    started = 0;
+    BOOST_CHECK_THROW(Opm::ECLExecution::parallelFor(10, 1, token,
+        [&started](const std::size_t, const std::size_t)
+    {
+        ++started;
+    }), Opm::ECLOperationCancelled);
+
+    BOOST_CHECK_EQUAL(started.load(), std::size_t{0});
+
+    Opm::ECLExecution::setDefaultExecutor(nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
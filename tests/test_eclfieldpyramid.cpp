@@ -0,0 +1,436 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_FIELD_PYRAMID
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLFieldPyramid.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    using Index3 = Opm::ECLFieldPyramid::Index3;
+
+    /// Field on fully active Cartesian grid, natural ordering.
+    struct CartesianField
+    {
+        Index3              dims;
+        std::vector<int>    cell;
+        std::vector<double> value;
+        std::vector<double> weight;
+    };
+
+    CartesianField linearField(const Index3& dims)
+    {
+        auto f = CartesianField{ dims, {}, {}, {} };
+
+        auto g = 0;
+        for (auto k = 0; k < dims[2]; ++k) {
+            for (auto j = 0; j < dims[1]; ++j) {
+                for (auto i = 0; i < dims[0]; ++i, ++g) {
+                    f.cell  .push_back(g);
+                    f.value .push_back(100.0 + i + 10.0*j + 0.5*k);
+                    f.weight.push_back(1.0 + 0.25*(g % 3));
+                }
+            }
+        }
+
+        return f;
+    }
+
+    /// Reassemble all tiles of single level.
+    std::vector<float>
+    levelValues(const Opm::ECLFieldPyramid& pyr, const int lvl)
+    {
+        const auto& L = pyr.level(lvl);
+
+        auto x = std::vector<float>(static_cast<std::size_t>
+            (L.dimensions[0] * L.dimensions[1] * L.dimensions[2]));
+
+        for (auto tk = 0; tk < L.numTiles[2]; ++tk) {
+            for (auto tj = 0; tj < L.numTiles[1]; ++tj) {
+                for (auto ti = 0; ti < L.numTiles[0]; ++ti) {
+                    const auto t = pyr.tile(lvl, Index3{ { ti, tj, tk } });
+
+                    auto v = t.values.begin();
+                    for (auto k = 0; k < t.size[2]; ++k) {
+                        for (auto j = 0; j < t.size[1]; ++j) {
+                            for (auto i = 0; i < t.size[0]; ++i, ++v) {
+                                const auto I = t.origin[0] + i;
+                                const auto J = t.origin[1] + j;
+                                const auto K = t.origin[2] + k;
+
+                                x[I + L.dimensions[0]*
+                                  (J + L.dimensions[1]*K)] = *v;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return x;
+    }
+
+    Opm::ECLFieldPyramid::Options tiles(const int ni, const int nj,
+                                        const int nk)
+    {
+        auto opt = Opm::ECLFieldPyramid::Options{};
+        opt.tileSize = Index3{ { ni, nj, nk } };
+
+        return opt;
+    }
+}
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Construction)
+
+BOOST_AUTO_TEST_CASE (LevelGeometry)
+{
+    const auto f = linearField(Index3{ { 5, 3, 2 } });
+
+    const auto pyr = Opm::ECLFieldPyramid {
+        f.dims, f.cell, f.value, f.weight, tiles(2, 2, 1)
+    };
+
+    BOOST_REQUIRE_EQUAL(pyr.numLevels(), 4);
+    BOOST_CHECK_EQUAL(pyr.finestLevel(), 0);
+
+    const auto expect = std::vector<Index3> {
+        Index3{ { 5, 3, 2 } },
+        Index3{ { 3, 2, 1 } },
+        Index3{ { 2, 1, 1 } },
+        Index3{ { 1, 1, 1 } },
+    };
+
+    for (auto lvl = 0; lvl < pyr.numLevels(); ++lvl) {
+        const auto& L = pyr.level(lvl);
+
+        BOOST_CHECK_EQUAL(L.blockSize, 1 << lvl);
+
+        for (auto d = 0; d < 3; ++d) {
+            BOOST_CHECK_EQUAL(L.dimensions[d], expect[lvl][d]);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(pyr.level(0).numTiles[0], 3);
+    BOOST_CHECK_EQUAL(pyr.level(0).numTiles[1], 2);
+    BOOST_CHECK_EQUAL(pyr.level(0).numTiles[2], 2);
+
+    BOOST_CHECK_THROW(pyr.level(4), std::invalid_argument);
+    BOOST_CHECK_THROW(pyr.tile(0, Index3{ { 3, 0, 0 } }),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE (FinestLevelExact)
+{
+    const auto f = linearField(Index3{ { 7, 5, 3 } });
+
+    const auto pyr = Opm::ECLFieldPyramid {
+        f.dims, f.cell, f.value, f.weight, tiles(4, 2, 2)
+    };
+
+    const auto x = levelValues(pyr, 0);
+
+    BOOST_REQUIRE_EQUAL(x.size(), f.value.size());
+
+    for (auto n = x.size(), i = 0*n; i < n; ++i) {
+        BOOST_CHECK_EQUAL(x[i], static_cast<float>(f.value[i]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE (WeightedAverages)
+{
+    const auto f = linearField(Index3{ { 4, 4, 2 } });
+
+    const auto pyr = Opm::ECLFieldPyramid {
+        f.dims, f.cell, f.value, f.weight, tiles(2, 2, 2)
+    };
+
+    // Level 1 cell (1,0,0) merges main grid cells I in {2,3}, J in {0,1},
+    // K in {0,1}.
+    {
+        auto num = 0.0, den = 0.0;
+
+        for (auto k = 0; k < 2; ++k) {
+            for (auto j = 0; j < 2; ++j) {
+                for (auto i = 2; i < 4; ++i) {
+                    const auto g = i + 4*(j + 4*k);
+
+                    num += f.weight[g] * f.value[g];
+                    den += f.weight[g];
+                }
+            }
+        }
+
+        const auto x = levelValues(pyr, 1);
+
+        BOOST_CHECK_CLOSE(x[1], num / den, 1.0e-5);
+    }
+
+    // Coarsest level is the average over all cells.
+    {
+        auto num = 0.0, den = 0.0;
+
+        for (auto n = f.value.size(), i = 0*n; i < n; ++i) {
+            num += f.weight[i] * f.value[i];
+            den += f.weight[i];
+        }
+
+        const auto top = pyr.tile(pyr.numLevels() - 1, Index3{ { 0, 0, 0 } });
+
+        BOOST_REQUIRE_EQUAL(top.values.size(), std::size_t{1});
+        BOOST_CHECK_CLOSE(top.values[0], num / den, 1.0e-5);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (RefinedAndInactiveCells)
+{
+    // 2x2x1 main grid.  Cell 0 is refined into three active cells, cell 1
+    // is inactive, cells 2 and 3 are regular.  Last active cell has no
+    // known host.
+    const auto dims   = Index3{ { 2, 2, 1 } };
+    const auto cell   = std::vector<int>   {  2,   3,   0,   0,   0,  -1 };
+    const auto value  = std::vector<double>{ 1.0, 2.0, 3.0, 6.0, 9.0, 1.0e6 };
+    const auto weight = std::vector<double>{ 1.0, 1.0, 1.0, 1.0, 2.0, 1.0 };
+
+    const auto pyr = Opm::ECLFieldPyramid {
+        dims, cell, value, weight, tiles(2, 2, 1)
+    };
+
+    const auto x = levelValues(pyr, 0);
+
+    BOOST_REQUIRE_EQUAL(x.size(), std::size_t{4});
+
+    BOOST_CHECK_CLOSE(x[0], (3.0 + 6.0 + 2*9.0) / 4.0, 1.0e-5);
+    BOOST_CHECK(std::isnan(x[1]));
+    BOOST_CHECK_EQUAL(x[2], 1.0f);
+    BOOST_CHECK_EQUAL(x[3], 2.0f);
+
+    // Inactive cell does not contribute to coarser levels.
+    const auto top = pyr.tile(1, Index3{ { 0, 0, 0 } });
+
+    BOOST_CHECK_CLOSE(top.values[0], (1.0 + 2.0 + 27.0) / 6.0, 1.0e-5);
+}
+
+BOOST_AUTO_TEST_CASE (InvalidInput)
+{
+    const auto dims = Index3{ { 2, 1, 1 } };
+
+    BOOST_CHECK_THROW(Opm::ECLFieldPyramid(dims, { 0, 1 }, { 1.0 },
+                                           { 1.0, 1.0 }),
+                      std::invalid_argument);
+
+    BOOST_CHECK_THROW(Opm::ECLFieldPyramid(dims, { 0, 2 }, { 1.0, 2.0 },
+                                           { 1.0, 1.0 }),
+                      std::invalid_argument);
+
+    BOOST_CHECK_THROW(Opm::ECLFieldPyramid(Index3{ { 0, 1, 1 } }, {}, {},
+                                           {}),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Tiling)
+
+BOOST_AUTO_TEST_CASE (TilesInRegion)
+{
+    const auto f = linearField(Index3{ { 16, 8, 2 } });
+
+    const auto pyr = Opm::ECLFieldPyramid {
+        f.dims, f.cell, f.value, f.weight, tiles(4, 4, 1)
+    };
+
+    // Level 0: Cells [3,9) x [0,2) x [1,2) touch tiles I in {0,1,2}.
+    {
+        const auto t = pyr.tilesInRegion(0, Index3{ { 3, 0, 1 } },
+                                            Index3{ { 9, 2, 2 } });
+
+        BOOST_REQUIRE_EQUAL(t.size(), std::size_t{3});
+
+        for (auto i = 0; i < 3; ++i) {
+            BOOST_CHECK_EQUAL(t[i][0], i);
+            BOOST_CHECK_EQUAL(t[i][1], 0);
+            BOOST_CHECK_EQUAL(t[i][2], 1);
+        }
+    }
+
+    // Level 1: Same region maps to level cells [1,4], single tile.
+    {
+        const auto t = pyr.tilesInRegion(1, Index3{ { 3, 0, 1 } },
+                                            Index3{ { 9, 2, 2 } });
+
+        BOOST_REQUIRE_EQUAL(t.size(), std::size_t{2});
+        BOOST_CHECK_EQUAL(t[0][0], 0);
+        BOOST_CHECK_EQUAL(t[1][0], 1);
+    }
+
+    // Region clipped to grid.
+    {
+        const auto t = pyr.tilesInRegion(0, Index3{ { -5, -5, -5 } },
+                                            Index3{ { 100, 100, 100 } });
+
+        BOOST_CHECK_EQUAL(t.size(), std::size_t{4 * 2 * 2});
+    }
+
+    // Empty region.
+    BOOST_CHECK(pyr.tilesInRegion(0, Index3{ { 3, 0, 0 } },
+                                     Index3{ { 3, 8, 2 } }).empty());
+}
+
+BOOST_AUTO_TEST_CASE (Compression)
+{
+    // Smooth field over 64x64x4 cells, half of which are inactive.
+    const auto dims = Index3{ { 64, 64, 4 } };
+
+    auto cell   = std::vector<int>{};
+    auto value  = std::vector<double>{};
+    auto weight = std::vector<double>{};
+
+    for (auto g = 0; g < dims[0]*dims[1]*dims[2]; ++g) {
+        const auto i = g % dims[0];
+
+        if (i >= dims[0] / 2) { continue; }
+
+        cell  .push_back(g);
+        value .push_back(250.0e5);
+        weight.push_back(1.0);
+    }
+
+    const auto pyr = Opm::ECLFieldPyramid {
+        dims, cell, value, weight, tiles(16, 16, 4)
+    };
+
+    auto raw = std::size_t{0};
+    for (auto lvl = 0; lvl < pyr.numLevels(); ++lvl) {
+        const auto& L = pyr.level(lvl);
+
+        raw += sizeof(float) * L.dimensions[0]
+            * L.dimensions[1] * L.dimensions[2];
+    }
+
+    BOOST_CHECK_LT(20 * pyr.compressedSize(), raw);
+
+    const auto x = levelValues(pyr, 0);
+
+    for (auto n = x.size(), g = 0*n; g < n; ++g) {
+        if (static_cast<int>(g % dims[0]) < dims[0] / 2) {
+            BOOST_CHECK_EQUAL(x[g], 250.0e5f);
+        }
+        else {
+            BOOST_CHECK(std::isnan(x[g]));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (PyramidFile)
+
+BOOST_AUTO_TEST_CASE (SaveAndLoad)
+{
+    namespace fs = boost::filesystem;
+
+    const auto f = linearField(Index3{ { 9, 6, 3 } });
+
+    const auto pyr = Opm::ECLFieldPyramid {
+        f.dims, f.cell, f.value, f.weight, tiles(4, 4, 2)
+    };
+
+    const auto file =
+        fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.fpyr");
+
+    pyr.save(file);
+
+    const auto all    = Opm::ECLFieldPyramid::load(file);
+    const auto coarse = Opm::ECLFieldPyramid::load(file, 2);
+
+    fs::remove(file);
+
+    BOOST_REQUIRE_EQUAL(all.numLevels(), pyr.numLevels());
+    BOOST_CHECK_EQUAL(all.compressedSize(), pyr.compressedSize());
+
+    for (auto lvl = 0; lvl < pyr.numLevels(); ++lvl) {
+        const auto expect = levelValues(pyr, lvl);
+        const auto x      = levelValues(all, lvl);
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(x     .begin(), x     .end(),
+                                      expect.begin(), expect.end());
+    }
+
+    BOOST_CHECK_EQUAL(coarse.finestLevel(), 2);
+    BOOST_CHECK_THROW(coarse.tile(1, Index3{ { 0, 0, 0 } }),
+                      std::invalid_argument);
+
+    for (auto lvl = 2; lvl < pyr.numLevels(); ++lvl) {
+        const auto expect = levelValues(pyr, lvl);
+        const auto x      = levelValues(coarse, lvl);
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(x     .begin(), x     .end(),
+                                      expect.begin(), expect.end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE (NotAPyramidFile)
+{
+    namespace fs = boost::filesystem;
+
+    const auto file =
+        fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.txt");
+
+    {
+        fs::ofstream os(file);
+        os << "Not a field pyramid\n";
+    }
+
+    BOOST_CHECK_THROW(Opm::ECLFieldPyramid::load(file), std::runtime_error);
+
+    fs::remove(file);
+
+    BOOST_CHECK_THROW(Opm::ECLFieldPyramid::load(file),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,751 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_KERNEL_EQUIVALENCE
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLExecutor.hpp>
+#include <opm/utility/ECLPiecewiseLinearInterpolant.hpp>
+#include <opm/utility/ECLPropTable.hpp>
+#include <opm/utility/ECLPvtCommon.hpp>
+#include <opm/utility/ECLTableInterpolation1D.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+/// \file
+///
+/// Equivalence of optimised kernels and their reference implementations.
+///
+/// Each optimised code path (search index, interval hints, fused
+/// multi-column evaluation, table simplification, parallel loops) is run
+/// side by side with a plain, scalar reference on randomised tables and
+/// sample points, including extrapolation.  Paths that only change how an
+/// interval is located must reproduce the reference bit for bit.  Paths
+/// that change the table itself are allowed a small number of units in the
+/// last place (ULPs) relative to the table's magnitude.
+
+namespace {
+    namespace PP = ::Opm::Interp1D::PiecewisePolynomial;
+
+    // -----------------------------------------------------------------
+    // Comparison
+    // -----------------------------------------------------------------
+
+    /// Map double to integer such that adjacent doubles map to adjacent
+    /// integers.
+    std::int64_t orderedBits(const double x)
+    {
+        auto i = std::int64_t{0};
+        std::memcpy(&i, &x, sizeof i);
+
+        return (i < 0) ? std::numeric_limits<std::int64_t>::min() - i : i;
+    }
+
+    /// Distance, in ULPs, between two finite doubles.
+    std::uint64_t ulpDistance(const double a, const double b)
+    {
+        const auto ia = orderedBits(a);
+        const auto ib = orderedBits(b);
+
+        return (ia > ib)
+            ? static_cast<std::uint64_t>(ia) - static_cast<std::uint64_t>(ib)
+            : static_cast<std::uint64_t>(ib) - static_cast<std::uint64_t>(ia);
+    }
+
+    /// Check that optimised results reproduce reference bit for bit.
+    void check_bitwise(const std::vector<double>& ref,
+                       const std::vector<double>& opt)
+    {
+        BOOST_REQUIRE_EQUAL(ref.size(), opt.size());
+
+        auto mismatch = std::size_t{0};
+        for (auto n = ref.size(), i = 0*n; i < n; ++i) {
+            mismatch += ulpDistance(ref[i], opt[i]) != 0;
+        }
+
+        BOOST_CHECK_MESSAGE(mismatch == 0, mismatch << " of " << ref.size()
+                            << " values differ from reference");
+    }
+
+    /// Check that optimised results are within 'maxUlps' units in the
+    /// last place of 'scale' from reference.
+    void check_ulp_bounded(const std::vector<double>& ref,
+                           const std::vector<double>& opt,
+                           const double               scale,
+                           const double               maxUlps)
+    {
+        BOOST_REQUIRE_EQUAL(ref.size(), opt.size());
+
+        const auto tol = maxUlps * std::numeric_limits<double>::epsilon()
+            * std::max(scale, std::numeric_limits<double>::min());
+
+        auto maxErr = 0.0;
+        for (auto n = ref.size(), i = 0*n; i < n; ++i) {
+            maxErr = std::max(maxErr, std::abs(ref[i] - opt[i]));
+        }
+
+        BOOST_CHECK_MESSAGE(maxErr <= tol, "Maximum deviation " << maxErr
+                            << " exceeds " << maxUlps << " ULPs ("
+                            << tol << ')');
+    }
+
+    double maxAbs(const std::vector<double>& x)
+    {
+        auto m = 0.0;
+        for (const auto& xi : x) { m = std::max(m, std::abs(xi)); }
+
+        return m;
+    }
+
+    // -----------------------------------------------------------------
+    // Synthetic input
+    // -----------------------------------------------------------------
+
+    /// Randomised, tabulated relative permeability and capillary pressure
+    /// curve.  Column major: S, kr, pc.  Contains a flat tail and collinear
+    /// runs so that table simplification has work to do.
+    struct SatTable
+    {
+        std::size_t         nrows;
+        std::vector<double> data;
+
+        std::vector<double> s() const
+        {
+            return { data.begin(), data.begin() + nrows };
+        }
+    };
+
+    SatTable randomSatTable(const std::size_t nrows, std::mt19937& gen)
+    {
+        auto unif = std::uniform_real_distribution<double>(0.0, 1.0);
+
+        auto s  = std::vector<double>(nrows);
+        auto kr = std::vector<double>(nrows);
+        auto pc = std::vector<double>(nrows);
+
+        const auto swco = 0.05 + 0.15*unif(gen);
+        const auto ds   = (1.0 - swco) / (nrows - 1);
+
+        const auto expo = 2.0 + unif(gen);
+
+        for (auto i = 0*nrows; i < nrows; ++i) {
+            s [i] = swco + i*ds;
+            kr[i] = std::pow(i*ds / (1.0 - swco), expo);
+            pc[i] = 3.0e5 * std::pow(1.0 - kr[i], 3.0);
+        }
+
+        // Flat tail below critical saturation and collinear interior
+        // nodes.
+        for (auto i = 0*nrows; i < std::min(nrows - 1, nrows*0 + 3); ++i) {
+            kr[i] = 0.0;
+            pc[i] = pc[0];
+        }
+
+        for (auto i = std::size_t{4}; i + 1 < nrows; i += 7) {
+            kr[i] = 0.5 * (kr[i - 1] + kr[i + 1]);
+            pc[i] = 0.5 * (pc[i - 1] + pc[i + 1]);
+        }
+
+        auto t = SatTable{ nrows, {} };
+        t.data.insert(t.data.end(), s .begin(), s .end());
+        t.data.insert(t.data.end(), kr.begin(), kr.end());
+        t.data.insert(t.data.end(), pc.begin(), pc.end());
+
+        return t;
+    }
+
+    /// Sample points covering interior, nodes and both extrapolation
+    /// ranges.
+    std::vector<double>
+    randomPoints(const std::vector<double>& x,
+                 const std::size_t          n,
+                 std::mt19937&              gen)
+    {
+        const auto width = x.back() - x.front();
+
+        auto unif = std::uniform_real_distribution<double>
+            (x.front() - 0.1*width, x.back() + 0.1*width);
+
+        auto pick = std::uniform_int_distribution<std::size_t>
+            (0, x.size() - 1);
+
+        auto p = std::vector<double>{};
+        p.reserve(n);
+
+        for (auto i = 0*n; i < n; ++i) {
+            // Every fourth point exactly at a table node.
+            p.push_back((i % 4 == 0) ? x[pick(gen)] : unif(gen));
+        }
+
+        p.push_back(x.front());
+        p.push_back(x.back());
+        p.push_back(std::nextafter(x.front(), -1.0e300));
+        p.push_back(std::nextafter(x.back() ,  1.0e300));
+
+        return p;
+    }
+
+    /// Perturb sample points slightly, as between consecutive report
+    /// steps.
+    std::vector<double>
+    perturb(std::vector<double> p, const double eps, std::mt19937& gen)
+    {
+        auto unif = std::uniform_real_distribution<double>(-eps, eps);
+
+        for (auto& pi : p) { pi += unif(gen); }
+
+        return p;
+    }
+
+    // -----------------------------------------------------------------
+    // Reference implementations
+    // -----------------------------------------------------------------
+
+    /// Scalar reference: linear search and linear interpolation,
+    /// constant extrapolation.
+    double referenceLinear(const std::vector<double>& x,
+                           const double*              y,
+                           const double               xi)
+    {
+        if (xi <= x.front()) { return y[0]; }
+        if (xi >= x.back())  { return y[x.size() - 1]; }
+
+        auto i = std::size_t{0};
+        while (! (xi < x[i + 1])) { ++i; }
+
+        const auto t = (xi - x[i]) / (x[i + 1] - x[i]);
+
+        return t*y[i + 1] + (1.0 - t)*y[i];
+    }
+
+    std::function<double(double)> identity()
+    {
+        return [](const double v) { return v; };
+    }
+
+    using ConstantInterp = PP::Linear<PP::ExtrapolationPolicy::Constant>;
+
+    ConstantInterp makeInterpolant(const SatTable& t)
+    {
+        using Extrap = PP::ExtrapolationPolicy::Constant;
+
+        auto xBegin = t.data.begin();
+        auto xEnd   = xBegin + t.nrows;
+
+        auto colIt = std::vector<decltype(xBegin)>{
+            xEnd, xEnd + t.nrows
+        };
+
+        return ConstantInterp {
+            Extrap{}, xBegin, xEnd, colIt,
+            identity(), std::vector<std::function<double(double)>>
+                            (colIt.size(), identity())
+        };
+    }
+
+    std::vector<double>
+    evaluate(const ConstantInterp&      interp,
+             const std::size_t          col,
+             const std::vector<double>& p)
+    {
+        auto y = std::vector<double>{};
+        y.reserve(p.size());
+
+        for (const auto& pi : p) {
+            y.push_back(interp.evaluate(col, interp.classifyPoint(pi)));
+        }
+
+        return y;
+    }
+
+    std::vector<double>
+    evaluate(const ConstantInterp&               interp,
+             const std::size_t                   col,
+             const std::vector<double>&          p,
+             Opm::Interp1D::IntervalHintCache&   hints)
+    {
+        hints.prepare(p.size());
+
+        auto y = std::vector<double>{};
+        y.reserve(p.size());
+
+        for (auto n = p.size(), i = 0*n; i < n; ++i) {
+            const auto pt = interp.classifyPoint(p[i], hints, i);
+
+            y.push_back(interp.evaluate(col, pt));
+        }
+
+        return y;
+    }
+
+    Opm::ECLPropTableRawData
+    rawSatTables(const std::vector<SatTable>& tables)
+    {
+        // Raw format: all tables' values of one column, then next column.
+        auto raw = Opm::ECLPropTableRawData{};
+
+        raw.numPrimary = 1;
+        raw.numRows    = tables.front().nrows;
+        raw.numCols    = 3;
+        raw.numTables  = tables.size();
+
+        for (auto c = 0*raw.numCols; c < raw.numCols; ++c) {
+            for (const auto& t : tables) {
+                const auto b = t.data.begin() + c*t.nrows;
+
+                raw.data.insert(raw.data.end(), b, b + t.nrows);
+            }
+        }
+
+        return raw;
+    }
+
+    Opm::SatFuncInterpolant::ConvertUnits identityUnits()
+    {
+        using Cvrt = Opm::SatFuncInterpolant::ConvertUnits::Converter;
+
+        return Opm::SatFuncInterpolant::ConvertUnits {
+            Cvrt{ identity() }, std::vector<Cvrt>(2, Cvrt{ identity() })
+        };
+    }
+
+    const auto tableSizes = std::vector<std::size_t>{
+        // Below and above Eytzinger index threshold.
+        5, 20, 64, 150, 301
+    };
+} // Anonymous
+
+// =====================================================================
+// Piecewise linear interpolant versus scalar reference
+// ---------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (PiecewiseLinear)
+
+BOOST_AUTO_TEST_CASE (SearchIndexMatchesReference)
+{
+    auto gen = std::mt19937{ 1234 };
+
+    for (const auto nrows : tableSizes) {
+        const auto t      = randomSatTable(nrows, gen);
+        const auto interp = makeInterpolant(t);
+        const auto x      = t.s();
+        const auto p      = randomPoints(x, 2000, gen);
+
+        for (const auto col : { std::size_t{0}, std::size_t{1} }) {
+            const auto* y = t.data.data() + (col + 1)*nrows;
+
+            auto ref = std::vector<double>{};
+            for (const auto& pi : p) {
+                ref.push_back(referenceLinear(x, y, pi));
+            }
+
+            // Unsimplified table.  Same interval, same arithmetic.
+            check_bitwise(ref, evaluate(interp, col, p));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (IntervalHints)
+{
+    auto gen = std::mt19937{ 4321 };
+
+    for (const auto nrows : tableSizes) {
+        const auto t      = randomSatTable(nrows, gen);
+        const auto interp = makeInterpolant(t);
+
+        auto hints = Opm::Interp1D::IntervalHintCache{};
+        auto p     = randomPoints(t.s(), 2000, gen);
+
+        // Sequence of "report steps".  Cold, warm and shifted hints.
+        for (auto step = 0; step < 4; ++step) {
+            for (const auto col : { std::size_t{0}, std::size_t{1} }) {
+                check_bitwise(evaluate(interp, col, p),
+                              evaluate(interp, col, p, hints));
+            }
+
+            p = perturb(std::move(p), 0.01 * step, gen);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (Simplification)
+{
+    auto gen = std::mt19937{ 5678 };
+
+    for (const auto nrows : tableSizes) {
+        const auto t    = randomSatTable(nrows, gen);
+        const auto ref  = makeInterpolant(t);
+        auto       simp = makeInterpolant(t);
+
+        // At least the interior node of the flat tail is redundant.
+        BOOST_CHECK(simp.simplify() > std::size_t{0});
+
+        const auto p = randomPoints(t.s(), 2000, gen);
+
+        for (const auto col : { std::size_t{0}, std::size_t{1} }) {
+            const auto y = ref.resultVariable(col);
+
+            check_ulp_bounded(evaluate(ref , col, p),
+                              evaluate(simp, col, p), maxAbs(y), 8.0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+// Saturation function tables (multiple regions)
+// ---------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (SatFunc)
+
+BOOST_AUTO_TEST_CASE (FusedAndHintedEvaluation)
+{
+    using InTable      = Opm::SatFuncInterpolant::InTable;
+    using ResultColumn = Opm::SatFuncInterpolant::ResultColumn;
+
+    auto gen = std::mt19937{ 2468 };
+
+    for (const auto nrows : tableSizes) {
+        const auto tables = std::vector<SatTable>{
+            randomSatTable(nrows, gen),
+            randomSatTable(nrows, gen),
+            randomSatTable(nrows, gen),
+        };
+
+        // Reference retains all nodes (default).  Optimised table drops
+        // exactly reproduced nodes (zero tolerance).
+        const auto ref = Opm::SatFuncInterpolant {
+            rawSatTables(tables), identityUnits()
+        };
+
+        const auto opt = Opm::SatFuncInterpolant {
+            rawSatTables(tables), identityUnits(), 0.0
+        };
+
+        const auto cols = std::vector<ResultColumn> {
+            ResultColumn{0}, ResultColumn{1}
+        };
+
+        for (auto k = 0*tables.size(); k < tables.size(); ++k) {
+            const auto& t = tables[k];
+            auto        p = randomPoints(t.s(), 1000, gen);
+
+            auto hints = Opm::Interp1D::IntervalHintCache{};
+
+            for (auto step = 0; step < 3; ++step) {
+                const auto fused  = opt.interpolate(InTable{k}, cols, p);
+                const auto hinted =
+                    opt.interpolate(InTable{k}, cols, p, hints);
+
+                BOOST_REQUIRE_EQUAL(fused .size(), cols.size());
+                BOOST_REQUIRE_EQUAL(hinted.size(), cols.size());
+
+                for (auto c = 0*cols.size(); c < cols.size(); ++c) {
+                    const auto single =
+                        opt.interpolate(InTable{k}, cols[c], p);
+
+                    // Fused and hinted paths only change point location.
+                    check_bitwise(single, fused [c]);
+                    check_bitwise(single, hinted[c]);
+
+                    // Simplified table versus all nodes.
+                    const auto full =
+                        ref.interpolate(InTable{k}, cols[c], p);
+
+                    const auto* y = t.data.data() + (c + 1)*t.nrows;
+                    const auto scale =
+                        maxAbs(std::vector<double>(y, y + t.nrows));
+
+                    check_ulp_bounded(full, single, scale, 8.0);
+                }
+
+                p = perturb(std::move(p), 0.02, gen);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+// Dead oil/dry gas PVT (PVDx)
+// ---------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (PVD)
+
+BOOST_AUTO_TEST_CASE (IntervalHints)
+{
+    auto gen = std::mt19937{ 1357 };
+
+    for (const auto nrows : tableSizes) {
+        // Columns: p, 1/B, 1/(B*mu), d(1/B)/dp, d(1/(B*mu))/dp
+        auto table = std::vector<double>(5 * nrows);
+        auto unif  = std::uniform_real_distribution<double>(0.9, 1.1);
+
+        for (auto i = 0*nrows; i < nrows; ++i) {
+            const auto p  = 1.0e5 * (1.0 + i + 0.5*unif(gen));
+            const auto b  = 1.0 / (1.2 - 1.0e-9*p);
+            const auto mu = 1.0e-3 * (1.0 + 1.0e-8*p);
+
+            table[0*nrows + i] = p;
+            table[1*nrows + i] = b;
+            table[2*nrows + i] = b / mu;
+            table[3*nrows + i] = 1.0e-9 * b * b;
+            table[4*nrows + i] = 1.0e-9 * b * b / mu;
+        }
+
+        auto xBegin = table.cbegin();
+        auto xEnd   = xBegin + nrows;
+
+        auto colIt = std::vector<decltype(xBegin)>{};
+        for (auto c = 1; c < 5; ++c) {
+            colIt.push_back(xBegin + c*nrows);
+        }
+
+        const auto convert = Opm::ECLPVT::ConvertUnits {
+            identity(),
+            std::vector<Opm::ECLPVT::ConvertUnits::Converter>
+                (4, identity())
+        };
+
+        auto pvd = Opm::ECLPVT::PVDx{ xBegin, xEnd, convert, colIt };
+
+        const auto x = std::vector<double>(xBegin, xEnd);
+        auto       p = randomPoints(x, 1000, gen);
+
+        for (auto step = 0; step < 3; ++step) {
+            pvd.useIntervalHints(false);
+            const auto B  = pvd.formationVolumeFactor(p);
+            const auto mu = pvd.viscosity(p);
+
+            pvd.useIntervalHints(true);
+            for (auto pass = 0; pass < 2; ++pass) {
+                check_bitwise(B , pvd.formationVolumeFactor(p));
+                check_bitwise(mu, pvd.viscosity(p));
+            }
+
+            p = perturb(std::move(p), 1.0e3, gen);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+// Live oil/wet gas PVT (PVTx)
+// ---------------------------------------------------------------------
+
+namespace {
+    /// Sub-table interpolant of PVTx evaluator.  Ascending inner variate
+    /// (pressure) for live oil, descending (vaporised oil-gas ratio) for
+    /// wet gas.
+    template <bool IsAscending>
+    using PVTxSubtable = PP::Linear<PP::ExtrapolationPolicy::Linearly,
+                                    IsAscending>;
+
+    /// Random sub-tables, one per primary key, with columns inner
+    /// variate, 1/B, and 1/(B*mu).  Sub-table abscissas differ between
+    /// primary keys.
+    template <bool IsAscending>
+    Opm::ECLPVT::PVTx<PVTxSubtable<IsAscending>>
+    randomPVTx(const std::vector<double>& key,
+               const std::size_t          nrows,
+               std::mt19937&              gen)
+    {
+        using StI = PVTxSubtable<IsAscending>;
+
+        auto unif = std::uniform_real_distribution<double>(0.9, 1.1);
+
+        auto sti = std::vector<StI>{};
+        sti.reserve(key.size());
+
+        for (auto k = 0*key.size(); k < key.size(); ++k) {
+            auto table = std::vector<double>(3 * nrows);
+
+            for (auto i = 0*nrows; i < nrows; ++i) {
+                const auto r = IsAscending ? i : nrows - i - 1;
+
+                const auto x  = 1.0e5 * (1.0 + i + 0.5*unif(gen));
+                const auto b  = 1.0 / (1.2 - 1.0e-9*x*(1.0 + 0.1*k));
+                const auto mu = 1.0e-3 * (1.0 + 1.0e-8*x + 0.01*k);
+
+                table[0*nrows + r] = x;
+                table[1*nrows + r] = b;
+                table[2*nrows + r] = b / mu;
+            }
+
+            auto xBegin = table.cbegin();
+            auto xEnd   = xBegin + nrows;
+
+            auto colIt = std::vector<decltype(xBegin)>{
+                xEnd, xEnd + nrows
+            };
+
+            sti.emplace_back(PP::ExtrapolationPolicy::Linearly{},
+                             xBegin, xEnd, colIt, identity(),
+                             std::vector<std::function<double(double)>>
+                                 (colIt.size(), identity()));
+        }
+
+        return { key, std::move(sti) };
+    }
+
+    /// Hinted versus unhinted evaluation of a PVTx evaluator across a
+    /// sequence of "report steps".
+    template <bool IsAscending>
+    void check_pvtx_hints(const std::size_t nkeys,
+                          const std::size_t nrows,
+                          std::mt19937&     gen)
+    {
+        using PVTx = Opm::ECLPVT::PVTx<PVTxSubtable<IsAscending>>;
+
+        auto key = std::vector<double>(nkeys);
+        for (auto k = 0*nkeys; k < nkeys; ++k) {
+            key[k] = 10.0 * (1.0 + k);
+        }
+
+        auto pvt = randomPVTx<IsAscending>(key, nrows, gen);
+
+        auto inner = std::vector<double>(nrows);
+        for (auto i = 0*nrows; i < nrows; ++i) {
+            inner[i] = 1.0e5 * (1.0 + i);
+        }
+
+        // Same number of points in both variates (randomPoints() adds four
+        // fixed points to each).
+        auto rs = randomPoints(key  , 1000, gen);
+        auto p  = randomPoints(inner, 1000, gen);
+
+        for (auto step = 0; step < 3; ++step) {
+            const auto K = typename PVTx::PrimaryKey  { rs };
+            const auto X = typename PVTx::InnerVariate{ p  };
+
+            pvt.useIntervalHints(false);
+            const auto B  = pvt.formationVolumeFactor(K, X);
+            const auto mu = pvt.viscosity(K, X);
+
+            pvt.useIntervalHints(true);
+            for (auto pass = 0; pass < 2; ++pass) {
+                check_bitwise(B , pvt.formationVolumeFactor(K, X));
+                check_bitwise(mu, pvt.viscosity(K, X));
+            }
+
+            // Second pass reuses the first pass' intervals.
+            BOOST_CHECK(pvt.intervalHintStatistics().hits > std::size_t{0});
+
+            rs = perturb(std::move(rs), 0.5  , gen);
+            p  = perturb(std::move(p) , 1.0e3, gen);
+        }
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (PVT)
+
+BOOST_AUTO_TEST_CASE (LiveOilIntervalHints)
+{
+    auto gen = std::mt19937{ 8642 };
+
+    for (const auto nrows : tableSizes) {
+        for (const auto nkeys : { std::size_t{2}, std::size_t{70} }) {
+            check_pvtx_hints<true>(nkeys, nrows, gen);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (WetGasIntervalHints)
+{
+    auto gen = std::mt19937{ 7531 };
+
+    for (const auto nrows : tableSizes) {
+        for (const auto nkeys : { std::size_t{2}, std::size_t{70} }) {
+            check_pvtx_hints<false>(nkeys, nrows, gen);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+// Parallel loops versus serial execution
+// ---------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (Executor)
+
+BOOST_AUTO_TEST_CASE (ParallelMatchesSerial)
+{
+    auto gen = std::mt19937{ 9753 };
+
+    const auto t      = randomSatTable(301, gen);
+    const auto interp = makeInterpolant(t);
+    const auto p      = randomPoints(t.s(), 200000, gen);
+
+    auto kernel = [&interp, &p]() -> std::vector<double>
+    {
+        auto y = std::vector<double>(p.size());
+
+        Opm::ECLExecution::parallelFor(p.size(), 1024,
+            [&interp, &p, &y](const std::size_t begin,
+                              const std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i) {
+                y[i] = interp.evaluate(0, interp.classifyPoint(p[i]));
+            }
+        });
+
+        return y;
+    };
+
+    Opm::ECLExecution::
+        setDefaultExecutor(std::make_shared<Opm::ECLSerialExecutor>());
+    const auto serial = kernel();
+
+    Opm::ECLExecution::setDefaultExecutor
+        (std::make_shared<Opm::ECLWorkStealingExecutor>(4));
+    const auto parallel = kernel();
+
+    Opm::ECLExecution::setDefaultExecutor(nullptr);
+
+    check_bitwise(serial, parallel);
+    check_bitwise(evaluate(interp, 0, p), parallel);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
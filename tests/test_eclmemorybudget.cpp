@@ -0,0 +1,279 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_MEMORY_BUDGET
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLMemoryBudget.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Cache = Opm::ECLBudgetedCache<int, std::vector<double>>;
+
+    std::size_t bytes(const std::vector<double>& x)
+    {
+        return x.size() * sizeof(double);
+    }
+
+    /// Cache value of 'n' doubles.  Counts invocations.
+    struct Compute
+    {
+        std::size_t  n;
+        std::size_t* count;
+
+        std::vector<double> operator()() const
+        {
+            *this->count += 1;
+
+            return std::vector<double>(this->n, 1.0);
+        }
+    };
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (Budget)
+
+BOOST_AUTO_TEST_CASE (Disabled)
+{
+    Opm::ECLMemoryBudget budget;
+    Cache cache{ "Disabled", bytes, budget };
+
+    BOOST_CHECK(! cache.enabled());
+
+    auto count = std::size_t{0};
+
+    cache.get(0, Compute{ 10, &count });
+    cache.get(0, Compute{ 10, &count });
+
+    // Nothing retained.  Recomputed on every request.
+    BOOST_CHECK_EQUAL(count, std::size_t{2});
+    BOOST_CHECK_EQUAL(budget.usage(), std::size_t{0});
+}
+
+BOOST_AUTO_TEST_CASE (RetainAndHit)
+{
+    Opm::ECLMemoryBudget budget{ 1000 * sizeof(double) };
+    Cache cache{ "Arrays", bytes, budget };
+
+    auto count = std::size_t{0};
+
+    const auto x = cache.get(1, Compute{ 100, &count });
+    const auto y = cache.get(1, Compute{ 100, &count });
+
+    BOOST_CHECK_EQUAL(count, std::size_t{1});
+    BOOST_CHECK(x == y);
+
+    BOOST_CHECK_EQUAL(cache.hits()  , std::size_t{1});
+    BOOST_CHECK_EQUAL(cache.misses(), std::size_t{1});
+
+    BOOST_CHECK_EQUAL(budget.usage(), 100 * sizeof(double));
+
+    const auto rpt = budget.report();
+    BOOST_REQUIRE_EQUAL(rpt.size(), std::size_t{1});
+    BOOST_CHECK_EQUAL(rpt[0].name   , std::string{ "Arrays" });
+    BOOST_CHECK_EQUAL(rpt[0].entries, std::size_t{1});
+    BOOST_CHECK_EQUAL(rpt[0].bytes  , 100 * sizeof(double));
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(budget.usage(), std::size_t{0});
+}
+
+BOOST_AUTO_TEST_CASE (OversizedEntry)
+{
+    Opm::ECLMemoryBudget budget{ 10 * sizeof(double) };
+    Cache cache{ "Large", bytes, budget };
+
+    auto count = std::size_t{0};
+
+    const auto x = cache.get(0, Compute{ 11, &count });
+    BOOST_CHECK_EQUAL(x->size(), std::size_t{11});
+
+    cache.get(0, Compute{ 11, &count });
+
+    BOOST_CHECK_EQUAL(count, std::size_t{2});
+    BOOST_CHECK_EQUAL(budget.usage(), std::size_t{0});
+}
+
+BOOST_AUTO_TEST_CASE (CoordinatedLRU)
+{
+    Opm::ECLMemoryBudget budget{ 30 * sizeof(double) };
+
+    Cache c1{ "First" , bytes, budget };
+    Cache c2{ "Second", bytes, budget };
+
+    auto n1 = std::size_t{0};
+    auto n2 = std::size_t{0};
+
+    c1.get(0, Compute{ 10, &n1 });
+    c2.get(0, Compute{ 10, &n2 });
+    c1.get(1, Compute{ 10, &n1 });
+
+    // Touch c1's first entry.  c2's entry is now least recently used.
+    c1.get(0, Compute{ 10, &n1 });
+
+    // Exceeds limit.  Evicts c2's entry.
+    c1.get(2, Compute{ 10, &n1 });
+
+    BOOST_CHECK_EQUAL(budget.usage(), 30 * sizeof(double));
+
+    {
+        const auto rpt = budget.report();
+        BOOST_REQUIRE_EQUAL(rpt.size(), std::size_t{2});
+
+        BOOST_CHECK_EQUAL(rpt[0].entries  , std::size_t{3});
+        BOOST_CHECK_EQUAL(rpt[0].evictions, std::size_t{0});
+        BOOST_CHECK_EQUAL(rpt[1].entries  , std::size_t{0});
+        BOOST_CHECK_EQUAL(rpt[1].evictions, std::size_t{1});
+    }
+
+    // Evicted entry is recomputed.
+    c2.get(0, Compute{ 10, &n2 });
+    BOOST_CHECK_EQUAL(n2, std::size_t{2});
+
+    // Reducing limit evicts least recently used entries.
+    budget.setLimit(15 * sizeof(double));
+    BOOST_CHECK_EQUAL(budget.usage(), 10 * sizeof(double));
+
+    c2.get(0, Compute{ 10, &n2 });
+    BOOST_CHECK_EQUAL(n2, std::size_t{2});
+
+    BOOST_CHECK_EQUAL(n1, std::size_t{3});
+}
+
+BOOST_AUTO_TEST_CASE (CacheDestroyed)
+{
+    Opm::ECLMemoryBudget budget{ 100 * sizeof(double) };
+
+    {
+        Cache cache{ "Temporary", bytes, budget };
+        auto count = std::size_t{0};
+
+        cache.get(0, Compute{ 50, &count });
+        BOOST_CHECK_EQUAL(budget.usage(), 50 * sizeof(double));
+    }
+
+    BOOST_CHECK_EQUAL(budget.usage(), std::size_t{0});
+    BOOST_CHECK(budget.report().empty());
+}
+
+BOOST_AUTO_TEST_CASE (NonEvictableClient)
+{
+    Opm::ECLMemoryBudget budget{ 30 * sizeof(double) };
+
+    Cache cache{ "Arrays", bytes, budget };
+
+    auto count = std::size_t{0};
+
+    cache.get(0, Compute{ 10, &count });
+    cache.get(1, Compute{ 10, &count });
+
+    const auto pinned = budget.registerClient("Static",
+                                              Opm::ECLMemoryBudget::Evictor{});
+
+    // Retained even though larger than the remaining room.  Evicts least
+    // recently used entry of the evictable cache.
+    BOOST_CHECK(budget.charge(pinned, 1, 15 * sizeof(double)));
+    BOOST_CHECK_EQUAL(budget.usage(), 25 * sizeof(double));
+
+    {
+        const auto rpt = budget.report();
+        BOOST_REQUIRE_EQUAL(rpt.size(), std::size_t{2});
+
+        BOOST_CHECK(  rpt[0].evictable);
+        BOOST_CHECK_EQUAL(rpt[0].entries  , std::size_t{1});
+        BOOST_CHECK_EQUAL(rpt[0].evictions, std::size_t{1});
+
+        BOOST_CHECK(! rpt[1].evictable);
+        BOOST_CHECK_EQUAL(rpt[1].name   , std::string{ "Static" });
+        BOOST_CHECK_EQUAL(rpt[1].entries, std::size_t{1});
+        BOOST_CHECK_EQUAL(rpt[1].bytes  , 15 * sizeof(double));
+    }
+
+    // Does not fit next to non-evictable entry.
+    cache.get(2, Compute{ 20, &count });
+    BOOST_CHECK_EQUAL(budget.usage(), 25 * sizeof(double));
+
+    // Non-evictable entries survive any limit.
+    budget.setLimit(5 * sizeof(double));
+    BOOST_CHECK_EQUAL(budget.usage(), 15 * sizeof(double));
+
+    budget.release(pinned, 1);
+    BOOST_CHECK_EQUAL(budget.usage(), std::size_t{0});
+
+    budget.charge(pinned, 2, 10 * sizeof(double));
+    budget.unregisterClient(pinned);
+
+    BOOST_CHECK_EQUAL(budget.usage(), std::size_t{0});
+    BOOST_CHECK_EQUAL(budget.report().size(), std::size_t{1});
+}
+
+BOOST_AUTO_TEST_CASE (Concurrent)
+{
+    Opm::ECLMemoryBudget budget{ 64 * 100 * sizeof(double) };
+
+    Cache c1{ "First" , bytes, budget };
+    Cache c2{ "Second", bytes, budget };
+
+    std::atomic<int> mismatch{0};
+
+    auto threads = std::vector<std::thread>{};
+
+    for (auto t = 0; t < 4; ++t) {
+        threads.emplace_back([t, &c1, &c2, &mismatch]()
+        {
+            for (auto i = 0; i < 2000; ++i) {
+                auto& c = ((i + t) % 2 == 0) ? c1 : c2;
+
+                const auto key = (i * 7 + t) % 97;
+                const auto x = c.get(key, [key]()
+                {
+                    return std::vector<double>(100, double(key));
+                });
+
+                if ((x->size() != 100) || (x->front() != double(key))) {
+                    ++mismatch;
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads) { t.join(); }
+
+    BOOST_CHECK_EQUAL(mismatch.load(), 0);
+    BOOST_CHECK(budget.usage() <= budget.limit());
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
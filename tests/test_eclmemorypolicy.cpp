@@ -0,0 +1,179 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_MEMORY_POLICY
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLExecutor.hpp>
+#include <opm/utility/ECLMemoryPolicy.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+
+namespace {
+    using Policy    = Opm::ECLMemory::Policy;
+    using Placement = Opm::ECLMemory::Placement;
+    using HugePages = Opm::ECLMemory::HugePages;
+
+    // Allocate, fill and verify array of 'n' doubles under given policy.
+    void exercise(const Policy& policy, const std::size_t n)
+    {
+        Opm::ECLMemory::setPolicy(policy);
+
+        auto x = Opm::ECLLargeArray<double>(n);
+        BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(x.data())
+                          % alignof(double), std::uintptr_t{0});
+
+        for (auto i = 0*n; i < n; ++i) {
+            BOOST_CHECK_EQUAL(x[i], 0.0);
+        }
+
+        std::iota(x.begin(), x.end(), 0.0);
+
+        const auto y = x;
+        BOOST_CHECK_EQUAL(y.back(), static_cast<double>(n - 1));
+    }
+
+    // Serial executor that records the partitioning of its loops.
+    class RecordingExecutor : public Opm::ECLExecutor
+    {
+    public:
+        void parallelFor(const std::size_t n,
+                         const std::size_t grain,
+                         const RangeTask&  task) override
+        {
+            this->n     = n;
+            this->grain = grain;
+
+            Opm::ECLSerialExecutor{}.parallelFor(n, grain, task);
+        }
+
+        std::size_t concurrency() const override
+        {
+            return 1;
+        }
+
+        std::size_t n{0};
+        std::size_t grain{0};
+    };
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (MemoryPolicy)
+
+BOOST_AUTO_TEST_CASE (SmallAllocations)
+{
+    Opm::ECLMemory::resetStatistics();
+
+    exercise(Policy{}, 1000);
+
+    BOOST_CHECK_EQUAL(Opm::ECLMemory::statistics().largeAllocations,
+                      std::size_t{0});
+}
+
+BOOST_AUTO_TEST_CASE (PagePlacement)
+{
+    const auto n = std::size_t{1} << 19; // 4 MiB of doubles
+
+    {
+        Opm::ECLMemory::resetStatistics();
+
+        auto p = Policy{};
+        p.placement = Placement::FirstTouch;
+
+        exercise(p, n);
+
+        const auto stats = Opm::ECLMemory::statistics();
+        BOOST_CHECK(stats.largeAllocations >= std::size_t{1});
+        BOOST_CHECK(stats.firstTouchBytes  >= n * sizeof(double));
+    }
+
+    {
+        Opm::ECLMemory::resetStatistics();
+
+        auto p = Policy{};
+        p.placement = Placement::Interleave;
+
+        exercise(p, n);
+
+        // Interleaving is unavailable on some systems.
+        const auto stats = Opm::ECLMemory::statistics();
+        BOOST_CHECK(stats.largeAllocations >= std::size_t{1});
+        BOOST_CHECK((stats.interleavedBytes >= n * sizeof(double)) ||
+                    (stats.fallbacks > std::size_t{0}));
+    }
+}
+
+BOOST_AUTO_TEST_CASE (FirstTouchElementRanges)
+{
+    const auto n = std::size_t{1} << 19;
+
+    auto exec = std::make_shared<RecordingExecutor>();
+    Opm::ECLExecution::setDefaultExecutor(exec);
+
+    auto p = Policy{};
+    p.placement = Placement::FirstTouch;
+    p.grain     = 1024;
+
+    exercise(p, n);
+
+    // Partitioned over elements with the policy's grain, not over pages.
+    BOOST_CHECK(exec->n >= n);
+    BOOST_CHECK(exec->n <  n + 4096);
+    BOOST_CHECK_EQUAL(exec->grain, std::size_t{1024});
+
+    Opm::ECLExecution::setDefaultExecutor(nullptr);
+    Opm::ECLMemory::setPolicy(Policy{});
+}
+
+BOOST_AUTO_TEST_CASE (HugePageSupport)
+{
+    const auto n = std::size_t{1} << 19;
+
+    for (const auto hp : { HugePages::Transparent, HugePages::Explicit }) {
+        Opm::ECLMemory::resetStatistics();
+
+        auto p = Policy{};
+        p.hugePages = hp;
+
+        exercise(p, n);
+
+        const auto stats = Opm::ECLMemory::statistics();
+        BOOST_CHECK((stats.hugePageBytes >= n * sizeof(double)) ||
+                    (stats.fallbacks > std::size_t{0}));
+    }
+
+    Opm::ECLMemory::setPolicy(Policy{});
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,606 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_PARALLEL_TOF
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLCancellation.hpp>
+#include <opm/utility/ECLExecutor.hpp>
+#include <opm/utility/ECLParallelTOF.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    /// Flow problem on connection graph.
+    struct Problem
+    {
+        std::size_t         numCells;
+        std::vector<int>    neighbours;
+        std::vector<double> pvol;
+        std::vector<double> flux;
+        std::vector<double> inflow;
+    };
+
+    /// One-dimensional chain of cells with uniform flux from first to
+    /// last cell.
+    Problem chain(const std::size_t n, const double q)
+    {
+        auto p = Problem{};
+
+        p.numCells = n;
+        p.inflow.assign(n, 0.0);
+
+        for (auto i = 0*n; i < n; ++i) {
+            p.pvol.push_back(1.0 + 0.25*(i % 3));
+
+            if (i + 1 < n) {
+                p.neighbours.push_back(static_cast<int>(i + 0));
+                p.neighbours.push_back(static_cast<int>(i + 1));
+                p.flux.push_back(q);
+            }
+        }
+
+        p.inflow.front() =  q;
+        p.inflow.back()  = -q;
+
+        return p;
+    }
+
+    /// Two-dimensional grid with diagonal background flow from the first
+    /// to the last cell.  Vortices of four cells are imposed at regular
+    /// intervals, forming strongly connected components.
+    Problem grid(const std::size_t nx, const std::size_t ny)
+    {
+        auto p = Problem{};
+
+        p.numCells = nx * ny;
+        p.inflow.assign(p.numCells, 0.0);
+
+        auto cell = [nx](const std::size_t i, const std::size_t j)
+        {
+            return static_cast<int>(i + j*nx);
+        };
+
+        auto vortex = [](const std::size_t i, const std::size_t j)
+        {
+            return ((i % 4) == 1) && ((j % 4) == 1);
+        };
+
+        for (auto j = 0*ny; j < ny; ++j) {
+            for (auto i = 0*nx; i < nx; ++i) {
+                p.pvol.push_back(1.0 + 0.1*((3*i + 7*j) % 5));
+
+                if (i + 1 < nx) {
+                    // Top edge of vortex reversed.
+                    const auto rev = (j > 0) && vortex(i, j - 1);
+
+                    p.neighbours.push_back(cell(i + 0, j));
+                    p.neighbours.push_back(cell(i + 1, j));
+                    p.flux.push_back((rev ? -2.0 : 1.0) * (1.0 + 0.01*j));
+                }
+
+                if (j + 1 < ny) {
+                    // Left edge of vortex reversed.
+                    const auto rev = vortex(i, j);
+
+                    p.neighbours.push_back(cell(i, j + 0));
+                    p.neighbours.push_back(cell(i, j + 1));
+                    p.flux.push_back((rev ? -1.5 : 0.5) * (1.0 + 0.02*i));
+                }
+            }
+        }
+
+        p.inflow.front() =  1.5;
+        p.inflow.back()  = -2.0;
+
+        return p;
+    }
+
+    Opm::ECLParallelTOF
+    engine(const Problem&                       p,
+           const Opm::ECLParallelTOF::Options&  opt =
+               Opm::ECLParallelTOF::Options{})
+    {
+        auto tof = Opm::ECLParallelTOF{ p.numCells, p.neighbours, opt };
+
+        tof.assignPoreVolume    (p.pvol);
+        tof.assignConnectionFlux(p.flux);
+        tof.assignInflowFlux    (p.inflow);
+
+        return tof;
+    }
+
+    /// Reference solution.  Repeated sweeps of the cell-wise update over
+    /// all cells, in index order, until the time-of-flight is stationary.
+    std::vector<double> reference(const Problem& p, const double sign)
+    {
+        const auto maxTOF = Opm::ECLParallelTOF::Options{}.maxTOF;
+        const auto n = p.numCells;
+
+        auto tof  = std::vector<double>(n, 0.0);
+        auto conc = std::vector<double>(n, 0.0);
+
+        auto influx = std::vector<double>(n, 0.0);
+        for (auto m = p.flux.size(), c = 0*m; c < m; ++c) {
+            const auto q = sign * p.flux[c];
+            influx[p.neighbours[2*c + ((q > 0.0) ? 1 : 0)]] += std::abs(q);
+        }
+
+        for (auto sweep = 0; sweep < 10000; ++sweep) {
+            auto change = 0.0;
+
+            for (auto i = 0*n; i < n; ++i) {
+                const auto src = std::max(sign * p.inflow[i], 0.0);
+                const auto q   = influx[i] + 2.0*src;
+
+                auto upTOF  = 0.0;
+                auto upConc = 0.0;
+                for (auto m = p.flux.size(), c = 0*m; c < m; ++c) {
+                    const auto f    = sign * p.flux[c];
+                    const auto down = p.neighbours[2*c + ((f > 0.0) ? 1 : 0)];
+                    const auto up   = p.neighbours[2*c + ((f > 0.0) ? 0 : 1)];
+
+                    if ((f != 0.0) && (static_cast<std::size_t>(down) == i)) {
+                        upTOF  += tof[up] * conc[up] * std::abs(f);
+                        upConc += conc[up] * std::abs(f);
+                    }
+                }
+
+                const auto t = tof[i];
+                if (q < p.pvol[i] / maxTOF) {
+                    tof[i] = maxTOF;
+                }
+                else {
+                    conc[i] = (src > 0.0) ? 1.0 : upConc / q;
+                    tof[i]  = (conc[i] > 0.0)
+                        ? (p.pvol[i]*conc[i] + upTOF) / (q * conc[i])
+                        : maxTOF;
+                }
+
+                change = std::max(change, std::abs(tof[i] - t) / tof[i]);
+            }
+
+            if (! (change > 1.0e-14)) { break; }
+        }
+
+        for (auto& t : tof) { t = std::min(t, maxTOF); }
+
+        return tof;
+    }
+
+    /// Reference tracer concentration of single start set.  Repeated
+    /// sweeps until the concentration is stationary.
+    std::vector<double> referenceTracer(const Problem&          p,
+                                        const double            sign,
+                                        const std::vector<int>& start)
+    {
+        const auto maxTOF = Opm::ECLParallelTOF::Options{}.maxTOF;
+        const auto n = p.numCells;
+
+        struct Upstream { int cell; double flux; };
+        auto up     = std::vector<std::vector<Upstream>>(n);
+        auto influx = std::vector<double>(n, 0.0);
+
+        for (auto m = p.flux.size(), c = 0*m; c < m; ++c) {
+            const auto f = sign * p.flux[c];
+            if (f == 0.0) { continue; }
+
+            const auto down = p.neighbours[2*c + ((f > 0.0) ? 1 : 0)];
+            const auto from = p.neighbours[2*c + ((f > 0.0) ? 0 : 1)];
+
+            up[down].push_back(Upstream{ from, std::abs(f) });
+            influx[down] += std::abs(f);
+        }
+
+        auto isStart = std::vector<bool>(n, false);
+        for (const auto& cell : start) { isStart[cell] = true; }
+
+        auto conc = std::vector<double>(n, 0.0);
+
+        for (auto sweep = 0; sweep < 10000; ++sweep) {
+            auto change = 0.0;
+
+            for (auto i = 0*n; i < n; ++i) {
+                const auto src = std::max(sign * p.inflow[i], 0.0);
+                const auto q   = influx[i] + 2.0*src;
+
+                auto c = 0.0;
+                if (! (q < p.pvol[i] / maxTOF)) {
+                    for (const auto& u : up[i]) {
+                        c += u.flux * conc[u.cell];
+                    }
+
+                    c = isStart[i] ? 1.0 : c / q;
+                }
+
+                change  = std::max(change, std::abs(c - conc[i]));
+                conc[i] = c;
+            }
+
+            if (! (change > 1.0e-15)) { break; }
+        }
+
+        return conc;
+    }
+
+    std::vector<double>
+    dense(const Opm::ECLParallelTOF::SparseTracer& t,
+          const std::size_t                        numCells)
+    {
+        auto c = std::vector<double>(numCells, 0.0);
+
+        BOOST_REQUIRE_EQUAL(t.cells.size(), t.concentration.size());
+        BOOST_CHECK(std::is_sorted(t.cells.begin(), t.cells.end()));
+
+        for (auto n = t.cells.size(), i = 0*n; i < n; ++i) {
+            BOOST_CHECK_GT(t.concentration[i], 0.0);
+
+            c[t.cells[i]] = t.concentration[i];
+        }
+
+        return c;
+    }
+
+    void check_close(const std::vector<double>& x,
+                     const std::vector<double>& y,
+                     const double               tol)
+    {
+        BOOST_REQUIRE_EQUAL(x.size(), y.size());
+
+        for (auto n = x.size(), i = 0*n; i < n; ++i) {
+            BOOST_CHECK_CLOSE(x[i], y[i], tol);
+        }
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (Chain)
+
+BOOST_AUTO_TEST_CASE (Forward)
+{
+    const auto q = 0.5;
+    const auto p = chain(10, q);
+
+    const auto sol = engine(p).solve(Opm::ECLParallelTOF::Direction::Forward);
+
+    // Half fill time in source cell, full fill time elsewhere.
+    auto expect = std::vector<double>{};
+    auto t = p.pvol[0] / (2.0 * q);
+    for (auto n = p.numCells, i = 0*n; i < n; ++i) {
+        expect.push_back(t);
+
+        if (i + 1 < n) { t += p.pvol[i + 1] / q; }
+    }
+
+    check_close(sol.timeOfFlight, expect, 1.0e-10);
+
+    BOOST_CHECK_EQUAL(sol.statistics.numLevels       , p.numCells);
+    BOOST_CHECK_EQUAL(sol.statistics.numComponents   , p.numCells);
+    BOOST_CHECK_EQUAL(sol.statistics.widestLevel     , std::size_t{1});
+    BOOST_CHECK_EQUAL(sol.statistics.largestComponent, std::size_t{1});
+}
+
+BOOST_AUTO_TEST_CASE (Reverse)
+{
+    const auto q = 0.5;
+    const auto p = chain(10, q);
+
+    const auto sol = engine(p).solve(Opm::ECLParallelTOF::Direction::Reverse);
+
+    auto expect = std::vector<double>(p.numCells);
+    auto t = p.pvol.back() / (2.0 * q);
+    for (auto i = p.numCells; i-- > 0;) {
+        expect[i] = t;
+
+        if (i > 0) { t += p.pvol[i - 1] / q; }
+    }
+
+    check_close(sol.timeOfFlight, expect, 1.0e-10);
+}
+
+BOOST_AUTO_TEST_CASE (Capped)
+{
+    const auto opt = Opm::ECLParallelTOF::Options{};
+
+    // Fill time of each cell exceeds maximum time-of-flight.
+    const auto p = chain(5, 1.0e-15);
+
+    const auto sol = engine(p).solve(Opm::ECLParallelTOF::Direction::Forward);
+
+    for (const auto& t : sol.timeOfFlight) {
+        BOOST_CHECK_EQUAL(t, opt.maxTOF);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Components)
+
+BOOST_AUTO_TEST_CASE (MatchesReference)
+{
+    const auto p = grid(30, 20);
+
+    for (const auto dir : { Opm::ECLParallelTOF::Direction::Forward,
+                            Opm::ECLParallelTOF::Direction::Reverse })
+    {
+        const auto sign =
+            (dir == Opm::ECLParallelTOF::Direction::Forward) ? 1.0 : -1.0;
+
+        const auto sol = engine(p).solve(dir);
+
+        BOOST_CHECK_EQUAL(sol.statistics.largestComponent, std::size_t{4});
+        BOOST_CHECK_GT   (sol.statistics.numDirectSolves , std::size_t{0});
+        BOOST_CHECK_EQUAL(sol.statistics.numUnconverged  , std::size_t{0});
+
+        check_close(sol.timeOfFlight, reference(p, sign), 1.0e-8);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (DirectAndIterative)
+{
+    const auto p = grid(30, 20);
+
+    auto opt = Opm::ECLParallelTOF::Options{};
+    opt.maxDirectSize = 0;
+
+    const auto dir = Opm::ECLParallelTOF::Direction::Forward;
+
+    const auto direct    = engine(p).solve(dir);
+    const auto iterative = engine(p, opt).solve(dir);
+
+    BOOST_CHECK_EQUAL(iterative.statistics.numDirectSolves, std::size_t{0});
+    BOOST_CHECK_EQUAL(iterative.statistics.numIterativeSolves,
+                      iterative.statistics.numComponents);
+    BOOST_CHECK_EQUAL(iterative.statistics.numUnconverged, std::size_t{0});
+
+    check_close(iterative.timeOfFlight, direct.timeOfFlight, 1.0e-8);
+}
+
+BOOST_AUTO_TEST_CASE (Unreachable)
+{
+    // Cells 0 and 1: source and downstream neighbour.  Cells 2, 3, 4:
+    // closed recirculation.  Cell 5: isolated.
+    auto p = Problem{};
+    p.numCells   = 6;
+    p.neighbours = { 0, 1,   2, 3,   3, 4,   4, 2 };
+    p.flux       = { 1.0,    1.0,    1.0,    1.0  };
+    p.pvol       = std::vector<double>(p.numCells, 1.0);
+    p.inflow     = { 1.0, -1.0, 0.0, 0.0, 0.0, 0.0 };
+
+    const auto maxTOF = Opm::ECLParallelTOF::Options{}.maxTOF;
+
+    for (const auto maxDirect : { 64, 0 }) {
+        auto opt = Opm::ECLParallelTOF::Options{};
+        opt.maxDirectSize = maxDirect;
+
+        const auto sol = engine(p, opt)
+            .solve(Opm::ECLParallelTOF::Direction::Forward);
+
+        const auto& t = sol.timeOfFlight;
+
+        BOOST_CHECK_CLOSE(t[0], 0.5, 1.0e-10);
+        BOOST_CHECK_CLOSE(t[1], 1.5, 1.0e-10);
+
+        for (auto i = 2; i < 6; ++i) {
+            BOOST_CHECK_EQUAL(t[i], maxTOF);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Parallel)
+
+BOOST_AUTO_TEST_CASE (ExecutorIndependent)
+{
+    // Levels wider than one parallel subrange.
+    const auto p   = grid(600, 400);
+    const auto dir = Opm::ECLParallelTOF::Direction::Forward;
+
+    Opm::ECLExecution::setDefaultExecutor
+        (std::make_shared<Opm::ECLSerialExecutor>());
+
+    const auto serial = engine(p).solve(dir);
+
+    Opm::ECLExecution::setDefaultExecutor
+        (std::make_shared<Opm::ECLWorkStealingExecutor>(4));
+
+    const auto parallel = engine(p).solve(dir);
+
+    Opm::ECLExecution::setDefaultExecutor(nullptr);
+
+    BOOST_CHECK_GT(serial.statistics.widestLevel, std::size_t{256});
+
+    BOOST_CHECK_EQUAL(serial.statistics.numLevels,
+                      parallel.statistics.numLevels);
+
+    BOOST_CHECK(serial.timeOfFlight == parallel.timeOfFlight);
+}
+
+BOOST_AUTO_TEST_CASE (Cancelled)
+{
+    const auto p = grid(600, 400);
+
+    const auto token = Opm::ECLCancellationToken::cancellable();
+    token.cancel();
+
+    BOOST_CHECK_THROW(engine(p).solve(Opm::ECLParallelTOF::Direction::Forward,
+                                      token),
+                      Opm::ECLOperationCancelled);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Tracers)
+
+BOOST_AUTO_TEST_CASE (ChainSparse)
+{
+    const auto p = chain(10, 0.5);
+
+    const auto t = engine(p)
+        .solveTracers(Opm::ECLParallelTOF::Direction::Forward,
+                      { { 3 }, { 9 }, {} });
+
+    BOOST_REQUIRE_EQUAL(t.size(), std::size_t{3});
+
+    // Downstream of start cell only.
+    BOOST_CHECK_EQUAL(t[0].cells.size(), std::size_t{7});
+    BOOST_CHECK_EQUAL(t[0].cells.front(), 3);
+    for (const auto& c : t[0].concentration) {
+        BOOST_CHECK_CLOSE(c, 1.0, 1.0e-12);
+    }
+
+    BOOST_CHECK_EQUAL(t[1].cells.size(), std::size_t{1});
+    BOOST_CHECK_EQUAL(t[1].cells.front(), 9);
+
+    BOOST_CHECK(t[2].cells.empty());
+}
+
+BOOST_AUTO_TEST_CASE (MatchesReference)
+{
+    const auto p = grid(30, 20);
+
+    // Not a multiple of the lane count.  Overlapping start sets.
+    auto startSets = std::vector<std::vector<int>>{};
+    for (auto k = 0; k < 21; ++k) {
+        startSets.push_back({ (37 * k) % 600, (37 * k + 211) % 600 });
+    }
+
+    for (const auto lanes : { 8, 16 }) {
+        auto opt = Opm::ECLParallelTOF::Options{};
+        opt.tracerLanes = lanes;
+
+        for (const auto dir : { Opm::ECLParallelTOF::Direction::Forward,
+                                Opm::ECLParallelTOF::Direction::Reverse })
+        {
+            const auto sign =
+                (dir == Opm::ECLParallelTOF::Direction::Forward)
+                ? 1.0 : -1.0;
+
+            const auto t = engine(p, opt).solveTracers(dir, startSets);
+
+            BOOST_REQUIRE_EQUAL(t.size(), startSets.size());
+
+            for (auto n = t.size(), k = 0*n; k < n; ++k) {
+                const auto c = dense(t[k], p.numCells);
+                const auto r = referenceTracer(p, sign, startSets[k]);
+
+                for (auto m = c.size(), i = 0*m; i < m; ++i) {
+                    BOOST_CHECK_SMALL(c[i] - r[i], 1.0e-10);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (ExecutorIndependent)
+{
+    const auto p   = grid(200, 100);
+    const auto dir = Opm::ECLParallelTOF::Direction::Forward;
+
+    auto startSets = std::vector<std::vector<int>>{};
+    for (auto k = 0; k < 100; ++k) {
+        startSets.push_back({ (7919 * k) % 20000 });
+    }
+
+    Opm::ECLExecution::setDefaultExecutor
+        (std::make_shared<Opm::ECLSerialExecutor>());
+
+    const auto serial = engine(p).solveTracers(dir, startSets);
+
+    Opm::ECLExecution::setDefaultExecutor
+        (std::make_shared<Opm::ECLWorkStealingExecutor>(4));
+
+    const auto parallel = engine(p).solveTracers(dir, startSets);
+
+    Opm::ECLExecution::setDefaultExecutor(nullptr);
+
+    BOOST_REQUIRE_EQUAL(serial.size(), parallel.size());
+
+    for (auto n = serial.size(), k = 0*n; k < n; ++k) {
+        BOOST_CHECK(serial[k].cells         == parallel[k].cells);
+        BOOST_CHECK(serial[k].concentration == parallel[k].concentration);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Construction)
+
+BOOST_AUTO_TEST_CASE (InvalidInput)
+{
+    BOOST_CHECK_THROW(Opm::ECLParallelTOF(3, { 0, 1, 2 }),
+                      std::invalid_argument);
+
+    BOOST_CHECK_THROW(Opm::ECLParallelTOF(3, { 0, 3 }),
+                      std::invalid_argument);
+
+    auto tof = Opm::ECLParallelTOF{ 3, { 0, 1, 1, 2 } };
+
+    BOOST_CHECK_THROW(tof.assignPoreVolume({ 1.0, 1.0 }),
+                      std::invalid_argument);
+
+    BOOST_CHECK_THROW(tof.assignConnectionFlux({ 1.0 }),
+                      std::invalid_argument);
+
+    BOOST_CHECK_THROW(tof.solve(Opm::ECLParallelTOF::Direction::Forward),
+                      std::logic_error);
+
+    tof.assignPoreVolume    ({ 1.0, 1.0, 1.0 });
+    tof.assignConnectionFlux({ 1.0, 1.0 });
+    tof.assignInflowFlux    ({ 1.0, 0.0, -1.0 });
+
+    BOOST_CHECK_THROW(tof.solveTracers(Opm::ECLParallelTOF::Direction::Forward,
+                                       { { 0 }, { 3 } }),
+                      std::invalid_argument);
+
+    auto opt = Opm::ECLParallelTOF::Options{};
+    opt.tracerLanes = 4;
+
+    BOOST_CHECK_THROW(Opm::ECLParallelTOF(3, { 0, 1 }, opt),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -35,6 +35,8 @@
 
 #include <opm/utility/ECLPropTable.hpp>
 
+#include <cmath>
+#include <cstddef>
 #include <exception>
 #include <stdexcept>
 
@@ -539,6 +541,80 @@ BOOST_AUTO_TEST_CASE (InterpolationLargeNodeAlloc)
 
 BOOST_AUTO_TEST_SUITE_END ()
 
+// =====================================================================
+// Multiple result columns from single classification pass.
+// ---------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (InterpolationMultiColumn)
+
+BOOST_AUTO_TEST_CASE (KrAndPc)
+{
+    auto t = Opm::ECLPropTableRawData{};
+
+    t.data = std::vector<double>{
+        // s, kr  , pc
+        0.2 , 0.0 , 4.0,
+        0.3 , 0.1 , 2.0,
+        0.8 , 0.5 , 0.5,
+    };
+
+    t.numPrimary = 1;
+    t.numRows    = 3;
+    t.numCols    = 3;
+    t.numTables  = 1;
+
+    const auto swfunc = Opm::SatFuncInterpolant {
+        toRawTableFormat(t),
+        createDummyUnitConverter(t.numCols - 1)
+    };
+
+    const auto s = std::vector<double>{
+        0.1, 0.2, 0.25, 0.3, 0.55, 0.8, 0.9,
+    };
+
+    const auto kr_expect = std::vector<double>{
+        0.0, 0.0, 0.05, 0.1, 0.3, 0.5, 0.5,
+    };
+
+    const auto pc_expect = std::vector<double>{
+        4.0, 4.0, 3.0, 2.0, 1.25, 0.5, 0.5,
+    };
+
+    using InTable      = Opm::SatFuncInterpolant::InTable;
+    using ResultColumn = Opm::SatFuncInterpolant::ResultColumn;
+
+    const auto cols = std::vector<ResultColumn>{
+        ResultColumn{0}, ResultColumn{1}
+    };
+
+    const auto krpc = swfunc.interpolate(InTable{0}, cols, s);
+
+    BOOST_REQUIRE_EQUAL(krpc.size(), cols.size());
+
+    check_is_close(krpc[0], kr_expect);
+    check_is_close(krpc[1], pc_expect);
+
+    // Must coincide with single-column evaluation.
+    check_is_close(krpc[0], swfunc.interpolate(InTable{0}, ResultColumn{0}, s));
+    check_is_close(krpc[1], swfunc.interpolate(InTable{0}, ResultColumn{1}, s));
+
+    // Check error handling
+
+    // Table ID out of range.
+    BOOST_CHECK_THROW(swfunc.interpolate(InTable{1}, cols, s),
+                      std::invalid_argument);
+
+    // Result Column ID out of range.
+    BOOST_CHECK_THROW(swfunc.interpolate(InTable{0},
+                                         std::vector<ResultColumn>{
+                                             ResultColumn{0},
+                                             ResultColumn{2}
+                                         }, s),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
 // =====================================================================
 // Multiple tables (i.e., multiple regions).
 // ---------------------------------------------------------------------
@@ -949,6 +1025,68 @@ BOOST_AUTO_TEST_CASE (InterpolationLargeNodeAlloc)
     }
 }
 
+BOOST_AUTO_TEST_CASE (SinglePrecisionStorage)
+{
+    auto t = Opm::ECLPropTableRawData{};
+
+    t.data = std::vector<double>{
+        // Table 0
+        // s, kr  , pc
+        0.2 , 0.0 , 0.3,
+        0.3 , 0.1 , 0.2,
+        0.8 , 0.7 , 0.0,
+
+        // Table 1
+        // s, kr      , pc
+        0.1 , 0.0     , 1.0/3.0,
+        0.4 , 1.0/7.0 , 0.1,
+        0.9 , 0.9     , 0.0,
+    };
+
+    t.numPrimary = 1;
+    t.numRows    = 3;
+    t.numCols    = 3;
+    t.numTables  = 2;
+
+    const auto orig = Opm::SatFuncInterpolant {
+        toRawTableFormat(t),
+        createDummyUnitConverter(t.numCols - 1)
+    };
+
+    auto single = orig;
+
+    const auto error = single.useSinglePrecision();
+
+    BOOST_CHECK_EQUAL(error.numValues, std::size_t{12});
+    BOOST_CHECK_GT(error.maxRelative, 0.0);
+    BOOST_CHECK_LT(error.maxRelative, 1.0e-7);
+
+    using InTable      = Opm::SatFuncInterpolant::InTable;
+    using ResultColumn = Opm::SatFuncInterpolant::ResultColumn;
+
+    // End-points unaffected.
+    check_is_close(single.connateSat(), orig.connateSat());
+    check_is_close(single.maximumSat(), orig.maximumSat());
+    check_is_close(single.criticalSat(ResultColumn{0}),
+                   orig  .criticalSat(ResultColumn{0}));
+
+    const auto s = std::vector<double>{
+        0.0, 0.15, 0.2, 0.25, 0.35, 0.5, 0.65, 0.8, 0.85, 1.0,
+    };
+
+    for (auto ti = 0*t.numTables; ti < t.numTables; ++ti) {
+        for (const auto c : { ResultColumn{0}, ResultColumn{1} }) {
+            const auto y  = single.interpolate(InTable{ti}, c, s);
+            const auto ye = orig  .interpolate(InTable{ti}, c, s);
+
+            for (auto n = s.size(), i = 0*n; i < n; ++i) {
+                BOOST_CHECK_LE(std::abs(y[i] - ye[i]),
+                               error.maxAbsolute * (1.0 + 1.0e-6));
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
 
 // =====================================================================
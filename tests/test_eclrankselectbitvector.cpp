@@ -0,0 +1,212 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_RANK_SELECT_BITVECTOR
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLRankSelectBitVector.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    /// Sparse activity pattern, roughly one quarter of all cells active,
+    /// with fully active and fully inactive runs spanning several blocks.
+    std::vector<bool> actnum(const std::size_t n)
+    {
+        auto act = std::vector<bool>(n, false);
+
+        for (auto i = 0*n; i < n; ++i) {
+            if      ((i >= 1000) && (i < 1700)) { act[i] = true;  }
+            else if ((i >= 3000) && (i < 5000)) { act[i] = false; }
+            else {
+                act[i] = ((i * 2654435761u) % 97) < 24;
+            }
+        }
+
+        return act;
+    }
+
+    /// Reference active cell index: explicit array.
+    std::vector<int> activeID(const std::vector<bool>& act)
+    {
+        auto id = std::vector<int>(act.size(), -1);
+
+        auto k = 0;
+        for (auto n = act.size(), i = 0*n; i < n; ++i) {
+            if (act[i]) { id[i] = k++; }
+        }
+
+        return id;
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (Queries)
+
+BOOST_AUTO_TEST_CASE (MatchesExplicitMapping)
+{
+    // Not a multiple of the word or block size.
+    const auto n   = std::size_t{10007};
+    const auto act = actnum(n);
+    const auto id  = activeID(act);
+
+    const auto bv = Opm::ECLRankSelectBitVector{ act };
+
+    BOOST_REQUIRE_EQUAL(bv.size(), n);
+
+    auto nact = std::size_t{0};
+    for (auto i = 0*n; i < n; ++i) {
+        BOOST_CHECK_EQUAL(bv.test(i), act[i]);
+        BOOST_CHECK_EQUAL(bv.rank(i), nact);
+        BOOST_CHECK_EQUAL(bv.position(i), id[i]);
+
+        if (act[i]) {
+            BOOST_CHECK_EQUAL(bv.select(nact), i);
+            ++nact;
+        }
+    }
+
+    BOOST_CHECK_EQUAL(bv.count(), nact);
+    BOOST_CHECK_EQUAL(bv.rank(n), nact);
+
+    // Out of range.
+    BOOST_CHECK_EQUAL(bv.position(n), -1);
+    BOOST_CHECK_THROW(bv.select(nact), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE (BatchedPositions)
+{
+    const auto n   = std::size_t{4096};
+    const auto act = actnum(n);
+    const auto id  = activeID(act);
+
+    const auto bv = Opm::ECLRankSelectBitVector{ act };
+
+    auto cells = std::vector<std::size_t>{};
+    for (auto i = 0*n; i < n + 10; i += 7) {
+        cells.push_back(i);
+    }
+
+    // Unsorted input.
+    cells.push_back(1500);
+    cells.push_back(3);
+
+    const auto pos = bv.position(cells);
+
+    BOOST_REQUIRE_EQUAL(pos.size(), cells.size());
+
+    for (auto m = cells.size(), i = 0*m; i < m; ++i) {
+        const auto expect = (cells[i] < n) ? id[cells[i]] : -1;
+
+        BOOST_CHECK_EQUAL(pos[i], expect);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (FromMemberList)
+{
+    const auto members = std::vector<std::size_t>{ 0, 63, 64, 255, 256, 511 };
+
+    const auto bv = Opm::ECLRankSelectBitVector{ 600, members };
+
+    BOOST_CHECK_EQUAL(bv.count(), members.size());
+
+    for (auto n = members.size(), k = 0*n; k < n; ++k) {
+        BOOST_CHECK_EQUAL(bv.select(k), members[k]);
+        BOOST_CHECK_EQUAL(bv.position(members[k]), static_cast<int>(k));
+    }
+
+    BOOST_CHECK_EQUAL(bv.position(62) , -1);
+    BOOST_CHECK_EQUAL(bv.position(599), -1);
+}
+
+BOOST_AUTO_TEST_CASE (EmptyAndFull)
+{
+    {
+        const auto bv = Opm::ECLRankSelectBitVector{};
+
+        BOOST_CHECK_EQUAL(bv.size() , std::size_t{0});
+        BOOST_CHECK_EQUAL(bv.count(), std::size_t{0});
+        BOOST_CHECK_EQUAL(bv.position(0), -1);
+        BOOST_CHECK_THROW(bv.select(0), std::out_of_range);
+    }
+
+    {
+        const auto bv =
+            Opm::ECLRankSelectBitVector{ std::vector<bool>(300, false) };
+
+        BOOST_CHECK_EQUAL(bv.count(), std::size_t{0});
+        BOOST_CHECK_EQUAL(bv.rank(300), std::size_t{0});
+    }
+
+    {
+        const auto bv =
+            Opm::ECLRankSelectBitVector{ std::vector<bool>(512, true) };
+
+        BOOST_CHECK_EQUAL(bv.count(), std::size_t{512});
+        BOOST_CHECK_EQUAL(bv.rank(512), std::size_t{512});
+        BOOST_CHECK_EQUAL(bv.select(511), std::size_t{511});
+        BOOST_CHECK_EQUAL(bv.position(300), 300);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Construction)
+
+BOOST_AUTO_TEST_CASE (InvalidMemberList)
+{
+    // Not increasing.
+    BOOST_CHECK_THROW(Opm::ECLRankSelectBitVector(10, { 1, 3, 3 }),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(Opm::ECLRankSelectBitVector(10, { 4, 2 }),
+                      std::invalid_argument);
+
+    // Outside range.
+    BOOST_CHECK_THROW(Opm::ECLRankSelectBitVector(10, { 1, 10 }),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE (MemoryUsage)
+{
+    const auto n  = std::size_t{1} << 20;
+    const auto bv = Opm::ECLRankSelectBitVector{ actnum(n) };
+
+    // 1.25 bits per cell, plus one trailing rank sample.
+    BOOST_CHECK_EQUAL(bv.memoryUsage(), (n / 8) + (n / 32) + 8);
+    BOOST_CHECK_LT(bv.memoryUsage() * 25, n * sizeof(int));
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,250 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_SHARED_FIELDS
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLSharedFields.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+    // Publication name unique to this process and test case.
+    std::string publicationName(const std::string& tag)
+    {
+        return "opm-test-shfld-" + std::to_string(::getpid()) + '-' + tag;
+    }
+
+    // Number of this process' memory mappings whose backing file name
+    // contains 'pattern'.  Negative if the mappings cannot be inspected.
+    int numMappings(const std::string& pattern)
+    {
+        std::ifstream maps("/proc/self/maps");
+
+        if (! maps) {
+            return -1;
+        }
+
+        auto n = 0;
+        for (std::string line; std::getline(maps, line); ) {
+            n += line.find(pattern) != std::string::npos;
+        }
+
+        return n;
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (SharedFields)
+
+BOOST_AUTO_TEST_CASE (PublishAndRead)
+{
+    const auto name = publicationName("read");
+
+    auto pub = Opm::ECLSharedFieldPublisher{ name, 4 };
+
+    const auto tof  = std::vector<double>{ 1.0, 2.5, 3.75 };
+    const auto conn = std::vector<int>{ 0, 1, 1, 2 };
+
+    pub.publish("TOF" , tof, 3);
+    pub.publish("CONN", conn);
+
+    const auto reader = Opm::ECLSharedFieldReader{ name };
+
+    const auto fields = reader.fields();
+    BOOST_CHECK_EQUAL(fields.size(), std::size_t{2});
+
+    BOOST_CHECK_EQUAL(fields[0].name, "TOF");
+    BOOST_CHECK(fields[0].type == Opm::ECLSharedFieldType::Double);
+    BOOST_CHECK_EQUAL(fields[0].size, tof.size());
+    BOOST_CHECK_EQUAL(fields[0].step, 3);
+    BOOST_CHECK_EQUAL(fields[0].generation, std::size_t{1});
+
+    BOOST_CHECK_EQUAL(fields[1].name, "CONN");
+    BOOST_CHECK(fields[1].type == Opm::ECLSharedFieldType::Int);
+    BOOST_CHECK_EQUAL(fields[1].step, -1);
+
+    const auto x = reader.doubleField("TOF");
+    BOOST_CHECK_EQUAL_COLLECTIONS(x  .begin(), x  .end(),
+                                  tof.begin(), tof.end());
+
+    const auto c = reader.intField("CONN");
+    BOOST_CHECK_EQUAL_COLLECTIONS(c   .begin(), c   .end(),
+                                  conn.begin(), conn.end());
+}
+
+BOOST_AUTO_TEST_CASE (Republish)
+{
+    const auto name = publicationName("republish");
+
+    auto pub = Opm::ECLSharedFieldPublisher{ name };
+
+    const auto v1 = std::vector<double>{ 1.0, 2.0 };
+    const auto v2 = std::vector<double>{ 10.0, 20.0, 30.0 };
+
+    pub.publish("FLUX", v1, 0);
+
+    const auto reader = Opm::ECLSharedFieldReader{ name };
+
+    const auto version = reader.version();
+    const auto old     = reader.doubleField("FLUX");
+
+    pub.publish("FLUX", v2, 1);
+
+    BOOST_CHECK(reader.version() != version);
+
+    // Previously obtained view unaffected by republication.
+    BOOST_CHECK_EQUAL_COLLECTIONS(old.begin(), old.end(),
+                                  v1 .begin(), v1 .end());
+
+    const auto fields = reader.fields();
+    BOOST_CHECK_EQUAL(fields.size(), std::size_t{1});
+    BOOST_CHECK_EQUAL(fields[0].generation, std::size_t{2});
+    BOOST_CHECK_EQUAL(fields[0].step, 1);
+
+    const auto cur = reader.doubleField("FLUX");
+    BOOST_CHECK_EQUAL_COLLECTIONS(cur.begin(), cur.end(),
+                                  v2 .begin(), v2 .end());
+
+    // Empty field has no data.
+    pub.publish("FLUX", std::vector<double>{}, 2);
+
+    const auto empty = reader.doubleField("FLUX");
+    BOOST_CHECK(empty.data == nullptr);
+    BOOST_CHECK_EQUAL(empty.size, std::size_t{0});
+}
+
+BOOST_AUTO_TEST_CASE (Errors)
+{
+    const auto name = publicationName("errors");
+
+    auto pub = Opm::ECLSharedFieldPublisher{ name, 1 };
+
+    // Duplicate publication.
+    BOOST_CHECK_THROW(Opm::ECLSharedFieldPublisher{ name }, std::exception);
+
+    BOOST_CHECK_THROW(pub.publish("", std::vector<int>{ 1 }),
+                      std::invalid_argument);
+
+    BOOST_CHECK_THROW(pub.publish("A/B", std::vector<int>{ 1 }),
+                      std::invalid_argument);
+
+    pub.publish("PORV", std::vector<double>{ 1.0 });
+
+    // Directory full.
+    BOOST_CHECK_THROW(pub.publish("TRAN", std::vector<double>{ 1.0 }),
+                      std::length_error);
+
+    const auto reader = Opm::ECLSharedFieldReader{ name };
+
+    BOOST_CHECK_THROW(reader.intField("PORV"), std::invalid_argument);
+    BOOST_CHECK_THROW(reader.doubleField("TRAN"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE (Lifetime)
+{
+    const auto name = publicationName("lifetime");
+
+    auto values = std::vector<double>{ 4.0, 5.0 };
+
+    auto reader = std::vector<Opm::ECLSharedFieldReader>{};
+    auto view   = Opm::ECLSharedFieldReader::View<double>{ nullptr, 0,
+                                                               nullptr };
+
+    {
+        auto pub = Opm::ECLSharedFieldPublisher{ name };
+        pub.publish("PRESSURE", values);
+
+        reader.emplace_back(name);
+        view = reader.back().doubleField("PRESSURE");
+    }
+
+    // Publication removed...
+    BOOST_CHECK_THROW(Opm::ECLSharedFieldReader{ name },
+                      std::invalid_argument);
+
+    // ...but existing mapping still valid.
+    BOOST_CHECK_EQUAL_COLLECTIONS(view  .begin(), view  .end(),
+                                  values.begin(), values.end());
+
+    // Also after destroying the reader.
+    reader.clear();
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(view  .begin(), view  .end(),
+                                  values.begin(), values.end());
+}
+
+BOOST_AUTO_TEST_CASE (StaleGenerations)
+{
+    const auto name    = publicationName("stale");
+    const auto segment = name + ".FLUX.";
+
+    auto pub = Opm::ECLSharedFieldPublisher{ name };
+    pub.publish("FLUX", std::vector<double>{ 1.0, 2.0 });
+
+    const auto reader = Opm::ECLSharedFieldReader{ name };
+
+    auto first = reader.doubleField("FLUX");
+
+    for (auto gen = 2; gen <= 20; ++gen) {
+        pub.publish("FLUX", std::vector<double>(3, double(gen)));
+
+        const auto cur = reader.doubleField("FLUX");
+
+        BOOST_CHECK_EQUAL(cur.size, std::size_t{3});
+        BOOST_CHECK_EQUAL(cur.data[0], double(gen));
+    }
+
+    // Outstanding view of first generation unaffected.
+    BOOST_CHECK_EQUAL(first.size, std::size_t{2});
+    BOOST_CHECK_EQUAL(first.data[0], 1.0);
+    BOOST_CHECK_EQUAL(first.data[1], 2.0);
+
+    const auto mapped = numMappings(segment);
+    if (mapped >= 0) {
+        // First and current generations only.
+        BOOST_CHECK_EQUAL(mapped, 2);
+
+        first = Opm::ECLSharedFieldReader::View<double>{ nullptr, 0,
+                                                         nullptr };
+
+        BOOST_CHECK_EQUAL(numMappings(segment), 1);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
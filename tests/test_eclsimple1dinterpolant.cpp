@@ -34,6 +34,9 @@
 #include <opm/utility/ECLPiecewiseLinearInterpolant.hpp>
 #include <opm/utility/ECLTableInterpolation1D.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <exception>
 #include <functional>
 #include <initializer_list>
@@ -1491,3 +1494,554 @@ BOOST_AUTO_TEST_CASE (PVTSingleSubTable_ExtrapWithDerivatives)
 }
 
 BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+// Point Location Using Eytzinger-Layout Search Index
+// ---------------------------------------------------------------------
+
+namespace {
+    std::vector<double> longTableAbscissas(const std::size_t n)
+    {
+        auto x = std::vector<double>{};
+        x.reserve(n);
+
+        // Non-uniform spacing.
+        for (auto i = 0*n; i < n; ++i) {
+            const auto xi = static_cast<double>(i);
+            x.push_back(1.0e5 * (xi + 0.01*xi*xi));
+        }
+
+        return x;
+    }
+
+    std::vector<double> samplePoints(const std::vector<double>& xi)
+    {
+        auto x = std::vector<double>{
+            xi.front() - 1.0, xi.back() + 1.0
+        };
+
+        for (auto n = xi.size(), i = 0*n; i < n; ++i) {
+            x.push_back(xi[i]);
+
+            if (i + 1 < n) {
+                x.push_back(0.5 * (xi[i] + xi[i + 1]));
+            }
+        }
+
+        return x;
+    }
+
+    template <class IsAscending>
+    void check_same_location(const std::vector<double>& abscissas,
+                             IsAscending                is_ascending)
+    {
+        const auto index = Opm::Interp1D::EytzingerIndex{ abscissas };
+
+        BOOST_REQUIRE(index.active());
+
+        for (const auto& x : samplePoints(abscissas)) {
+            const auto expect =
+                PP::LocalInterpPoint::identify(abscissas, x, is_ascending);
+
+            const auto pt =
+                PP::LocalInterpPoint::identify(abscissas, x, index,
+                                               is_ascending);
+
+            BOOST_CHECK(pt.cat == expect.cat);
+            BOOST_CHECK_EQUAL(pt.interval, expect.interval);
+            BOOST_CHECK_EQUAL(pt.t, expect.t);
+        }
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (PointLocationBinning_EytzingerIndex)
+
+BOOST_AUTO_TEST_CASE (ShortTableInactive)
+{
+    const auto n = Opm::Interp1D::EytzingerIndex::minimumSize() - 1;
+
+    const auto index =
+        Opm::Interp1D::EytzingerIndex{ longTableAbscissas(n) };
+
+    BOOST_CHECK(! index.active());
+
+    // Inactive index falls back to ordinary binary search.
+    const auto abscissas = longTableAbscissas(n);
+    const auto pt =
+        PP::LocalInterpPoint::identify(abscissas, abscissas[3], index);
+
+    BOOST_CHECK(pt.cat == Opm::Interp1D::PointCategory::InRange);
+    BOOST_CHECK_EQUAL(pt.interval, std::size_t{2});
+}
+
+BOOST_AUTO_TEST_CASE (Ascending)
+{
+    // Complete and incomplete trees.
+    for (const auto n : { std::size_t{  64 }, std::size_t{ 127 },
+                          std::size_t{ 128 }, std::size_t{ 300 } })
+    {
+        check_same_location(longTableAbscissas(n), std::true_type{});
+    }
+}
+
+BOOST_AUTO_TEST_CASE (Descending)
+{
+    for (const auto n : { std::size_t{  64 }, std::size_t{ 127 },
+                          std::size_t{ 128 }, std::size_t{ 300 } })
+    {
+        auto abscissas = longTableAbscissas(n);
+        std::reverse(std::begin(abscissas), std::end(abscissas));
+
+        check_same_location(abscissas, std::false_type{});
+    }
+}
+
+BOOST_AUTO_TEST_CASE (LongTableInterpolant)
+{
+    // Table of y = 2x + 1 on long, non-uniform range of abscissas.
+    auto table = longTableAbscissas(200);
+    const auto x = table;
+
+    const auto nRows = table.size();
+    for (const auto& xi : x) {
+        table.push_back(2.0*xi + 1.0);
+    }
+
+    auto xBegin = std::begin(table);
+    auto xEnd   = xBegin + nRows;
+
+    auto colIt = std::vector<decltype(xBegin)>{ xEnd };
+
+    using Extrap = PP::ExtrapolationPolicy::Constant;
+    auto interp  = PP::Linear<Extrap>
+        { Extrap{}, xBegin, xEnd, colIt,
+          createDummyTransform(),
+          createDummyTransform(colIt.size()) };
+
+    for (const auto& xi : samplePoints(x)) {
+        const auto pt = interp.classifyPoint(xi);
+
+        // Constant extrapolation outside range.
+        const auto xc = std::max(x.front(), std::min(x.back(), xi));
+
+        BOOST_CHECK_CLOSE(interp.evaluate(0, pt), 2.0*xc + 1.0, 1.0e-10);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+// Point Location Using Warm-Start Interval Hints
+// ---------------------------------------------------------------------
+
+namespace {
+    template <class IsAscending>
+    void check_hinted_location(const std::vector<double>&        abscissas,
+                               const std::vector<double>&        x,
+                               Opm::Interp1D::IntervalHintCache& hints,
+                               IsAscending                       is_ascending)
+    {
+        const auto index = Opm::Interp1D::EytzingerIndex{ abscissas };
+
+        hints.prepare(x.size());
+
+        for (auto n = x.size(), i = 0*n; i < n; ++i) {
+            const auto expect =
+                PP::LocalInterpPoint::identify(abscissas, x[i], is_ascending);
+
+            const auto pt =
+                PP::LocalInterpPoint::identify(abscissas, x[i], index,
+                                               hints, i, is_ascending);
+
+            BOOST_CHECK(pt.cat == expect.cat);
+            BOOST_CHECK_EQUAL(pt.interval, expect.interval);
+            BOOST_CHECK_EQUAL(pt.t, expect.t);
+        }
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (PointLocationBinning_IntervalHints)
+
+BOOST_AUTO_TEST_CASE (RepeatedSequence)
+{
+    for (const auto n : { std::size_t{ 10 }, std::size_t{ 200 } }) {
+        const auto abscissas = longTableAbscissas(n);
+        const auto x         = samplePoints(abscissas);
+
+        auto hints = Opm::Interp1D::IntervalHintCache{};
+
+        // Cold start.  No hits.
+        check_hinted_location(abscissas, x, hints, std::true_type{});
+        {
+            const auto& stats = hints.statistics();
+
+            BOOST_CHECK_EQUAL(stats.lookups, x.size());
+            BOOST_CHECK_EQUAL(stats.neighbourHits, std::size_t{0});
+            BOOST_CHECK_EQUAL(stats.hits, std::size_t{0});
+
+            // Points outside the tabulated range counted separately.
+            BOOST_CHECK_EQUAL(stats.extrapolated, std::size_t{2});
+            BOOST_CHECK_CLOSE(stats.hitRate(), 0.0, 1.0e-10);
+        }
+
+        hints.resetStatistics();
+
+        // Same sequence again.  Every point in hinted interval.
+        check_hinted_location(abscissas, x, hints, std::true_type{});
+        {
+            const auto& stats = hints.statistics();
+
+            BOOST_CHECK_EQUAL(stats.lookups     , x.size());
+            BOOST_CHECK_EQUAL(stats.hits        , x.size() - 2);
+            BOOST_CHECK_EQUAL(stats.extrapolated, std::size_t{2});
+            BOOST_CHECK_CLOSE(stats.hitRate(), 1.0, 1.0e-10);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (NeighbourFallback)
+{
+    const auto abscissas = longTableAbscissas(100);
+
+    // Midpoints of intervals 10, 20, ..., 80.
+    auto x = std::vector<double>{};
+    for (auto i = 10; i < 90; i += 10) {
+        x.push_back(0.5 * (abscissas[i] + abscissas[i + 1]));
+    }
+
+    auto hints = Opm::Interp1D::IntervalHintCache{};
+    check_hinted_location(abscissas, x, hints, std::true_type{});
+
+    hints.resetStatistics();
+
+    // Shift every point one interval to the right.
+    for (auto n = x.size(), i = 0*n; i < n; ++i) {
+        const auto k = 10*(i + 1) + 1;
+        x[i] = 0.5 * (abscissas[k] + abscissas[k + 1]);
+    }
+
+    check_hinted_location(abscissas, x, hints, std::true_type{});
+    {
+        const auto& stats = hints.statistics();
+
+        BOOST_CHECK_EQUAL(stats.lookups      , x.size());
+        BOOST_CHECK_EQUAL(stats.hits         , std::size_t{0});
+        BOOST_CHECK_EQUAL(stats.neighbourHits, x.size());
+    }
+
+    hints.resetStatistics();
+
+    // Shift every point far away.  Full search, but correct result.
+    for (auto n = x.size(), i = 0*n; i < n; ++i) {
+        const auto k = n - i;
+        x[i] = 0.5 * (abscissas[k] + abscissas[k + 1]);
+    }
+
+    check_hinted_location(abscissas, x, hints, std::true_type{});
+    {
+        const auto& stats = hints.statistics();
+
+        BOOST_CHECK_EQUAL(stats.lookups, x.size());
+        BOOST_CHECK_CLOSE(stats.hitRate(), 0.0, 1.0e-10);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (Descending)
+{
+    auto abscissas = longTableAbscissas(150);
+    std::reverse(abscissas.begin(), abscissas.end());
+
+    const auto x = samplePoints(abscissas);
+
+    auto hints = Opm::Interp1D::IntervalHintCache{};
+
+    check_hinted_location(abscissas, x, hints, std::false_type{});
+    hints.resetStatistics();
+
+    check_hinted_location(abscissas, x, hints, std::false_type{});
+
+    BOOST_CHECK_EQUAL(hints.statistics().hits, x.size());
+}
+
+BOOST_AUTO_TEST_CASE (ChangedSequenceSize)
+{
+    const auto abscissas = longTableAbscissas(20);
+
+    auto x = samplePoints(abscissas);
+
+    auto hints = Opm::Interp1D::IntervalHintCache{};
+    check_hinted_location(abscissas, x, hints, std::true_type{});
+
+    hints.resetStatistics();
+
+    // Different number of points discards existing hints.
+    x.pop_back();
+    check_hinted_location(abscissas, x, hints, std::true_type{});
+
+    BOOST_CHECK_EQUAL(hints.size(), x.size());
+    BOOST_CHECK_EQUAL(hints.statistics().neighbourHits, std::size_t{0});
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+// Lossless Table Simplification
+// ---------------------------------------------------------------------
+
+namespace {
+    using LinExtrap =
+        PP::Linear<PP::ExtrapolationPolicy::Linearly>;
+
+    // Table with columns
+    //   X   Y1   Y2
+    // stored column-major as in the TAB vector.
+    LinExtrap createTwoColumnInterpolant(std::vector<double> table)
+    {
+        assert (table.size() % 3 == 0);
+
+        const auto nRows = table.size() / 3;
+
+        auto xBegin = std::begin(table);
+        auto xEnd   = xBegin + nRows;
+
+        auto colIt = std::vector<decltype(xBegin)>{ xEnd, xEnd + nRows };
+
+        using Extrap = PP::ExtrapolationPolicy::Linearly;
+        return LinExtrap {
+            Extrap{}, xBegin, xEnd, colIt,
+            createDummyTransform(),
+            createDummyTransform(colIt.size())
+        };
+    }
+
+    std::vector<double> simplifyTable()
+    {
+        return {
+            // X
+            0.0 , 0.25, 0.5 , 0.5 , 0.75 , 1.0, 1.25, 1.5 ,
+            // Y1: Collinear on [0,1] except repeated row, kink at 1.
+            0.0 , 0.25, 0.5 , 0.5 , 0.75 , 1.0, 0.5 , 0.0 ,
+            // Y2: Constant except final interval.
+            2.0 , 2.0 , 2.0 , 2.0 , 2.0  , 2.0, 2.0 , 3.0 ,
+        };
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (TableSimplification)
+
+BOOST_AUTO_TEST_CASE (ExactCollinearAndDuplicate)
+{
+    const auto orig = createTwoColumnInterpolant(simplifyTable());
+    auto       simp = createTwoColumnInterpolant(simplifyTable());
+
+    // Removed: X = 0.25, 0.5 (twice), 0.75.  X = 1.25 retained since Y2
+    // changes slope at that node.
+    BOOST_CHECK_EQUAL(simp.simplify(), std::size_t{4});
+
+    {
+        const auto expect = std::vector<double> { 0.0, 1.0, 1.25, 1.5 };
+        const auto& x = simp.independentVariable();
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(x.begin(), x.end(),
+                                      expect.begin(), expect.end());
+    }
+
+    // Idempotent.
+    BOOST_CHECK_EQUAL(simp.simplify(), std::size_t{0});
+
+    // Same values everywhere, including extrapolation.
+    for (auto i = -4; i <= 10; ++i) {
+        const auto x = 0.125 + i*0.2;
+
+        const auto pto = orig.classifyPoint(x);
+        const auto pts = simp.classifyPoint(x);
+
+        for (const auto col : { std::size_t{0}, std::size_t{1} }) {
+            BOOST_CHECK_CLOSE(simp.evaluate(col, pts),
+                              orig.evaluate(col, pto), 1.0e-12);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (Disabled)
+{
+    auto interp = createTwoColumnInterpolant(simplifyTable());
+
+    BOOST_CHECK_EQUAL(interp.simplify(-1.0), std::size_t{0});
+    BOOST_CHECK_EQUAL(interp.independentVariable().size(), std::size_t{8});
+}
+
+BOOST_AUTO_TEST_CASE (Tolerance)
+{
+    auto table = simplifyTable();
+
+    // Perturb interior node at X = 0.75.
+    table[8 + 4] *= 1.0 + 1.0e-8;
+
+    {
+        auto interp = createTwoColumnInterpolant(table);
+
+        // Line from X = 0 to X = 0.75 is no longer exact.  Only X =
+        // 0.25 and the first of the repeated X = 0.5 rows are removed.
+        BOOST_CHECK_EQUAL(interp.simplify(), std::size_t{2});
+    }
+
+    {
+        auto interp = createTwoColumnInterpolant(table);
+
+        BOOST_CHECK_EQUAL(interp.simplify(1.0e-6), std::size_t{4});
+    }
+}
+
+BOOST_AUTO_TEST_CASE (Discontinuity)
+{
+    auto interp = createTwoColumnInterpolant({
+        // X
+        0.0, 0.5, 0.5, 1.0,
+        // Y1
+        0.0, 0.5, 1.0, 1.5,
+        // Y2
+        1.0, 1.0, 1.0, 1.0,
+    });
+
+    BOOST_CHECK_EQUAL(interp.simplify(), std::size_t{0});
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+// Single Precision Table Storage
+// ---------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE (SinglePrecisionStorage)
+
+BOOST_AUTO_TEST_CASE (ExactlyRepresentable)
+{
+    const auto orig   = createTwoColumnInterpolant(simplifyTable());
+    auto       single = createTwoColumnInterpolant(simplifyTable());
+
+    const auto error = single.useSinglePrecision();
+
+    BOOST_CHECK(single.singlePrecision());
+    BOOST_CHECK_EQUAL(error.numValues, std::size_t{16});
+    BOOST_CHECK_EQUAL(error.maxAbsolute, 0.0);
+    BOOST_CHECK_EQUAL(error.maxRelative, 0.0);
+
+    for (auto i = -4; i <= 10; ++i) {
+        const auto x = 0.125 + i*0.2;
+
+        const auto pto = orig  .classifyPoint(x);
+        const auto pts = single.classifyPoint(x);
+
+        for (const auto col : { std::size_t{0}, std::size_t{1} }) {
+            BOOST_CHECK_EQUAL(single.evaluate(col, pts),
+                              orig  .evaluate(col, pto));
+        }
+    }
+
+    // Already converted.  No further loss.
+    BOOST_CHECK_EQUAL(single.useSinglePrecision().numValues,
+                      std::size_t{0});
+}
+
+BOOST_AUTO_TEST_CASE (RoundingErrorBound)
+{
+    const auto table = std::vector<double> {
+        // X
+        0.0    , 0.1    , 0.3    , 0.7    , 1.0    ,
+        // Y1
+        1.0/3.0, 0.1    , 2.0/7.0, 1.0e-3 , 0.0    ,
+        // Y2
+        1.0e5/3, 123.456, 1.0e-9 , 9.87654, 1.0/9.0,
+    };
+
+    const auto orig   = createTwoColumnInterpolant(table);
+    auto       single = createTwoColumnInterpolant(table);
+
+    const auto error = single.useSinglePrecision();
+
+    BOOST_CHECK_EQUAL(error.numValues, std::size_t{10});
+    BOOST_CHECK_GT(error.maxAbsolute, 0.0);
+    BOOST_CHECK_GT(error.maxRelative, 0.0);
+
+    // Round to nearest: Half a unit in the last place of a float.
+    BOOST_CHECK_LE(error.maxRelative, std::ldexp(1.0, -24));
+
+    // Abscissas unaffected.
+    {
+        const auto& x = single.independentVariable();
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(x.begin(), x.end(),
+                                      table.begin(), table.begin() + 5);
+    }
+
+    // Interpolated values are convex combinations of the stored
+    // ordinates and inherit the error bound.
+    for (auto i = 0; i <= 50; ++i) {
+        const auto x = i / 50.0;
+
+        const auto pto = orig  .classifyPoint(x);
+        const auto pts = single.classifyPoint(x);
+
+        for (const auto col : { std::size_t{0}, std::size_t{1} }) {
+            const auto yo = orig  .evaluate(col, pto);
+            const auto ys = single.evaluate(col, pts);
+
+            BOOST_CHECK_LE(std::abs(ys - yo),
+                           error.maxAbsolute * (1.0 + 1.0e-6));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (SimplifyAfterConversion)
+{
+    const auto orig   = createTwoColumnInterpolant(simplifyTable());
+    auto       single = createTwoColumnInterpolant(simplifyTable());
+
+    single.useSinglePrecision();
+
+    BOOST_CHECK_EQUAL(single.simplify(), std::size_t{4});
+    BOOST_CHECK(single.singlePrecision());
+
+    for (auto i = -4; i <= 10; ++i) {
+        const auto x = 0.125 + i*0.2;
+
+        const auto pto = orig  .classifyPoint(x);
+        const auto pts = single.classifyPoint(x);
+
+        for (const auto col : { std::size_t{0}, std::size_t{1} }) {
+            BOOST_CHECK_CLOSE(single.evaluate(col, pts),
+                              orig  .evaluate(col, pto), 1.0e-12);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (NotRepresentable)
+{
+    // Overflow
+    {
+        auto interp = createTwoColumnInterpolant({
+            0.0, 1.0,  1.0e300, 1.0,  0.5, 0.25,
+        });
+
+        BOOST_CHECK_EQUAL(interp.useSinglePrecision().numValues,
+                          std::size_t{0});
+        BOOST_CHECK(! interp.singlePrecision());
+
+        const auto pt = interp.classifyPoint(0.0);
+        BOOST_CHECK_EQUAL(interp.evaluate(0, pt), 1.0e300);
+    }
+
+    // Underflow.  Would map positive ordinate to zero.
+    {
+        auto interp = createTwoColumnInterpolant({
+            0.0, 1.0,  0.0, 1.0e-50,  0.5, 0.25,
+        });
+
+        BOOST_CHECK_EQUAL(interp.useSinglePrecision().numValues,
+                          std::size_t{0});
+        BOOST_CHECK(! interp.singlePrecision());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,398 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_SPATIAL_INDEX
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLSpatialIndex.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <ios>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    using Point = Opm::ECLSpatialIndex::Point;
+    using CellCorners = Opm::ECLSpatialIndex::CellCorners;
+
+    // Box-shaped cell [x0,x0+dx] x [y0,y0+dy] x [z0,z0+dz] in ECL corner
+    // ordering.
+    CellCorners boxCell(const double x0, const double y0, const double z0,
+                        const double dx, const double dy, const double dz)
+    {
+        auto x = CellCorners{};
+
+        for (auto c = 0; c < 8; ++c) {
+            x[c] = Point{ {
+                x0 + ((c >> 0) & 1)*dx,
+                y0 + ((c >> 1) & 1)*dy,
+                z0 + ((c >> 2) & 1)*dz
+            } };
+        }
+
+        return x;
+    }
+
+    // NX-by-NY-by-NZ grid of unit cubes, natural ordering.
+    std::vector<CellCorners>
+    cartesianGrid(const int nx, const int ny, const int nz)
+    {
+        auto cells = std::vector<CellCorners>{};
+
+        for (auto k = 0; k < nz; ++k) {
+            for (auto j = 0; j < ny; ++j) {
+                for (auto i = 0; i < nx; ++i) {
+                    cells.push_back(boxCell(i, j, k, 1.0, 1.0, 1.0));
+                }
+            }
+        }
+
+        return cells;
+    }
+
+    // Three unit cubes along X, starting at X=10, in which the middle cell
+    // (active cell 1) is the empty host of a 2-by-2-by-2 local grid
+    // refinement (active cells 3..10, natural ordering).
+    std::vector<CellCorners> refinedGrid()
+    {
+        auto cells = std::vector<CellCorners> {
+            boxCell(10.0, 0.0, 0.0, 1.0, 1.0, 1.0),
+            Opm::ECLSpatialIndex::emptyCell(),
+            boxCell(12.0, 0.0, 0.0, 1.0, 1.0, 1.0),
+        };
+
+        for (auto k = 0; k < 2; ++k) {
+            for (auto j = 0; j < 2; ++j) {
+                for (auto i = 0; i < 2; ++i) {
+                    cells.push_back(boxCell(11.0 + 0.5*i, 0.5*j, 0.5*k,
+                                            0.5, 0.5, 0.5));
+                }
+            }
+        }
+
+        return cells;
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (PointLocation)
+
+BOOST_AUTO_TEST_CASE (CartesianCells)
+{
+    const auto nx = 10, ny = 7, nz = 5;
+
+    const auto index = Opm::ECLSpatialIndex{ cartesianGrid(nx, ny, nz) };
+
+    BOOST_CHECK_EQUAL(index.numCells(), std::size_t(nx * ny * nz));
+
+    auto points = std::vector<Point>{};
+    auto expect = std::vector<int>{};
+
+    for (auto k = 0; k < nz; ++k) {
+        for (auto j = 0; j < ny; ++j) {
+            for (auto i = 0; i < nx; ++i) {
+                points.push_back(Point{ { i + 0.25, j + 0.5, k + 0.75 } });
+                expect.push_back(i + nx*(j + ny*k));
+            }
+        }
+    }
+
+    // Outside model.
+    points.push_back(Point{ { -0.5, 0.5, 0.5 } });
+    expect.push_back(-1);
+
+    points.push_back(Point{ { 0.5, 0.5, nz + 0.5 } });
+    expect.push_back(-1);
+
+    const auto cells = index.locate(points);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(cells .begin(), cells .end(),
+                                  expect.begin(), expect.end());
+}
+
+BOOST_AUTO_TEST_CASE (SharedFace)
+{
+    const auto index = Opm::ECLSpatialIndex{ cartesianGrid(2, 1, 1) };
+
+    // On face shared by cells 0 and 1.  Least active index wins.
+    const auto cells = index.locate({ Point{ { 1.0, 0.5, 0.5 } } });
+
+    BOOST_CHECK_EQUAL(cells.size(), std::size_t{1});
+    BOOST_CHECK_EQUAL(cells[0], 0);
+}
+
+BOOST_AUTO_TEST_CASE (SkewedCell)
+{
+    // Single cell whose top is shifted one unit in the X direction.
+    auto cell = boxCell(0.0, 0.0, 0.0, 1.0, 1.0, 1.0);
+    for (auto c = 4; c < 8; ++c) {
+        cell[c][0] += 1.0;
+    }
+
+    const auto index =
+        Opm::ECLSpatialIndex{ std::vector<CellCorners>{ cell } };
+
+    // Inside bounding box, outside cell.
+    // Inside cell near top.
+    const auto cells = index.locate({
+        Point{ { 1.75, 0.5, 0.25 } },
+        Point{ { 1.75, 0.5, 0.90 } },
+    });
+
+    BOOST_CHECK_EQUAL(cells[0], -1);
+    BOOST_CHECK_EQUAL(cells[1],  0);
+}
+
+BOOST_AUTO_TEST_CASE (LocalGridRefinement)
+{
+    const auto index = Opm::ECLSpatialIndex{ refinedGrid() };
+
+    BOOST_CHECK_EQUAL(index.numCells(), std::size_t{11});
+
+    // Host cell's volume resolves to refined cells.  Origin (where an
+    // unfilled host cell would be) is outside the model.
+    const auto cells = index.locate({
+        Point{ { 10.50, 0.50, 0.50 } },
+        Point{ { 11.25, 0.25, 0.25 } },
+        Point{ { 11.75, 0.75, 0.75 } },
+        Point{ { 12.50, 0.50, 0.50 } },
+        Point{ {  0.00, 0.00, 0.00 } },
+    });
+
+    const auto expect = std::vector<int>{ 0, 3, 10, 2, -1 };
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(cells .begin(), cells .end(),
+                                  expect.begin(), expect.end());
+}
+
+BOOST_AUTO_TEST_CASE (Empty)
+{
+    const auto index =
+        Opm::ECLSpatialIndex{ std::vector<CellCorners>{} };
+
+    const auto cells = index.locate({ Point{ { 0.0, 0.0, 0.0 } } });
+
+    BOOST_CHECK_EQUAL(index.numCells(), std::size_t{0});
+    BOOST_CHECK_EQUAL(cells[0], -1);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Proximity)
+
+BOOST_AUTO_TEST_CASE (Radius)
+{
+    const auto nx = 20, ny = 20, nz = 3;
+
+    const auto index = Opm::ECLSpatialIndex{ cartesianGrid(nx, ny, nz) };
+
+    // Centroid of cell (5,5,1) and its six face neighbours.
+    {
+        const auto cells =
+            index.cellsWithinRadius(Point{ { 5.5, 5.5, 1.5 } }, 1.0);
+
+        const auto expect = std::vector<int> {
+            5 + nx*(5 + ny*0),
+            5 + nx*(4 + ny*1),
+            4 + nx*(5 + ny*1),
+            5 + nx*(5 + ny*1),
+            6 + nx*(5 + ny*1),
+            5 + nx*(6 + ny*1),
+            5 + nx*(5 + ny*2),
+        };
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(cells .begin(), cells .end(),
+                                      expect.begin(), expect.end());
+    }
+
+    // Batched.  Far away point has no neighbours.
+    {
+        const auto cells = index.cellsWithinRadius({
+            Point{ {   0.5,   0.5, 0.5 } },
+            Point{ { 100.0, 100.0, 0.5 } },
+        }, 0.1);
+
+        BOOST_CHECK_EQUAL(cells.size(), std::size_t{2});
+        BOOST_CHECK_EQUAL(cells[0].size(), std::size_t{1});
+        BOOST_CHECK_EQUAL(cells[0][0], 0);
+        BOOST_CHECK(cells[1].empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE (LocalGridRefinement)
+{
+    const auto index = Opm::ECLSpatialIndex{ refinedGrid() };
+
+    // Host cell's centroid is never reported.
+    {
+        const auto cells =
+            index.cellsWithinRadius(Point{ { 11.5, 0.5, 0.5 } }, 0.5);
+
+        const auto expect = std::vector<int>{ 3, 4, 5, 6, 7, 8, 9, 10 };
+
+        BOOST_CHECK_EQUAL_COLLECTIONS(cells .begin(), cells .end(),
+                                      expect.begin(), expect.end());
+    }
+
+    {
+        const auto cells =
+            index.cellsWithinRadius(Point{ { 0.0, 0.0, 0.0 } }, 1.0);
+
+        BOOST_CHECK(cells.empty());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (CacheFile)
+
+BOOST_AUTO_TEST_CASE (SaveAndLoad)
+{
+    namespace fs = boost::filesystem;
+
+    const auto nx = 9, ny = 8, nz = 4;
+
+    const auto index = Opm::ECLSpatialIndex{ cartesianGrid(nx, ny, nz) };
+
+    const auto cache =
+        fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.sidx");
+
+    index.save(cache);
+
+    const auto restored = Opm::ECLSpatialIndex::load(cache);
+
+    fs::remove(cache);
+
+    BOOST_CHECK_EQUAL(restored.numCells(), index.numCells());
+
+    auto points = std::vector<Point>{};
+    for (auto k = 0; k < nz; ++k) {
+        for (auto j = 0; j < ny; ++j) {
+            for (auto i = 0; i < nx; ++i) {
+                points.push_back(Point{ { i + 0.5, j + 0.5, k + 0.5 } });
+            }
+        }
+    }
+
+    const auto expect = index   .locate(points);
+    const auto cells  = restored.locate(points);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(cells .begin(), cells .end(),
+                                  expect.begin(), expect.end());
+}
+
+BOOST_AUTO_TEST_CASE (SaveAndLoadRefined)
+{
+    namespace fs = boost::filesystem;
+
+    const auto index = Opm::ECLSpatialIndex{ refinedGrid() };
+
+    const auto cache =
+        fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.sidx");
+
+    index.save(cache);
+
+    const auto restored = Opm::ECLSpatialIndex::load(cache);
+
+    fs::remove(cache);
+
+    const auto points = std::vector<Point> {
+        Point{ { 10.50, 0.50, 0.50 } },
+        Point{ { 11.25, 0.75, 0.25 } },
+        Point{ { 11.50, 0.50, 0.50 } },
+        Point{ { 12.50, 0.50, 0.50 } },
+    };
+
+    const auto expect = index   .locate(points);
+    const auto cells  = restored.locate(points);
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(cells .begin(), cells .end(),
+                                  expect.begin(), expect.end());
+}
+
+BOOST_AUTO_TEST_CASE (CorruptCellIndex)
+{
+    namespace fs = boost::filesystem;
+
+    const auto index = Opm::ECLSpatialIndex{ cartesianGrid(3, 2, 2) };
+
+    const auto cache =
+        fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.sidx");
+
+    index.save(cache);
+
+    // Last record of file is final element of leaf ordering.  Replace
+    // by out of bounds cell index.
+    {
+        fs::fstream f(cache, std::ios::in | std::ios::out |
+                             std::ios::binary);
+
+        const auto bad = 1000;
+
+        f.seekp(-static_cast<std::streamoff>(sizeof bad), std::ios::end);
+        f.write(reinterpret_cast<const char*>(&bad), sizeof bad);
+    }
+
+    BOOST_CHECK_THROW(Opm::ECLSpatialIndex::load(cache),
+                      std::runtime_error);
+
+    fs::remove(cache);
+}
+
+BOOST_AUTO_TEST_CASE (NotACacheFile)
+{
+    namespace fs = boost::filesystem;
+
+    const auto file =
+        fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.txt");
+
+    {
+        fs::ofstream os(file);
+        os << "Not a spatial index\n";
+    }
+
+    BOOST_CHECK_THROW(Opm::ECLSpatialIndex::load(file), std::runtime_error);
+
+    fs::remove(file);
+
+    BOOST_CHECK_THROW(Opm::ECLSpatialIndex::load(file),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,261 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_STATIC_ARRAY_CACHE
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLMemoryBudget.hpp>
+#include <opm/utility/ECLStaticArrayCache.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE (Lookup)
+
+BOOST_AUTO_TEST_CASE (ComputedOnce)
+{
+    Opm::ECLStaticArrayCache cache{};
+
+    auto ncompute = 0;
+    auto swl = [&ncompute]()
+    {
+        ++ncompute;
+
+        return std::vector<double>{ 0.1, 0.2, 0.15 };
+    };
+
+    const auto key = Opm::ECLStaticArrayCache::Key{ 1, "SWL" };
+
+    const auto x1 = cache.get<double>(key, swl);
+    const auto x2 = cache.get<double>(key, swl);
+
+    BOOST_CHECK_EQUAL(ncompute, 1);
+    BOOST_CHECK_EQUAL(x1.get(), x2.get());
+    BOOST_CHECK_EQUAL(x1->size(), std::size_t{3});
+
+    BOOST_CHECK_EQUAL(cache.hits(),   std::size_t{1});
+    BOOST_CHECK_EQUAL(cache.misses(), std::size_t{1});
+    BOOST_CHECK_EQUAL(cache.bytes(),  3 * sizeof(double));
+}
+
+BOOST_AUTO_TEST_CASE (DistinctKeys)
+{
+    Opm::ECLStaticArrayCache cache{};
+
+    auto ncompute = 0;
+    auto array = [&ncompute](const int value)
+    {
+        return [&ncompute, value]()
+        {
+            ++ncompute;
+
+            return std::vector<int>(4, value);
+        };
+    };
+
+    // Same keyword, different cell layouts.
+    const auto a = cache.get<int>({ 1, "SATNUM" }, array(1));
+    const auto b = cache.get<int>({ 2, "SATNUM" }, array(2));
+
+    // Same layout, different keywords.
+    const auto c = cache.get<int>({ 1, "PVTNUM" }, array(3));
+
+    BOOST_CHECK_EQUAL(ncompute, 3);
+    BOOST_CHECK_EQUAL((*a)[0], 1);
+    BOOST_CHECK_EQUAL((*b)[0], 2);
+    BOOST_CHECK_EQUAL((*c)[0], 3);
+
+    // Element types are cached separately.
+    const auto d = cache.get<double>({ 1, "SATNUM" }, []()
+    {
+        return std::vector<double>(2, 1.0);
+    });
+
+    BOOST_CHECK_EQUAL(d->size(), std::size_t{2});
+    BOOST_CHECK_EQUAL(cache.misses(), std::size_t{4});
+}
+
+BOOST_AUTO_TEST_CASE (EmptyResultCached)
+{
+    Opm::ECLStaticArrayCache cache{};
+
+    auto ncompute = 0;
+    auto missing = [&ncompute]()
+    {
+        ++ncompute;
+
+        return std::vector<double>{};
+    };
+
+    cache.get<double>({ 1, "SGU" }, missing);
+    const auto x = cache.get<double>({ 1, "SGU" }, missing);
+
+    BOOST_CHECK(x->empty());
+    BOOST_CHECK_EQUAL(ncompute, 1);
+}
+
+BOOST_AUTO_TEST_CASE (FailedComputationNotCached)
+{
+    Opm::ECLStaticArrayCache cache{};
+
+    BOOST_CHECK_THROW(cache.get<double>({ 1, "DEPTH" }, []()
+                      -> std::vector<double>
+    {
+        throw std::invalid_argument("Keyword Not Available");
+    }), std::invalid_argument);
+
+    const auto x = cache.get<double>({ 1, "DEPTH" }, []()
+    {
+        return std::vector<double>{ 1000.0 };
+    });
+
+    BOOST_CHECK_EQUAL(x->size(), std::size_t{1});
+    BOOST_CHECK_EQUAL(cache.misses(), std::size_t{1});
+}
+
+BOOST_AUTO_TEST_CASE (Clear)
+{
+    Opm::ECLStaticArrayCache cache{};
+
+    auto ncompute = 0;
+    auto f = [&ncompute]()
+    {
+        ++ncompute;
+
+        return std::vector<int>(10, 1);
+    };
+
+    const auto x = cache.get<int>({ 1, "FIPNUM" }, f);
+
+    cache.clear();
+
+    BOOST_CHECK_EQUAL(cache.bytes(), std::size_t{0});
+
+    // Existing references remain valid.
+    BOOST_CHECK_EQUAL(x->size(), std::size_t{10});
+
+    cache.get<int>({ 1, "FIPNUM" }, f);
+
+    BOOST_CHECK_EQUAL(ncompute, 2);
+}
+
+BOOST_AUTO_TEST_CASE (ChargedToBudget)
+{
+    Opm::ECLMemoryBudget budget{ 10 * sizeof(double) };
+
+    {
+        Opm::ECLStaticArrayCache cache{ budget };
+
+        cache.get<int>({ 1, "FIPNUM" }, []()
+        {
+            return std::vector<int>(10, 1);
+        });
+
+        cache.get<double>({ 1, "PORV" }, []()
+        {
+            return std::vector<double>(20, 0.1);
+        });
+
+        // Retained although larger than the limit.
+        BOOST_CHECK_EQUAL(budget.usage(), cache.bytes());
+
+        const auto rpt = budget.report();
+        BOOST_REQUIRE_EQUAL(rpt.size(), std::size_t{1});
+
+        BOOST_CHECK(! rpt[0].evictable);
+        BOOST_CHECK_EQUAL(rpt[0].entries, std::size_t{2});
+        BOOST_CHECK_EQUAL(rpt[0].bytes  , cache.bytes());
+
+        cache.clear();
+        BOOST_CHECK_EQUAL(budget.usage(), std::size_t{0});
+
+        cache.get<int>({ 1, "FIPNUM" }, []()
+        {
+            return std::vector<int>(10, 1);
+        });
+
+        BOOST_CHECK_EQUAL(budget.usage(), 10 * sizeof(int));
+    }
+
+    BOOST_CHECK_EQUAL(budget.usage(), std::size_t{0});
+    BOOST_CHECK(budget.report().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Concurrency)
+
+BOOST_AUTO_TEST_CASE (ConcurrentRequestsComputeOnce)
+{
+    Opm::ECLStaticArrayCache cache{};
+
+    std::atomic<int> ncompute{0};
+    std::atomic<int> nwrong{0};
+
+    auto swl = [&ncompute]()
+    {
+        ++ncompute;
+
+        return std::vector<double>(1000, 0.2);
+    };
+
+    // Boost.Test assertions are not thread-safe.  Count failures instead.
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t < 8; ++t) {
+        threads.emplace_back([&cache, &nwrong, &swl]()
+        {
+            for (auto i = 0; i < 100; ++i) {
+                const auto x = cache.get<double>({ 1, "SWL" }, swl);
+
+                if (x->size() != 1000) {
+                    ++nwrong;
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    BOOST_CHECK_EQUAL(nwrong.load(), 0);
+    BOOST_CHECK_EQUAL(ncompute.load(), 1);
+    BOOST_CHECK_EQUAL(cache.hits() + cache.misses(), std::size_t{800});
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
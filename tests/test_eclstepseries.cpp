@@ -0,0 +1,306 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_STEP_SERIES
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLStepSeries.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    /// Slowly varying pressure-like field.  Single precision values, as
+    /// stored in restart files.
+    std::vector<double> pressure(const std::size_t n, const int step)
+    {
+        auto p = std::vector<double>(n);
+
+        for (auto i = 0*n; i < n; ++i) {
+            p[i] = static_cast<float>(250.0 + 0.01*i - 0.125*step
+                + ((i % 7 == static_cast<std::size_t>(step % 7))
+                   ? 1.0e-3 : 0.0));
+        }
+
+        return p;
+    }
+
+    std::uint64_t bits(const double x)
+    {
+        auto w = std::uint64_t{0};
+        std::memcpy(&w, &x, sizeof w);
+
+        return w;
+    }
+
+    void checkBitwiseEqual(const std::vector<double>& x,
+                           const std::vector<double>& expect)
+    {
+        BOOST_REQUIRE_EQUAL(x.size(), expect.size());
+
+        for (auto n = x.size(), i = 0*n; i < n; ++i) {
+            BOOST_CHECK_EQUAL(bits(x[i]), bits(expect[i]));
+        }
+    }
+
+    Opm::ECLStepSeries::Options options(const int    keyframeInterval,
+                                        const double tolerance)
+    {
+        auto opt = Opm::ECLStepSeries::Options{};
+
+        opt.keyframeInterval = keyframeInterval;
+        opt.tolerance        = tolerance;
+
+        return opt;
+    }
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (Lossless)
+
+BOOST_AUTO_TEST_CASE (RandomAccess)
+{
+    const auto n = std::size_t{100};
+
+    auto series = Opm::ECLStepSeries{ n, options(4, 0.0) };
+
+    // Report steps need not be contiguous.
+    for (auto step = 1; step <= 21; step += 2) {
+        auto p = pressure(n, step);
+        p[step % n] = std::numeric_limits<double>::quiet_NaN();
+        p[0]        = -0.0;
+
+        series.append(step, p);
+    }
+
+    BOOST_CHECK_EQUAL(series.reportSteps().size(), std::size_t{11});
+    BOOST_CHECK(  series.hasStep(5));
+    BOOST_CHECK(! series.hasStep(6));
+
+    // Reverse order to exercise keyframe lookup independently of
+    // insertion order.
+    for (auto step = 21; step >= 1; step -= 2) {
+        auto expect = pressure(n, step);
+        expect[step % n] = std::numeric_limits<double>::quiet_NaN();
+        expect[0]        = -0.0;
+
+        checkBitwiseEqual(series.values(step), expect);
+    }
+
+    BOOST_CHECK_THROW(series.values(6), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE (CompressesSlowlyVaryingField)
+{
+    const auto n = std::size_t{2000};
+    const auto nstep = 16;
+
+    auto series = Opm::ECLStepSeries{ n, options(8, 0.0) };
+
+    for (auto step = 0; step < nstep; ++step) {
+        series.append(step, pressure(n, step));
+    }
+
+    const auto raw = n * nstep * sizeof(double);
+
+    BOOST_CHECK_LT(series.compressedSize(), raw / 2);
+}
+
+BOOST_AUTO_TEST_CASE (EveryStepKeyframe)
+{
+    const auto n = std::size_t{50};
+
+    auto series = Opm::ECLStepSeries{ n, options(1, 0.0) };
+
+    for (auto step = 0; step < 5; ++step) {
+        series.append(step, pressure(n, step));
+    }
+
+    for (auto step = 0; step < 5; ++step) {
+        checkBitwiseEqual(series.values(step), pressure(n, step));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (BoundedError)
+
+BOOST_AUTO_TEST_CASE (WithinTolerance)
+{
+    const auto n   = std::size_t{500};
+    const auto tol = 1.0e-4;
+
+    auto series = Opm::ECLStepSeries{ n, options(5, tol) };
+
+    for (auto step = 0; step < 23; ++step) {
+        series.append(step, pressure(n, step));
+    }
+
+    for (auto step = 0; step < 23; ++step) {
+        const auto x      = series.values(step);
+        const auto expect = pressure(n, step);
+
+        BOOST_REQUIRE_EQUAL(x.size(), expect.size());
+
+        for (auto i = 0*n; i < n; ++i) {
+            BOOST_CHECK_LE(std::abs(x[i] - expect[i]), tol * (1.0 + 1.0e-9));
+        }
+    }
+
+    // Quantised differences are smaller than bit pattern XORs.
+    auto lossless = Opm::ECLStepSeries{ n, options(5, 0.0) };
+    for (auto step = 0; step < 23; ++step) {
+        lossless.append(step, pressure(n, step));
+    }
+
+    BOOST_CHECK_LT(series.compressedSize(), lossless.compressedSize());
+}
+
+BOOST_AUTO_TEST_CASE (NonFiniteValue)
+{
+    auto series = Opm::ECLStepSeries{ 3, options(4, 0.5) };
+
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    BOOST_CHECK_THROW(series.append(0, { 1.0, nan, 2.0 }),
+                      std::invalid_argument);
+
+    BOOST_CHECK_THROW(series.append(0, { 1.0, 1.0e300, 2.0 }),
+                      std::invalid_argument);
+
+    BOOST_CHECK(series.reportSteps().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (Errors)
+
+BOOST_AUTO_TEST_CASE (InvalidInput)
+{
+    BOOST_CHECK_THROW(Opm::ECLStepSeries(10, options(0, 0.0)),
+                      std::invalid_argument);
+
+    BOOST_CHECK_THROW(Opm::ECLStepSeries(10, options(4, -1.0)),
+                      std::invalid_argument);
+
+    auto series = Opm::ECLStepSeries{ 3 };
+
+    series.append(2, { 1.0, 2.0, 3.0 });
+
+    // Non-increasing report step.
+    BOOST_CHECK_THROW(series.append(2, { 1.0, 2.0, 3.0 }),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(series.append(1, { 1.0, 2.0, 3.0 }),
+                      std::invalid_argument);
+
+    // Size mismatch.
+    BOOST_CHECK_THROW(series.append(3, { 1.0, 2.0 }),
+                      std::invalid_argument);
+
+    BOOST_CHECK_EQUAL(series.reportSteps().size(), std::size_t{1});
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// =====================================================================
+
+BOOST_AUTO_TEST_SUITE (StepSeriesFile)
+
+BOOST_AUTO_TEST_CASE (SaveAndLoad)
+{
+    namespace fs = boost::filesystem;
+
+    const auto n = std::size_t{64};
+
+    auto series = Opm::ECLStepSeries{ n, options(3, 0.0) };
+    for (auto step = 0; step < 7; ++step) {
+        series.append(step, pressure(n, step));
+    }
+
+    const auto file =
+        fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.fstep");
+
+    series.save(file);
+
+    auto restored = Opm::ECLStepSeries::load(file);
+
+    fs::remove(file);
+
+    BOOST_CHECK_EQUAL(restored.numValues(), n);
+    BOOST_CHECK_EQUAL(restored.options().keyframeInterval, 3);
+    BOOST_CHECK_EQUAL(restored.compressedSize(), series.compressedSize());
+
+    for (auto step = 0; step < 7; ++step) {
+        checkBitwiseEqual(restored.values(step), pressure(n, step));
+    }
+
+    // Restored series continues from last step.
+    restored.append(7, pressure(n, 7));
+    series  .append(7, pressure(n, 7));
+
+    BOOST_CHECK_EQUAL(restored.compressedSize(), series.compressedSize());
+    checkBitwiseEqual(restored.values(7), pressure(n, 7));
+}
+
+BOOST_AUTO_TEST_CASE (NotAStepSeriesFile)
+{
+    namespace fs = boost::filesystem;
+
+    const auto file =
+        fs::temp_directory_path() / fs::unique_path("%%%%-%%%%.fstep");
+
+    {
+        fs::ofstream os(file);
+        os << "Not a step series";
+    }
+
+    BOOST_CHECK_THROW(Opm::ECLStepSeries::load(file), std::runtime_error);
+
+    fs::remove(file);
+
+    BOOST_CHECK_THROW(Opm::ECLStepSeries::load(file),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,262 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_SUMMARY_DATA
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLSummaryData.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    // Minimal writer of unformatted ECL keywords (big-endian, Fortran
+    // record markers).
+    class ECLWriter
+    {
+    public:
+        explicit ECLWriter(const boost::filesystem::path& file)
+            : os_(file, std::ios::out | std::ios::binary)
+        {}
+
+        void strings(const std::string&              name,
+                     const std::vector<std::string>& x)
+        {
+            auto raw = std::string{};
+            for (const auto& s : x) {
+                raw += (s + std::string(8, ' ')).substr(0, 8);
+            }
+
+            this->keyword(name, "CHAR", x.size(), raw, 8, 105);
+        }
+
+        void ints(const std::string& name, const std::vector<int>& x)
+        {
+            auto raw = std::string{};
+            for (const auto& i : x) {
+                raw += bigEndian(static_cast<std::uint32_t>(i));
+            }
+
+            this->keyword(name, "INTE", x.size(), raw, 4, 1000);
+        }
+
+        void floats(const std::string& name, const std::vector<float>& x)
+        {
+            auto raw = std::string{};
+            for (const auto& f : x) {
+                auto u = std::uint32_t{0};
+                std::memcpy(&u, &f, sizeof u);
+
+                raw += bigEndian(u);
+            }
+
+            this->keyword(name, "REAL", x.size(), raw, 4, 1000);
+        }
+
+    private:
+        boost::filesystem::ofstream os_;
+
+        static std::string bigEndian(const std::uint32_t u)
+        {
+            const char b[] = {
+                char((u >> 24) & 0xFF), char((u >> 16) & 0xFF),
+                char((u >>  8) & 0xFF), char((u >>  0) & 0xFF)
+            };
+
+            return std::string(b, 4);
+        }
+
+        void record(const std::string& data)
+        {
+            const auto m = bigEndian(static_cast<std::uint32_t>(data.size()));
+
+            this->os_ << m << data << m;
+        }
+
+        void keyword(const std::string& name, const std::string& type,
+                     const std::size_t count, const std::string& raw,
+                     const std::size_t elemSize, const std::size_t block)
+        {
+            this->record((name + std::string(8, ' ')).substr(0, 8)
+                         + bigEndian(static_cast<std::uint32_t>(count))
+                         + type);
+
+            for (auto p = std::size_t{0}; p < raw.size();
+                 p += block * elemSize)
+            {
+                this->record(raw.substr(p, block * elemSize));
+            }
+        }
+    };
+
+    struct Case
+    {
+        Case()
+        {
+            namespace fs = boost::filesystem;
+
+            const auto base = fs::temp_directory_path()
+                / fs::unique_path("%%%%-%%%%");
+
+            this->smspec = base; this->smspec += ".SMSPEC";
+            this->unsmry = base; this->unsmry += ".UNSMRY";
+
+            {
+                ECLWriter w{ this->smspec };
+
+                w.ints("DIMENS", { 6, 10, 10, 3, 0, -1 });
+                w.strings("KEYWORDS", { "TIME", "WOPR", "WOPR", "WWIR",
+                                        "FOPT", "BPR" });
+                w.strings("WGNAMES", { ":+:+:+:+", "P1", "P2", "I1",
+                                       ":+:+:+:+", ":+:+:+:+" });
+                w.ints("NUMS", { 0, 0, 0, 0, 0, 123 });
+                w.strings("UNITS", { "DAYS", "SM3/DAY", "SM3/DAY",
+                                     "SM3/DAY", "SM3", "BARSA" });
+            }
+
+            {
+                ECLWriter w{ this->unsmry };
+
+                auto t = 0.0f;
+                auto ministep = 0;
+
+                // Three report steps with 2, 1 and 3 time steps.
+                for (const auto nstep : { 2, 1, 3 }) {
+                    w.ints("SEQHDR", { 0 });
+
+                    for (auto i = 0; i < nstep; ++i) {
+                        t += 10.0f;
+
+                        w.ints("MINISTEP", { ministep++ });
+                        w.floats("PARAMS", { t, 100.0f + t, 200.0f + t,
+                                             300.0f + t, 10.0f * t,
+                                             250.0f });
+                    }
+                }
+            }
+        }
+
+        ~Case()
+        {
+            boost::filesystem::remove(this->smspec);
+            boost::filesystem::remove(this->unsmry);
+        }
+
+        boost::filesystem::path smspec;
+        boost::filesystem::path unsmry;
+    };
+} // Anonymous
+
+BOOST_AUTO_TEST_SUITE (SummaryData)
+
+BOOST_AUTO_TEST_CASE (Index)
+{
+    const Case cse{};
+    const auto smry = Opm::ECLSummaryData{ cse.smspec, cse.unsmry };
+
+    BOOST_CHECK(  smry.hasVector({ "WOPR", "P1" }));
+    BOOST_CHECK(  smry.hasVector({ "FOPT" }));
+    BOOST_CHECK(  smry.hasVector({ "BPR", "", 123 }));
+    BOOST_CHECK(! smry.hasVector({ "BPR", "", 124 }));
+    BOOST_CHECK(! smry.hasVector({ "WOPR", "I1" }));
+    BOOST_CHECK(! smry.hasVector({ "WWCT", "P1" }));
+
+    const auto wells = smry.names("WOPR");
+    const auto expect = std::vector<std::string>{ "P1", "P2" };
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(wells .begin(), wells .end(),
+                                  expect.begin(), expect.end());
+
+    BOOST_CHECK_EQUAL(smry.unit({ "WWIR", "I1" }), "SM3/DAY");
+}
+
+BOOST_AUTO_TEST_CASE (Extract)
+{
+    const Case cse{};
+    const auto smry = Opm::ECLSummaryData{ cse.smspec, cse.unsmry };
+
+    const auto ts = smry.extract({ { "WOPR", "P2" }, { "FOPT" } });
+
+    BOOST_CHECK_EQUAL(ts.time.size(), std::size_t{6});
+    BOOST_CHECK_EQUAL(ts.values.size(), std::size_t{2});
+
+    const auto steps  = std::vector<int>{ 1, 1, 2, 3, 3, 3 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(ts.reportStep.begin(), ts.reportStep.end(),
+                                  steps.begin(), steps.end());
+
+    for (auto i = 0; i < 6; ++i) {
+        const auto t = 10.0*(i + 1);
+
+        BOOST_CHECK_CLOSE(ts.time[i], t, 1.0e-5);
+        BOOST_CHECK_CLOSE(ts.values[0][i], 200.0 + t, 1.0e-5);
+        BOOST_CHECK_CLOSE(ts.values[1][i], 10.0 * t, 1.0e-5);
+    }
+
+    BOOST_CHECK_EQUAL(ts.timeStepAtReport(1),  1);
+    BOOST_CHECK_EQUAL(ts.timeStepAtReport(2),  2);
+    BOOST_CHECK_EQUAL(ts.timeStepAtReport(3),  5);
+    BOOST_CHECK_EQUAL(ts.timeStepAtReport(0), -1);
+    BOOST_CHECK_EQUAL(ts.timeStepAtReport(4), -1);
+
+    BOOST_CHECK_THROW(smry.extract({ { "WOPR" } }), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE (Errors)
+{
+    namespace fs = boost::filesystem;
+
+    const auto missing = fs::temp_directory_path()
+        / fs::unique_path("%%%%-%%%%.SMSPEC");
+
+    BOOST_CHECK_THROW(Opm::ECLSummaryData(missing, missing),
+                      std::invalid_argument);
+
+    {
+        fs::ofstream os(missing);
+        os << "Not an ECL file at all";
+    }
+
+    BOOST_CHECK_THROW(Opm::ECLSummaryData(missing, missing),
+                      std::runtime_error);
+
+    fs::remove(missing);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
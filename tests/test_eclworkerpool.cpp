@@ -0,0 +1,196 @@
+/*
+  Copyright 2017 Statoil ASA.
+
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif // HAVE_CONFIG_H
+
+#if HAVE_DYNAMIC_BOOST_TEST
+#define BOOST_TEST_DYN_LINK
+#endif
+
+#define NVERBOSE
+
+#define BOOST_TEST_MODULE TEST_WORKER_POOL
+
+#include <opm/common/utility/platform_dependent/disable_warnings.h>
+#include <boost/test/unit_test.hpp>
+#include <opm/common/utility/platform_dependent/reenable_warnings.h>
+
+#include <opm/utility/ECLExecutor.hpp>
+#include <opm/utility/ECLWorkerPool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <csignal>
+#include <unistd.h>
+
+BOOST_AUTO_TEST_SUITE (WorkerPool)
+
+BOOST_AUTO_TEST_CASE (SharedState)
+{
+    // "Static model" loaded once in parent.
+    auto model = std::vector<double>(100000);
+    std::iota(model.begin(), model.end(), 0.0);
+
+    Opm::ECLWorkerPool pool{ 3 };
+
+    const auto nTask = 8;
+    for (auto step = 0; step < nTask; ++step) {
+        const auto ticket = pool.submit([&model, step]() -> std::string
+        {
+            // Modifications are private to the worker.
+            model[0] = -1.0;
+
+            return std::to_string(step) + ':'
+                + std::to_string(static_cast<long>(model[step + 1]));
+        });
+
+        BOOST_CHECK_EQUAL(ticket, std::size_t(step));
+        BOOST_CHECK(pool.running() <= std::size_t{3});
+    }
+
+    const auto results = pool.wait();
+
+    BOOST_CHECK_EQUAL(pool.running(), std::size_t{0});
+    BOOST_CHECK_EQUAL(results.size(), std::size_t(nTask));
+
+    for (auto step = 0; step < nTask; ++step) {
+        BOOST_CHECK_EQUAL(results[step].status, 0);
+        BOOST_CHECK_EQUAL(results[step].output,
+                          std::to_string(step) + ':' +
+                          std::to_string(step + 1));
+    }
+
+    BOOST_CHECK_EQUAL(model[0], 0.0);
+}
+
+BOOST_AUTO_TEST_CASE (LargeOutput)
+{
+    Opm::ECLWorkerPool pool{ 2 };
+
+    // Larger than typical pipe buffer.
+    const auto n = std::size_t{1} << 20;
+
+    pool.submit([n]() { return std::string(n, 'x'); });
+    pool.submit([n]() { return std::string(n, 'y'); });
+
+    const auto results = pool.wait();
+
+    BOOST_CHECK_EQUAL(results[0].output, std::string(n, 'x'));
+    BOOST_CHECK_EQUAL(results[1].output, std::string(n, 'y'));
+}
+
+BOOST_AUTO_TEST_CASE (Failures)
+{
+    BOOST_CHECK_THROW(Opm::ECLWorkerPool{ 0 }, std::invalid_argument);
+
+    Opm::ECLWorkerPool pool{ 4 };
+
+    pool.submit([]() -> std::string
+    {
+        throw std::runtime_error("Step 3 Unavailable");
+    });
+
+    pool.submit([]() -> std::string
+    {
+        ::_exit(7);
+    });
+
+    pool.submit([]() -> std::string
+    {
+        std::raise(SIGKILL);
+        return "";
+    });
+
+    const auto results = pool.wait();
+
+    BOOST_CHECK_EQUAL(results[0].status, 1);
+    BOOST_CHECK_EQUAL(results[0].output, "Step 3 Unavailable");
+
+    BOOST_CHECK_EQUAL(results[1].status, 7);
+    BOOST_CHECK_EQUAL(results[2].status, -SIGKILL);
+
+    // Results are consumed by wait().
+    BOOST_CHECK(pool.wait().empty());
+}
+
+BOOST_AUTO_TEST_CASE (ForkAfterParallelLoop)
+{
+    Opm::ECLExecution::setDefaultExecutor
+        (std::make_shared<Opm::ECLWorkStealingExecutor>(4));
+
+    const auto n = std::size_t{100000};
+
+    // Start the parent's worker threads.
+    std::atomic<std::size_t> total{ 0 };
+    Opm::ECLExecution::parallelFor(n, 64,
+        [&total](const std::size_t begin, const std::size_t end)
+    {
+        total += end - begin;
+    });
+
+    BOOST_CHECK_EQUAL(total.load(), n);
+
+    Opm::ECLWorkerPool pool{ 2 };
+
+    for (auto task = 0; task < 4; ++task) {
+        pool.submit([n]() -> std::string
+        {
+            // Turn a deadlock into a failed task.
+            ::alarm(60);
+
+            auto count = std::size_t{0};
+            Opm::ECLExecution::parallelFor(n, 64,
+                [&count](const std::size_t begin, const std::size_t end)
+            {
+                count += end - begin;
+            });
+
+            const auto concurrency =
+                Opm::ECLExecution::defaultExecutor()->concurrency();
+
+            return std::to_string(count) + ':'
+                + std::to_string(concurrency);
+        });
+    }
+
+    const auto results = pool.wait();
+
+    BOOST_CHECK_EQUAL(results.size(), std::size_t{4});
+
+    for (const auto& result : results) {
+        BOOST_CHECK_EQUAL(result.status, 0);
+        BOOST_CHECK_EQUAL(result.output, std::to_string(n) + ":1");
+    }
+
+    // Parent's executor unaffected.
+    BOOST_CHECK_EQUAL(Opm::ECLExecution::defaultExecutor()->concurrency(),
+                      std::size_t{4});
+
+    Opm::ECLExecution::setDefaultExecutor(nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()